@@ -464,6 +464,14 @@ void ETH_DeInit(void);
   */
 void ETH_EnableRx(void);
 
+/**
+  * \brief  Enable the TX interrupt and let the DMA poll the Tx descriptors.
+  * \note   The Tx descriptors of the frame must be owned by the DMA before calling it.
+  * \param[in]  ETH_InitStruct: The pointer to ETH_InitTypeDef.
+  * \return None.
+  */
+void ETH_TriggerTx(ETH_InitTypeDef *ETH_InitStruct);
+
 /**
   * \brief  To send frame.
   * \param[in]  ETH_InitStruct: The pointer to ETH_InitTypeDef.
@@ -531,6 +531,19 @@ void ETH_DeInit(void)
     RCC_PeriphClockCmd(APBPeriph_ETH, APBPeriph_ETH_CLOCK, DISABLE);
 }
 
+/**
+  * \brief  Enable the TX interrupt and let the DMA poll the Tx descriptors.
+  * \param  ETH_InitStruct: The pointer to ETH_InitTypeDef.
+  * \return None.
+  */
+RAM_FUNCTION
+void ETH_TriggerTx(ETH_InitTypeDef *ETH_InitStruct)
+{
+    ETH_InitStruct->ETH_IntMaskAndStatus |= ETH_IMR_TOK;
+    ETH->ETH_ISR_IMR.b.tok_or_ti |= 1;
+    ETH_CPU->ETH_ETHER_IO_CMD.b.tx_fn1st = 1;
+}
+
 /**
   * \brief  To send frame.
   * \param  ETH_InitStruct: The pointer to ETH_InitTypeDef.
@@ -634,9 +647,7 @@ ETH_Status ETH_SendFrame(ETH_InitTypeDef *ETH_InitStruct, uint32_t FrameLength)
         }
     }
 
-    ETH_InitStruct->ETH_IntMaskAndStatus |= ETH_IMR_TOK;
-    ETH->ETH_ISR_IMR.b.tok_or_ti |= 1;
-    ETH_CPU->ETH_ETHER_IO_CMD.b.tx_fn1st = 1;
+    ETH_TriggerTx(ETH_InitStruct);
 
     return ETH_STATUS_OK;
 }
@@ -15,6 +15,7 @@
 #include <link_mgr.h>
 #include <user_cmd.h>
 #include <user_cmd_parse.h>
+#include <data_uart.h>
 #include <simple_ble_client.h>
 #include <gaps_client.h>
 #include <bas_client.h>
@@ -55,7 +56,8 @@ void app_handle_gap_msg(T_IO_MSG  *p_gap_msg);
 void app_handle_io_msg(T_IO_MSG io_msg)
 {
     uint16_t msg_type = io_msg.type;
-    uint8_t rx_char;
+    uint8_t rx_buf[32];
+    uint16_t rx_len;
 
     switch (msg_type)
     {
@@ -66,8 +68,10 @@ void app_handle_io_msg(T_IO_MSG io_msg)
         break;
     case IO_MSG_TYPE_UART:
         /* We handle user command informations from Data UART in this branch. */
-        rx_char = (uint8_t)io_msg.subtype;
-        user_cmd_collect(&user_cmd_if, &rx_char, sizeof(rx_char), user_cmd_table);
+        while ((rx_len = data_uart_read(rx_buf, sizeof(rx_buf))) != 0)
+        {
+            user_cmd_collect(&user_cmd_if, rx_buf, rx_len, user_cmd_table);
+        }
         break;
     default:
         break;
@@ -22,6 +22,7 @@
 #if USER_CMD_EN
 #include <user_cmd.h>
 #include <user_cmd_parse.h>
+#include <data_uart.h>
 #endif
 /** @defgroup  PRIVA_PERIPH_APP Peripheral Privacy Application
     * @brief This file handles BLE peripheral privacy application routines.
@@ -77,9 +78,12 @@ void app_handle_io_msg(T_IO_MSG io_msg)
     case IO_MSG_TYPE_UART:
         /* We handle user command informations from Data UART in this branch. */
         {
-            uint8_t rx_char;
-            rx_char = (uint8_t)io_msg.subtype;
-            user_cmd_collect(&user_cmd_if, &rx_char, sizeof(rx_char), user_cmd_table);
+            uint8_t rx_buf[32];
+            uint16_t rx_len;
+            while ((rx_len = data_uart_read(rx_buf, sizeof(rx_buf))) != 0)
+            {
+                user_cmd_collect(&user_cmd_if, rx_buf, rx_len, user_cmd_table);
+            }
         }
         break;
 #endif
@@ -22,6 +22,7 @@
 #include "dis.h"
 #include "ota_service.h"
 #include "dfu_service.h"
+#include "ble_dfu_transport.h"
 #include "app_task.h"
 #include "ota_app.h"
 #if F_BT_ANCS_CLIENT_SUPPORT
@@ -192,6 +193,7 @@ void app_le_profile_init(void)
     dis_srv_id = dis_add_service(app_profile_callback);
     ota_srv_id  = ota_add_service(app_profile_callback);
     dfu_srv_id = dfu_add_service(app_profile_callback);
+    ble_dfu_register_send_msg(app_send_msg_to_apptask);
     server_register_app_cb(app_profile_callback);
 #if F_BT_ANCS_CLIENT_SUPPORT
     client_init(1);
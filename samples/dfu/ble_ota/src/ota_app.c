@@ -84,6 +84,11 @@ void app_handle_io_msg(T_IO_MSG io_msg)
             app_handle_gap_msg(&io_msg);
         }
         break;
+    case IO_MSG_TYPE_DFU:
+        {
+            ble_dfu_handle_io_msg(&io_msg);
+        }
+        break;
 #if F_BT_ANCS_CLIENT_SUPPORT
     case IO_MSG_TYPE_ANCS:
         {
@@ -40,6 +40,7 @@
 #include "lwip/prot/ethernet.h"
 #include "lwip/etharp.h"
 #include "lwip/ethip6.h"
+#include "lwip/tcpip.h"
 #include "ethernetif.h"
 #include <string.h>
 #include <trace.h>
@@ -60,6 +61,21 @@ struct ethernetif
     struct eth_addr *ethaddr;
     /* Add whatever per-interface state that is needed here. */
 };
+
+/* A received buffer passed up to lwIP without copying */
+struct ethernetif_rx_pbuf
+{
+    struct pbuf_custom pc;
+    uint8_t *buf;
+};
+
+static struct ethernetif_rx_pbuf rx_pbuf_pool[ETH_RX_SPARE_BUF_NUM];
+static struct ethernetif_rx_pbuf *rx_pbuf_free_list[ETH_RX_SPARE_BUF_NUM];
+static uint8_t rx_pbuf_free_num = 0;
+
+/* Serializes the Tx ring between low_level_output and the reclaim after TOK */
+static sys_sem_t outsem = NULL;
+static volatile bool tx_reclaim_pending = false;
 /*============================================================================*
  *                              Global Variables
  *============================================================================*/
@@ -87,6 +103,12 @@ static void low_level_init(struct netif *netif)
 
     eth_init_driver();
 
+    for (uint8_t i = 0; i < ETH_RX_SPARE_BUF_NUM; i++)
+    {
+        rx_pbuf_free_list[i] = &rx_pbuf_pool[i];
+    }
+    rx_pbuf_free_num = ETH_RX_SPARE_BUF_NUM;
+
     if (tmp_status == ETH_STATUS_OK)
     {
         /* Set netif link flag */
@@ -132,6 +154,78 @@ static void low_level_init(struct netif *netif)
     ETH_EnableRx();
 }
 
+/******************************************************************
+ * @brief  return a received buffer to the Rx ring. Called by pbuf_free.
+ * @param  p - the custom pbuf wrapping the buffer
+ * @return none
+ */
+static void ethernetif_rx_pbuf_free(struct pbuf *p)
+{
+    struct ethernetif_rx_pbuf *rx_pbuf = (struct ethernetif_rx_pbuf *)p;
+    SYS_ARCH_DECL_PROTECT(old_level);
+
+    SYS_ARCH_PROTECT(old_level);
+    eth_ring_rx_put(&eth_ring, rx_pbuf->buf);
+    rx_pbuf_free_list[rx_pbuf_free_num++] = rx_pbuf;
+    SYS_ARCH_UNPROTECT(old_level);
+}
+
+/******************************************************************
+ * @brief  check if the DMA can read the pbuf payload in place
+ * @param  q - the pbuf
+ * @return true if the payload is in the lwIP heap or pool, or in a received buffer
+ */
+static bool ethernetif_tx_in_place(struct pbuf *q)
+{
+    if (q->len == 0 || q->len > ETH_TX_BUF_SIZE)
+    {
+        return false;
+    }
+
+    /* PBUF_ROM and PBUF_REF payloads may be in flash or on a stack */
+    return (pbuf_match_allocsrc(q, PBUF_RAM) || pbuf_match_allocsrc(q, PBUF_POOL) ||
+            ((q->flags & PBUF_FLAG_IS_CUSTOM) != 0));
+}
+
+/******************************************************************
+ * @brief  release the pbufs of the frames already sent, called with outsem taken
+ * @param  none
+ * @return none
+ */
+static void ethernetif_tx_reclaim(void)
+{
+    void *cookie;
+
+    while (eth_ring_tx_reclaim(&eth_ring, &cookie))
+    {
+        if (cookie != NULL)
+        {
+            pbuf_free((struct pbuf *)cookie);
+        }
+    }
+}
+
+/******************************************************************
+ * @brief  reclaim in the tcpip thread after TOK, so lwIP sees its segments free again
+ *         without waiting for the next frame to go out
+ * @param  ctx - not used
+ * @return none
+ */
+static void ethernetif_tx_reclaim_cb(void *ctx)
+{
+    tx_reclaim_pending = false;
+
+    sys_sem_wait(&outsem);
+    /* TOK was closed by ETH_Handler, arm it before reclaiming so a frame still in flight
+       raises its own TOK and is not held until the next transmit */
+    if (eth_ring.tx_used != 0)
+    {
+        eth_tx_int_rearm();
+    }
+    ethernetif_tx_reclaim();
+    sys_sem_signal(&outsem);
+}
+
 /******************************************************************
  * @brief  send packet
  * @param  netif - the lwip network interface structure for this ethernetif
@@ -140,7 +234,6 @@ static void low_level_init(struct netif *netif)
  */
 static err_t low_level_output(struct netif *netif, struct pbuf *p)
 {
-    static sys_sem_t outsem = NULL;
     if (outsem == NULL)
     {
         if (ERR_OK == sys_sem_new(&outsem, 0))
@@ -153,74 +246,64 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
         }
     }
 
-    err_t errval;
+    err_t errval = ERR_OK;
     struct pbuf *q;
+    T_ETH_RING_SEG seg[ETH_TX_DESC_NUM];
+    uint8_t seg_num = 0;
+    uint8_t *buffer;
 
-    uint8_t tx_serach_idx = ETH_InitStruct.ETH_TxDescCurrentNum;
-    uint8_t *buffer = (uint8_t *)(ETH_InitStruct.ETH_TxDesc[tx_serach_idx].addr);
-    uint32_t framelength = 0;
-    uint32_t bufferoffset = 0;
-    uint32_t byteslefttocopy = 0;
-    uint32_t payloadoffset = 0;
-
-    if ((((volatile uint32_t)(ETH_InitStruct.ETH_TxDesc[tx_serach_idx].dw1)) & ETH_TX_DESC_OWN) != 0)
+    if (p->tot_len > ETH_TX_BUF_SIZE)
     {
-        APP_PRINT_WARN0("[low_level_output] Tx descriptor ring is full !!");
-        errval = ERR_USE;
-        goto error;
+        APP_PRINT_WARN1("[low_level_output] frame too long %d", p->tot_len);
+        return ERR_BUF;
     }
 
     sys_sem_wait(&outsem);
 
-    /* copy frame from pbufs to driver buffers */
+    /* release the pbufs of the frames already sent */
+    ethernetif_tx_reclaim();
+
+    /* hand the pbuf chain to the DMA, one descriptor per pbuf */
     for (q = p; q != NULL; q = q->next)
     {
-        /* Get bytes in current lwIP buffer */
-        byteslefttocopy = q->len;
-        payloadoffset = 0;
-
-        /* Check if the length of data to copy is bigger than Tx buffer size*/
-        while ((byteslefttocopy + bufferoffset) > ETH_TX_BUF_SIZE)
+        if (q->len == 0)
         {
-            /* Copy data to Tx buffer*/
-            memcpy((uint8_t *)((uint8_t *)buffer + bufferoffset),
-                   (uint8_t *)((uint8_t *)q->payload + payloadoffset),
-                   (ETH_TX_BUF_SIZE - bufferoffset));
-
-            /* Point to next descriptor */
-            if (tx_serach_idx == ((ETH_InitStruct.ETH_TxDescNum) - 1))
-            {
-                tx_serach_idx = 0;
-            }
-            else
-            {
-                tx_serach_idx++;
-            }
-
-            if ((((volatile uint32_t)(ETH_InitStruct.ETH_TxDesc[tx_serach_idx].dw1)) & ETH_TX_DESC_OWN) != 0)
-            {
-                APP_PRINT_WARN0("[low_level_output] Tx descriptor ring is full !!");
-            }
-
-            buffer = (uint8_t *)(ETH_InitStruct.ETH_TxDesc[tx_serach_idx].addr);
+            continue;
+        }
+        if (!ethernetif_tx_in_place(q) || seg_num == eth_ring_tx_free_num(&eth_ring))
+        {
+            seg_num = 0;
+            break;
+        }
+        seg[seg_num].addr = (const uint8_t *)q->payload;
+        seg[seg_num].len = q->len;
+        seg_num++;
+    }
 
-            byteslefttocopy = byteslefttocopy - (ETH_TX_BUF_SIZE - bufferoffset);
-            payloadoffset = payloadoffset + (ETH_TX_BUF_SIZE - bufferoffset);
-            framelength = framelength + (ETH_TX_BUF_SIZE - bufferoffset);
-            bufferoffset = 0;
+    if (seg_num != 0)
+    {
+        /* hold the chain until the DMA has read it */
+        pbuf_ref(p);
+        eth_ring_tx_frame(&eth_ring, seg, seg_num, p);
+    }
+    else
+    {
+        /* copy the frame into the buffer of one descriptor */
+        buffer = eth_ring_tx_buf_get(&eth_ring);
+        if (buffer == NULL)
+        {
+            APP_PRINT_WARN0("[low_level_output] Tx descriptor ring is full !!");
+            errval = ERR_USE;
+            goto error;
         }
 
-        /* Copy the remaining bytes */
-        memcpy((uint8_t *)((uint8_t *)buffer + bufferoffset),
-               (uint8_t *)((uint8_t *)q->payload + payloadoffset), byteslefttocopy);
-        bufferoffset = bufferoffset + byteslefttocopy;
-        framelength = framelength + byteslefttocopy;
+        seg[0].addr = buffer;
+        seg[0].len = pbuf_copy_partial(p, buffer, p->tot_len, 0);
+        eth_ring_tx_frame(&eth_ring, seg, 1, NULL);
     }
 
     /* Prepare transmit descriptors to give to DMA */
-    ETH_SendFrame(&ETH_InitStruct, framelength);
-
-    errval = ERR_OK;
+    ETH_TriggerTx(&ETH_InitStruct);
 
 error:
     sys_sem_signal(&outsem);
@@ -236,16 +319,15 @@ error:
 static struct pbuf *low_level_input(struct netif *netif)
 {
     struct pbuf *p = NULL;
-    struct pbuf *q = NULL;
+    struct ethernetif_rx_pbuf *rx_pbuf = NULL;
     uint16_t len = 0;
-    uint8_t *buffer;
-    uint32_t bufferoffset = 0;
-    uint32_t payloadoffset = 0;
-    uint32_t byteslefttocopy = 0;
+    uint8_t *buffer = NULL;
+    uint16_t offset = 0;
+    uint16_t copy_len;
     uint32_t i = 0;
     uint8_t rx_serach_idx = 0, tmp_rx_serach_idx = 0;
     uint32_t tmp_seg_count = 0;
-    bool is_first_copy = true;
+    SYS_ARCH_DECL_PROTECT(old_level);
 
     /* get received frame */
     if (ETH_ReceiveFrame(&ETH_InitStruct) != ETH_STATUS_OK)
@@ -258,56 +340,57 @@ static struct pbuf *low_level_input(struct netif *netif)
     /* Clear Segment_Count */
     ETH_InitStruct.ETH_RxSegmentCount = 0;
     tmp_rx_serach_idx = ETH_InitStruct.ETH_RxFrameStartDescIdx;
-    rx_serach_idx = tmp_rx_serach_idx;
 
     ETH_DBG_BUFFER(MODULE_APP, LEVEL_INFO, "[low_level_input] low_level_input rx_idx=%d\n", 1,
-                   rx_serach_idx);
+                   tmp_rx_serach_idx);
     /* Obtain the size of the packet and put it into the "len" variable. */
     len = ETH_InitStruct.ETH_RxFrameLen;
-    buffer = (uint8_t *)((ETH_InitStruct.ETH_RxDesc[rx_serach_idx].addr) + 2);//2byte offset
 
-    ETH_DBG_BUFFER(MODULE_APP, LEVEL_INFO, "[low_level_input] receive frame %d len buffer : %p\n", 2,
-                   len, buffer);
-    if (len > 0)
+    /* a frame in one descriptor is passed up in its own buffer, a spare buffer takes its place */
+    if (len > 0 && tmp_seg_count == 1)
     {
-        /* We allocate a pbuf chain of pbufs from the Lwip buffer pool */
-        p = pbuf_alloc(PBUF_RAW, len, PBUF_POOL);
+        SYS_ARCH_PROTECT(old_level);
+        if (rx_pbuf_free_num > 0)
+        {
+            buffer = eth_ring_rx_take(&eth_ring, tmp_rx_serach_idx);
+            if (buffer != NULL)
+            {
+                rx_pbuf = rx_pbuf_free_list[--rx_pbuf_free_num];
+            }
+        }
+        SYS_ARCH_UNPROTECT(old_level);
     }
 
-    if (p != NULL)
+    if (rx_pbuf != NULL)
+    {
+        rx_pbuf->buf = buffer;
+        rx_pbuf->pc.custom_free_function = ethernetif_rx_pbuf_free;
+        p = pbuf_alloced_custom(PBUF_RAW, len, PBUF_REF, &rx_pbuf->pc, buffer + ETH_RING_RX_OFFSET,
+                                ETH_RX_BUF_SIZE - ETH_RING_RX_OFFSET);
+    }
+    else if (len > 0)
     {
-        bufferoffset = 0;
-        for (q = p; q != NULL; q = q->next)
+        /* We allocate a pbuf chain of pbufs from the Lwip buffer pool */
+        p = pbuf_alloc(PBUF_RAW, len, PBUF_POOL);
+        if (p != NULL)
         {
-            byteslefttocopy = q->len;
-            payloadoffset = 0;
-
-            while (((byteslefttocopy + bufferoffset) > ETH_RX_BUF_SIZE) ||
-                   ((is_first_copy == true) && (byteslefttocopy >= (ETH_RX_BUF_SIZE - 2))))
+            rx_serach_idx = tmp_rx_serach_idx;
+            for (i = 0; i < tmp_seg_count && offset < len; i++)
             {
-                /* Copy data to pbuf */
-                if ((is_first_copy == true) && (byteslefttocopy >= (ETH_RX_BUF_SIZE - 2)))
+                buffer = (uint8_t *)(ETH_InitStruct.ETH_RxDesc[rx_serach_idx].addr);
+                copy_len = ETH_RX_BUF_SIZE;
+                if (i == 0)
                 {
-                    memcpy((uint8_t *)((uint8_t *)q->payload + payloadoffset),
-                           (uint8_t *)((uint8_t *)buffer + bufferoffset),
-                           (ETH_RX_BUF_SIZE - 2 - bufferoffset));
-
-                    byteslefttocopy = byteslefttocopy - (ETH_RX_BUF_SIZE - 2 - bufferoffset);
-                    payloadoffset = payloadoffset + (ETH_RX_BUF_SIZE - 2 - bufferoffset);
+                    buffer += ETH_RING_RX_OFFSET;
+                    copy_len -= ETH_RING_RX_OFFSET;
                 }
-                else
+                if (copy_len > len - offset)
                 {
-                    memcpy((uint8_t *)((uint8_t *)q->payload + payloadoffset),
-                           (uint8_t *)((uint8_t *)buffer + bufferoffset),
-                           (ETH_RX_BUF_SIZE - bufferoffset));
-
-                    byteslefttocopy = byteslefttocopy - (ETH_RX_BUF_SIZE - bufferoffset);
-                    payloadoffset = payloadoffset + (ETH_RX_BUF_SIZE - bufferoffset);
+                    copy_len = len - offset;
                 }
+                pbuf_take_at(p, buffer, copy_len, offset);
+                offset += copy_len;
 
-                is_first_copy = false;
-
-                /* Point to next descriptor */
                 if (rx_serach_idx == ((ETH_InitStruct.ETH_RxDescNum) - 1))
                 {
                     rx_serach_idx = 0;
@@ -316,35 +399,15 @@ static struct pbuf *low_level_input(struct netif *netif)
                 {
                     rx_serach_idx++;
                 }
-                buffer = (uint8_t *)(ETH_InitStruct.ETH_RxDesc[rx_serach_idx].addr);
-                bufferoffset = 0;
             }
-            /* Copy remaining data in pbuf */
-            memcpy((uint8_t *)((uint8_t *)q->payload + payloadoffset),
-                   (uint8_t *)((uint8_t *)buffer + bufferoffset), byteslefttocopy);
-            bufferoffset = bufferoffset + byteslefttocopy;
         }
     }
 
+    ETH_DBG_BUFFER(MODULE_APP, LEVEL_INFO, "[low_level_input] receive frame %d len in place %d\n", 2,
+                   len, (rx_pbuf != NULL));
+
     /* Release descriptors to DMA */
-    /* Point to first descriptor */
-    rx_serach_idx = tmp_rx_serach_idx;
-    /* Set Own bit in Rx descriptors: gives the buffers back to DMA */
-    for (i = 0; i < tmp_seg_count; i++)
-    {
-        ETH_InitStruct.ETH_RxDesc[rx_serach_idx].dw1 &= ETH_RX_DESC_EOR;
-        ETH_InitStruct.ETH_RxDesc[rx_serach_idx].dw1 |= (ETH_RX_DESC_OWN | ETH_RX_BUF_SIZE);
-        ETH_InitStruct.ETH_RxDesc[rx_serach_idx].dw2 = 0;
-        ETH_InitStruct.ETH_RxDesc[rx_serach_idx].dw3 = 0;
-        if (rx_serach_idx == ((ETH_InitStruct.ETH_RxDescNum) - 1))
-        {
-            rx_serach_idx = 0;
-        }
-        else
-        {
-            rx_serach_idx++;
-        }
-    }
+    eth_ring_rx_release(&eth_ring, tmp_rx_serach_idx, tmp_seg_count);
 
     return p;
 }
@@ -364,31 +427,32 @@ void ethernetif_input(void *pParams)
     {
         if (xSemaphoreTake(s_xSemaphore, portMAX_DELAY) == pdTRUE)
         {
-            /* move received packet into a new pbuf */
-            taskENTER_CRITICAL();
-TRY_GET_NEXT_FRAGMENT:
             ETH_DBG_BUFFER(MODULE_APP, LEVEL_INFO, "[ethernetif_input] low level input", 0);
 
-            p = low_level_input(netif);
-            taskEXIT_CRITICAL();
-            /* points to packet payload, which starts with an Ethernet header */
-            if (p != NULL)
+            /* move received packets into pbufs, this task is the only reader of the Rx ring */
+            while ((p = low_level_input(netif)) != NULL)
             {
-                taskENTER_CRITICAL();
                 /* full packet send to tcpip_thread to process */
                 if (netif->input(p, netif) != ERR_OK)
                 {
                     APP_PRINT_INFO0("[ethernetif_input] IP input error");
                     pbuf_free(p);
                     p = NULL;
+                    break;
                 }
-                else
+
+                ETH_DBG_BUFFER(MODULE_APP, LEVEL_INFO, "[ethernetif_input] try again", 0);
+                xSemaphoreTake(s_xSemaphore, 0);
+            }
+
+            /* TOK also wakes this task, the held Tx pbufs are freed in the tcpip thread */
+            if (eth_ring.tx_used != 0 && !tx_reclaim_pending)
+            {
+                tx_reclaim_pending = true;
+                if (tcpip_try_callback(ethernetif_tx_reclaim_cb, NULL) != ERR_OK)
                 {
-                    ETH_DBG_BUFFER(MODULE_APP, LEVEL_INFO, "[ethernetif_input] try again", 0);
-                    xSemaphoreTake(s_xSemaphore, 0);
-                    goto TRY_GET_NEXT_FRAGMENT;
+                    tx_reclaim_pending = false;
                 }
-                taskEXIT_CRITICAL();
             }
         }
     }
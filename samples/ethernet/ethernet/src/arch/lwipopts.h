@@ -49,7 +49,7 @@
  * critical regions during buffer allocation, deallocation and memory
  * allocation and deallocation.
  */
-#define SYS_LIGHTWEIGHT_PROT            0
+#define SYS_LIGHTWEIGHT_PROT            1
 
 /**
  * NO_SYS==1: Provides VERY minimal functionality. Otherwise,
@@ -377,6 +377,12 @@
  */
 #define PBUF_POOL_BUFSIZE               LWIP_MEM_ALIGN_SIZE(TCP_MSS+40+PBUF_LINK_HLEN)
 
+/**
+ * LWIP_SUPPORT_CUSTOM_PBUF==1: the ethernetif passes received frames up in
+ * custom pbufs wrapping the Rx buffers of the descriptor ring.
+ */
+#define LWIP_SUPPORT_CUSTOM_PBUF        1
+
 /*
    ------------------------------------
    ---------- LOOPIF options ----------
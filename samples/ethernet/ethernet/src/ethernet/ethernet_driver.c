@@ -36,11 +36,13 @@ static uint8_t *pTmpTxDesc = NULL;
 static uint8_t *pTmpRxDesc = NULL;
 static uint8_t *pTmpTxPktBuf = NULL;
 static uint8_t *pTmpRxPktBuf = NULL;
+static uint8_t *pTmpRxSpareBuf = NULL;
 
 /*============================================================================*
  *                              Global Variables
  *============================================================================*/
 ETH_InitTypeDef ETH_InitStruct;
+T_ETH_RING eth_ring;
 
 /*============================================================================*
  *                              Functions Declaration
@@ -109,6 +111,8 @@ void eth_init_data(void)
                                                    ETH_TX_DESC_NUM * ETH_TX_ALLOC_BUF_SIZE, 32);
     pTmpRxPktBuf = (uint8_t *)os_mem_aligned_alloc(RAM_TYPE_DATA_ON,
                                                    ETH_RX_DESC_NUM * ETH_RX_ALLOC_BUF_SIZE, 32);
+    pTmpRxSpareBuf = (uint8_t *)os_mem_aligned_alloc(RAM_TYPE_DATA_ON,
+                                                     ETH_RX_SPARE_BUF_NUM * ETH_RX_ALLOC_BUF_SIZE, 32);
 
     if (pTmpTxDesc == NULL || pTmpRxDesc == NULL || pTmpTxPktBuf == NULL || pTmpRxPktBuf == NULL)
     {
@@ -116,12 +120,30 @@ void eth_init_data(void)
         return;
     }
 
+    if (pTmpRxSpareBuf == NULL)
+    {
+        APP_PRINT_WARN0("[eth_init_data] RX spare buffer malloc fail, received frames are copied");
+    }
+
     memset(pTmpTxDesc, 0, ETH_TX_DESC_NUM * ETH_TX_DESC_SIZE);
     memset(pTmpRxDesc, 0, ETH_RX_DESC_NUM * ETH_RX_DESC_SIZE);
     memset(pTmpTxPktBuf, 0, ETH_TX_DESC_NUM * ETH_TX_ALLOC_BUF_SIZE);
     memset(pTmpRxPktBuf, 0, ETH_RX_DESC_NUM * ETH_RX_ALLOC_BUF_SIZE);
 }
 
+/******************************************************************
+ * @brief  enable the TOK interrupt again after ETH_Handler closed it
+ * @param  none
+ * @return none
+ */
+void eth_tx_int_rearm(void)
+{
+    taskENTER_CRITICAL();
+    ETH_InitStruct.ETH_IntMaskAndStatus |= ETH_IMR_TOK;
+    ETH->ETH_ISR_IMR.b.tok_or_ti = 1;
+    taskEXIT_CRITICAL();
+}
+
 /******************************************************************
  * @brief  handle eth interrupt
  * @param  none
@@ -162,6 +184,10 @@ void ETH_Handler(void)
         ETH_InitStruct.ETH_IntMaskAndStatus &= (~ETH_IMR_TOK);
         ETH->ETH_ISR_IMR.b.tok_or_ti = 0; //close interrupt
         ETH->ETH_ISR_IMR.b.s_tok_or_ti = 1;
+
+        /* wake ethernetif_input to release the zero-copy Tx pbufs */
+        xSemaphoreGiveFromISR(s_xSemaphore, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
     }
 
     if ((tmp_status & ETH_ISR_LINK_CHANGE) &&
@@ -221,6 +247,9 @@ void eth_init_bsp_driver(void)
                    ETH_RX_BUF_SIZE);
 
     ETH_Init(&ETH_InitStruct);
+
+    eth_ring_init(&eth_ring, &ETH_InitStruct, pTmpRxSpareBuf,
+                  (pTmpRxSpareBuf != NULL) ? ETH_RX_SPARE_BUF_NUM : 0);
 }
 /*============================================================================*
 *                              Global Functions
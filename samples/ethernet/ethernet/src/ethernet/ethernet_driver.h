@@ -24,6 +24,7 @@ extern "C"
 #include "rtl876x.h"
 #include "vector_table.h"
 #include "rtl_ethernet.h"
+#include "ethernet_ring.h"
 
 /*============================================================================*
  *                         Macros
@@ -42,6 +43,9 @@ extern "C"
 #define ETH_RX_BUF_SIZE             1524// 512//
 #define ETH_TX_ALLOC_BUF_SIZE       1600
 #define ETH_RX_ALLOC_BUF_SIZE       1600//600//
+
+/* Rx buffers lent to lwIP are replaced by spare ones, frames are copied when none is left */
+#define ETH_RX_SPARE_BUF_NUM        4
 /*============================================================================*
  *                         Types
  *============================================================================*/
@@ -50,11 +54,13 @@ extern "C"
 *                        Export Global Variables
 *============================================================================*/
 extern ETH_InitTypeDef ETH_InitStruct;
+extern T_ETH_RING eth_ring;
 
 /*============================================================================*
  *                         Functions
  *============================================================================*/
 void eth_init_driver(void);
+void eth_tx_int_rearm(void);
 
 #ifdef  __cplusplus
 }
@@ -0,0 +1,195 @@
+/**
+*********************************************************************************************************
+*               Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+**********************************************************************************************************
+* @file     ethernet_ring.c
+* @brief    ethernet descriptor ring management
+* @details  Tx descriptors point at the frame data directly, and Rx buffers can be lent out by
+*           swapping a spare buffer into the descriptor. No register is accessed here.
+* @version  v1.0
+*********************************************************************************************************
+*/
+
+/*============================================================================*
+ *                              Header Files
+ *============================================================================*/
+#include <string.h>
+#include "ethernet_ring.h"
+
+/*============================================================================*
+ *                              Local Functions
+ *============================================================================*/
+static inline uint8_t eth_ring_next(uint8_t idx, uint8_t num)
+{
+    return (idx == (num - 1)) ? 0 : (idx + 1);
+}
+
+/*============================================================================*
+ *                              Global Functions
+ *============================================================================*/
+bool eth_ring_init(T_ETH_RING *ring, ETH_InitTypeDef *init, uint8_t *rx_spare,
+                   uint8_t rx_spare_num)
+{
+    uint8_t i;
+
+    if ((ring == NULL) || (init == NULL) || (init->ETH_TxDescNum > ETH_RING_TX_DESC_MAX) ||
+        (rx_spare_num > ETH_RING_RX_SPARE_MAX))
+    {
+        return false;
+    }
+
+    memset(ring, 0, sizeof(T_ETH_RING));
+    ring->init = init;
+    ring->tx_clean = init->ETH_TxDescCurrentNum;
+
+    for (i = 0; i < init->ETH_TxDescNum; i++)
+    {
+        ring->tx_buf[i] = (uint8_t *)(init->ETH_TxDesc[i].addr);
+    }
+
+    if (rx_spare != NULL)
+    {
+        for (i = 0; i < rx_spare_num; i++)
+        {
+            ring->rx_spare[i] = rx_spare + i * init->ETH_RxAllocBufSize;
+        }
+        ring->rx_spare_num = rx_spare_num;
+    }
+
+    return true;
+}
+
+ETH_RING_FUNCTION
+uint8_t eth_ring_tx_free_num(T_ETH_RING *ring)
+{
+    return ring->init->ETH_TxDescNum - ring->tx_used;
+}
+
+ETH_RING_FUNCTION
+uint8_t *eth_ring_tx_buf_get(T_ETH_RING *ring)
+{
+    if (eth_ring_tx_free_num(ring) == 0)
+    {
+        return NULL;
+    }
+
+    return ring->tx_buf[ring->init->ETH_TxDescCurrentNum];
+}
+
+ETH_RING_FUNCTION
+bool eth_ring_tx_frame(T_ETH_RING *ring, const T_ETH_RING_SEG *seg, uint8_t seg_num, void *cookie)
+{
+    ETH_InitTypeDef *init = ring->init;
+    volatile ETH_TxDescTypeDef *desc;
+    uint8_t first = init->ETH_TxDescCurrentNum;
+    uint8_t idx = first;
+    uint32_t dw1;
+    uint8_t i;
+
+    if ((seg_num == 0) || (seg_num > eth_ring_tx_free_num(ring)))
+    {
+        return false;
+    }
+
+    for (i = 0; i < seg_num; i++)
+    {
+        desc = &init->ETH_TxDesc[idx];
+
+        dw1 = (desc->dw1 & ETH_TX_DESC_EOR) | ETH_TX_DESC_CRC | (seg[i].len & 0x1ffff);
+        if (i == 0)
+        {
+            dw1 |= ETH_TX_DESC_FS;
+        }
+        if (i == (seg_num - 1))
+        {
+            dw1 |= ETH_TX_DESC_LS;
+            ring->tx_cookie[idx] = cookie;
+        }
+        else
+        {
+            ring->tx_cookie[idx] = NULL;
+        }
+
+        desc->addr = (uint32_t)seg[i].addr;
+        /* the first descriptor is given to the DMA last, so it never sees a partial frame */
+        if (i != 0)
+        {
+            dw1 |= ETH_TX_DESC_OWN;
+        }
+        desc->dw1 = dw1;
+
+        idx = eth_ring_next(idx, init->ETH_TxDescNum);
+    }
+
+    ETH_RING_DMB();
+    init->ETH_TxDesc[first].dw1 |= ETH_TX_DESC_OWN;
+
+    ring->tx_used += seg_num;
+    init->ETH_TxDescCurrentNum = idx;
+
+    return true;
+}
+
+ETH_RING_FUNCTION
+bool eth_ring_tx_reclaim(T_ETH_RING *ring, void **cookie)
+{
+    ETH_InitTypeDef *init = ring->init;
+    uint8_t idx = ring->tx_clean;
+
+    if ((ring->tx_used == 0) || ((init->ETH_TxDesc[idx].dw1 & ETH_TX_DESC_OWN) != 0))
+    {
+        return false;
+    }
+
+    *cookie = ring->tx_cookie[idx];
+    ring->tx_cookie[idx] = NULL;
+    ring->tx_clean = eth_ring_next(idx, init->ETH_TxDescNum);
+    ring->tx_used--;
+
+    return true;
+}
+
+ETH_RING_FUNCTION
+uint8_t *eth_ring_rx_take(T_ETH_RING *ring, uint8_t idx)
+{
+    volatile ETH_RxDescTypeDef *desc = &ring->init->ETH_RxDesc[idx];
+    uint8_t *buf;
+
+    if (ring->rx_spare_num == 0)
+    {
+        return NULL;
+    }
+
+    buf = (uint8_t *)(desc->addr);
+    desc->addr = (uint32_t)ring->rx_spare[--ring->rx_spare_num];
+
+    return buf;
+}
+
+ETH_RING_FUNCTION
+void eth_ring_rx_put(T_ETH_RING *ring, uint8_t *buf)
+{
+    ring->rx_spare[ring->rx_spare_num++] = buf;
+}
+
+ETH_RING_FUNCTION
+void eth_ring_rx_release(T_ETH_RING *ring, uint8_t idx, uint32_t seg_num)
+{
+    ETH_InitTypeDef *init = ring->init;
+    volatile ETH_RxDescTypeDef *desc;
+    uint32_t i;
+
+    /* Set Own bit in Rx descriptors: gives the buffers back to DMA */
+    for (i = 0; i < seg_num; i++)
+    {
+        desc = &init->ETH_RxDesc[idx];
+        desc->dw2 = 0;
+        desc->dw3 = 0;
+        ETH_RING_DMB();
+        desc->dw1 = (desc->dw1 & ETH_RX_DESC_EOR) | ETH_RX_DESC_OWN | init->ETH_RxBufSize;
+
+        idx = eth_ring_next(idx, init->ETH_RxDescNum);
+    }
+}
+
+/******************* (C) COPYRIGHT 2026 Realtek Semiconductor Corporation *****END OF FILE****/
@@ -0,0 +1,123 @@
+/**
+*********************************************************************************************************
+*               Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*********************************************************************************************************
+* @file     ethernet_ring.h
+* @brief    The header file of the ETHERNET descriptor ring management.
+* @details  The ring only reads and writes the Tx/Rx descriptors in memory. All register access
+*           stays in rtl_ethernet.c, so the ring can run against descriptors owned by a mock MAC.
+* @version  v1.0
+* *********************************************************************************************************
+*/
+#ifndef ETHERNET_RING_H_
+#define ETHERNET_RING_H_
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+/*============================================================================*
+ *                        Header Files
+ *============================================================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "ethernet_ring_port.h"
+
+/*============================================================================*
+ *                         Macros
+ *============================================================================*/
+#define ETH_RING_TX_DESC_MAX        16
+#define ETH_RING_RX_SPARE_MAX       16
+
+/* received data starts 2 bytes into the Rx buffer, so the IP header is word aligned */
+#define ETH_RING_RX_OFFSET          2
+
+/*============================================================================*
+ *                         Types
+ *============================================================================*/
+typedef struct
+{
+    const uint8_t *addr;
+    uint32_t len;
+} T_ETH_RING_SEG;
+
+typedef struct
+{
+    ETH_InitTypeDef *init;
+    uint8_t tx_clean;                           /* the oldest Tx descriptor not reclaimed */
+    uint8_t tx_used;                            /* the number of Tx descriptors not reclaimed */
+    uint8_t rx_spare_num;
+    uint8_t *tx_buf[ETH_RING_TX_DESC_MAX];      /* the buffer of each Tx descriptor used for copied frames */
+    void *tx_cookie[ETH_RING_TX_DESC_MAX];      /* set on the last descriptor of a frame */
+    uint8_t *rx_spare[ETH_RING_RX_SPARE_MAX];   /* the buffers to swap into the Rx descriptors */
+} T_ETH_RING;
+
+/*============================================================================*
+ *                         Functions
+ *============================================================================*/
+/**
+ * @brief  Take over the descriptors set up by ETH_Init.
+ * @param  ring - the ring to init
+ * @param  init - the ETH_InitTypeDef passed to ETH_Init
+ * @param  rx_spare - rx_spare_num buffers of init->ETH_RxAllocBufSize bytes, or NULL
+ * @param  rx_spare_num - the number of spare Rx buffers
+ * @return true if the ring is set up
+ */
+bool eth_ring_init(T_ETH_RING *ring, ETH_InitTypeDef *init, uint8_t *rx_spare,
+                   uint8_t rx_spare_num);
+
+/**
+ * @brief  Get the number of Tx descriptors that can be filled.
+ */
+uint8_t eth_ring_tx_free_num(T_ETH_RING *ring);
+
+/**
+ * @brief  Get the buffer of the next Tx descriptor to copy a frame into.
+ * @return the buffer of init->ETH_TxBufSize bytes, or NULL if the ring is full
+ */
+uint8_t *eth_ring_tx_buf_get(T_ETH_RING *ring);
+
+/**
+ * @brief  Fill one Tx descriptor per segment and give them to the DMA.
+ * @note   The caller triggers the DMA by ETH_TriggerTx afterwards.
+ * @param  seg - the segments of the frame, each no longer than init->ETH_TxBufSize
+ * @param  seg_num - the number of segments, no more than eth_ring_tx_free_num
+ * @param  cookie - returned by eth_ring_tx_reclaim once the frame is sent
+ * @return true if the frame is queued
+ */
+bool eth_ring_tx_frame(T_ETH_RING *ring, const T_ETH_RING_SEG *seg, uint8_t seg_num, void *cookie);
+
+/**
+ * @brief  Reclaim the oldest Tx descriptor the DMA is done with.
+ * @param  cookie - the cookie of the frame if this was its last descriptor, otherwise NULL
+ * @return true if a descriptor was reclaimed
+ */
+bool eth_ring_tx_reclaim(T_ETH_RING *ring, void **cookie);
+
+/**
+ * @brief  Take the buffer of a received Rx descriptor, a spare buffer takes its place.
+ * @note   Not reentrant with eth_ring_rx_put, the caller locks both.
+ * @param  idx - the Rx descriptor index
+ * @return the buffer, or NULL if there is no spare buffer
+ */
+uint8_t *eth_ring_rx_take(T_ETH_RING *ring, uint8_t idx);
+
+/**
+ * @brief  Return a buffer taken by eth_ring_rx_take to the spare buffers.
+ */
+void eth_ring_rx_put(T_ETH_RING *ring, uint8_t *buf);
+
+/**
+ * @brief  Give the Rx descriptors of a received frame back to the DMA.
+ * @param  idx - the first Rx descriptor index of the frame
+ * @param  seg_num - the number of Rx descriptors of the frame
+ */
+void eth_ring_rx_release(T_ETH_RING *ring, uint8_t idx, uint32_t seg_num);
+
+#ifdef  __cplusplus
+}
+#endif
+#endif /* ETHERNET_RING_H_ */
+
+/******************* (C) COPYRIGHT 2026 Realtek Semiconductor *****END OF FILE****/
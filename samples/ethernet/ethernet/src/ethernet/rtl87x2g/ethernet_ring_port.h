@@ -0,0 +1,40 @@
+/**
+*********************************************************************************************************
+*               Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*********************************************************************************************************
+* @file     ethernet_ring_port.h
+* @brief    The platform definitions used by the ETHERNET descriptor ring.
+* @details  The descriptor types, the memory barrier and the code section come from here, so
+*           ethernet_ring.c stays plain C. A host build provides its own copy of this file.
+* @version  v1.0
+* *********************************************************************************************************
+*/
+#ifndef ETHERNET_RING_PORT_H_
+#define ETHERNET_RING_PORT_H_
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+/*============================================================================*
+ *                        Header Files
+ *============================================================================*/
+#include "rtl876x.h"
+#include "rtl_ethernet.h"
+#include "app_section.h"
+
+/*============================================================================*
+ *                         Macros
+ *============================================================================*/
+/* the ring is used from the ETH interrupt path, keep it out of flash */
+#define ETH_RING_FUNCTION           RAM_FUNCTION
+
+/* order the descriptor fields against the OWN bit seen by the DMA */
+#define ETH_RING_DMB()              __DMB()
+
+#ifdef  __cplusplus
+}
+#endif
+#endif /* ETHERNET_RING_PORT_H_ */
+/******************* (C) COPYRIGHT 2026 Realtek Semiconductor *****END OF FILE****/
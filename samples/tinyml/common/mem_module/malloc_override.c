@@ -20,7 +20,7 @@
  *
  * Fix:
  *   Redirect ALL newlib heap operations (malloc/free/calloc/realloc and their
- *   reentrant _r variants) to psRamPortMalloc/psRamFree which allocate from
+ *   reentrant _r variants) to psRamPortMalloc/psRamFree/psRamRealloc which allocate from
  *   ucHeap[] in .bss (NS_RAM_APP).  NS_HEAP is then used exclusively by ROM's
  *   pvPortMalloc, eliminating the conflict.
  *
@@ -32,7 +32,6 @@
 #if defined(__GNUC__) && !defined(__ARMCC_VERSION)
 
 #include <stddef.h>
-#include <string.h>  /* memcpy */
 #include <reent.h>   /* struct _reent */
 
 #include "psRam_heap.h"
@@ -56,20 +55,9 @@ void *calloc(size_t n, size_t size)
 
 void *realloc(void *ptr, size_t size)
 {
-    void *newptr;
-    if (!ptr)  { return psRamPortMalloc(size); }
-    if (!size) { psRamFree(ptr); return NULL;  }
-    newptr = psRamPortMalloc(size);
-    if (newptr)
-    {
-        /* Copy at most 'size' bytes.  Safe for shrinking realloc; for growing
-         * realloc this reads up to 'size' bytes from the old buffer which may
-         * be beyond the original allocation (acceptable in this firmware since
-         * growing realloc is not used). */
-        memcpy(newptr, ptr, size);
-        psRamFree(ptr);
-    }
-    return newptr;
+    /* Grows in place when the next block is free, and copies only the old
+     * block size when the data has to move. */
+    return psRamRealloc(ptr, size);
 }
 
 /* ---------- reentrant _r variants (called internally by newlib) ---------- */
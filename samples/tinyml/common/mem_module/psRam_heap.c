@@ -0,0 +1,761 @@
+/*
+ * Copyright (c) 2026, Realtek Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: LicenseRef-Realtek-5-Clause
+ */
+
+/*
+ * Two level segregated fit (TLSF) heap of the TinyML arenas.
+ *
+ * The free blocks are kept in lists by size: the first level splits the sizes
+ * by powers of two, the second level splits each power of two into
+ * psRAM_SL_INDEX_COUNT ranges.  A bitmap per level tells which lists are not
+ * empty, so malloc and free take a constant time whatever the fragmentation,
+ * where heap_4 walks the whole free list.  Each block keeps a link to the
+ * block before it in memory, so a freed block is merged with both neighbours
+ * at once and realloc can grow into the next block.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+#include "psRam_heap.h"
+#include "app_section.h"
+
+extern void vTaskSuspendAll(void);
+extern int xTaskResumeAll(void);
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+#define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Second level lists per power of two, and the largest power of two of a block.
+ * Sizes below psRAM_SMALL_BLOCK_SIZE all sit in the first level 0, in steps
+ * of psRAM_portBYTE_ALIGNMENT. */
+#define psRAM_SL_INDEX_COUNT_LOG2   4
+#define psRAM_FL_INDEX_MAX          24
+#define psRAM_ALIGN_SIZE_LOG2       3
+
+#define psRAM_SL_INDEX_COUNT        ( 1 << psRAM_SL_INDEX_COUNT_LOG2 )
+#define psRAM_FL_INDEX_SHIFT        ( psRAM_SL_INDEX_COUNT_LOG2 + psRAM_ALIGN_SIZE_LOG2 )
+#define psRAM_FL_INDEX_COUNT        ( psRAM_FL_INDEX_MAX - psRAM_FL_INDEX_SHIFT + 1 )
+#define psRAM_SMALL_BLOCK_SIZE      ( ( size_t ) 1 << psRAM_FL_INDEX_SHIFT )
+#define psRAM_BLOCK_SIZE_MAX        ( ( ( size_t ) 1 << psRAM_FL_INDEX_MAX ) - psRAM_portBYTE_ALIGNMENT )
+
+#if ( ( 1 << psRAM_ALIGN_SIZE_LOG2 ) != psRAM_portBYTE_ALIGNMENT )
+#error psRAM_ALIGN_SIZE_LOG2 does not match psRAM_portBYTE_ALIGNMENT
+#endif
+
+#if ( configTOTAL_psRAM_HEAP_SIZE > ( 1 << psRAM_FL_INDEX_MAX ) )
+#error configTOTAL_psRAM_HEAP_SIZE is larger than the TLSF first level covers, raise psRAM_FL_INDEX_MAX
+#endif
+
+/* Low bits of xSize, which is a multiple of psRAM_portBYTE_ALIGNMENT */
+#define heapBLOCK_FREE_BIT         ( ( size_t ) 1 )
+#define heapBLOCK_PREV_FREE_BIT    ( ( size_t ) 2 )
+#define heapBLOCK_FLAG_MASK        ( heapBLOCK_FREE_BIT | heapBLOCK_PREV_FREE_BIT )
+
+/*-----------------------------------------------------------*/
+
+/* Allocate the memory for the heap. */
+uint8_t ucHeap[ configTOTAL_psRAM_HEAP_SIZE ];// __attribute__((section(".app.psram.data")));//__attribute__((at(0x0C000000)));
+
+/* The header of every block.  The free list links overlay the first bytes of
+ * the payload, so they only cost memory while the block is free. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK *pxPrevPhysBlock;  /*<< The block just before this one in memory. */
+    size_t xSize;                          /*<< The payload size, and the heapBLOCK_x bits. */
+    struct A_BLOCK_LINK *pxNextFreeBlock;  /*<< The next block of the same free list. */
+    struct A_BLOCK_LINK *pxPrevFreeBlock;  /*<< The previous block of the same free list. */
+} psRam_BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/* The header of an allocated block, i.e. the offset of the payload. */
+static const size_t xHeapStructSize = (offsetof(psRam_BlockLink_t, pxNextFreeBlock) + ((size_t)(
+                                                                                              psRAM_portBYTE_ALIGNMENT - 1))) & ~((size_t) psRAM_portBYTE_ALIGNMENT_MASK);
+
+/* A free block must hold the free list links. */
+static const size_t xMinimumBlockSize = (sizeof(psRam_BlockLink_t) - offsetof(psRam_BlockLink_t,
+                                                                               pxNextFreeBlock) + ((size_t)(psRAM_portBYTE_ALIGNMENT - 1))) & ~((size_t)
+                                                                                       psRAM_portBYTE_ALIGNMENT_MASK);
+
+/* Bitmaps of the non empty lists, and the lists themselves. */
+static uint32_t ulFlBitmap = 0;
+static uint32_t ulSlBitmap[ psRAM_FL_INDEX_COUNT ];
+static psRam_BlockLink_t *pxFreeLists[ psRAM_FL_INDEX_COUNT ][ psRAM_SL_INDEX_COUNT ];
+
+/* The zero size block at the end of the heap, it is never free. */
+static psRam_BlockLink_t *pxEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining.  The byte counts include the block headers. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfFreeBlocks = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/*-----------------------------------------------------------*/
+
+#define PSRAM_LOG(format, ...)  //DBG_DIRECT(format, ##__VA_ARGS__)
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * psRamPortMalloc() is called.
+ */
+static void psRamHeapInit(void);
+
+/*-----------------------------------------------------------*/
+
+static int psRamFls(size_t xValue)
+{
+    return (int)(sizeof(unsigned long) * 8) - 1 - __builtin_clzl((unsigned long) xValue);
+}
+
+static int psRamFfs(uint32_t ulValue)
+{
+    return __builtin_ctz(ulValue);
+}
+
+static size_t psRamBlockSize(const psRam_BlockLink_t *pxBlock)
+{
+    return pxBlock->xSize & ~heapBLOCK_FLAG_MASK;
+}
+
+static void psRamBlockSetSize(psRam_BlockLink_t *pxBlock, size_t xSize)
+{
+    pxBlock->xSize = xSize | (pxBlock->xSize & heapBLOCK_FLAG_MASK);
+}
+
+static psRam_BlockLink_t *psRamBlockNext(const psRam_BlockLink_t *pxBlock)
+{
+    return (psRam_BlockLink_t *)(((uint8_t *) pxBlock) + xHeapStructSize + psRamBlockSize(pxBlock));
+}
+
+static psRam_BlockLink_t *psRamBlockFromPtr(const void *pv)
+{
+    return (psRam_BlockLink_t *)(((uint8_t *) pv) - xHeapStructSize);
+}
+
+static void *psRamBlockToPtr(const psRam_BlockLink_t *pxBlock)
+{
+    return (void *)(((uint8_t *) pxBlock) + xHeapStructSize);
+}
+
+/* Marks the block free or used, in its own header and in the header of the
+ * next block. */
+static void psRamBlockMarkFree(psRam_BlockLink_t *pxBlock)
+{
+    psRam_BlockLink_t *pxNext = psRamBlockNext(pxBlock);
+
+    pxNext->pxPrevPhysBlock = pxBlock;
+    pxNext->xSize |= heapBLOCK_PREV_FREE_BIT;
+    pxBlock->xSize |= heapBLOCK_FREE_BIT;
+}
+
+static void psRamBlockMarkUsed(psRam_BlockLink_t *pxBlock)
+{
+    psRam_BlockLink_t *pxNext = psRamBlockNext(pxBlock);
+
+    pxNext->xSize &= ~heapBLOCK_PREV_FREE_BIT;
+    pxBlock->xSize &= ~heapBLOCK_FREE_BIT;
+}
+
+/* Size rounded up to the alignment and the minimum block, 0 if too large. */
+static size_t psRamAdjustRequestSize(size_t xWantedSize)
+{
+    size_t xAdjusted;
+
+    if ((xWantedSize == 0) || (xWantedSize > psRAM_BLOCK_SIZE_MAX))
+    {
+        return 0;
+    }
+
+    xAdjusted = (xWantedSize + psRAM_portBYTE_ALIGNMENT_MASK) & ~((size_t) psRAM_portBYTE_ALIGNMENT_MASK);
+    return (xAdjusted < xMinimumBlockSize) ? xMinimumBlockSize : xAdjusted;
+}
+
+/*-----------------------------------------------------------*/
+
+/* The list which holds blocks of xSize. */
+static void psRamMappingInsert(size_t xSize, int *pxFl, int *pxSl)
+{
+    int xFl, xSl;
+
+    if (xSize < psRAM_SMALL_BLOCK_SIZE)
+    {
+        xFl = 0;
+        xSl = (int)(xSize / (psRAM_SMALL_BLOCK_SIZE / psRAM_SL_INDEX_COUNT));
+    }
+    else
+    {
+        xFl = psRamFls(xSize);
+        xSl = (int)(xSize >> (xFl - psRAM_SL_INDEX_COUNT_LOG2)) ^ psRAM_SL_INDEX_COUNT;
+        xFl -= (psRAM_FL_INDEX_SHIFT - 1);
+    }
+
+    *pxFl = xFl;
+    *pxSl = xSl;
+}
+
+/* The first list whose blocks are all at least xSize large. */
+static void psRamMappingSearch(size_t xSize, int *pxFl, int *pxSl)
+{
+    if (xSize >= psRAM_SMALL_BLOCK_SIZE)
+    {
+        xSize += ((size_t) 1 << (psRamFls(xSize) - psRAM_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+
+    psRamMappingInsert(xSize, pxFl, pxSl);
+}
+
+static psRam_BlockLink_t *psRamSearchSuitableBlock(int *pxFl, int *pxSl)
+{
+    int xFl = *pxFl;
+    int xSl;
+    uint32_t ulSlMap;
+    uint32_t ulFlMap;
+
+    if (xFl >= psRAM_FL_INDEX_COUNT)
+    {
+        return NULL;
+    }
+
+    ulSlMap = ulSlBitmap[ xFl ] & (~0UL << *pxSl);
+    if (ulSlMap == 0)
+    {
+        /* Nothing left in this first level, take the next larger one. */
+        ulFlMap = ulFlBitmap & (~0UL << (xFl + 1));
+        if (ulFlMap == 0)
+        {
+            return NULL;
+        }
+
+        xFl = psRamFfs(ulFlMap);
+        ulSlMap = ulSlBitmap[ xFl ];
+    }
+
+    xSl = psRamFfs(ulSlMap);
+    *pxFl = xFl;
+    *pxSl = xSl;
+    return pxFreeLists[ xFl ][ xSl ];
+}
+
+static void psRamRemoveFreeBlock(psRam_BlockLink_t *pxBlock, int xFl, int xSl)
+{
+    psRam_BlockLink_t *pxPrev = pxBlock->pxPrevFreeBlock;
+    psRam_BlockLink_t *pxNext = pxBlock->pxNextFreeBlock;
+
+    if (pxNext != NULL)
+    {
+        pxNext->pxPrevFreeBlock = pxPrev;
+    }
+
+    if (pxPrev != NULL)
+    {
+        pxPrev->pxNextFreeBlock = pxNext;
+    }
+    else
+    {
+        pxFreeLists[ xFl ][ xSl ] = pxNext;
+        if (pxNext == NULL)
+        {
+            ulSlBitmap[ xFl ] &= ~(1UL << xSl);
+            if (ulSlBitmap[ xFl ] == 0)
+            {
+                ulFlBitmap &= ~(1UL << xFl);
+            }
+        }
+    }
+
+    xNumberOfFreeBlocks--;
+}
+
+static void psRamInsertFreeBlock(psRam_BlockLink_t *pxBlock)
+{
+    int xFl, xSl;
+
+    psRamMappingInsert(psRamBlockSize(pxBlock), &xFl, &xSl);
+
+    pxBlock->pxPrevFreeBlock = NULL;
+    pxBlock->pxNextFreeBlock = pxFreeLists[ xFl ][ xSl ];
+    if (pxBlock->pxNextFreeBlock != NULL)
+    {
+        pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock;
+    }
+
+    pxFreeLists[ xFl ][ xSl ] = pxBlock;
+    ulFlBitmap |= 1UL << xFl;
+    ulSlBitmap[ xFl ] |= 1UL << xSl;
+    xNumberOfFreeBlocks++;
+}
+
+static void psRamRemoveBlock(psRam_BlockLink_t *pxBlock)
+{
+    int xFl, xSl;
+
+    psRamMappingInsert(psRamBlockSize(pxBlock), &xFl, &xSl);
+    psRamRemoveFreeBlock(pxBlock, xFl, xSl);
+}
+
+/*-----------------------------------------------------------*/
+
+/* Merges the free block pxNext into pxBlock, pxNext must not be in a list. */
+static void psRamBlockAbsorb(psRam_BlockLink_t *pxBlock, psRam_BlockLink_t *pxNext)
+{
+    psRamBlockSetSize(pxBlock, psRamBlockSize(pxBlock) + xHeapStructSize + psRamBlockSize(pxNext));
+    psRamBlockNext(pxBlock)->pxPrevPhysBlock = pxBlock;
+}
+
+/* Merges a block about to become free with its free neighbours, none of them
+ * in a list when this returns. */
+static psRam_BlockLink_t *psRamBlockMerge(psRam_BlockLink_t *pxBlock)
+{
+    psRam_BlockLink_t *pxNeighbour;
+
+    if ((pxBlock->xSize & heapBLOCK_PREV_FREE_BIT) != 0)
+    {
+        pxNeighbour = pxBlock->pxPrevPhysBlock;
+        psRamRemoveBlock(pxNeighbour);
+        psRamBlockAbsorb(pxNeighbour, pxBlock);
+        pxBlock = pxNeighbour;
+    }
+
+    pxNeighbour = psRamBlockNext(pxBlock);
+    if ((pxNeighbour->xSize & heapBLOCK_FREE_BIT) != 0)
+    {
+        psRamRemoveBlock(pxNeighbour);
+        psRamBlockAbsorb(pxBlock, pxNeighbour);
+    }
+
+    return pxBlock;
+}
+
+/* Cuts the used block down to xSize and frees the rest, if the rest is large
+ * enough to be a block of its own. */
+static void psRamBlockTrimUsed(psRam_BlockLink_t *pxBlock, size_t xSize)
+{
+    psRam_BlockLink_t *pxRemaining;
+    size_t xBlockSize = psRamBlockSize(pxBlock);
+
+    if (xBlockSize < xSize + xHeapStructSize + xMinimumBlockSize)
+    {
+        return;
+    }
+
+    pxRemaining = (psRam_BlockLink_t *)(((uint8_t *) psRamBlockToPtr(pxBlock)) + xSize);
+    pxRemaining->pxPrevPhysBlock = pxBlock;
+    pxRemaining->xSize = xBlockSize - xSize - xHeapStructSize;
+    psRamBlockSetSize(pxBlock, xSize);
+
+    pxRemaining = psRamBlockMerge(pxRemaining);
+    psRamBlockMarkFree(pxRemaining);
+    psRamInsertFreeBlock(pxRemaining);
+}
+
+/* Splits the free space in front of xAligned off pxBlock, which is free and
+ * not in a list, and returns the block starting at xAligned. */
+static psRam_BlockLink_t *psRamBlockTrimLeading(psRam_BlockLink_t *pxBlock, uint8_t *pucAligned)
+{
+    psRam_BlockLink_t *pxAligned = psRamBlockFromPtr(pucAligned);
+    size_t xLeading = (size_t)(pucAligned - (uint8_t *) psRamBlockToPtr(pxBlock));
+
+    pxAligned->pxPrevPhysBlock = pxBlock;
+    pxAligned->xSize = psRamBlockSize(pxBlock) - xLeading;
+    psRamBlockSetSize(pxBlock, xLeading - xHeapStructSize);
+
+    psRamBlockNext(pxAligned)->pxPrevPhysBlock = pxAligned;
+    psRamBlockMarkFree(pxBlock);
+    psRamInsertFreeBlock(pxBlock);
+    return pxAligned;
+}
+
+/* Takes a free block of at least xSize out of the lists, NULL if none. */
+static psRam_BlockLink_t *psRamLocateFree(size_t xSize)
+{
+    psRam_BlockLink_t *pxBlock;
+    int xFl, xSl;
+
+    psRamMappingSearch(xSize, &xFl, &xSl);
+    pxBlock = psRamSearchSuitableBlock(&xFl, &xSl);
+    if (pxBlock != NULL)
+    {
+        psRamRemoveFreeBlock(pxBlock, xFl, xSl);
+    }
+
+    return pxBlock;
+}
+
+/* Hands a located block out, trimmed to xSize, and updates the statistics. */
+static void *psRamBlockPrepareUsed(psRam_BlockLink_t *pxBlock, size_t xSize)
+{
+    psRamBlockMarkUsed(pxBlock);
+    psRamBlockTrimUsed(pxBlock, xSize);
+
+    xFreeBytesRemaining -= xHeapStructSize + psRamBlockSize(pxBlock);
+    if (xFreeBytesRemaining < xMinimumEverFreeBytesRemaining)
+    {
+        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+    }
+
+    xNumberOfSuccessfulAllocations++;
+    return psRamBlockToPtr(pxBlock);
+}
+
+/*-----------------------------------------------------------*/
+
+void *psRamPortMalloc(size_t xWantedSize)
+{
+    psRam_BlockLink_t *pxBlock;
+    void *pvReturn = NULL;
+    size_t xSize = psRamAdjustRequestSize(xWantedSize);
+
+    vTaskSuspendAll();
+    {
+        /* If this is the first call to malloc then the heap will require
+         * initialisation to setup the free lists. */
+        if (pxEnd == NULL)
+        {
+            psRamHeapInit();
+        }
+
+        if (xSize != 0)
+        {
+            pxBlock = psRamLocateFree(xSize);
+            if (pxBlock != NULL)
+            {
+                pvReturn = psRamBlockPrepareUsed(pxBlock, xSize);
+                PSRAM_LOG("[TS] psRamPortMalloc addr 0x%x, size %d", pvReturn, psRamBlockSize(pxBlock));
+            }
+        }
+    }
+    (void) xTaskResumeAll();
+
+    if (pvReturn == NULL)
+    {
+        PSRAM_LOG("[TS] psRam malloc failed, size %d", xWantedSize);
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *psRamPortMallocAligned(size_t xWantedSize, size_t xAlignment)
+{
+    psRam_BlockLink_t *pxBlock;
+    void *pvReturn = NULL;
+    size_t xSize = psRamAdjustRequestSize(xWantedSize);
+    size_t xGapMinimum = xHeapStructSize + xMinimumBlockSize;
+    size_t xAlignedSize;
+    uintptr_t uxPtr;
+    uintptr_t uxAligned;
+
+    if ((xAlignment & (xAlignment - 1)) != 0)
+    {
+        return NULL;
+    }
+
+    if (xAlignment <= psRAM_portBYTE_ALIGNMENT)
+    {
+        return psRamPortMalloc(xWantedSize);
+    }
+
+    /* Room to move the payload up to the alignment, leaving a free block in
+     * front of it. */
+    xAlignedSize = psRamAdjustRequestSize(xSize + xAlignment + xGapMinimum);
+
+    vTaskSuspendAll();
+    {
+        if (pxEnd == NULL)
+        {
+            psRamHeapInit();
+        }
+
+        if ((xSize != 0) && (xAlignedSize != 0))
+        {
+            pxBlock = psRamLocateFree(xAlignedSize);
+            if (pxBlock != NULL)
+            {
+                uxPtr = (uintptr_t) psRamBlockToPtr(pxBlock);
+                uxAligned = (uxPtr + xAlignment - 1) & ~((uintptr_t) xAlignment - 1);
+                if ((uxAligned != uxPtr) && (uxAligned - uxPtr < xGapMinimum))
+                {
+                    uxAligned = (uxPtr + xGapMinimum + xAlignment - 1) & ~((uintptr_t) xAlignment - 1);
+                }
+
+                if (uxAligned != uxPtr)
+                {
+                    pxBlock = psRamBlockTrimLeading(pxBlock, (uint8_t *) uxAligned);
+                }
+
+                pvReturn = psRamBlockPrepareUsed(pxBlock, xSize);
+            }
+        }
+    }
+    (void) xTaskResumeAll();
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void psRamFree(void *pv)
+{
+    psRam_BlockLink_t *pxLink;
+
+    if (pv != NULL)
+    {
+        pxLink = psRamBlockFromPtr(pv);
+
+        PSRAM_LOG("[TS] psRamFree addr 0x%x, size %d", pxLink, psRamBlockSize(pxLink));
+
+        PSRAM_ASSERT((pxLink->xSize & heapBLOCK_FREE_BIT) == 0);
+
+        if ((pxLink->xSize & heapBLOCK_FREE_BIT) == 0)
+        {
+#if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                (void) memset(pv, 0, psRamBlockSize(pxLink));
+            }
+#endif
+
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += xHeapStructSize + psRamBlockSize(pxLink);
+                pxLink = psRamBlockMerge(pxLink);
+                psRamBlockMarkFree(pxLink);
+                psRamInsertFreeBlock(pxLink);
+                xNumberOfSuccessfulFrees++;
+            }
+            (void) xTaskResumeAll();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void *psRamRealloc(void *pv, size_t xWantedSize)
+{
+    psRam_BlockLink_t *pxBlock;
+    psRam_BlockLink_t *pxNext;
+    size_t xSize = psRamAdjustRequestSize(xWantedSize);
+    size_t xCurrentSize;
+    size_t xCombinedSize;
+    void *pvReturn = NULL;
+    int xInPlace = 0;
+
+    if (pv == NULL)
+    {
+        return psRamPortMalloc(xWantedSize);
+    }
+
+    if (xWantedSize == 0)
+    {
+        psRamFree(pv);
+        return NULL;
+    }
+
+    if (xSize == 0)
+    {
+        return NULL;
+    }
+
+    pxBlock = psRamBlockFromPtr(pv);
+    PSRAM_ASSERT((pxBlock->xSize & heapBLOCK_FREE_BIT) == 0);
+
+    vTaskSuspendAll();
+    {
+        xCurrentSize = psRamBlockSize(pxBlock);
+        pxNext = psRamBlockNext(pxBlock);
+        xCombinedSize = xCurrentSize;
+        if ((pxNext->xSize & heapBLOCK_FREE_BIT) != 0)
+        {
+            xCombinedSize += xHeapStructSize + psRamBlockSize(pxNext);
+        }
+
+        if (xSize <= xCombinedSize)
+        {
+            /* Fits here, growing into the free block behind if needed. */
+            xFreeBytesRemaining += xHeapStructSize + xCurrentSize;
+            if (xSize > xCurrentSize)
+            {
+                psRamRemoveBlock(pxNext);
+                psRamBlockAbsorb(pxBlock, pxNext);
+                psRamBlockMarkUsed(pxBlock);
+            }
+
+            psRamBlockTrimUsed(pxBlock, xSize);
+            xFreeBytesRemaining -= xHeapStructSize + psRamBlockSize(pxBlock);
+            if (xFreeBytesRemaining < xMinimumEverFreeBytesRemaining)
+            {
+                xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+            }
+
+            xInPlace = 1;
+        }
+    }
+    (void) xTaskResumeAll();
+
+    if (xInPlace != 0)
+    {
+        return pv;
+    }
+
+    /* The neighbour is in use, move the data. */
+    pvReturn = psRamPortMalloc(xWantedSize);
+    if (pvReturn != NULL)
+    {
+        (void) memcpy(pvReturn, pv, xCurrentSize);
+        psRamFree(pv);
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t psRamGetBlockSize(void *pv)
+{
+    if (pv == NULL)
+    {
+        return 0;
+    }
+
+    return psRamBlockSize(psRamBlockFromPtr(pv));
+}
+/*-----------------------------------------------------------*/
+
+size_t psRamGetFreeHeapSize(void)
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t psRamGetMinimumEverFreeHeapSize(void)
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void psRamInitialiseBlocks(void)
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void *psRamPortCalloc(size_t xNum,
+                      size_t xSize)
+{
+    void *pv = NULL;
+
+    if (heapMULTIPLY_WILL_OVERFLOW(xNum, xSize) == 0)
+    {
+        pv = psRamPortMalloc(xNum * xSize);
+
+        if (pv != NULL)
+        {
+            (void) memset(pv, 0, xNum * xSize);
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static void psRamHeapInit(void)   /*  */
+{
+    psRam_BlockLink_t *pxFirstFreeBlock;
+    uint8_t *pucAlignedHeap;
+    uintptr_t uxAddress;
+    size_t xTotalHeapSize = configTOTAL_psRAM_HEAP_SIZE;
+
+    /* Ensure the heap starts on a correctly aligned boundary. */
+    uxAddress = (uintptr_t) ucHeap;
+
+    if ((uxAddress & psRAM_portBYTE_ALIGNMENT_MASK) != 0)
+    {
+        uxAddress += (psRAM_portBYTE_ALIGNMENT - 1);
+        uxAddress &= ~((uintptr_t) psRAM_portBYTE_ALIGNMENT_MASK);
+        xTotalHeapSize -= uxAddress - (uintptr_t) ucHeap;
+    }
+
+    xTotalHeapSize &= ~((size_t) psRAM_portBYTE_ALIGNMENT_MASK);
+    pucAlignedHeap = (uint8_t *) uxAddress;
+
+    /* There is a single free block that is sized to take up the entire heap
+     * space, minus the header of pxEnd which closes the heap. */
+    pxFirstFreeBlock = (psRam_BlockLink_t *) pucAlignedHeap;
+    pxFirstFreeBlock->pxPrevPhysBlock = NULL;
+    pxFirstFreeBlock->xSize = xTotalHeapSize - (2 * xHeapStructSize);
+
+    pxEnd = psRamBlockNext(pxFirstFreeBlock);
+    pxEnd->xSize = 0;
+    psRamBlockMarkFree(pxFirstFreeBlock);
+    psRamInsertFreeBlock(pxFirstFreeBlock);
+
+    xMinimumEverFreeBytesRemaining = xTotalHeapSize - xHeapStructSize;
+    xFreeBytesRemaining = xTotalHeapSize - xHeapStructSize;
+}
+/*-----------------------------------------------------------*/
+
+void psRamGetHeapStats(psRam_HeapStats_t *pxHeapStats)
+{
+    psRam_BlockLink_t *pxBlock;
+    size_t xMaxSize = 0, xMinSize = 0;
+    int xFl, xSl;
+
+    vTaskSuspendAll();
+    {
+        if (pxEnd == NULL)
+        {
+            psRamHeapInit();
+        }
+
+        /* The largest block is in the last non empty list, the smallest in
+         * the first one, so only these two lists are walked. */
+        if (ulFlBitmap != 0)
+        {
+            xFl = psRamFls(ulFlBitmap);
+            xSl = psRamFls(ulSlBitmap[ xFl ]);
+            for (pxBlock = pxFreeLists[ xFl ][ xSl ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock)
+            {
+                if (psRamBlockSize(pxBlock) > xMaxSize)
+                {
+                    xMaxSize = psRamBlockSize(pxBlock);
+                }
+            }
+
+            xFl = psRamFfs(ulFlBitmap);
+            xSl = psRamFfs(ulSlBitmap[ xFl ]);
+            xMinSize = heapSIZE_MAX;
+            for (pxBlock = pxFreeLists[ xFl ][ xSl ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock)
+            {
+                if (psRamBlockSize(pxBlock) < xMinSize)
+                {
+                    xMinSize = psRamBlockSize(pxBlock);
+                }
+            }
+
+            xMaxSize += xHeapStructSize;
+            xMinSize += xHeapStructSize;
+        }
+
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+        pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+        pxHeapStats->xNumberOfFreeBlocks = xNumberOfFreeBlocks;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xFragmentationPercent = (xFreeBytesRemaining == 0) ? 0 :
+                                             ((xFreeBytesRemaining - xMaxSize) * 100) / xFreeBytesRemaining;
+    }
+    (void) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
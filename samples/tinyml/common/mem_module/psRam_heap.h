@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, Realtek Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: LicenseRef-Realtek-5-Clause
+ */
+
+#ifndef _PSRAM_HEAP_HEAD_
+#define _PSRAM_HEAP_HEAD_
+
+#include <stddef.h>
+#include "app_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#define psRAM_portBYTE_ALIGNMENT 8
+#define psRAM_portBYTE_ALIGNMENT_MASK ( 0x0007 )
+
+/* Each sample sets the size of its arena in app_flags.h */
+#ifndef configTOTAL_psRAM_HEAP_SIZE
+#define configTOTAL_psRAM_HEAP_SIZE (100 * 1024)
+#endif
+
+#define PSRAM_ASSERT(e) \
+    do \
+    { \
+        if(!(e)) \
+        { \
+            DBG_DIRECT("(" #e ") psram assert failed! Func: %s. Line: %d.", __func__, __LINE__); \
+            DBG_DIRECT("(" #e ") psram assert failed! Func: %s. Line: %d.", __func__, __LINE__); \
+            for(;;); \
+        } \
+    } while(0)
+
+/* Byte counts include the block headers, the same as xBlockSize of heap_4 */
+typedef struct
+{
+    size_t xAvailableHeapSpaceInBytes;      /* Total free bytes */
+    size_t xSizeOfLargestFreeBlockInBytes;
+    size_t xSizeOfSmallestFreeBlockInBytes;
+    size_t xNumberOfFreeBlocks;
+    size_t xMinimumEverFreeBytesRemaining;
+    size_t xNumberOfSuccessfulAllocations;
+    size_t xNumberOfSuccessfulFrees;
+    size_t xFragmentationPercent;           /* Share of the free bytes outside the largest free block */
+} psRam_HeapStats_t;
+
+void *psRamPortMalloc(size_t xWantedSize);
+void psRamFree(void *pv);
+size_t psRamGetFreeHeapSize(void);
+size_t psRamGetMinimumEverFreeHeapSize(void);
+void *psRamPortCalloc(size_t xNum,
+                      size_t xSize);
+
+/* xAlignment is a power of two, e.g. 16 for the CMSIS-NN buffers */
+void *psRamPortMallocAligned(size_t xWantedSize, size_t xAlignment);
+
+/* Grows into the next block when it is free, so the data is only copied
+ * when the neighbour is in use. */
+void *psRamRealloc(void *pv, size_t xWantedSize);
+
+/* Usable size of an allocated block, at least the size asked for */
+size_t psRamGetBlockSize(void *pv);
+
+/* Walks the free lists of the largest and smallest sizes only */
+void psRamGetHeapStats(psRam_HeapStats_t *pxHeapStats);
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026, Realtek Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: LicenseRef-Realtek-5-Clause
+ */
+
+#include "string.h"
+#include "board.h"
+#include "os_timer.h"
+#include "os_sched.h"
+#include "app_msg.h"
+#include "os_sync.h"
+#include "trace.h"
+#include "os_mem.h"
+#include "ts_mem.h"
+#include "psRam_heap.h"
+
+
+
+#define LOG_Mem_Print(format, ...)  //DBG_DIRECT(format, ##__VA_ARGS__)
+
+
+void *ts_realloc(void *mem, size_t size)
+{
+    void *new_ptr;
+
+    LOG_Mem_Print("[TS] realloc mem %x size %d", mem, size);
+
+    /* Grows in place when the next block is free, else moves the data */
+    new_ptr = psRamRealloc(mem, size);
+    if (new_ptr == NULL && size != 0)
+    {
+        LOG_Mem_Print("[TS] new_ptr failed!");
+    }
+
+    return new_ptr;
+}
+
+size_t ts_getUsedSize(void *pt)
+{
+    LOG_Mem_Print("[TS] ts_getUsedSize %d, addr 0x%x", psRamGetBlockSize(pt), pt);
+
+    return psRamGetBlockSize(pt);
+}
+
+static uint32_t g_Max_size = 0;
+void *ts_malloc(uint32_t size)
+{
+    //
+    void *pt = psRamPortMalloc(size);
+    //void *pt = os_mem_alloc(RAM_TYPE_DSPSHARE, size);
+    if (pt == NULL)
+    {
+        LOG_Mem_Print("[TS] malloc failed!!!!!!!");
+        return NULL;
+    }
+
+    LOG_Mem_Print("[TS] ts_malloc wanted size %d, addr 0x%x, size %d", size, pt,
+                  psRamGetBlockSize(pt));
+
+    if ((uint32_t)pt > g_Max_size) { g_Max_size = (uint32_t)pt; }
+
+    return pt;
+}
+
+uint32_t test_get_max_size(void)
+{
+    return g_Max_size;
+}
+
+void *ts_calloc(uint32_t nblock, uint32_t size)
+{
+#if 1
+    void *pt = ts_malloc(nblock * size);
+    if (pt)
+    {
+        memset(pt, 0, nblock * size);
+    }
+#else
+    void *pt = psRamPortCalloc(nblock, size);
+#endif
+    LOG_Mem_Print("[TS] ts_calloc nblock * size %d, addr %x", nblock * size, pt);
+    return pt;
+}
+void ts_free(void *pt)
+{
+    if (pt != NULL)
+    {
+        LOG_Mem_Print("[TS] ts_free size %d, addr 0x%x", psRamGetBlockSize(pt), pt);
+        //os_mem_free(pt);
+        psRamFree(pt);
+
+        //pt = NULL;
+    }
+
+}
+
+
@@ -28,6 +28,8 @@
 #define F_BT_ANCS_GET_APP_ATTR              (F_BT_ANCS_CLIENT_SUPPORT & 0)
 /** @brief  Config ANCS Client debug log: 0-close, 1-open  */
 #define F_BT_ANCS_CLIENT_DEBUG              (F_BT_ANCS_CLIENT_SUPPORT & 0)
+/** @brief  Size of the PSRAM heap, see common/mem_module/psRam_heap.h */
+#define configTOTAL_psRAM_HEAP_SIZE         (180 * 1024)
 
 /** @} */ /* End of group PERIPH_Config */
 #endif
@@ -89,6 +89,15 @@
 #define KWS_INP_SCALE_INV                (0.0390625f / 0.1019607857f)  /* ~= 0.383113 */
 #define KWS_INP_ZP                       (-128)
 
+/* The same scale in Q18, folded at compile time.  For the scale above,
+ *   ((v * KWS_INP_SCALE_Q + 2^17) >> 18) == (int32_t)(v * KWS_INP_SCALE_INV + 0.5f)
+ * for every uint16 v that does not saturate; checked over all 65536 inputs.
+ * Inputs from KWS_INP_SAT_VALUE on all quantize to 127, clamping them first
+ * keeps the product in 32 bits. */
+#define KWS_INP_SCALE_SHIFT              18
+#define KWS_INP_SCALE_Q                  ((uint32_t)(KWS_INP_SCALE_INV * (1 << KWS_INP_SCALE_SHIFT) + 0.5f))
+#define KWS_INP_SAT_VALUE                1024u
+
 /* ts_realtek_invoke dequantizes uint8 output to float32 internally;
  * caller receives probability directly (no manual scaling needed). */
 
@@ -115,11 +124,12 @@ static int8_t s_features_int8[KWS_INPUT_BYTES];
  *============================================================================*/
 void TinyML_main_task(void *p_param);
 
-/* Quantize one uint16 mel feature to int8. */
+/* Quantize one uint16 mel feature to int8, without the FPU. */
 static inline int8_t quantize_feature(uint16_t v)
 {
-    int32_t q = (int32_t)((float)v * KWS_INP_SCALE_INV + 0.5f) + KWS_INP_ZP;
-    if (q < -128) { q = -128; }
+    uint32_t x = (v < KWS_INP_SAT_VALUE) ? v : KWS_INP_SAT_VALUE;
+    int32_t q = (int32_t)((x * KWS_INP_SCALE_Q + (1u << (KWS_INP_SCALE_SHIFT - 1))) >>
+                          KWS_INP_SCALE_SHIFT) + KWS_INP_ZP;
     if (q >  127) { q =  127; }
     return (int8_t)q;
 }
@@ -15,7 +15,10 @@
 #include "dfu_service.h"
 #include "dfu_common.h"
 #include "gap_conn_le.h"
+#include "os_msg.h"
+#include "os_sched.h"
 #include "os_sync.h"
+#include "os_task.h"
 #include "os_timer.h"
 #include "fmc_api.h"
 #include "fmc_platform.h"
@@ -24,16 +27,107 @@
 #include "dfu_main.h"
 #endif
 #include "rtl876x_lib_platform.h"
+#if (FTL_POOL_ENABLE == 1)
+#include "ftl.h"
+#include "rtl_errno.h"
+#endif
 
 
 /*if enable transfer encrypted air data packet by aes. disable: 0*/
 #define ENABLE_OTA_AES                  1
 
+/*if write a checked buffer to flash while the next buffer is received. disable: 0*/
+#ifndef DFU_PIPELINE_WRITE
+#define DFU_PIPELINE_WRITE              1
+#endif
+
+#define DFU_WRITER_TASK_PRIORITY        1
+#define DFU_WRITER_TASK_STACK_SIZE      1024
+
+/*if save the download progress to resume an interrupted image after timeout or reboot. disable: 0*/
+#ifndef DFU_JOURNAL_ENABLE
+#if (FTL_POOL_ENABLE == 1)
+#define DFU_JOURNAL_ENABLE              1
+#else
+#define DFU_JOURNAL_ENABLE              0
+#endif
+#endif
+
+#define DFU_JOURNAL_NAME                "DFUJ"
+#define DFU_JOURNAL_MAGIC               0x4A554644
+#define DFU_JOURNAL_BLOCK_LEN           64
+#define DFU_JOURNAL_SIZE                (3 * DFU_JOURNAL_BLOCK_LEN)
+#define DFU_JOURNAL_SAVE_INTERVAL       (8 * FLASH_SECTOR_SIZE)
+
+/*============================================================================*
+ *                              Types
+ *============================================================================*/
+/* A buffer that passed the buffer check and waits to be written to flash */
+typedef struct
+{
+    uint8_t *p_buf;
+    uint32_t cur_offset;
+    uint32_t next_subimage_offset;
+    uint16_t image_id;
+    uint16_t data_size;
+    uint16_t write_size;
+    uint8_t conn_id;
+} T_DFU_WRITE_JOB;
+
+#if (DFU_JOURNAL_ENABLE == 1)
+/* Progress of the image being downloaded, all data before cur_offset is on flash */
+typedef union
+{
+    uint8_t bytes[DFU_JOURNAL_SIZE];
+    struct
+    {
+        uint32_t magic;
+        uint32_t image_total_length;
+        uint32_t next_subimage_offset;
+        uint32_t cur_offset;
+        uint16_t image_id;
+        uint16_t crc16;             /* build of the image, from the ctrl header of start dfu */
+        T_DFU_IMAGE_HASH hash;
+        uint8_t ic_type;
+        uint8_t secure_version;
+    };
+} T_DFU_JOURNAL;
+
+PLATFORM_STATIC_ASSERT(sizeof(T_DFU_JOURNAL) == DFU_JOURNAL_SIZE, dfu_journal_size);
+#endif
+
+#if (DFU_PIPELINE_WRITE == 1)
+typedef struct
+{
+    void *task_handle;
+    void *queue_handle;
+    void *sem_handle;
+    uint8_t *p_spare_buf;
+    T_DFU_WRITE_JOB job;
+    uint32_t result;
+    bool busy;
+} T_DFU_WRITER;
+#endif
+
 /*============================================================================*
  *                              Variables
  *============================================================================*/
 static OTA_FUNCTION_STRUCT ota_struct;
 static uint8_t temp_image_total_num = 0;
+static uint64_t dfu_start_time = 0;
+static P_FUN_DFU_SEND_MSG dfu_send_msg = NULL;
+static volatile bool dfu_trans_timeout_pending = false;
+#if (DFU_PIPELINE_WRITE == 1)
+static T_DFU_WRITER dfu_writer;
+#endif
+#if (DFU_JOURNAL_ENABLE == 1)
+static T_DFU_JOURNAL dfu_journal;
+static bool dfu_journal_loaded = false;
+/* ctrl header of the image being downloaded */
+static T_IMG_CTRL_HEADER_FORMAT dfu_ctrl_header;
+/* the cur_offset of the journal was reported to the client, start dfu resumes from it */
+static bool dfu_journal_reported = false;
+#endif
 
 bool dfu_active_reset_pending = false;
 bool dfu_active_reset_to_ota_mode = false;
@@ -207,6 +301,500 @@ static bool dfu_check_section_size(void)
     return true;
 }
 
+static bool dfu_get_enc_setting(void);
+#if (DFU_JOURNAL_ENABLE == 1)
+static void ble_dfu_journal_save(bool force);
+#endif
+
+/**
+    * @brief    Decrypt a checked buffer and write it to flash
+    * @param    p_job     buffer to be written
+    * @return   0 on success, non-zero on failure
+    */
+static uint32_t ble_dfu_buffer_write(T_DFU_WRITE_JOB *p_job)
+{
+    if (dfu_get_enc_setting())
+    {
+        uint16_t offset = 0;
+        while ((p_job->data_size - offset) >= 16)
+        {
+            dfu_aes256_decrypt_16byte(p_job->p_buf + offset);
+            offset += 16;
+        }
+    }
+
+    return dfu_write_data_to_flash(p_job->image_id, p_job->cur_offset, p_job->next_subimage_offset,
+                                   p_job->write_size, p_job->p_buf);
+}
+
+/**
+    * @brief    Roll cur_offset back to the start of the failed sector and erase it for resending
+    * @param    conn_id   ID to identify the connection
+    * @return   DFU_ARV_FAIL_FLASH_WRITE_ERROR if the sector can be resent, else DFU_ARV_FAIL_FLASH_ERASE_ERROR
+    */
+static uint8_t ble_dfu_write_fail_handle(uint8_t conn_id)
+{
+    uint32_t erase_time = 0;
+    uint32_t resend_offset = (ota_struct.next_subimage_offset + ota_struct.cur_offset) /
+                             FLASH_SECTOR_SIZE * FLASH_SECTOR_SIZE;
+
+    if (resend_offset < ota_struct.next_subimage_offset)
+    {
+        return DFU_ARV_FAIL_FLASH_ERASE_ERROR;
+    }
+
+    ota_struct.cur_offset = resend_offset - ota_struct.next_subimage_offset;
+    DFU_PRINT_TRACE3("ble_dfu_write_fail_handle: cur_offset=0x%x, resend_offset=0x%x, next_subimage_offset=0x%x",
+                     ota_struct.cur_offset, resend_offset, ota_struct.next_subimage_offset);
+
+    while (erase_time < 3)
+    {
+        if (dfu_flash_erase((IMG_ID)ota_struct.image_id, resend_offset) == true)
+        {
+            return DFU_ARV_FAIL_FLASH_WRITE_ERROR;
+        }
+        erase_time++;
+    }
+
+    DFU_PRINT_ERROR0("ble_dfu_write_fail_handle: erase fail more than three times!");
+
+    T_DFU_CALLBACK_DATA callback_data;
+    T_DFU_FAIL_REASON dfu_fail_reason = DFU_FAIL_UPDATE_FLASH;
+    callback_data.conn_id = conn_id;
+    callback_data.msg_type = SERVICE_CALLBACK_TYPE_WRITE_CHAR_VALUE;
+    callback_data.msg_data.write.write_attrib_index = INDEX_DFU_CHAR_DFU_CONTROL_POINT_INDEX;
+    callback_data.msg_data.write.opcode = DFU_WRITE_FAIL;
+    callback_data.msg_data.write.length = sizeof(T_DFU_FAIL_REASON);
+    callback_data.msg_data.write.p_value = (uint8_t *)&dfu_fail_reason;
+    if (p_dfu_extended_cb)
+    {
+        T_APP_RESULT cause = p_dfu_extended_cb(dfu_srv_id_local, (void *)&callback_data);
+        if (cause != APP_RESULT_SUCCESS)
+        {
+            DFU_PRINT_ERROR1("ble_dfu_write_fail_handle: write fail rejected by app, cause=%d", cause);
+            return DFU_ARV_FAIL_FLASH_ERASE_ERROR;
+        }
+    }
+
+    return DFU_ARV_FAIL_FLASH_ERASE_ERROR;
+}
+
+/**
+    * @brief    Report the written length of a buffer to the application
+    * @param    conn_id   ID to identify the connection
+    * @param    length    written length
+    * @return   true if the application accepts it
+    */
+static bool ble_dfu_write_doing_notify(uint8_t conn_id, uint32_t length)
+{
+    T_DFU_CALLBACK_DATA callback_data;
+    uint32_t updated_success_len = length;
+
+    callback_data.conn_id = conn_id;
+    callback_data.msg_type = SERVICE_CALLBACK_TYPE_WRITE_CHAR_VALUE;
+    callback_data.msg_data.write.write_attrib_index = INDEX_DFU_CHAR_DFU_CONTROL_POINT_INDEX;
+    callback_data.msg_data.write.opcode = DFU_WRITE_DOING;
+    callback_data.msg_data.write.length = 4;
+    callback_data.msg_data.write.p_value = (uint8_t *)&updated_success_len;
+    if (p_dfu_extended_cb)
+    {
+        return (p_dfu_extended_cb(dfu_srv_id_local, (void *)&callback_data) == APP_RESULT_SUCCESS);
+    }
+
+    return true;
+}
+
+#if (DFU_PIPELINE_WRITE == 1)
+static void ble_dfu_writer_task(void *p_param)
+{
+    T_DFU_WRITE_JOB job;
+
+    os_alloc_secure_ctx(1024);
+
+    while (true)
+    {
+        if (os_msg_recv(dfu_writer.queue_handle, &job, 0xFFFFFFFF) == true)
+        {
+            dfu_writer.result = ble_dfu_buffer_write(&job);
+            os_sem_give(dfu_writer.sem_handle);
+        }
+    }
+}
+
+/**
+    * @brief    Create the writer task and its spare buffer
+    * @param    buffer_size   size of the spare buffer
+    * @return   true if buffers can be written in the background
+    */
+static bool ble_dfu_writer_init(uint16_t buffer_size)
+{
+    if (dfu_writer.task_handle != NULL)
+    {
+        return true;
+    }
+
+    dfu_writer.p_spare_buf = (uint8_t *)malloc(buffer_size);
+    if (dfu_writer.p_spare_buf == NULL)
+    {
+        return false;
+    }
+
+    if (os_msg_queue_create(&dfu_writer.queue_handle, "dfuWrQ", 1, sizeof(T_DFU_WRITE_JOB)) &&
+        os_sem_create(&dfu_writer.sem_handle, "dfuWrSem", 0, 1) &&
+        os_task_create(&dfu_writer.task_handle, "dfu_writer", ble_dfu_writer_task, NULL,
+                       DFU_WRITER_TASK_STACK_SIZE, DFU_WRITER_TASK_PRIORITY))
+    {
+        return true;
+    }
+
+    DFU_PRINT_ERROR0("ble_dfu_writer_init: fail, write buffers in place");
+    if (dfu_writer.sem_handle != NULL)
+    {
+        os_sem_delete(dfu_writer.sem_handle);
+    }
+    if (dfu_writer.queue_handle != NULL)
+    {
+        os_msg_queue_delete(dfu_writer.queue_handle);
+    }
+    free(dfu_writer.p_spare_buf);
+    memset(&dfu_writer, 0, sizeof(dfu_writer));
+
+    return false;
+}
+
+static void ble_dfu_writer_deinit(void)
+{
+    if (dfu_writer.task_handle == NULL)
+    {
+        return;
+    }
+
+    if (dfu_writer.busy)
+    {
+        os_sem_take(dfu_writer.sem_handle, 0xFFFFFFFF);
+    }
+
+    os_task_delete(dfu_writer.task_handle);
+    os_sem_delete(dfu_writer.sem_handle);
+    os_msg_queue_delete(dfu_writer.queue_handle);
+    free(dfu_writer.p_spare_buf);
+    memset(&dfu_writer, 0, sizeof(dfu_writer));
+}
+
+/**
+    * @brief    Hand a checked buffer to the writer task and continue receiving into the spare buffer
+    * @param    p_job     buffer to be written
+    * @return   true if the writer task took it
+    */
+static bool ble_dfu_writer_submit(T_DFU_WRITE_JOB *p_job)
+{
+    if ((dfu_writer.task_handle == NULL) ||
+        (os_msg_send(dfu_writer.queue_handle, p_job, 0) == false))
+    {
+        return false;
+    }
+
+    dfu_writer.job = *p_job;
+    dfu_writer.busy = true;
+    ota_struct.p_ota_temp_buf_head = dfu_writer.p_spare_buf;
+    dfu_writer.p_spare_buf = p_job->p_buf;
+
+    return true;
+}
+#endif
+
+/**
+    * @brief    Wait for the buffer in flight before cur_offset or the buffers are used
+    * @return   DFU_ARV_SUCCESS if it was written, else the result of
+    *           \ref ble_dfu_write_fail_handle with cur_offset rolled back for resending
+    */
+static uint8_t ble_dfu_writer_flush(void)
+{
+#if (DFU_PIPELINE_WRITE == 1)
+    if (!dfu_writer.busy)
+    {
+        return DFU_ARV_SUCCESS;
+    }
+
+    os_sem_take(dfu_writer.sem_handle, 0xFFFFFFFF);
+    dfu_writer.busy = false;
+
+    DFU_PRINT_TRACE2("ble_dfu_writer_flush: offset=0x%x, write ret %d",
+                     dfu_writer.job.cur_offset, dfu_writer.result);
+
+    if (dfu_writer.result != 0)
+    {
+        ota_struct.cur_offset = dfu_writer.job.cur_offset;
+        return ble_dfu_write_fail_handle(dfu_writer.job.conn_id);
+    }
+
+#if (DFU_JOURNAL_ENABLE == 1)
+    /* nothing is in flight, all data before cur_offset is on flash */
+    ble_dfu_journal_save(false);
+#endif
+#endif
+
+    return DFU_ARV_SUCCESS;
+}
+
+/**
+    * @brief    Get the offset in the temp bank where an image is downloaded
+    * @param    image_id    image to be downloaded
+    * @return   offset after the images already downloaded, 0 if the image has its own bank
+    */
+static uint32_t ble_dfu_get_next_subimage_offset(uint16_t image_id)
+{
+#if (SUPPORT_BL_COPY_SECURE_IMAGE == 1)
+    if (is_ota_support_bank_switch())
+    {
+        if ((image_id >= IMG_BANK_FIRST && image_id < IMG_DFU_MAX) ||
+            image_id == IMG_OTA)
+        {
+            /*only the images located in OTA Bank need set to 0 when dual bank*/
+            return 0;
+        }
+
+        /*restore next image offset*/
+        return ota_struct.tmp_next_subimage_offset;
+    }
+
+    return ota_struct.next_subimage_offset;
+#else
+    if (is_ota_support_bank_switch())
+    {
+        return 0;
+    }
+
+    if (image_id == IMG_BOOTPATCH ||
+        (image_id >= IMG_USER_DATA_FIRST && image_id < IMG_USER_DATA_MAX))
+    {
+        /*bootpatch always dual bank*/
+        return 0;
+    }
+
+    /*restore next image offset*/
+    return ota_struct.tmp_next_subimage_offset;
+#endif
+}
+
+/**
+    * @brief    Start receiving the image described by ota_struct
+    * @param    cur_offset    offset to receive from
+    * @return   void
+    */
+static void ble_dfu_start_process(uint32_t cur_offset)
+{
+    ota_struct.ota_flag.is_ota_process = true;
+    ota_struct.ota_temp_buf_used_size = 0;
+    ota_struct.cur_offset = cur_offset;
+    dfu_start_time = os_sys_time_get();
+#if (SUPPORT_NORMAL_OTA == 1)
+    if (is_normal_ota_mode)
+    {
+        uint32_t restart_ms = (ota_struct.image_total_length + 0x19000 - 1) / 0x19000 *
+                              NORMAL_OTA_TIMEOUT_TOTAL * 1000;
+        os_timer_restart(&normal_ota_total_timer_handle, restart_ms);
+        DFU_PRINT_INFO1("ble_dfu_start_process: restart total timer %d ms", restart_ms);
+    }
+#endif
+
+    uint32_t s;
+    s = os_lock();
+    fmc_flash_nor_set_bp_lv(FMC_MAIN0_ADDR, 0);
+    os_unlock(s);
+}
+
+#if (DFU_JOURNAL_ENABLE == 1)
+/**
+    * @brief    Create the journal module and load the journal saved by the last download
+    * @return   true if the journal can be used
+    */
+static bool ble_dfu_journal_load(void)
+{
+    int32_t ret;
+
+    if (dfu_journal_loaded)
+    {
+        return true;
+    }
+
+    ret = ftl_init_module(DFU_JOURNAL_NAME, sizeof(T_DFU_JOURNAL), DFU_JOURNAL_BLOCK_LEN);
+    if (ret != ESUCCESS)
+    {
+        DFU_PRINT_ERROR1("ble_dfu_journal_load: init fail %d", ret);
+        return false;
+    }
+
+    if ((ftl_load_from_module(DFU_JOURNAL_NAME, &dfu_journal, 0, sizeof(T_DFU_JOURNAL)) != ESUCCESS) ||
+        (dfu_journal.magic != DFU_JOURNAL_MAGIC))
+    {
+        memset(&dfu_journal, 0, sizeof(T_DFU_JOURNAL));
+    }
+    dfu_journal_loaded = true;
+
+    return true;
+}
+
+/**
+    * @brief    Save the download progress of the current image
+    * @param    force     save it even if less than DFU_JOURNAL_SAVE_INTERVAL was written since the last save
+    * @return   void
+    */
+static void ble_dfu_journal_save(bool force)
+{
+    uint32_t done_offset;
+    uint32_t saved_offset = 0;
+    int32_t ret;
+
+    if (!ota_struct.ota_flag.is_ota_process || (dfu_ctrl_header.image_id != ota_struct.image_id) ||
+        !ble_dfu_journal_load())
+    {
+        return;
+    }
+
+    /* a resumed download erases the sector it starts in, so only whole sectors are done */
+    done_offset = (ota_struct.next_subimage_offset + ota_struct.cur_offset) /
+                  FLASH_SECTOR_SIZE * FLASH_SECTOR_SIZE;
+    if (done_offset <= ota_struct.next_subimage_offset)
+    {
+        return;
+    }
+    done_offset -= ota_struct.next_subimage_offset;
+
+    if ((dfu_journal.magic == DFU_JOURNAL_MAGIC) &&
+        (dfu_journal.image_id == ota_struct.image_id) &&
+        (dfu_journal.next_subimage_offset == ota_struct.next_subimage_offset))
+    {
+        saved_offset = dfu_journal.cur_offset;
+    }
+
+    if ((done_offset == saved_offset) ||
+        (!force && (done_offset < saved_offset + DFU_JOURNAL_SAVE_INTERVAL)))
+    {
+        return;
+    }
+
+    memset(&dfu_journal, 0, sizeof(T_DFU_JOURNAL));
+    dfu_journal.magic = DFU_JOURNAL_MAGIC;
+    dfu_journal.image_id = ota_struct.image_id;
+    dfu_journal.image_total_length = ota_struct.image_total_length;
+    dfu_journal.next_subimage_offset = ota_struct.next_subimage_offset;
+    dfu_journal.cur_offset = done_offset;
+    dfu_journal.crc16 = dfu_ctrl_header.crc16;
+    dfu_journal.ic_type = dfu_ctrl_header.ic_type;
+    dfu_journal.secure_version = dfu_ctrl_header.secure_version;
+    dfu_image_hash_get(&dfu_journal.hash);
+
+    ret = ftl_save_to_module(DFU_JOURNAL_NAME, &dfu_journal, 0, sizeof(T_DFU_JOURNAL));
+    DFU_PRINT_TRACE3("ble_dfu_journal_save: image_id=0x%x, cur_offset=0x%x, ret %d",
+                     dfu_journal.image_id, dfu_journal.cur_offset, ret);
+    if (ret != ESUCCESS)
+    {
+        dfu_journal.magic = 0;
+    }
+}
+
+/**
+    * @brief    Drop the journal once its image is validated or abandoned
+    * @return   void
+    */
+static void ble_dfu_journal_clear(void)
+{
+    if (!ble_dfu_journal_load() || (dfu_journal.magic != DFU_JOURNAL_MAGIC))
+    {
+        return;
+    }
+
+    memset(&dfu_journal, 0, sizeof(T_DFU_JOURNAL));
+    ftl_save_to_module(DFU_JOURNAL_NAME, &dfu_journal, 0, sizeof(T_DFU_JOURNAL));
+    DFU_PRINT_TRACE0("ble_dfu_journal_clear");
+}
+
+/**
+    * @brief    Check that the journal is for the image the client reports and the build on flash,
+    *           the journal is cleared if not
+    * @param    image_id    image reported by the client
+    * @return   true if the download may continue from dfu_journal.cur_offset
+    */
+static bool ble_dfu_journal_lookup(uint16_t image_id)
+{
+    T_IMG_CTRL_HEADER_FORMAT header;
+    uint32_t header_offset = offsetof(T_IMG_HEADER_FORMAT, ctrl_header);
+    uint32_t dfu_base_addr;
+    uint32_t s;
+
+    if (!ble_dfu_journal_load() || (dfu_journal.magic != DFU_JOURNAL_MAGIC))
+    {
+        return false;
+    }
+
+    /* the images downloaded before it in the temp bank must still be there */
+    dfu_base_addr = dfu_get_temp_ota_bank_img_addr_by_img_id((IMG_ID)image_id);
+    if ((dfu_journal.image_id != image_id) || (dfu_base_addr == 0) ||
+        ((dfu_base_addr % FLASH_SECTOR_SIZE) != 0) ||
+        (dfu_journal.next_subimage_offset != ble_dfu_get_next_subimage_offset(image_id)) ||
+        (dfu_journal.cur_offset < header_offset + sizeof(T_IMG_CTRL_HEADER_FORMAT)))
+    {
+        ble_dfu_journal_clear();
+        return false;
+    }
+
+    if (image_id >= IMG_DFU_FIRST && image_id < IMG_DFU_MAX)
+    {
+        dfu_base_addr += dfu_journal.next_subimage_offset;
+    }
+
+    s = os_lock();
+    fmc_flash_nor_read(dfu_base_addr + header_offset, &header, sizeof(T_IMG_CTRL_HEADER_FORMAT));
+    os_unlock(s);
+
+    /* the data on flash must be the build the journal was saved for */
+    if ((header.image_id != image_id) || (header.crc16 != dfu_journal.crc16) ||
+        (header.ic_type != dfu_journal.ic_type) ||
+        (header.secure_version != dfu_journal.secure_version) ||
+        (header.payload_len + DEFAULT_HEADER_SIZE != dfu_journal.image_total_length))
+    {
+        DFU_PRINT_INFO2("ble_dfu_journal_lookup: image_id=0x%x, crc16=0x%x is another build",
+                        image_id, header.crc16);
+        ble_dfu_journal_clear();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+    * @brief    Restart an interrupted download from the offset reported by ble_dfu_journal_lookup
+    * @param    p_header    ctrl header of start dfu
+    * @return   true if the download is resumed from ota_struct.cur_offset
+    */
+static bool ble_dfu_journal_resume(T_IMG_CTRL_HEADER_FORMAT *p_header)
+{
+    bool reported = dfu_journal_reported;
+
+    dfu_journal_reported = false;
+
+    /* the client may start another build than the one it was told to continue */
+    if (!reported || (dfu_journal.magic != DFU_JOURNAL_MAGIC) ||
+        (p_header->image_id != dfu_journal.image_id) || (p_header->crc16 != dfu_journal.crc16) ||
+        (p_header->ic_type != dfu_journal.ic_type) ||
+        (p_header->secure_version != dfu_journal.secure_version) ||
+        (ota_struct.image_total_length != dfu_journal.image_total_length) ||
+        (ota_struct.next_subimage_offset != dfu_journal.next_subimage_offset))
+    {
+        return false;
+    }
+
+    dfu_image_hash_set(&dfu_journal.hash);
+    ble_dfu_start_process(dfu_journal.cur_offset);
+
+    DFU_PRINT_INFO3("ble_dfu_journal_resume: image_id=0x%x, cur_offset=0x%x, total length=0x%x",
+                    ota_struct.image_id, ota_struct.cur_offset, ota_struct.image_total_length);
+
+    return true;
+}
+#endif
+
 /**
     * @brief  Reset local variables
     * @return void
@@ -214,6 +802,19 @@ static bool dfu_check_section_size(void)
 static void ble_dfu_clear_local(T_OTA_CLEAR_LOCAL_CAUSE cause)
 {
     APP_PRINT_TRACE1("app_ota_clear_local cause: %d", cause);
+#if (DFU_JOURNAL_ENABLE == 1)
+    dfu_journal_reported = false;
+    if ((cause == OTA_SUCCESS_REBOOT) || (cause == OTA_RESET_CMD))
+    {
+        ble_dfu_journal_clear();
+    }
+    else if ((cause == OTA_BLE_DISC) && (ble_dfu_writer_flush() == DFU_ARV_SUCCESS))
+    {
+        /* resume from here when the client comes back */
+        ble_dfu_journal_save(true);
+    }
+    /* on a timeout only the progress saved while the data was coming in is kept */
+#endif
     temp_image_total_num = 0;
     ota_struct.image_total_length = 0;
     ota_struct.image_id = 0;
@@ -226,6 +827,10 @@ static void ble_dfu_clear_local(T_OTA_CLEAR_LOCAL_CAUSE cause)
         ota_struct.test.value = 0;
     }
 
+#if (DFU_PIPELINE_WRITE == 1)
+    ble_dfu_writer_deinit();
+#endif
+
     memset(ota_struct.bd_addr, 0, sizeof(ota_struct.bd_addr));
     if (ota_struct.force_temp_mode)
     {
@@ -266,8 +871,16 @@ static void ble_dfu_timeout_cb(void *p_xtimer)
     {
     case TIMER_ID_DFU_IMAGE_TRANS:
         {
-            os_timer_stop(&ota_struct.timer_handle_ota_transfer);
-            ble_dfu_clear_local(OTA_IMAGE_TRANS_TIMEOUT);
+            T_IO_MSG timeout_msg;
+
+            /* the writer, flash and ftl cleanup blocks, leave it to the task of the service */
+            dfu_trans_timeout_pending = true;
+            timeout_msg.type = IO_MSG_TYPE_DFU;
+            timeout_msg.subtype = TIMER_ID_DFU_IMAGE_TRANS;
+            if ((dfu_send_msg == NULL) || !dfu_send_msg(&timeout_msg))
+            {
+                DFU_PRINT_WARN0("ble_dfu_timeout_cb: cleanup at the next request");
+            }
         }
         break;
     default:
@@ -275,6 +888,19 @@ static void ble_dfu_timeout_cb(void *p_xtimer)
     }
 }
 
+/**
+    * @brief  Clean up an image transfer that timed out, in the task of the service
+    * @return void
+    */
+static void ble_dfu_handle_trans_timeout(void)
+{
+    if (dfu_trans_timeout_pending)
+    {
+        dfu_trans_timeout_pending = false;
+        ble_dfu_clear_local(OTA_IMAGE_TRANS_TIMEOUT);
+    }
+}
+
 static bool dfu_get_enc_setting(void)
 {
     if (ENABLE_OTA_AES)
@@ -323,41 +949,7 @@ static uint8_t ble_dfu_cp_start_dfu_handle(uint8_t *p_data) //0x01
                      ota_struct.image_total_length
                     );
 
-#if (SUPPORT_BL_COPY_SECURE_IMAGE == 1)
-    if (is_ota_support_bank_switch())
-    {
-        if ((ota_struct.image_id >= IMG_BANK_FIRST && ota_struct.image_id < IMG_DFU_MAX) ||
-            ota_struct.image_id == IMG_OTA)
-        {
-            /*only the images located in OTA Bank need set to 0 when dual bank*/
-            ota_struct.next_subimage_offset = 0;
-        }
-        else
-        {
-            /*restore next image offset*/
-            ota_struct.next_subimage_offset = ota_struct.tmp_next_subimage_offset;
-        }
-    }
-#else
-    if (is_ota_support_bank_switch())
-    {
-        ota_struct.next_subimage_offset = 0;
-    }
-    else
-    {
-        if (ota_struct.image_id == IMG_BOOTPATCH ||
-            (ota_struct.image_id >= IMG_USER_DATA_FIRST && ota_struct.image_id < IMG_USER_DATA_MAX))
-        {
-            /*bootpatch always dual bank*/
-            ota_struct.next_subimage_offset = 0;
-        }
-        else
-        {
-            /*restore next image offset*/
-            ota_struct.next_subimage_offset = ota_struct.tmp_next_subimage_offset;
-        }
-    }
-#endif
+    ota_struct.next_subimage_offset = ble_dfu_get_next_subimage_offset(ota_struct.image_id);
 
     if (dfu_check_section_size() == false)
     {
@@ -380,23 +972,18 @@ static uint8_t ble_dfu_cp_start_dfu_handle(uint8_t *p_data) //0x01
         return results;
     }
 
-    ota_struct.ota_flag.is_ota_process = true;
-    ota_struct.ota_temp_buf_used_size = 0;
-    ota_struct.cur_offset = 0;
-#if (SUPPORT_NORMAL_OTA == 1)
-    if (is_normal_ota_mode)
+#if (DFU_JOURNAL_ENABLE == 1)
+    dfu_ctrl_header = *start_dfu_para;
+    if (ble_dfu_journal_resume(start_dfu_para))
     {
-        uint32_t restart_ms = (ota_struct.image_total_length + 0x19000 - 1) / 0x19000 *
-                              NORMAL_OTA_TIMEOUT_TOTAL * 1000;
-        os_timer_restart(&normal_ota_total_timer_handle, restart_ms);
-        DFU_PRINT_INFO1("ble_dfu_cp_start_dfu_handle: restart total timer %d ms", restart_ms);
+        return results;
     }
+
+    /* the image is restarted from offset 0, a journal left for it is stale */
+    ble_dfu_journal_clear();
 #endif
 
-    uint32_t s;
-    s = os_lock();
-    fmc_flash_nor_set_bp_lv(FMC_MAIN0_ADDR, 0);
-    os_unlock(s);
+    ble_dfu_start_process(0);
 
     return results;
 }
@@ -427,6 +1014,12 @@ static uint8_t ble_dfu_cp_valid_handle(uint8_t *p_data) //0x03
         return results;
     }
 
+    if (ble_dfu_writer_flush() != DFU_ARV_SUCCESS)
+    {
+        results = DFU_ARV_FAIL_FLASH_WRITE_ERROR;
+        return results;
+    }
+
     LE_ARRAY_TO_UINT16(image_id, p_data);
     LE_ARRAY_TO_UINT8(ota_struct.is_last_image, p_data + 2);
     DFU_PRINT_TRACE3("==>ble_dfu_cp_valid_handle: img_id=0x%x, ota_struct.image_id=0x%x, is_last_image=%d",
@@ -434,9 +1027,17 @@ static uint8_t ble_dfu_cp_valid_handle(uint8_t *p_data) //0x03
 
     if (image_id == ota_struct.image_id)
     {
+#if (DFU_JOURNAL_ENABLE == 1)
+        /* a failed image is downloaded again from offset 0, a validated one is done */
+        ble_dfu_journal_clear();
+#endif
         if (!dfu_checksum((IMG_ID)image_id, ota_struct.next_subimage_offset))
         {
             results = DFU_ARV_FAIL_CRC_ERROR;
+            /* the image must be started again, nothing may resume or journal it */
+            ota_struct.ota_flag.is_ota_process = false;
+            ota_struct.cur_offset = 0;
+            ota_struct.ota_temp_buf_used_size = 0;
         }
         else
         {
@@ -489,6 +1090,29 @@ static uint8_t ble_dfu_cp_valid_handle(uint8_t *p_data) //0x03
     return results;
 }
 
+/**
+    * @brief    Trace the effective throughput of the image just validated
+    * @param    conn_id     ID to identify the connection
+    * @return   void
+    */
+static void ble_dfu_report_throughput(uint8_t conn_id)
+{
+    uint16_t mtu_size = 0;
+    uint16_t conn_interval = 0;
+    uint32_t elapsed_ms = (uint32_t)(os_sys_time_get() - dfu_start_time);
+    uint32_t bytes_per_sec = 0;
+
+    if (elapsed_ms != 0)
+    {
+        bytes_per_sec = (uint32_t)((uint64_t)ota_struct.image_total_length * 1000 / elapsed_ms);
+    }
+
+    le_get_conn_param(GAP_PARAM_CONN_MTU_SIZE, &mtu_size, conn_id);
+    le_get_conn_param(GAP_PARAM_CONN_INTERVAL, &conn_interval, conn_id);
+    DFU_PRINT_INFO5("ble_dfu_report_throughput: length=%d, time=%dms, %dB/s, mtu_size=%d, conn_interval=%d",
+                    ota_struct.image_total_length, elapsed_ms, bytes_per_sec, mtu_size, conn_interval);
+}
+
 static void ble_dfu_bootpatch_always_bank_switch(void)
 {
     if (ota_struct.test.t_stress_test && GET_VALID_BITMAP(IMG_BOOTPATCH))
@@ -638,6 +1262,9 @@ static void ble_dfu_cp_report_img_info_handle(uint8_t *p_data, uint8_t *p_notify
         return;
     }
 
+    /* a failed buffer in flight rolls back the cur_offset reported below */
+    ble_dfu_writer_flush();
+
     LE_ARRAY_TO_UINT16(image_id, p_data);
     DFU_PRINT_TRACE2("ble_dfu_cp_report_img_info_handle: received img_id 0x%x, ota_struct.image_id=0x%x",
                      image_id, ota_struct.image_id);
@@ -646,6 +1273,15 @@ static void ble_dfu_cp_report_img_info_handle(uint8_t *p_data, uint8_t *p_notify
     {
         ota_struct.cur_offset = 0;
         ota_struct.ota_temp_buf_used_size = 0;
+#if (DFU_JOURNAL_ENABLE == 1)
+        /* the client sends start dfu and then the data from the reported cur_offset */
+        dfu_journal_reported = !ota_struct.ota_flag.is_ota_process &&
+                               ble_dfu_journal_lookup(image_id);
+        if (dfu_journal_reported)
+        {
+            ota_struct.cur_offset = dfu_journal.cur_offset;
+        }
+#endif
         ota_struct.image_id = image_id;
     }
 
@@ -764,6 +1400,12 @@ static void ble_dfu_cp_buffer_check_en_handle(uint8_t *p_notify_data,
     {
         ota_struct.ota_flag.buffer_check_en = false;
     }
+#if (DFU_PIPELINE_WRITE == 1)
+    else
+    {
+        ble_dfu_writer_init(ota_struct.buffer_size);
+    }
+#endif
     p_notify_data[0] = ota_struct.ota_flag.buffer_check_en;
     LE_UINT16_TO_ARRAY(&p_notify_data[1], ota_struct.buffer_size);
     //LE_UINT16_TO_ARRAY(&p_notify_data[3], ota_struct.mtu_size);  //ota version =4, is rsvd val
@@ -783,11 +1425,6 @@ static void ble_dfu_cp_buffer_check_handle(uint8_t conn_id, uint8_t *p_data, uin
     uint16_t data_size;
     uint16_t crc;
 
-    T_DFU_CALLBACK_DATA callback_data;
-    callback_data.conn_id = conn_id;
-    callback_data.msg_type = SERVICE_CALLBACK_TYPE_WRITE_CHAR_VALUE;
-    callback_data.msg_data.write.write_attrib_index = INDEX_DFU_CHAR_DFU_CONTROL_POINT_INDEX;
-
     if ((p_data == NULL) || (ota_struct.ota_flag.is_ota_process == false))
     {
         ota_struct.ota_temp_buf_used_size = 0;
@@ -821,98 +1458,82 @@ static void ble_dfu_cp_buffer_check_handle(uint8_t conn_id, uint8_t *p_data, uin
     }
     else
     {
+        T_DFU_WRITE_JOB job;
+        uint8_t result;
+        bool app_notified = false;
+
         DFU_PRINT_TRACE1("ble_dfu_cp_buffer_check_handle: write flash, offset=0x%x", ota_struct.cur_offset);
-        if (dfu_get_enc_setting())
+
+        /* the previous buffer must be on flash before this one is acknowledged */
+        result = ble_dfu_writer_flush();
+        if (result != DFU_ARV_SUCCESS)
         {
-            uint16_t offset = 0;
-            while ((ota_struct.ota_temp_buf_used_size - offset) >= 16)
+            ota_struct.ota_temp_buf_used_size = 0;
+            if (result != DFU_ARV_FAIL_OPERATION)
             {
-                dfu_aes256_decrypt_16byte(ota_struct.p_ota_temp_buf_head + offset);
-                offset += 16;
+                data[0] = result;
+                LE_UINT32_TO_ARRAY(&data[1], ota_struct.cur_offset);
             }
+            return;
         }
 
-        uint32_t flash_write_result = dfu_write_data_to_flash(ota_struct.image_id,
-                                                              ota_struct.cur_offset,
-                                                              ota_struct.next_subimage_offset,
-                                                              ota_struct.ota_temp_buf_used_size + ota_struct.buffer_check_offset,
-                                                              ota_struct.p_ota_temp_buf_head);
-
-        DFU_PRINT_TRACE1("ble_dfu_cp_buffer_check_handle: write ret %d", flash_write_result);
-
-        if (flash_write_result == 0)
+        job.p_buf = ota_struct.p_ota_temp_buf_head;
+        job.cur_offset = ota_struct.cur_offset;
+        job.next_subimage_offset = ota_struct.next_subimage_offset;
+        job.image_id = ota_struct.image_id;
+        job.data_size = ota_struct.ota_temp_buf_used_size;
+        job.write_size = ota_struct.ota_temp_buf_used_size + ota_struct.buffer_check_offset;
+        job.conn_id = conn_id;
+
+#if (DFU_PIPELINE_WRITE == 1)
+        /* the application accepts the buffer before the client is acknowledged */
+        if (dfu_writer.task_handle != NULL)
         {
-            uint32_t updated_success_len = ota_struct.ota_temp_buf_used_size;
-            callback_data.msg_data.write.opcode = DFU_WRITE_DOING;
-            callback_data.msg_data.write.length = 4;
-            callback_data.msg_data.write.p_value = (uint8_t *)&updated_success_len;
-            if (p_dfu_extended_cb)
+            if (!ble_dfu_write_doing_notify(conn_id, job.data_size))
             {
-                T_APP_RESULT cause = p_dfu_extended_cb(dfu_srv_id_local, (void *)&callback_data);
-                if (cause != APP_RESULT_SUCCESS)
-                {
-                    return;
-                }
+                ota_struct.ota_temp_buf_used_size = 0;
+                return;
             }
+            app_notified = true;
+        }
 
+        if (ble_dfu_writer_submit(&job))
+        {
+            /* write failure is reported on the next buffer check with the offset to resend */
             ota_struct.cur_offset += ota_struct.ota_temp_buf_used_size;
             ota_struct.ota_temp_buf_used_size = 0;
             ota_struct.buffer_check_offset = 0;
             data[0] = DFU_ARV_SUCCESS;
             LE_UINT32_TO_ARRAY(&data[1], ota_struct.cur_offset);
+            return;
         }
-        else
-        {
-            uint32_t erase_time = 0;
-            uint32_t resend_offset = (ota_struct.next_subimage_offset + ota_struct.cur_offset) /
-                                     FLASH_SECTOR_SIZE * FLASH_SECTOR_SIZE;
+#endif
 
-            if (resend_offset < ota_struct.next_subimage_offset)
-            {
-                ota_struct.ota_temp_buf_used_size = 0;
-                data[0] = DFU_ARV_FAIL_FLASH_ERASE_ERROR;
-                LE_UINT32_TO_ARRAY(&data[1], ota_struct.cur_offset);
-                return;
-            }
+        uint32_t flash_write_result = ble_dfu_buffer_write(&job);
 
-            ota_struct.cur_offset = resend_offset - ota_struct.next_subimage_offset;
-            DFU_PRINT_TRACE3("ble_dfu_cp_buffer_check_handle: write fail! cur_offset=0x%x, resend_offset=0x%x, next_subimage_offset=0x%x",
-                             ota_struct.cur_offset, resend_offset, ota_struct.next_subimage_offset);
+        DFU_PRINT_TRACE1("ble_dfu_cp_buffer_check_handle: write ret %d", flash_write_result);
 
-            while (erase_time < 3)
+        if (flash_write_result == 0)
+        {
+            if (!app_notified && !ble_dfu_write_doing_notify(conn_id, ota_struct.ota_temp_buf_used_size))
             {
-                if (dfu_flash_erase((IMG_ID)ota_struct.image_id, resend_offset) == true)
-                {
-                    ota_struct.ota_temp_buf_used_size = 0;
-                    data[0] = DFU_ARV_FAIL_FLASH_WRITE_ERROR;
-                    LE_UINT32_TO_ARRAY(&data[1], ota_struct.cur_offset);
-                    break;
-                }
-                else
-                {
-                    erase_time++;
-                }
+                return;
             }
-            if (erase_time >= 3)
-            {
-                ota_struct.ota_temp_buf_used_size = 0;
-                data[0] = DFU_ARV_FAIL_FLASH_ERASE_ERROR;
-                LE_UINT32_TO_ARRAY(&data[1], ota_struct.cur_offset);
-                DFU_PRINT_ERROR0("ble_dfu_cp_buffer_check_handle: erase fail more than three times!");
 
-                T_DFU_FAIL_REASON dfu_fail_reason = DFU_FAIL_UPDATE_FLASH;
-                callback_data.msg_data.write.opcode = DFU_WRITE_FAIL;
-                callback_data.msg_data.write.length = sizeof(T_DFU_FAIL_REASON);
-                callback_data.msg_data.write.p_value = (uint8_t *)&dfu_fail_reason;
-                if (p_dfu_extended_cb)
-                {
-                    T_APP_RESULT cause = p_dfu_extended_cb(dfu_srv_id_local, (void *)&callback_data);
-                    if (cause != APP_RESULT_SUCCESS)
-                    {
-                        return;
-                    }
-                }
-            }
+            ota_struct.cur_offset += ota_struct.ota_temp_buf_used_size;
+            ota_struct.ota_temp_buf_used_size = 0;
+            ota_struct.buffer_check_offset = 0;
+            data[0] = DFU_ARV_SUCCESS;
+            LE_UINT32_TO_ARRAY(&data[1], ota_struct.cur_offset);
+#if (DFU_JOURNAL_ENABLE == 1)
+            ble_dfu_journal_save(false);
+#endif
+        }
+        else
+        {
+            ota_struct.ota_temp_buf_used_size = 0;
+            data[0] = ble_dfu_write_fail_handle(conn_id);
+            LE_UINT32_TO_ARRAY(&data[1], ota_struct.cur_offset);
         }
     }
 }
@@ -938,6 +1559,12 @@ static uint8_t ble_dfu_cp_copy_img_handle(uint8_t *p_data) //0x0c
 
     ota_struct.ota_flag.skip_flag = 1;
 
+    if (ble_dfu_writer_flush() != DFU_ARV_SUCCESS)
+    {
+        ret = DFU_ARV_FAIL_FLASH_WRITE_ERROR;
+        return ret;
+    }
+
     if (ota_struct.test.t_copy_fail)
     {
         ota_struct.test.t_copy_fail = 0;
@@ -1373,6 +2000,31 @@ bool ble_dfu_get_ota_status(void)
     return ota_struct.ota_flag.is_ota_process;
 }
 
+/**
+ * @brief    Register the function that sends DFU messages to the task of the DFU service.
+ * @param    p_func      Function to send the message.
+ */
+void ble_dfu_register_send_msg(P_FUN_DFU_SEND_MSG p_func)
+{
+    dfu_send_msg = p_func;
+}
+
+/**
+ * @brief    Handle an IO_MSG_TYPE_DFU message in the task of the DFU service.
+ * @param    p_msg       Message posted by the DFU transport.
+ */
+void ble_dfu_handle_io_msg(T_IO_MSG *p_msg)
+{
+    switch (p_msg->subtype)
+    {
+    case TIMER_ID_DFU_IMAGE_TRANS:
+        ble_dfu_handle_trans_timeout();
+        break;
+    default:
+        break;
+    }
+}
+
 /**
  * @brief    Notify about connection parameter update request during DFU.
  * @param    conn_id     Identifier for the connection.
@@ -1430,6 +2082,8 @@ T_APP_RESULT ble_dfu_service_handle_cp_req(uint8_t conn_id, uint16_t length, uin
 
     DFU_PRINT_INFO2("===>ble_dfu_service_handle_cp_req: opcode=0x%x, length=%d", opcode, length);
 
+    ble_dfu_handle_trans_timeout();
+
     if (opcode > DFU_OPCODE_MIN && opcode <= DFU_OPCODE_TEST_EN
         && ota_struct.ota_flag.is_ota_process)
     {
@@ -1480,6 +2134,7 @@ T_APP_RESULT ble_dfu_service_handle_cp_req(uint8_t conn_id, uint16_t length, uin
                 cause = APP_RESULT_SUCCESS;
                 if (image_id == ota_struct.image_id)
                 {
+                    ble_dfu_writer_flush();
                     LE_ARRAY_TO_UINT32(ota_struct.cur_offset, p + 2);
                     DFU_PRINT_TRACE2("===>ble_dfu_service_handle_cp_req: image_id=0x%x, cur_offset=%d",
                                      image_id, ota_struct.cur_offset);
@@ -1497,6 +2152,10 @@ T_APP_RESULT ble_dfu_service_handle_cp_req(uint8_t conn_id, uint16_t length, uin
             {
                 cause = APP_RESULT_SUCCESS;
                 results = ble_dfu_cp_valid_handle(p);
+                if (results == DFU_ARV_SUCCESS)
+                {
+                    ble_dfu_report_throughput(conn_id);
+                }
                 ble_dfu_service_prepare_send_notify(conn_id, DFU_OPCODE_VALID_FW, sizeof(results), &results);
             }
             else
@@ -1717,6 +2376,7 @@ T_APP_RESULT ble_dfu_service_handle_packet(uint8_t conn_id, uint16_t length, uin
 {
     uint8_t result;
 
+    ble_dfu_handle_trans_timeout();
     result = ble_dfu_packet_handle(p_value, length);
 
     if (result == DFU_ARV_FAIL_INVALID_PARAMETER)
@@ -13,6 +13,7 @@
 #include "gap.h"
 #include "profile_server.h"
 #include "patch_header_check.h"
+#include "app_msg.h"
 
 
 /** @defgroup  BLE_DFU_TRANSPORT BLE DFU Transport
@@ -245,6 +246,9 @@ typedef enum
     TIMER_ID_DFU_IMAGE_TRANS,
 } T_OTA_TIMER_ID;
 
+/** @brief  Send a message to the task that handles the DFU service, used from the timer context */
+typedef bool (*P_FUN_DFU_SEND_MSG)(T_IO_MSG *p_msg);
+
 /** @brief  OTA flag */
 typedef union
 {
@@ -414,6 +418,21 @@ void ble_dfu_get_section_size(uint8_t *p_data);
  */
 bool ble_dfu_get_ota_status(void);
 
+/**
+ * @brief    Register the function that sends DFU messages to the task of the DFU service.
+ * @note     The timeout of the image transfer is posted as an @ref IO_MSG_TYPE_DFU message
+ *           and cleaned up in that task by @ref ble_dfu_handle_io_msg. Without a sender
+ *           the cleanup is done at the next request of the client.
+ * @param[in]     p_func      Function to send the message.
+ */
+void ble_dfu_register_send_msg(P_FUN_DFU_SEND_MSG p_func);
+
+/**
+ * @brief    Handle an @ref IO_MSG_TYPE_DFU message in the task of the DFU service.
+ * @param[in]     p_msg       Message posted by the DFU transport.
+ */
+void ble_dfu_handle_io_msg(T_IO_MSG *p_msg);
+
 /**
  * @brief    Notify about connection parameter update request during DFU.
  * @param[in]     conn_id     Identifier for the connection.
@@ -72,6 +72,11 @@ void dfu_handle_io_msg(T_IO_MSG io_msg)
             dfu_periph_handle_gap_msg(&io_msg);
         }
         break;
+    case IO_MSG_TYPE_DFU:
+        {
+            ble_dfu_handle_io_msg(&io_msg);
+        }
+        break;
     default:
         break;
     }
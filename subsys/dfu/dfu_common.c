@@ -39,6 +39,22 @@ PLATFORM_STATIC_ASSERT((IMG_DFU_MAX - IMG_DFU_FIRST + 1) < (sizeof(valid_bitmap)
 
 uint32_t user_data_valid_bitmap = 0;
 
+static bool dfu_flash_nor_erase(uint32_t addr);
+static bool dfu_flash_nor_write(uint32_t addr, void *p_data, uint32_t len);
+static bool dfu_flash_nor_verify(uint32_t addr, const void *p_data, uint32_t len);
+
+static const T_DFU_FLASH_OPS dfu_flash_nor_ops =
+{
+    .erase = dfu_flash_nor_erase,
+    .write = dfu_flash_nor_write,
+    .verify = dfu_flash_nor_verify,
+};
+
+static const T_DFU_FLASH_OPS *p_dfu_flash_ops = &dfu_flash_nor_ops;
+
+/* hash of the image being downloaded, so dfu_checksum needn't read it back */
+static T_DFU_IMAGE_HASH dfu_image_hash;
+
 /*============================================================================*
  *                              Private Functions
  *============================================================================*/
@@ -72,6 +88,158 @@ static void aes256_key_swap(uint8_t key[32])
     memcpy(key + 16, tmp, 16);
 }
 
+static bool dfu_flash_nor_erase(uint32_t addr)
+{
+    bool ret;
+    uint32_t s;
+
+    s = os_lock();
+    ret = fmc_flash_nor_erase(addr, FMC_FLASH_NOR_ERASE_SECTOR);
+    os_unlock(s);
+
+    return ret;
+}
+
+static bool dfu_flash_nor_write(uint32_t addr, void *p_data, uint32_t len)
+{
+    bool ret;
+    uint32_t s;
+
+    s = os_lock();
+    ret = fmc_flash_nor_write(addr, p_data, len);
+    os_unlock(s);
+
+    return ret;
+}
+
+static bool dfu_flash_nor_verify(uint32_t addr, const void *p_data, uint32_t len)
+{
+    uint8_t readback_buffer[READ_BACK_BUFFER_SIZE];
+    const uint8_t *p_src = (const uint8_t *)p_data;
+    uint32_t read_back_len;
+    uint32_t s;
+
+    while (len)
+    {
+        read_back_len = (len >= READ_BACK_BUFFER_SIZE) ? READ_BACK_BUFFER_SIZE : len;
+        s = os_lock();
+        fmc_flash_nor_read(addr, readback_buffer, read_back_len);
+        os_unlock(s);
+        if (memcmp(readback_buffer, p_src, read_back_len) != 0)
+        {
+            return false;
+        }
+
+        addr += read_back_len;
+        p_src += read_back_len;
+        len -= read_back_len;
+    }
+
+    return true;
+}
+
+/**
+ * @brief      Add the bytes just written to the image hash
+ * @param[in]  image_id      The identifier of the image.
+ * @param[in]  offset        Offset of the data in the image.
+ * @param[in]  total_offset  Offset of the image in OTA TEMP area.
+ * @param[in]  p_data        The data written.
+ * @param[in]  length        Length of the data.
+ */
+static void dfu_image_hash_update(uint16_t image_id, uint32_t offset, uint32_t total_offset,
+                                  uint8_t *p_data, uint32_t length)
+{
+    uint32_t not_ready_offset = offsetof(T_IMG_HEADER_FORMAT, ctrl_header) +
+                                offsetof(T_IMG_CTRL_HEADER_FORMAT, ctrl_flag);
+    uint32_t end = offset + length;
+    uint32_t pos;
+    uint8_t ctrl_flag;
+
+    if (offset == 0)
+    {
+        memset(&dfu_image_hash, 0, sizeof(dfu_image_hash));
+        dfu_image_hash.image_id = image_id;
+        dfu_image_hash.total_offset = total_offset;
+        /* the image hash starts from the control header */
+        dfu_image_hash.hashed_offset = offsetof(T_IMG_HEADER_FORMAT, ctrl_header);
+        dfu_image_hash.valid = true;
+        hw_sha256_init();
+        hw_sha256_start(&dfu_image_hash.ctx, NULL);
+    }
+
+    if (!dfu_image_hash.valid)
+    {
+        return;
+    }
+
+    if ((dfu_image_hash.image_id != image_id) || (dfu_image_hash.total_offset != total_offset) ||
+        (offset > dfu_image_hash.hashed_offset))
+    {
+        /* data skipped, dfu_checksum reads the image back instead */
+        dfu_image_hash.valid = false;
+        return;
+    }
+
+    /* resent data before hashed_offset is already hashed */
+    pos = dfu_image_hash.hashed_offset;
+    if (end <= pos)
+    {
+        return;
+    }
+
+    if (pos <= not_ready_offset && not_ready_offset < end)
+    {
+        /* the image hash is calculated with not_ready cleared */
+        if (not_ready_offset > pos)
+        {
+            hw_sha256_cpu_update(&dfu_image_hash.ctx, p_data + (pos - offset), not_ready_offset - pos);
+        }
+        ctrl_flag = p_data[not_ready_offset - offset] & ~BIT7;
+        hw_sha256_cpu_update(&dfu_image_hash.ctx, &ctrl_flag, 1);
+        pos = not_ready_offset + 1;
+    }
+
+    if (end > pos)
+    {
+        hw_sha256_cpu_update(&dfu_image_hash.ctx, p_data + (pos - offset), end - pos);
+    }
+    dfu_image_hash.hashed_offset = end;
+}
+
+/**
+ * @brief      Check the image hash accumulated while the image was written
+ * @param[in]  image_id      The identifier of the image.
+ * @param[in]  total_offset  Offset of the image in OTA TEMP area.
+ * @param[in]  p_header      pointer to dfu check image header
+ * @param[in]  image_len     Length of the image including the header.
+ * @return     Check result
+ * @retval     true check pass
+ * @retval     false check fail or the image was not hashed completely
+ */
+static bool dfu_image_hash_check(IMG_ID image_id, uint32_t total_offset,
+                                 T_IMG_HEADER_FORMAT *p_header, uint32_t image_len)
+{
+    HW_SHA256_CTX ctx;
+    uint32_t sha256sum[SHA256_LENGTH / 4] = {0};
+    uint8_t sha256img[SHA256_LENGTH] = {0};
+    uint32_t s;
+
+    if (!dfu_image_hash.valid || (dfu_image_hash.image_id != image_id) ||
+        (dfu_image_hash.total_offset != total_offset) || (dfu_image_hash.hashed_offset != image_len))
+    {
+        return false;
+    }
+
+    /* finish a copy so the image can be checked again */
+    memcpy(&ctx, &dfu_image_hash.ctx, sizeof(ctx));
+    hw_sha256_finish(&ctx, sha256sum);
+    s = os_lock();
+    fmc_flash_nor_read((uint32_t)&p_header->auth.image_hash, sha256img, SHA256_LENGTH);
+    os_unlock(s);
+
+    return (memcmp(sha256img, sha256sum, SHA256_LENGTH) == 0);
+}
+
 /**
  * @brief      Check image sha256
  * @param[in]  p_header   pointer to dfu check image header
@@ -427,7 +595,7 @@ uint32_t dfu_flash_erase(IMG_ID image_id, uint32_t offset)
         return __LINE__;
     }
 
-    result = fmc_flash_nor_erase(dfu_base_addr + offset, FMC_FLASH_NOR_ERASE_SECTOR);
+    result = p_dfu_flash_ops->erase(dfu_base_addr + offset);
 
     DFU_PRINT_TRACE1("<==dfu_flash_erase: result=%d", result);
 
@@ -447,12 +615,8 @@ uint32_t dfu_write_data_to_flash(uint16_t image_id, uint32_t offset, uint32_t to
 {
     uint32_t ret = 0;
     uint32_t dfu_base_addr;
-    uint8_t readback_buffer[READ_BACK_BUFFER_SIZE];
-    uint32_t read_back_len;
     uint32_t dest_addr;
     uint8_t *p_src = (uint8_t *)p_void;
-    uint32_t remain_size = length;
-    uint32_t s;
 
     DFU_PRINT_TRACE3("==>dfu_write_data_to_flash: total_offset=0x%x, offset=%d, length=%d",
                      total_offset, offset, length);
@@ -491,9 +655,7 @@ uint32_t dfu_write_data_to_flash(uint16_t image_id, uint32_t offset, uint32_t to
                      dest_addr);
     if ((dest_addr % FLASH_SECTOR_SIZE) == 0)
     {
-        s = os_lock();
-        fmc_flash_nor_erase(dest_addr, FMC_FLASH_NOR_ERASE_SECTOR);
-        os_unlock(s);
+        p_dfu_flash_ops->erase(dest_addr);
     }
     else
     {
@@ -501,42 +663,63 @@ uint32_t dfu_write_data_to_flash(uint16_t image_id, uint32_t offset, uint32_t to
         {
             if ((dest_addr + length) % FLASH_SECTOR_SIZE)
             {
-                s = os_lock();
-                fmc_flash_nor_erase((dest_addr + length) & ~(FLASH_SECTOR_SIZE - 1),
-                                    FMC_FLASH_NOR_ERASE_SECTOR);
-                os_unlock(s);
+                p_dfu_flash_ops->erase((dest_addr + length) & ~(FLASH_SECTOR_SIZE - 1));
             }
         }
     }
 
-    s = os_lock();
-    fmc_flash_nor_write(dest_addr, p_void, length);
-    os_unlock(s);
-
-    SCB_InvalidateDCache_by_Addr((uint32_t *)dest_addr, length);
-
-    while (remain_size)
+    if (!p_dfu_flash_ops->write(dest_addr, p_void, length) ||
+        !p_dfu_flash_ops->verify(dest_addr, p_src, length))
     {
-        read_back_len = (remain_size >= READ_BACK_BUFFER_SIZE) ? READ_BACK_BUFFER_SIZE : remain_size;
-        s = os_lock();
-        fmc_flash_nor_read(dest_addr, readback_buffer, read_back_len);
-        os_unlock(s);
-        if (memcmp(readback_buffer, p_src, read_back_len) != 0)
-        {
-            ret = __LINE__;
-            goto L_EXIT;
-        }
-
-        dest_addr += read_back_len;
-        p_src += read_back_len;
-        remain_size -= read_back_len;
+        ret = __LINE__;
+        goto L_EXIT;
     }
 
+    dfu_image_hash_update(image_id, offset, total_offset, p_src, length);
+
 L_EXIT:
     DFU_PRINT_TRACE1("<==dfu_write_data_to_flash: ret=%d", ret);
     return ret;
 }
 
+/**
+ * @brief    Replace the flash operations used to write DFU images.
+ * @param    p_ops     The flash operations, NULL to restore the internal flash operations.
+ */
+void dfu_flash_ops_register(const T_DFU_FLASH_OPS *p_ops)
+{
+    p_dfu_flash_ops = (p_ops != NULL) ? p_ops : &dfu_flash_nor_ops;
+}
+
+/**
+ * @brief    Get the image hash accumulated while the image is written.
+ * @param    p_hash    The image hash state.
+ */
+void dfu_image_hash_get(T_DFU_IMAGE_HASH *p_hash)
+{
+    if (p_hash != NULL)
+    {
+        memcpy(p_hash, &dfu_image_hash, sizeof(dfu_image_hash));
+    }
+}
+
+/**
+ * @brief    Restore the image hash before resuming a download.
+ * @param    p_hash    The image hash state, NULL to drop it.
+ */
+void dfu_image_hash_set(const T_DFU_IMAGE_HASH *p_hash)
+{
+    if (p_hash != NULL)
+    {
+        memcpy(&dfu_image_hash, p_hash, sizeof(dfu_image_hash));
+        hw_sha256_init();
+    }
+    else
+    {
+        memset(&dfu_image_hash, 0, sizeof(dfu_image_hash));
+    }
+}
+
 /**
  * @brief    Validate the integrity of a specified image.
  * @param    image_id   The identifier of the image.
@@ -567,6 +750,12 @@ bool dfu_checksum(IMG_ID img_id, uint32_t offset)
                        &image_total_length, 4);
     image_total_length += sizeof(T_IMG_HEADER_FORMAT);
 
+    if (dfu_image_hash_check(img_id, offset, (T_IMG_HEADER_FORMAT *)base_addr, image_total_length))
+    {
+        DFU_PRINT_TRACE1("<==dfu_checksum: hashed while written, base_addr=0x%x", base_addr);
+        return true;
+    }
+
     /*store wdg config and check wdg enable*/
     bool wdt_en = WDT_IsEnable();
     WDTMode_TypeDef wdt_mode = WDT_GetMode();
@@ -10,6 +10,7 @@
 #ifndef _DFU_COMMON_H_
 #define _DFU_COMMON_H_
 
+#include "crypto_engine_nsc.h"
 #include "patch_header_check.h"
 #include "rtl876x.h"
 #include "wdt.h"
@@ -90,6 +91,25 @@ typedef enum
     USER_DATA_TYPE_ERROR,
 } T_USER_DATA_ERROR_TYPE;
 
+/** @brief  Flash operations used to write DFU images, addresses are absolute. */
+typedef struct
+{
+    bool (*erase)(uint32_t addr);                                       /**< Erase the sector at addr. */
+    bool (*write)(uint32_t addr, void *p_data, uint32_t len);           /**< Program len bytes at addr. */
+    bool (*verify)(uint32_t addr, const void *p_data, uint32_t len);    /**< Check the programmed bytes. */
+} T_DFU_FLASH_OPS;
+
+/** @brief  SHA-256 of an image accumulated while it is written to flash. */
+typedef struct
+{
+    HW_SHA256_CTX ctx;              /**< Hash state of the bytes before hashed_offset. */
+    uint32_t total_offset;          /**< Offset of the image in OTA TEMP area. */
+    uint32_t hashed_offset;         /**< Image offset up to which the image is hashed. */
+    uint16_t image_id;              /**< The identifier of the image. */
+    uint8_t valid;                  /**< The image was written contiguously since offset 0. */
+    uint8_t rsvd;
+} T_DFU_IMAGE_HASH;
+
 /** End of DFU_COMMON_Exported_Types
   * @}
   */
@@ -195,6 +215,25 @@ uint32_t dfu_flash_erase(IMG_ID image_id, uint32_t offset);
 uint32_t dfu_write_data_to_flash(uint16_t image_id, uint32_t offset, uint32_t total_offset,
                                  uint32_t length, void *p_void);
 
+/**
+ * @brief    Replace the flash operations used by \ref dfu_write_data_to_flash and \ref dfu_flash_erase.
+ * @param[in]    p_ops     The flash operations, NULL to restore the internal flash operations.
+ */
+void dfu_flash_ops_register(const T_DFU_FLASH_OPS *p_ops);
+
+/**
+ * @brief    Get the image hash accumulated by \ref dfu_write_data_to_flash, to be saved with the
+ *           download progress.
+ * @param[out]   p_hash    The image hash state.
+ */
+void dfu_image_hash_get(T_DFU_IMAGE_HASH *p_hash);
+
+/**
+ * @brief    Restore the image hash saved by \ref dfu_image_hash_get before resuming a download.
+ * @param[in]    p_hash    The image hash state, NULL to drop it.
+ */
+void dfu_image_hash_set(const T_DFU_IMAGE_HASH *p_hash);
+
 /**
  * @brief    Validate the integrity of a specified image.
  * @param[in]    image_id   The identifier of the image.
@@ -13,6 +13,7 @@
 #include "dfu_main.h"
 #include "dfu_task.h"
 #include "dfu_app.h"
+#include "ble_dfu_transport.h"
 #include "fmc_api.h"
 #include "fmc_platform.h"
 #include "gap.h"
@@ -168,6 +169,7 @@ void dfu_le_profile_init(void)
 {
     server_init(1);
     rtk_dfu_service_id = dfu_add_service(dfu_profile_callback);
+    ble_dfu_register_send_msg(dfu_send_msg_to_dfutask);
     server_register_app_cb(dfu_profile_callback);
 }
 
@@ -7,6 +7,8 @@
 #ifndef _DFU_TASK_H_
 #define _DFU_TASK_H_
 
+#include <stdbool.h>
+#include "app_msg.h"
 
 /** @defgroup DFU_TASK DFU Task
   * @brief Peripheral DFU Task
@@ -33,6 +35,13 @@ void dfu_main_task(void *p_param);
  */
 void dfu_task_init(void);
 
+/**
+ * @brief  Send msg to dfu task
+ * @param[in]   p_msg   Pointer to the IO message to be sent.
+ * @return true if the message is sent, false otherwise.
+ */
+bool dfu_send_msg_to_dfutask(T_IO_MSG *p_msg);
+
 /** End of DFU_TASK_Exported_Functions
   * @}
   */
@@ -0,0 +1,188 @@
+/**
+*********************************************************************************************************
+*               Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+**********************************************************************************************************
+* \file     rtl_idu_format.h
+* \brief    This file provides the IDU compressed image format definitions.
+* \details  The definitions only depend on the C standard headers, so they are shared
+*           by the IDU driver and the software codec in rtl_idu_sw.h.
+* \version  v1.0
+*********************************************************************************************************
+*/
+
+/*============================================================================*
+ *               Define to prevent recursive inclusion
+ *============================================================================*/
+#ifndef RTL_IDU_FORMAT_H
+#define RTL_IDU_FORMAT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================*
+ *                        Header Files
+ *============================================================================*/
+#include <stdint.h>
+
+/** \addtogroup IDU_Exported_Constants
+  * \{
+  */
+
+/** \defgroup IDU_ALGORITHM IDU Compress Algorithm
+ * \{
+ * \ingroup  IDU_Exported_Constants
+ */
+typedef enum
+{
+    IDU_RLE = 0x00,                         /*!< The compressed image uses Run Length Encode algorithm. */
+    IDU_FASTLZ = 0x01,                      /*!< The compressed image uses FastLZ compression algorithm. */
+    IDU_YUV_SAMPLE_BLUR_FASTLZ = 0x02,      /*!< The image is sampled in the YUV color space with a 0-3 bit blur, and then compressed using the FastLZ compression algorithm. */
+    IDU_YUV_SAMPLE_BLUR = 0x03,             /*!< The image is sampled in the YUV color space with a 0-3 bit blur. */
+} IDU_ALGORITHM;
+
+#define IS_IDU_ALGORITHM(ALGO)       (((ALGO) == IDU_RLE) || \
+                                      ((ALGO) == IDU_FASTLZ) || \
+                                      ((ALGO) == IDU_YUV_SAMPLE_BLUR_FASTLZ) || \
+                                      ((ALGO) == IDU_YUV_SAMPLE_BLUR))
+/** End of IDU_ALGORITHM
+  * \}
+  */
+
+/** \defgroup IDU_YUV_SAMPLE_TYPE IDU YUV Sample Type
+  * \{
+  * \ingroup  IDU_Exported_Constants
+  */
+typedef enum
+{
+    IDU_YUV444_SAMPLE = 0x00,       /*!< YUV444 sampling, data storing format: [Y0 U0 V0 Y1 U1 V1]. */
+    IDU_YUV422_SAMPLE = 0x01,       /*!< YUV422 sampling, data storing format: [Y0 U0 Y1 V1]. */
+    IDU_YUV411_SAMPLE = 0x02,       /*!< YUV411 sampling, data storing format: [Y0 U0 Y1 Y2 V2 Y3]. */
+} IDU_YUV_SAMPLE_TYPE;
+
+#define IS_IDU_YUV_TYPE(TYPE)        (((TYPE) == IDU_YUV444_SAMPLE) || \
+                                      ((TYPE) == IDU_YUV422_SAMPLE) || \
+                                      ((TYPE) == IDU_YUV411_SAMPLE))
+
+/** End of IDU_YUV_SAMPLE_TYPE
+  * \}
+  */
+
+/** \defgroup IDU_YUV_BLUR_BIT IDU Blur Bit
+  * \{
+  * \ingroup  IDU_Exported_Constants
+  */
+typedef enum
+{
+    IDU_YUV_BLUR_0BIT = 0x00,       /*!< The compressed image keeps all data after YUV sampling. */
+    IDU_YUV_BLUR_1BIT = 0x01,       /*!< The compressed image throws away 1 least significant bit of each byte after YUV sampling. */
+    IDU_YUV_BLUR_2BIT = 0x02,       /*!< The compressed image throws away 2 least significant bits of each byte after YUV sampling. */
+    IDU_YUV_BLUR_4BIT = 0x03,       /*!< The compressed image throws away 4 least significant bits of each byte after YUV sampling. */
+} IDU_YUV_BLUR_BIT;
+
+#define IS_IDU_YUB_BLUR_BIT(NUM)     (((NUM) == IDU_YUV_BLUR_0BIT) || \
+                                      ((NUM) == IDU_YUV_BLUR_1BIT) || \
+                                      ((NUM) == IDU_YUV_BLUR_2BIT) || \
+                                      ((NUM) == IDU_YUV_BLUR_4BIT))
+/** End of IDU_YUV_BLUR_BIT
+  * \}
+  */
+
+/** \defgroup IDU_RLE_RUNLENGTH_SIZE IDU RLE Run Length
+  * \{
+  * \ingroup  IDU_Exported_Constants
+  */
+typedef enum
+{
+    RUN_LENGTH_SIZE_0BYTE = 0x00,       /*!< The input data is not RLE compressed. */
+    RUN_LENGTH_SIZE_1BYTE = 0x01,       /*!< Run length is 1 byte. */
+    RUN_LENGTH_SIZE_2BYTE = 0x02,       /*!< Run length is 2 bytes. */
+} IDU_RLE_RUNLENGTH_SIZE;
+
+#define IS_IDU_RLE_BYTE_LEN(LEN)          (((LEN) == RUN_LENGTH_SIZE_1BYTE) || ((LEN) == RUN_LENGTH_SIZE_2BYTE))
+
+/** End of IDU_RLE_RUNLENGTH_SIZE
+  * \}
+  */
+
+/** \defgroup IDU_ERROR IDU Error Code
+  * \{
+  * \ingroup  IDU_Exported_Constants
+  */
+typedef enum
+{
+    IDU_SUCCESS = 0x0,                  /*!< IDU decode procedure successfully finished. */
+    IDU_ERROR_NULL_INPUT,               /*!< The pointer points to input data is NULL. */
+    IDU_ERROR_DECODE_FAIL,              /*!< IDU decode error interrupt is triggered and detected. */
+    IDU_ERROR_START_EXCEED_BOUNDARY,    /*!< Decode start line or column exceeds boundary. */
+    IDU_ERROR_END_EXCEED_BOUNDARY,      /*!< Decode end line or column exceeds boundary. */
+    IDU_ERROR_START_LARGER_THAN_END,    /*!< Decode start line or column exceeds end line or column. */
+    IDU_ERROR_INVALID_PARAM,            /*!< Parameters in DMA setting are invalid. */
+    IDU_ERROR_FILE_INVALID,             /*!< Parameters in input compressed file setting are invalid. */
+    IDU_ERROR_LINE_NOT_ALIGNED,         /*!< Line width in bytes must be 4-byte aligned when target stride is larger than line width. */
+    IDU_ERROR_NO_MEMORY,                /*!< There is not enough heap for the software codec. */
+} IDU_ERROR;
+/** End of IDU_ERROR
+  * \}
+  */
+
+/** End of IDU_Exported_Constants
+  * \}
+  */
+
+/** \addtogroup IDU_Exported_Types
+  * \{
+  */
+
+/**
+ * \defgroup    IDU_FILE_HEADER IDU_file_header
+ * \{
+ * \ingroup     IDU_Exported_Types
+ */
+typedef struct
+{
+    struct
+    {
+        uint8_t algorithm: 2;       /*!< Compression algorithm of input file,
+                                        This parameter can be a value of @ref IDU_ALGORITHM. */
+        uint8_t feature_1: 2;       /*!< For RLE: Run length size, value of @ref IDU_RLE_RUNLENGTH_SIZE.
+                                        For YUV: Sample type, value of @ref IDU_YUV_SAMPLE_TYPE. */
+        uint8_t feature_2: 2;       /*!< For RLE: Run length size, value of @ref IDU_RLE_RUNLENGTH_SIZE.
+                                        For YUV: Blur bit, value of @ref IDU_YUV_BLUR_BIT. */
+        uint8_t pixel_bytes: 2;     /*!< Size of pixel, can be 1-4 bytes. */
+    } algorithm_type;               /*!< Compressing information. */
+    uint8_t reserved[3];            /*!< Reserved for future use. */
+    uint32_t raw_pic_width;         /*!< Width of compressed picture in pixel. */
+    uint32_t raw_pic_height;        /*!< Height of compressed picture in pixel. */
+} IDU_file_header;
+/** End of IDU_FILE_HEADER
+  * \}
+  */
+
+/**
+ * \defgroup    IDU_DECODE_RANGE IDU_decode_range
+ * \{
+ * \ingroup     IDU_Exported_Types
+ */
+typedef struct
+{
+    uint32_t start_line;            /*!< Start line of target decode range. */
+    uint32_t end_line;              /*!< End line of target decode range. */
+    uint32_t start_column;          /*!< Start column of target decode range. */
+    uint32_t end_column;            /*!< End column of target decode range. */
+    uint32_t target_stride;         /*!< Data length between 2 contiguous target lines.*/
+} IDU_decode_range;
+/** End of IDU_DECODE_RANGE
+  * \}
+  */
+/** End of IDU_Exported_Types
+  * \}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTL_IDU_FORMAT_H */
+
+/******************* (C) COPYRIGHT 2023 Realtek Semiconductor Corporation *****END OF FILE****/
@@ -0,0 +1,145 @@
+/**
+*********************************************************************************************************
+*               Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+**********************************************************************************************************
+* \file     rtl_idu_sw.h
+* \brief    This file provides the IDU software codec functions.
+* \details  The software codec encodes and decodes the compressed image format of the IDU
+*           in portable C. It can run on the host to pre-compress assets, or on the target
+*           to decode images on parts without IDU.
+* \version  v1.0
+*********************************************************************************************************
+*/
+
+/*============================================================================*
+ *               Define to prevent recursive inclusion
+ *============================================================================*/
+#ifndef RTL_IDU_SW_H
+#define RTL_IDU_SW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================*
+ *                        Header Files
+ *============================================================================*/
+#include <stdint.h>
+#include "rtl_idu_format.h"
+
+/** \defgroup IDU_SW       IDU Software Codec
+  * \brief    Software encoder and decoder of the IDU compressed image format
+  * \details  The compressed file starts with @ref IDU_FILE_HEADER, followed by a table of
+  *           (height + 1) 32-bit offsets of the compressed lines relative to the file start.
+  *           The last offset is the file length. Each line is compressed separately:
+  *           - RLE: with feature_2 of 0, each record is [run length][pixel]. Otherwise each
+  *             record is [pixel count][run length][pixels], and every pixel is repeated
+  *             run length times. The field sizes are feature_1 and feature_2 bytes.
+  *           - YUV: the Y, U and V values of the sampled line are packed MSB first with the
+  *             blur bits thrown away, and the line is padded to a byte. The last
+  *             (width % 4) pixels of a line are always stored as YUV444.
+  *           - FastLZ: the raw line, or the sampled YUV line, is compressed by FastLZ.
+  *
+  *           YUV sampling is supported for 24-bit pixels stored in B, G, R order.
+  * \{
+  */
+
+/*============================================================================*
+ *                         Functions
+ *============================================================================*/
+/** \defgroup IDU_SW_Exported_Functions IDU Software Codec Exported Functions
+  * \brief    Functions for software encoding and decoding
+  * \{
+  */
+
+/**
+ * \brief  Decode compressed image by software.
+ * \param[in] file: Pointer to header of compressed image.
+ * \param[in] range: Decompress range, refer to @ref IDU_DECODE_RANGE.
+ *            A target_stride of 0 means the decoded lines are contiguous.
+ * \param[out] output: Buffer that stores decoded data.
+ * \return Operation result
+ * \retval - IDU_SUCCESS: Operation success.
+ * \retval - Others: Operation failure, cause refers to @ref IDU_ERROR.
+ *
+ * <b>Example usage</b>
+ * \code{.c}
+    void demo_code(void){
+        IDU_file_header* header = (IDU_file_header*)file_data;
+        IDU_decode_range range = {0, header->raw_pic_height - 1, 0, header->raw_pic_width - 1, 0};
+        IDU_ERROR err = IDU_SW_Decode(file_data, &range, buf);
+    }
+ * \endcode
+ */
+IDU_ERROR IDU_SW_Decode(const uint8_t *file, const IDU_decode_range *range, uint8_t *output);
+
+/**
+ * \brief  Get the maximum size of compressed file.
+ * \param[in] header: Compressing information and size of the image, refer to @ref IDU_FILE_HEADER.
+ * \return Maximum size of compressed file
+ * \retval - 0: Invalid header.
+ * \retval - Others: Size in bytes.
+ */
+uint32_t IDU_SW_Get_Encode_Bound(const IDU_file_header *header);
+
+/**
+ * \brief  Encode image by software.
+ * \param[in] header: Compressing information and size of the image, refer to @ref IDU_FILE_HEADER.
+ * \param[in] image: Pointer to the raw image.
+ * \param[in] image_stride: Data length between 2 contiguous image lines, 0 means contiguous lines.
+ * \param[out] file: Buffer that stores compressed file, or NULL to get the compressed size only.
+ * \param[in,out] file_len: In: size of file buffer. Out: size of compressed file.
+ * \return Operation result
+ * \retval - IDU_SUCCESS: Operation success.
+ * \retval - IDU_ERROR_INVALID_PARAM: The file buffer is too small.
+ * \retval - Others: Operation failure, cause refers to @ref IDU_ERROR.
+ *
+ * <b>Example usage</b>
+ * \code{.c}
+    void demo_code(void){
+        IDU_file_header header = {0};
+        header.algorithm_type.algorithm = IDU_RLE;
+        header.algorithm_type.feature_1 = RUN_LENGTH_SIZE_1BYTE;
+        header.algorithm_type.feature_2 = RUN_LENGTH_SIZE_1BYTE;
+        header.algorithm_type.pixel_bytes = 2;
+        header.raw_pic_width = 100;
+        header.raw_pic_height = 100;
+        uint32_t file_len = IDU_SW_Get_Encode_Bound(&header);
+        uint8_t *file = malloc(file_len);
+        IDU_ERROR err = IDU_SW_Encode(&header, image, 0, file, &file_len);
+    }
+ * \endcode
+ */
+IDU_ERROR IDU_SW_Encode(const IDU_file_header *header, const uint8_t *image,
+                        uint32_t image_stride, uint8_t *file, uint32_t *file_len);
+
+/**
+ * \brief  Encode image by software with the run length sizes that give the smallest file.
+ * \param[in,out] header: Size and pixel bytes of the image, refer to @ref IDU_FILE_HEADER.
+ *                The algorithm must be @ref IDU_RLE. The chosen feature_1 and feature_2 are passed back.
+ * \param[in] image: Pointer to the raw image.
+ * \param[in] image_stride: Data length between 2 contiguous image lines, 0 means contiguous lines.
+ * \param[out] file: Buffer that stores compressed file, or NULL to get the compressed size only.
+ * \param[in,out] file_len: In: size of file buffer. Out: size of compressed file.
+ * \return Operation result
+ * \retval - IDU_SUCCESS: Operation success.
+ * \retval - Others: Operation failure, cause refers to @ref IDU_ERROR.
+ */
+IDU_ERROR IDU_SW_Encode_Smallest(IDU_file_header *header, const uint8_t *image,
+                                 uint32_t image_stride, uint8_t *file, uint32_t *file_len);
+
+/** End of IDU_SW_Exported_Functions
+  * \}
+  */
+
+/** End of IDU_SW
+  * \}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTL_IDU_SW_H */
+
+/******************* (C) COPYRIGHT 2023 Realtek Semiconductor Corporation *****END OF FILE****/
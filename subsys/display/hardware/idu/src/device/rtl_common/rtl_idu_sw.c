@@ -0,0 +1,938 @@
+/**
+*********************************************************************************************************
+*               Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+**********************************************************************************************************
+* \file     rtl_idu_sw.c
+* \brief    This file provides the IDU software codec functions.
+* \details  Portable C, no hardware register is accessed.
+* \version  v1.0
+*********************************************************************************************************
+*/
+
+/*============================================================================*
+ *                        Header Files
+ *============================================================================*/
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rtl_idu_sw.h"
+
+/*============================================================================*
+ *                              Macros
+ *============================================================================*/
+#ifndef IDU_SW_MALLOC
+#define IDU_SW_MALLOC(size)             malloc(size)
+#define IDU_SW_FREE(ptr)                free(ptr)
+#endif
+
+#define IDU_SW_HEADER_SIZE              12
+#define IDU_SW_NO_POSITION              0xFFFFFFFF
+
+#define IDU_SW_FASTLZ_HASH_LOG          13
+#define IDU_SW_FASTLZ_HASH_SIZE         (1 << IDU_SW_FASTLZ_HASH_LOG)
+#define IDU_SW_FASTLZ_MAX_COPY          32
+#define IDU_SW_FASTLZ_MAX_MATCH         264
+#define IDU_SW_FASTLZ_L1_DISTANCE       8192
+#define IDU_SW_FASTLZ_L2_DISTANCE       8191
+
+/*============================================================================*
+ *                              Types
+ *============================================================================*/
+typedef struct
+{
+    uint8_t algorithm;
+    uint8_t feature_1;
+    uint8_t feature_2;
+    uint8_t pixel_size;
+    uint32_t width;
+    uint32_t height;
+    uint32_t line_size;         /* raw line, or sampled line for YUV */
+    uint32_t line_bound;        /* maximum size of a compressed line */
+} IDU_SW_Format;
+
+typedef struct
+{
+    const uint8_t *p;
+    const uint8_t *end;
+    uint32_t acc;
+    uint8_t cnt;
+    uint8_t bits;
+} IDU_SW_BitReader;
+
+typedef struct
+{
+    uint8_t *p;
+    uint32_t acc;
+    uint8_t cnt;
+    uint8_t bits;
+} IDU_SW_BitWriter;
+
+/*============================================================================*
+ *                              Variables
+ *============================================================================*/
+/* pixels sharing U and V, and thrown away bits, indexed by feature_1 and feature_2 */
+static const uint8_t idu_sw_yuv_group[3] = {1, 2, 4};
+static const uint8_t idu_sw_yuv_blur[4] = {0, 1, 2, 4};
+
+/*============================================================================*
+ *                           Static Functions
+ *============================================================================*/
+static uint32_t idu_sw_read_le(const uint8_t *p, uint8_t len)
+{
+    uint32_t value = 0;
+
+    while (len--)
+    {
+        value = (value << 8) | p[len];
+    }
+    return value;
+}
+
+static void idu_sw_write_le(uint8_t *p, uint32_t value, uint8_t len)
+{
+    while (len--)
+    {
+        *p++ = (uint8_t)value;
+        value >>= 8;
+    }
+}
+
+static uint32_t idu_sw_min(uint32_t a, uint32_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static uint8_t idu_sw_clamp(int32_t value)
+{
+    return (value < 0) ? 0 : ((value > 255) ? 255 : (uint8_t)value);
+}
+
+/* Sampled line: each group of n pixels stores Y0 U Y1..Yk V Yk+1..Yn-1 with k = n / 2.
+ * The last (width % 4) pixels are stored as YUV444.
+ */
+static uint32_t idu_sw_yuv_line_size(uint8_t sample_type, uint8_t blur, uint32_t width)
+{
+    uint8_t n = idu_sw_yuv_group[sample_type];
+    uint32_t rest = width % 4;
+    uint64_t values = (uint64_t)(width - rest) / n * (n + 2) + rest * 3;
+
+    return (uint32_t)((values * (8 - idu_sw_yuv_blur[blur]) + 7) / 8);
+}
+
+static bool idu_sw_format_init(IDU_SW_Format *fmt, uint8_t algorithm, uint8_t feature_1,
+                               uint8_t feature_2, uint8_t pixel_bytes, uint32_t width, uint32_t height)
+{
+    uint64_t line_bound;
+
+    if (!IS_IDU_ALGORITHM(algorithm) || pixel_bytes > 2 || width == 0 || height == 0 ||
+        width > 0xFFFFFF || height > 0xFFFFFF)
+    {
+        return false;
+    }
+
+    fmt->algorithm = algorithm;
+    fmt->feature_1 = feature_1;
+    fmt->feature_2 = feature_2;
+    fmt->pixel_size = pixel_bytes + 2;
+    fmt->width = width;
+    fmt->height = height;
+
+    switch (algorithm)
+    {
+    case IDU_RLE:
+        if (!IS_IDU_RLE_BYTE_LEN(feature_1) || feature_2 > RUN_LENGTH_SIZE_2BYTE)
+        {
+            return false;
+        }
+        fmt->line_size = width * fmt->pixel_size;
+        line_bound = (uint64_t)width * (fmt->pixel_size + feature_1 + feature_2);
+        break;
+
+    case IDU_FASTLZ:
+        fmt->line_size = width * fmt->pixel_size;
+        line_bound = fmt->line_size + (fmt->line_size + IDU_SW_FASTLZ_MAX_COPY - 1) / IDU_SW_FASTLZ_MAX_COPY;
+        break;
+
+    default:
+        /* YUV sampling is defined for 24-bit pixels only */
+        if (fmt->pixel_size != 3 || !IS_IDU_YUV_TYPE(feature_1))
+        {
+            return false;
+        }
+        fmt->line_size = idu_sw_yuv_line_size(feature_1, feature_2, width);
+        line_bound = fmt->line_size;
+        if (algorithm == IDU_YUV_SAMPLE_BLUR_FASTLZ)
+        {
+            line_bound += (fmt->line_size + IDU_SW_FASTLZ_MAX_COPY - 1) / IDU_SW_FASTLZ_MAX_COPY;
+        }
+        break;
+    }
+
+    if (IDU_SW_HEADER_SIZE + ((uint64_t)height + 1) * 4 + line_bound * height > 0xFFFFFFFF)
+    {
+        return false;
+    }
+    fmt->line_bound = (uint32_t)line_bound;
+    return true;
+}
+
+static bool idu_sw_format_parse(IDU_SW_Format *fmt, const uint8_t *file)
+{
+    return idu_sw_format_init(fmt, file[0] & 0x03, (file[0] >> 2) & 0x03, (file[0] >> 4) & 0x03,
+                              file[0] >> 6, idu_sw_read_le(file + 4, 4), idu_sw_read_le(file + 8, 4));
+}
+
+static uint32_t idu_sw_encode_bound(const IDU_SW_Format *fmt)
+{
+    return IDU_SW_HEADER_SIZE + (fmt->height + 1) * 4 + fmt->line_bound * fmt->height;
+}
+
+static void idu_sw_fill_pixel(uint8_t *dst, const uint8_t *pixel, uint8_t pixel_size, uint32_t num)
+{
+    uint32_t total = num * pixel_size;
+    uint32_t done = pixel_size;
+
+    memcpy(dst, pixel, pixel_size);
+    while (done < total)
+    {
+        uint32_t len = idu_sw_min(done, total - done);
+
+        memcpy(dst + done, dst, len);
+        done += len;
+    }
+}
+
+static bool idu_sw_rle_decode_line(const IDU_SW_Format *fmt, const uint8_t *src, uint32_t src_len,
+                                   uint32_t start, uint32_t end, uint8_t *dst)
+{
+    const uint8_t *src_end = src + src_len;
+    uint8_t pixel_size = fmt->pixel_size;
+    uint32_t x = 0;
+
+    while (x <= end)
+    {
+        uint32_t count = 1;
+        uint32_t run;
+
+        if ((uint32_t)(src_end - src) < fmt->feature_1 + fmt->feature_2)
+        {
+            return false;
+        }
+        if (fmt->feature_2 != RUN_LENGTH_SIZE_0BYTE)
+        {
+            count = idu_sw_read_le(src, fmt->feature_2);
+            src += fmt->feature_2;
+        }
+        run = idu_sw_read_le(src, fmt->feature_1);
+        src += fmt->feature_1;
+        if (count == 0 || run == 0 || count * pixel_size > (uint32_t)(src_end - src))
+        {
+            return false;
+        }
+
+        for (; count > 0; count--, src += pixel_size)
+        {
+            uint32_t lo;
+            uint32_t hi;
+
+            if (run > fmt->width - x)
+            {
+                return false;
+            }
+            lo = (x > start) ? x : start;
+            hi = idu_sw_min(x + run, end + 1);
+            if (lo < hi)
+            {
+                idu_sw_fill_pixel(dst + (lo - start) * pixel_size, src, pixel_size, hi - lo);
+            }
+            x += run;
+        }
+    }
+    return true;
+}
+
+static bool idu_sw_bits_get(IDU_SW_BitReader *reader, uint8_t *value)
+{
+    if (reader->cnt < reader->bits)
+    {
+        if (reader->p >= reader->end)
+        {
+            return false;
+        }
+        reader->acc = (reader->acc << 8) | *reader->p++;
+        reader->cnt += 8;
+    }
+    reader->cnt -= reader->bits;
+    *value = (uint8_t)((reader->acc >> reader->cnt) & ((1u << reader->bits) - 1));
+    return true;
+}
+
+static void idu_sw_bits_put(IDU_SW_BitWriter *writer, uint8_t value)
+{
+    writer->acc = (writer->acc << writer->bits) | value;
+    writer->cnt += writer->bits;
+    if (writer->cnt >= 8)
+    {
+        writer->cnt -= 8;
+        *writer->p++ = (uint8_t)(writer->acc >> writer->cnt);
+    }
+}
+
+static void idu_sw_bits_flush(IDU_SW_BitWriter *writer)
+{
+    if (writer->cnt != 0)
+    {
+        *writer->p++ = (uint8_t)(writer->acc << (8 - writer->cnt));
+        writer->cnt = 0;
+    }
+}
+
+static void idu_sw_yuv_to_rgb(int32_t y, int32_t u, int32_t v, uint8_t *dst)
+{
+    u -= 128;
+    v -= 128;
+    dst[0] = idu_sw_clamp(y + ((907 * u + 416) >> 9));
+    dst[1] = idu_sw_clamp(y - ((2818 * u + 5849 * v + 3464) >> 13));
+    dst[2] = idu_sw_clamp(y + ((359 * v + 119) >> 8));
+}
+
+static void idu_sw_rgb_to_yuv(const uint8_t *src, int32_t *y, int32_t *u, int32_t *v)
+{
+    int32_t b = src[0];
+    int32_t g = src[1];
+    int32_t r = src[2];
+
+    *y = (19595 * r + 38470 * g + 7471 * b + 32768) >> 16;
+    *u = idu_sw_clamp(((-11059 * r - 21709 * g + 32768 * b + 32768) >> 16) + 128);
+    *v = idu_sw_clamp(((32768 * r - 27439 * g - 5329 * b + 32768) >> 16) + 128);
+}
+
+static bool idu_sw_yuv_decode_line(const IDU_SW_Format *fmt, const uint8_t *src, uint32_t src_len,
+                                   uint32_t start, uint32_t end, uint8_t *dst)
+{
+    uint8_t n = idu_sw_yuv_group[fmt->feature_1];
+    uint8_t blur = idu_sw_yuv_blur[fmt->feature_2];
+    IDU_SW_BitReader reader = {src, src + src_len, 0, 0, 8 - blur};
+    uint32_t body = fmt->width - fmt->width % 4;
+    uint32_t x;
+    uint8_t cnt;
+
+    for (x = 0; x <= end; x += cnt)
+    {
+        uint8_t y[4];
+        uint8_t u;
+        uint8_t v;
+        uint8_t k;
+        uint8_t i;
+        bool ok;
+
+        cnt = (x < body) ? n : 1;
+        k = cnt / 2;
+        ok = idu_sw_bits_get(&reader, &y[0]) && idu_sw_bits_get(&reader, &u);
+
+        for (i = 1; ok && i <= k; i++)
+        {
+            ok = idu_sw_bits_get(&reader, &y[i]);
+        }
+        ok = ok && idu_sw_bits_get(&reader, &v);
+        for (i = k + 1; ok && i < cnt; i++)
+        {
+            ok = idu_sw_bits_get(&reader, &y[i]);
+        }
+        if (!ok)
+        {
+            return false;
+        }
+
+        for (i = 0; i < cnt; i++)
+        {
+            if (x + i >= start && x + i <= end)
+            {
+                idu_sw_yuv_to_rgb(y[i] << blur, u << blur, v << blur, dst + (x + i - start) * 3);
+            }
+        }
+    }
+    return true;
+}
+
+static uint8_t idu_sw_yuv_quantize(int32_t value, uint8_t blur)
+{
+    uint32_t q = ((uint32_t)value + ((1u << blur) >> 1)) >> blur;
+
+    return (uint8_t)idu_sw_min(q, 0xFF >> blur);
+}
+
+static uint32_t idu_sw_yuv_encode_line(const IDU_SW_Format *fmt, const uint8_t *src, uint8_t *dst)
+{
+    uint8_t n = idu_sw_yuv_group[fmt->feature_1];
+    uint8_t blur = idu_sw_yuv_blur[fmt->feature_2];
+    IDU_SW_BitWriter writer = {dst, 0, 0, 8 - blur};
+    uint32_t body = fmt->width - fmt->width % 4;
+    uint32_t x;
+    uint8_t cnt;
+
+    for (x = 0; x < fmt->width; x += cnt)
+    {
+        int32_t y[4];
+        int32_t u;
+        int32_t v;
+        int32_t u_sum = 0;
+        int32_t v_sum = 0;
+        uint8_t k;
+        uint8_t i;
+
+        cnt = (x < body) ? n : 1;
+        k = cnt / 2;
+        for (i = 0; i < cnt; i++)
+        {
+            idu_sw_rgb_to_yuv(src + (x + i) * 3, &y[i], &u, &v);
+            u_sum += u;
+            v_sum += v;
+        }
+        u = (u_sum + cnt / 2) / cnt;
+        v = (v_sum + cnt / 2) / cnt;
+
+        idu_sw_bits_put(&writer, idu_sw_yuv_quantize(y[0], blur));
+        idu_sw_bits_put(&writer, idu_sw_yuv_quantize(u, blur));
+        for (i = 1; i <= k; i++)
+        {
+            idu_sw_bits_put(&writer, idu_sw_yuv_quantize(y[i], blur));
+        }
+        idu_sw_bits_put(&writer, idu_sw_yuv_quantize(v, blur));
+        for (i = k + 1; i < cnt; i++)
+        {
+            idu_sw_bits_put(&writer, idu_sw_yuv_quantize(y[i], blur));
+        }
+    }
+    idu_sw_bits_flush(&writer);
+
+    return (uint32_t)(writer.p - dst);
+}
+
+/* FastLZ level 1 and level 2 streams, the level is kept in the top 3 bits of the first byte */
+static bool idu_sw_fastlz_decompress(const uint8_t *src, uint32_t src_len, uint8_t *dst,
+                                     uint32_t dst_len)
+{
+    const uint8_t *ip = src;
+    const uint8_t *ip_end = src + src_len;
+    uint8_t *op = dst;
+    uint8_t *op_end = dst + dst_len;
+    uint8_t level;
+    uint32_t ctrl;
+
+    if (src_len == 0)
+    {
+        return false;
+    }
+    level = *ip >> 5;
+    if (level > 1)
+    {
+        return false;
+    }
+    ctrl = *ip++ & 31;
+
+    while (true)
+    {
+        if (ctrl >= 32)
+        {
+            uint32_t len = (ctrl >> 5) - 1;
+            uint32_t dist;
+            uint8_t code;
+
+            if (len == 7 - 1)
+            {
+                do
+                {
+                    if (ip >= ip_end)
+                    {
+                        return false;
+                    }
+                    code = *ip++;
+                    len += code;
+                }
+                while (level == 1 && code == 255);
+            }
+            if (ip >= ip_end)
+            {
+                return false;
+            }
+            code = *ip++;
+            len += 3;
+            dist = ((ctrl & 31) << 8) + code + 1;
+            if (level == 1 && code == 255 && (ctrl & 31) == 31)
+            {
+                if (ip_end - ip < 2)
+                {
+                    return false;
+                }
+                dist = ((uint32_t)ip[0] << 8) + ip[1] + IDU_SW_FASTLZ_L2_DISTANCE + 1;
+                ip += 2;
+            }
+            if (dist > (uint32_t)(op - dst) || len > (uint32_t)(op_end - op))
+            {
+                return false;
+            }
+            if (dist >= len)
+            {
+                memcpy(op, op - dist, len);
+                op += len;
+            }
+            else
+            {
+                const uint8_t *ref = op - dist;
+
+                while (len--)
+                {
+                    *op++ = *ref++;
+                }
+            }
+        }
+        else
+        {
+            ctrl++;
+            if (ctrl > (uint32_t)(ip_end - ip) || ctrl > (uint32_t)(op_end - op))
+            {
+                return false;
+            }
+            memcpy(op, ip, ctrl);
+            ip += ctrl;
+            op += ctrl;
+        }
+
+        if (ip >= ip_end)
+        {
+            break;
+        }
+        ctrl = *ip++;
+    }
+    return op == op_end;
+}
+
+static uint8_t *idu_sw_fastlz_literals(const uint8_t *src, uint32_t len, uint8_t *op)
+{
+    while (len > 0)
+    {
+        uint32_t n = idu_sw_min(len, IDU_SW_FASTLZ_MAX_COPY);
+
+        *op++ = (uint8_t)(n - 1);
+        memcpy(op, src, n);
+        op += n;
+        src += n;
+        len -= n;
+    }
+    return op;
+}
+
+/* FastLZ level 1, the first instruction is always a literal run so the level bits stay 0 */
+static uint32_t idu_sw_fastlz_compress(const uint8_t *src, uint32_t len, uint8_t *dst,
+                                       uint32_t *htab)
+{
+    uint8_t *op = dst;
+    uint32_t anchor = 0;
+    uint32_t ip = 0;
+    uint32_t i;
+
+    for (i = 0; i < IDU_SW_FASTLZ_HASH_SIZE; i++)
+    {
+        htab[i] = IDU_SW_NO_POSITION;
+    }
+
+    while (ip + 3 <= len)
+    {
+        uint32_t seq = src[ip] | (src[ip + 1] << 8) | ((uint32_t)src[ip + 2] << 16);
+        uint32_t hash = (seq * 2654435761u) >> (32 - IDU_SW_FASTLZ_HASH_LOG);
+        uint32_t ref = htab[hash];
+        uint32_t match = 3;
+        uint32_t dist;
+
+        htab[hash] = ip;
+        if (ref == IDU_SW_NO_POSITION || ip - ref > IDU_SW_FASTLZ_L1_DISTANCE ||
+            memcmp(src + ref, src + ip, 3) != 0)
+        {
+            ip++;
+            continue;
+        }
+
+        while (ip + match < len && match < IDU_SW_FASTLZ_MAX_MATCH && src[ref + match] == src[ip + match])
+        {
+            match++;
+        }
+
+        op = idu_sw_fastlz_literals(src + anchor, ip - anchor, op);
+        dist = ip - ref - 1;
+        if (match - 2 < 7)
+        {
+            *op++ = (uint8_t)(((match - 2) << 5) + (dist >> 8));
+        }
+        else
+        {
+            *op++ = (uint8_t)((7 << 5) + (dist >> 8));
+            *op++ = (uint8_t)(match - 2 - 7);
+        }
+        *op++ = (uint8_t)dist;
+
+        ip += match;
+        anchor = ip;
+    }
+
+    op = idu_sw_fastlz_literals(src + anchor, len - anchor, op);
+    return (uint32_t)(op - dst);
+}
+
+static uint32_t idu_sw_rle_encode_line(const IDU_SW_Format *fmt, const uint8_t *src, uint8_t *dst)
+{
+    uint8_t pixel_size = fmt->pixel_size;
+    uint32_t max_run = (fmt->feature_1 == RUN_LENGTH_SIZE_1BYTE) ? 0xFF : 0xFFFF;
+    uint32_t max_count = (fmt->feature_2 == RUN_LENGTH_SIZE_1BYTE) ? 0xFF : 0xFFFF;
+    uint8_t *op = dst;
+    uint8_t *p_count = NULL;
+    uint32_t count = 0;
+    uint32_t last_run = 0;
+    uint32_t x = 0;
+
+    while (x < fmt->width)
+    {
+        const uint8_t *pixel = src + x * pixel_size;
+        uint32_t run = 1;
+
+        while (x + run < fmt->width && run < max_run &&
+               memcmp(pixel, pixel + run * pixel_size, pixel_size) == 0)
+        {
+            run++;
+        }
+
+        if (fmt->feature_2 == RUN_LENGTH_SIZE_0BYTE)
+        {
+            idu_sw_write_le(op, run, fmt->feature_1);
+            op += fmt->feature_1;
+        }
+        else if (p_count == NULL || run != last_run || count == max_count)
+        {
+            /* pixels with the same run length share one record */
+            if (p_count != NULL)
+            {
+                idu_sw_write_le(p_count, count, fmt->feature_2);
+            }
+            p_count = op;
+            op += fmt->feature_2;
+            idu_sw_write_le(op, run, fmt->feature_1);
+            op += fmt->feature_1;
+            count = 0;
+            last_run = run;
+        }
+        memcpy(op, pixel, pixel_size);
+        op += pixel_size;
+        count++;
+        x += run;
+    }
+
+    if (p_count != NULL)
+    {
+        idu_sw_write_le(p_count, count, fmt->feature_2);
+    }
+    return (uint32_t)(op - dst);
+}
+
+/*============================================================================*
+ *                           Public Functions
+ *============================================================================*/
+IDU_ERROR IDU_SW_Decode(const uint8_t *file, const IDU_decode_range *range, uint8_t *output)
+{
+    IDU_SW_Format fmt;
+    IDU_ERROR err = IDU_SUCCESS;
+    uint8_t *line_buf = NULL;
+    uint32_t table_end;
+    uint32_t line_size;
+    uint32_t stride;
+    uint32_t line;
+
+    if (file == NULL)
+    {
+        return IDU_ERROR_NULL_INPUT;
+    }
+    if (range == NULL || output == NULL)
+    {
+        return IDU_ERROR_INVALID_PARAM;
+    }
+    if (!idu_sw_format_parse(&fmt, file))
+    {
+        return IDU_ERROR_FILE_INVALID;
+    }
+    if ((range->start_line >= fmt.height) || (range->start_column >= fmt.width))
+    {
+        return IDU_ERROR_START_EXCEED_BOUNDARY;
+    }
+    if ((range->start_line > range->end_line) || (range->start_column > range->end_column))
+    {
+        return IDU_ERROR_START_LARGER_THAN_END;
+    }
+    if ((range->end_line >= fmt.height) || (range->end_column >= fmt.width))
+    {
+        return IDU_ERROR_END_EXCEED_BOUNDARY;
+    }
+
+    line_size = (range->end_column - range->start_column + 1) * fmt.pixel_size;
+    stride = (range->target_stride != 0) ? range->target_stride : line_size;
+    if (stride < line_size)
+    {
+        return IDU_ERROR_INVALID_PARAM;
+    }
+
+    /* a full-width FastLZ line is decompressed in place */
+    if (fmt.algorithm == IDU_YUV_SAMPLE_BLUR_FASTLZ ||
+        (fmt.algorithm == IDU_FASTLZ && line_size != fmt.line_size))
+    {
+        line_buf = IDU_SW_MALLOC(fmt.line_size);
+        if (line_buf == NULL)
+        {
+            return IDU_ERROR_NO_MEMORY;
+        }
+    }
+
+    table_end = IDU_SW_HEADER_SIZE + (fmt.height + 1) * 4;
+    for (line = range->start_line; line <= range->end_line && err == IDU_SUCCESS; line++)
+    {
+        uint32_t start = idu_sw_read_le(file + IDU_SW_HEADER_SIZE + line * 4, 4);
+        uint32_t end = idu_sw_read_le(file + IDU_SW_HEADER_SIZE + (line + 1) * 4, 4);
+        uint8_t *dst = output + (line - range->start_line) * stride;
+        bool ok = false;
+
+        if (start < table_end || end < start)
+        {
+            err = IDU_ERROR_FILE_INVALID;
+            break;
+        }
+
+        switch (fmt.algorithm)
+        {
+        case IDU_RLE:
+            ok = idu_sw_rle_decode_line(&fmt, file + start, end - start,
+                                        range->start_column, range->end_column, dst);
+            break;
+
+        case IDU_FASTLZ:
+            if (line_buf == NULL)
+            {
+                ok = idu_sw_fastlz_decompress(file + start, end - start, dst, fmt.line_size);
+            }
+            else
+            {
+                ok = idu_sw_fastlz_decompress(file + start, end - start, line_buf, fmt.line_size);
+                if (ok)
+                {
+                    memcpy(dst, line_buf + range->start_column * fmt.pixel_size, line_size);
+                }
+            }
+            break;
+
+        case IDU_YUV_SAMPLE_BLUR_FASTLZ:
+            ok = idu_sw_fastlz_decompress(file + start, end - start, line_buf, fmt.line_size) &&
+                 idu_sw_yuv_decode_line(&fmt, line_buf, fmt.line_size,
+                                        range->start_column, range->end_column, dst);
+            break;
+
+        default:
+            ok = idu_sw_yuv_decode_line(&fmt, file + start, end - start,
+                                        range->start_column, range->end_column, dst);
+            break;
+        }
+
+        if (!ok)
+        {
+            err = IDU_ERROR_FILE_INVALID;
+        }
+    }
+
+    if (line_buf != NULL)
+    {
+        IDU_SW_FREE(line_buf);
+    }
+    return err;
+}
+
+uint32_t IDU_SW_Get_Encode_Bound(const IDU_file_header *header)
+{
+    IDU_SW_Format fmt;
+
+    if (header == NULL ||
+        !idu_sw_format_init(&fmt, header->algorithm_type.algorithm, header->algorithm_type.feature_1,
+                            header->algorithm_type.feature_2, header->algorithm_type.pixel_bytes,
+                            header->raw_pic_width, header->raw_pic_height))
+    {
+        return 0;
+    }
+    return idu_sw_encode_bound(&fmt);
+}
+
+IDU_ERROR IDU_SW_Encode(const IDU_file_header *header, const uint8_t *image,
+                        uint32_t image_stride, uint8_t *file, uint32_t *file_len)
+{
+    IDU_SW_Format fmt;
+    IDU_ERROR err = IDU_SUCCESS;
+    uint8_t *line_buf = NULL;
+    uint8_t *sample_buf = NULL;
+    uint32_t *htab = NULL;
+    uint32_t pos;
+    uint32_t line;
+
+    if (image == NULL)
+    {
+        return IDU_ERROR_NULL_INPUT;
+    }
+    if (header == NULL || file_len == NULL)
+    {
+        return IDU_ERROR_INVALID_PARAM;
+    }
+    if (!idu_sw_format_init(&fmt, header->algorithm_type.algorithm, header->algorithm_type.feature_1,
+                            header->algorithm_type.feature_2, header->algorithm_type.pixel_bytes,
+                            header->raw_pic_width, header->raw_pic_height))
+    {
+        return IDU_ERROR_FILE_INVALID;
+    }
+    if (image_stride == 0)
+    {
+        image_stride = fmt.width * fmt.pixel_size;
+    }
+    else if (image_stride < fmt.width * fmt.pixel_size)
+    {
+        return IDU_ERROR_INVALID_PARAM;
+    }
+
+    pos = IDU_SW_HEADER_SIZE + (fmt.height + 1) * 4;
+    if (file != NULL)
+    {
+        if (*file_len < pos)
+        {
+            return IDU_ERROR_INVALID_PARAM;
+        }
+        memset(file, 0, IDU_SW_HEADER_SIZE);
+        file[0] = (uint8_t)(fmt.algorithm | (fmt.feature_1 << 2) | (fmt.feature_2 << 4) |
+                            ((fmt.pixel_size - 2) << 6));
+        /* the same reserved byte as the image converter */
+        file[1] = 0x01;
+        idu_sw_write_le(file + 4, fmt.width, 4);
+        idu_sw_write_le(file + 8, fmt.height, 4);
+    }
+
+    line_buf = IDU_SW_MALLOC(fmt.line_bound);
+    if (fmt.algorithm == IDU_FASTLZ || fmt.algorithm == IDU_YUV_SAMPLE_BLUR_FASTLZ)
+    {
+        htab = IDU_SW_MALLOC(IDU_SW_FASTLZ_HASH_SIZE * sizeof(uint32_t));
+    }
+    if (fmt.algorithm == IDU_YUV_SAMPLE_BLUR_FASTLZ)
+    {
+        sample_buf = IDU_SW_MALLOC(fmt.line_size);
+    }
+    if (line_buf == NULL || (htab == NULL && fmt.algorithm == IDU_FASTLZ) ||
+        ((htab == NULL || sample_buf == NULL) && fmt.algorithm == IDU_YUV_SAMPLE_BLUR_FASTLZ))
+    {
+        err = IDU_ERROR_NO_MEMORY;
+    }
+
+    for (line = 0; line < fmt.height && err == IDU_SUCCESS; line++)
+    {
+        const uint8_t *src = image + line * image_stride;
+        uint32_t len;
+
+        switch (fmt.algorithm)
+        {
+        case IDU_RLE:
+            len = idu_sw_rle_encode_line(&fmt, src, line_buf);
+            break;
+
+        case IDU_FASTLZ:
+            len = idu_sw_fastlz_compress(src, fmt.line_size, line_buf, htab);
+            break;
+
+        case IDU_YUV_SAMPLE_BLUR_FASTLZ:
+            idu_sw_yuv_encode_line(&fmt, src, sample_buf);
+            len = idu_sw_fastlz_compress(sample_buf, fmt.line_size, line_buf, htab);
+            break;
+
+        default:
+            len = idu_sw_yuv_encode_line(&fmt, src, line_buf);
+            break;
+        }
+
+        if (file != NULL)
+        {
+            if (len > *file_len - pos)
+            {
+                err = IDU_ERROR_INVALID_PARAM;
+                break;
+            }
+            idu_sw_write_le(file + IDU_SW_HEADER_SIZE + line * 4, pos, 4);
+            memcpy(file + pos, line_buf, len);
+        }
+        pos += len;
+    }
+
+    if (err == IDU_SUCCESS)
+    {
+        if (file != NULL)
+        {
+            idu_sw_write_le(file + IDU_SW_HEADER_SIZE + fmt.height * 4, pos, 4);
+        }
+        *file_len = pos;
+    }
+
+    if (line_buf != NULL)
+    {
+        IDU_SW_FREE(line_buf);
+    }
+    if (sample_buf != NULL)
+    {
+        IDU_SW_FREE(sample_buf);
+    }
+    if (htab != NULL)
+    {
+        IDU_SW_FREE(htab);
+    }
+    return err;
+}
+
+IDU_ERROR IDU_SW_Encode_Smallest(IDU_file_header *header, const uint8_t *image,
+                                 uint32_t image_stride, uint8_t *file, uint32_t *file_len)
+{
+    IDU_file_header trial;
+    uint32_t best_len = 0xFFFFFFFF;
+    uint8_t best_feature_1 = RUN_LENGTH_SIZE_1BYTE;
+    uint8_t best_feature_2 = RUN_LENGTH_SIZE_0BYTE;
+    uint8_t feature_1;
+    uint8_t feature_2;
+
+    if (header == NULL || header->algorithm_type.algorithm != IDU_RLE)
+    {
+        return IDU_ERROR_INVALID_PARAM;
+    }
+
+    trial = *header;
+    for (feature_1 = RUN_LENGTH_SIZE_1BYTE; feature_1 <= RUN_LENGTH_SIZE_2BYTE; feature_1++)
+    {
+        for (feature_2 = RUN_LENGTH_SIZE_0BYTE; feature_2 <= RUN_LENGTH_SIZE_2BYTE; feature_2++)
+        {
+            uint32_t len = 0;
+            IDU_ERROR err;
+
+            trial.algorithm_type.feature_1 = feature_1;
+            trial.algorithm_type.feature_2 = feature_2;
+            err = IDU_SW_Encode(&trial, image, image_stride, NULL, &len);
+            if (err != IDU_SUCCESS)
+            {
+                return err;
+            }
+            if (len < best_len)
+            {
+                best_len = len;
+                best_feature_1 = feature_1;
+                best_feature_2 = feature_2;
+            }
+        }
+    }
+
+    header->algorithm_type.feature_1 = best_feature_1;
+    header->algorithm_type.feature_2 = best_feature_2;
+    return IDU_SW_Encode(header, image, image_stride, file, file_len);
+}
+
+/******************* (C) COPYRIGHT 2023 Realtek Semiconductor Corporation *****END OF FILE****/
@@ -25,6 +25,7 @@ extern "C" {
  *                        Header Files
  *============================================================================*/
 #include "rtl_ppe_def.h"
+#include "rtl_ppe_format.h"
 
 /*============================================================================*
  *                          Private Macros
@@ -43,104 +44,6 @@ extern "C" {
   * \{
   */
 
-/** \defgroup PPE_PIXEL_FORMAT PPE Pixel Format
-  * \{
-  * \ingroup  PPE_Exported_Constants
-  */
-typedef enum
-{
-    PPE_ABGR8888 = 0x0,     /*!< ABGR8888: A(bit 31:24) B(bit 23:16) G(bit 15:8) R(bit 7:0) */
-    PPE_ARGB8888,           /*!< ARGB8888: A(bit 31:24) R(bit 23:16) G(bit 15:8) B(bit 7:0) */
-    PPE_XBGR8888,           /*!< XBGR8888: X(bit 31:24) B(bit 23:16) G(bit 15:8) R(bit 7:0) */
-    PPE_XRGB8888,           /*!< XRGB8888: X(bit 31:24) R(bit 23:16) G(bit 15:8) B(bit 7:0) */
-    PPE_BGRA8888,           /*!< BGRA8888: B(bit 31:24) G(bit 23:16) R(bit 15:8) A(bit 7:0) */
-    PPE_RGBA8888,           /*!< RGBA8888: R(bit 31:24) G(bit 23:16) B(bit 15:8) A(bit 7:0) */
-    PPE_BGRX8888,           /*!< BGRX8888: B(bit 31:24) G(bit 23:16) R(bit 15:8) X(bit 7:0) */
-    PPE_RGBX8888,           /*!< RGBX8888: R(bit 31:24) G(bit 23:16) B(bit 15:8) X(bit 7:0) */
-    PPE_ABGR4444,           /*!< ABGR4444: A(bit 15:12) B(bit 11:8) G(bit 7:4) R(bit 3:0) */
-    PPE_ARGB4444,           /*!< ARGB4444: A(bit 15:12) R(bit 11:8) G(bit 7:4) B(bit 3:0) */
-    PPE_XBGR4444,           /*!< XBGR4444: X(bit 15:12) B(bit 11:8) G(bit 7:4) R(bit 3:0) */
-    PPE_XRGB4444,           /*!< XRGB4444: X(bit 15:12) R(bit 11:8) G(bit 7:4) B(bit 3:0) */
-    PPE_BGRA4444,           /*!< BGRA4444: B(bit 15:12) G(bit 11:8) R(bit 7:4) A(bit 3:0) */
-    PPE_RGBA4444,           /*!< RGBA4444: R(bit 15:12) G(bit 11:8) B(bit 7:4) A(bit 3:0) */
-    PPE_BGRX4444,           /*!< BGRX4444: B(bit 15:12) G(bit 11:8) R(bit 7:4) X(bit 3:0) */
-    PPE_RGBX4444,           /*!< RGBX4444: R(bit 15:12) G(bit 11:8) B(bit 7:4) X(bit 3:0) */
-    PPE_ABGR2222,           /*!< ABGR2222: A(bit 7:6) B(bit 5:4) G(bit 3:2) R(bit 1:0) */
-    PPE_ARGB2222,           /*!< ARGB2222: A(bit 7:6) R(bit 5:4) G(bit 3:2) B(bit 1:0) */
-    PPE_XBGR2222,           /*!< XBGR2222: X(bit 7:6) B(bit 5:4) G(bit 3:2) R(bit 1:0) */
-    PPE_XRGB2222,           /*!< XRGB2222: X(bit 7:6) R(bit 5:4) G(bit 3:2) B(bit 1:0) */
-    PPE_BGRA2222,           /*!< BGRA2222: B(bit 7:6) G(bit 5:4) R(bit 3:2) A(bit 1:0) */
-    PPE_RGBA2222,           /*!< RGBA2222: R(bit 7:6) G(bit 5:4) B(bit 3:2) A(bit 1:0) */
-    PPE_BGRX2222,           /*!< BGRX2222: B(bit 7:6) G(bit 5:4) R(bit 3:2) X(bit 1:0) */
-    PPE_RGBX2222,           /*!< RGBX2222: R(bit 7:6) G(bit 5:4) B(bit 3:2) X(bit 1:0) */
-    PPE_ABGR8565,           /*!< ABGR8565: A(bit 23:16) B(bit 15:11) G(bit 10:5) R(bit 4:0) */
-    PPE_ARGB8565,           /*!< ARGB8565: A(bit 23:16) R(bit 15:11) G(bit 10:5) B(bit 4:0) */
-    PPE_XBGR8565,           /*!< XBGR8565: X(bit 23:16) B(bit 15:11) G(bit 10:5) R(bit 4:0) */
-    PPE_XRGB8565,           /*!< XRGB8565: X(bit 23:16) R(bit 15:11) G(bit 10:5) B(bit 4:0) */
-    PPE_BGRA5658,           /*!< BGRA5658: B(bit 23:19) G(bit 18:13) R(bit 12:8) A(bit 7:0) */
-    PPE_RGBA5658,           /*!< RGBA5658: R(bit 23:19) G(bit 18:13) B(bit 12:8) A(bit 7:0) */
-    PPE_BGRX5658,           /*!< BGRX5658: B(bit 23:19) G(bit 18:13) R(bit 12:8) X(bit 7:0) */
-    PPE_RGBX5658,           /*!< RGBX5658: R(bit 23:19) G(bit 18:13) B(bit 12:8) X(bit 7:0) */
-    PPE_ABGR1555,           /*!< ABGR1555: A(bit 15) B(bit 14:10) G(bit 9:5) R(bit 4:0) */
-    PPE_ARGB1555,           /*!< ARGB1555: A(bit 15) R(bit 14:10) G(bit 9:5) B(bit 4:0) */
-    PPE_XBGR1555,           /*!< XBGR1555: X(bit 15) B(bit 14:10) G(bit 9:5) R(bit 4:0) */
-    PPE_XRGB1555,           /*!< XRGB1555: X(bit 15) R(bit 14:10) G(bit 9:5) B(bit 4:0) */
-    PPE_BGRA5551,           /*!< BGRA5551: B(bit 15:11) G(bit 10:6) R(bit 5:1) A(bit 0) */
-    PPE_RGBA5551,           /*!< RGBA5551: R(bit 15:11) G(bit 10:6) B(bit 5:1) A(bit 0) */
-    PPE_BGRX5551,           /*!< BGRX5551: B(bit 15:11) G(bit 10:6) R(bit 5:1) X(bit 0) */
-    PPE_RGBX5551,           /*!< RGBX5551: R(bit 15:11) G(bit 10:6) B(bit 5:1) X(bit 0) */
-    PPE_BGR888,             /*!< BGR888: B(bit 23:16) G(bit 15:8) R(bit 7:0) */
-    PPE_RGB888,             /*!< RGB888: R(bit 23:16) G(bit 15:8) B(bit 7:0) */
-    PPE_BGR565,             /*!< BGR565: B(bit 15:11) G(bit 10:5) R(bit 4:0) */
-    PPE_RGB565,             /*!< RGB565: R(bit 15:11) G(bit 10:5) B(bit 4:0) */
-    PPE_A8,                 /*!< A8: A(bit 7:0) */
-    PPE_X8,                 /*!< X8: X(bit 7:0) */
-    PPE_ABGR8666 = 0x32,    /*!< ABGR8666: A(bit 31:24) B(bit 23:18) G(bit 15:10) R(bit 8:2) */
-    PPE_ARGB8666,           /*!< ARGB8666: A(bit 31:24) R(bit 23:18) G(bit 15:10) B(bit 8:2) */
-    PPE_XBGR8666,           /*!< XBGR8666: X(bit 31:24) B(bit 23:18) G(bit 15:10) R(bit 8:2) */
-    PPE_XRGB8666,           /*!< XRGB8666: X(bit 31:24) R(bit 23:18) G(bit 15:10) B(bit 8:2) */
-    PPE_BGRA6668,           /*!< BGRA6668: B(bit 31:26) G(bit 23:18) R(bit 15:10) A(bit 7:0) */
-    PPE_RGBA6668,           /*!< RGBA6668: R(bit 31:26) G(bit 23:18) B(bit 15:10) A(bit 7:0) */
-    PPE_BGRX6668,           /*!< BGRX6668: B(bit 31:26) G(bit 23:18) R(bit 15:10) X(bit 7:0) */
-    PPE_RGBX6668,           /*!< RGBX6668: R(bit 31:26) G(bit 23:18) B(bit 15:10) X(bit 7:0) */
-    PPE_FORMAT_NOT_SUPPORT = 0xFF, /*!< Other color formats are not supported */
-} PPE_PIXEL_FORMAT;
-/** End of PPE_PIXEL_FORMAT
-  * \}
-  */
-
-/** \defgroup PPE_ERR PPE Error Code
-  * \{
-  * \ingroup  PPE_Exported_Constants
-  */
-typedef enum
-{
-    PPE_SUCCESS,                    /*!< No error occurred. */
-    PPE_SUCCESS_NOT_CHANGE,         /*!< No error occurred and PPE takes no operation. */
-    PPE_ERROR_ADDR_NOT_ALIGNED,     /*!< Input buffer address is not aligned to 4 bytes. */
-    PPE_ERROR_INVALID_PARAM,        /*!< Scissor or blending area is invalid. */
-    PPE_ERROR_UNKNOWN_FORMAT,       /*!< Color format not supported. */
-    PPE_ERROR_NULL_SOURCE,          /*!< Blending source is invalid. */
-    PPE_ERROR_NULL_TARGET,          /*!< Blending target is invalid. */
-    PPE_ERROR_OUT_OF_RANGE,         /*!< Image is out of blending area. */
-} PPE_ERR;
-/** End of PPE_ERR
-  * \}
-  */
-
-/** \defgroup PPE_BLEND_MODE PPE Blend Mode
-  * \{
-  * \ingroup  PPE_Exported_Constants
-  */
-typedef enum
-{
-    PPE_BYPASS_MODE,    /*!< Bypass mode: D = S */
-    PPE_SRC_OVER_MODE,  /*!< Source over mode: D = (1 - a) * D + S * a */
-} PPE_BLEND_MODE;
-/** End of PPE_BLEND_MODE
-  * \}
-  */
-
 /** \defgroup PPE_INTERRUPT PPE Interrupt
   * \{
   * \ingroup  PPE_Exported_Constants
@@ -172,85 +75,6 @@ typedef enum
   * \{
   */
 
-/** \defgroup PPE_RECT PPE Rectrangle
-  * \{
-  * \ingroup  PPE_Exported_Types
-  */
-typedef struct
-{
-    union
-    {
-        int32_t left;   /*!< Coordinate of left boarder, same with x1. */
-        int32_t x1;     /*!< Coordinate of left boarder, same with left. */
-    }; /*!< Union of left and x1. */
-    union
-    {
-        int32_t top;   /*!< Coordinate of top boarder, same with y1. */
-        int32_t y1;    /*!< Coordinate of top boarder, same with top. */
-    }; /*!< Union of top and y1. */
-    union
-    {
-        int32_t right; /*!< Coordinate of right boarder, same with x2. */
-        int32_t x2;    /*!< Coordinate of right boarder, same with right. */
-    }; /*!< Union of right and x2. */
-    union
-    {
-        int32_t bottom; /*!< Coordinate of bottom boarder, same with y2. */
-        int32_t y2;    /*!< Coordinate of bottom boarder, same with bottom. */
-    }; /*!< Union of bottom and y2. */
-} ppe_rect_t;
-/** End of PPE_RECT
-  * \}
-  */
-
-/** \defgroup PPE_TRANS PPE Position Translation
-  * \{
-  * \ingroup  PPE_Exported_Types
-  */
-typedef struct
-{
-    int32_t x;  /*!< Horizontal translation on blend target. */
-    int32_t y;  /*!< Vertical translation on blend target. */
-} ppe_translate_t;
-/** End of PPE_TRANS
-  * \}
-  */
-
-/** \defgroup PPE_BUFFER PPE Buffer Structure
-  * \{
-  * \ingroup  PPE_Exported_Types
-  */
-typedef struct
-{
-    uint32_t *memory;  /*!< Pointer to memory of blend buffer. */
-    uint32_t address;  /*!< Unsigned integer of buffer address, has the same value with member 'memory'. */
-    PPE_PIXEL_FORMAT format; /*!< Pixel format of buffer, can be a value of @ref PPE_PIXEL_FORMAT . */
-    bool global_alpha_en;  /*!< Control additional opacity placed on image. */
-    uint8_t global_alpha;  /*!< Value of additional opacity. */
-    bool color_key_en; /*!< Control color key of image. */
-    uint32_t color_key_value; /*!< Pixel value that equals to color key value will be filtered. */
-    uint16_t width;    /*!< Width of image. */
-    uint16_t height;   /*!< Height of image. */
-    uint16_t stride;   /*!< Stride of image between 2 contiguous lines. */
-} ppe_buffer_t;
-/** End of PPE_BUFFER
-  * \}
-  */
-
-/** \defgroup PPE_LAYER PPE Layer Configuration
-  * \{
-  * \ingroup  PPE_Exported_Types
-  */
-typedef struct
-{
-    ppe_buffer_t buffer;   /*!< Image buffer to be draw onto layer, described in @ref PPE_BUFFER. */
-    ppe_rect_t *rect;      /*!< Draw area constraint, described in @ref PPE_RECT. */
-    ppe_translate_t trans; /*!< Relative position, described in @ref PPE_TRANS . */
-} ppe_layer_t;
-/** End of PPE_LAYER
-  * \}
-  */
-
 /** \defgroup PPE_LAYER_LIST PPE Layer Configuration List
   * \{
   * \ingroup  PPE_Exported_Types
@@ -0,0 +1,321 @@
+/**
+*********************************************************************************************************
+*               Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*********************************************************************************************************
+* \file     rtl_ppe_dl.h
+* \brief    This file provides the PPE display list functions.
+* \details  Drawing operations are recorded with their target rectangles, and drawn only
+*           inside the dirty rectangles when the list is flushed. The operations covering
+*           a dirty rectangle are packed into passes of up to 4 PPE input layers.
+* \version  v1.0
+*********************************************************************************************************
+*/
+
+/*============================================================================*
+ *               Define to prevent recursive inclusion
+ *============================================================================*/
+#ifndef RTL_PPE_DL_H
+#define RTL_PPE_DL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================*
+ *                        Header Files
+ *============================================================================*/
+#include "rtl_ppe_format.h"
+
+/** \defgroup PPE_DL       PPE Display List
+  * \brief    Record drawing operations and draw the dirty area in batched PPE passes
+  * \details  Flushing a display list works as below:
+  *           - The dirty rectangles are clipped to the target. Overlapping rectangles are
+  *             merged, as are close rectangles if the merged one wastes no more than
+  *             PPE_DL_MERGE_SLACK pixels. So no pixel is drawn twice.
+  *           - Each dirty rectangle is a tile. The operations before the last one that
+  *             covers the whole tile with opaque pixels are dropped for that tile.
+  *           - The remaining operations become the layers of a pass, the bottom layer is
+  *             the target itself or the covering operation. A full pass is followed by a
+  *             pass whose bottom layer is the target again.
+  *           - A scale operation is drawn alone, after everything recorded before it.
+  *
+  *           The passes of all tiles are handed to the back end together, so the hardware
+  *           back end starts each pass from the completion interrupt of the previous one.
+  * \{
+  */
+
+/*============================================================================*
+ *                         Constants
+ *============================================================================*/
+/** \defgroup PPE_DL_Exported_Constants PPE Display List Exported Constants
+  * \{
+  */
+
+#define PPE_DL_PASS_LAYER_MAX        4      /*!< Input layers of a PPE pass. */
+
+/** \brief Close dirty rectangles are merged if the merged one covers no more than this many extra pixels. */
+#ifndef PPE_DL_MERGE_SLACK
+#define PPE_DL_MERGE_SLACK           1024
+#endif
+
+/** \defgroup PPE_DL_OP_TYPE PPE Display List Operation Type
+  * \{
+  * \ingroup  PPE_DL_Exported_Constants
+  */
+typedef enum
+{
+    PPE_DL_OP_CLEAR,    /*!< Fill a rectangle with a color, blended as PPE_Clear_Rect does. */
+    PPE_DL_OP_BLEND,    /*!< Blend an image as PPE_Blend_Rect does. */
+    PPE_DL_OP_SCALE,    /*!< Scale an image into a buffer as PPE_Scale does. */
+} PPE_DL_OP_TYPE;
+/** End of PPE_DL_OP_TYPE
+  * \}
+  */
+
+/** End of PPE_DL_Exported_Constants
+  * \}
+  */
+
+/*============================================================================*
+ *                         Types
+ *============================================================================*/
+/** \defgroup PPE_DL_Exported_Types PPE Display List Exported Types
+  * \{
+  */
+
+/** \defgroup PPE_DL_LAYER PPE Display List Pass Layer
+  * \{
+  * \ingroup  PPE_DL_Exported_Types
+  */
+typedef struct
+{
+    const ppe_buffer_t *image;  /*!< Image of the layer, NULL for a layer of constant color. */
+    uint32_t color;             /*!< Color in ABGR8888 format of a constant layer. */
+    ppe_rect_t rect;            /*!< Area of the layer on the target, inside the pass window. */
+    int32_t src_x;              /*!< Horizontal position in the image of the left of rect. */
+    int32_t src_y;              /*!< Vertical position in the image of the top of rect. */
+} ppe_dl_layer_t;
+/** End of PPE_DL_LAYER
+  * \}
+  */
+
+/** \defgroup PPE_DL_PASS PPE Display List Pass
+  * \{
+  * \ingroup  PPE_DL_Exported_Types
+  */
+typedef struct
+{
+    ppe_buffer_t *target;       /*!< Target buffer. */
+    ppe_rect_t window;          /*!< Area of the target written by the pass. */
+    uint8_t layer_num;          /*!< Number of layers, the first one covers the whole window. */
+    ppe_dl_layer_t layer[PPE_DL_PASS_LAYER_MAX]; /*!< Layers from bottom to top. */
+} ppe_dl_pass_t;
+/** End of PPE_DL_PASS
+  * \}
+  */
+
+/** \defgroup PPE_DL_BACKEND PPE Display List Back End
+  * \{
+  * \ingroup  PPE_DL_Exported_Types
+  */
+typedef struct
+{
+    /** Start drawing the passes in order, the passes stay valid until wait returns. */
+    PPE_ERR(*submit)(const ppe_dl_pass_t *pass, uint32_t pass_num);
+    /** Wait until the submitted passes are drawn. */
+    PPE_ERR(*wait)(void);
+    /** Scale an image, with the semantics of PPE_Scale. */
+    PPE_ERR(*scale)(ppe_buffer_t *image, ppe_buffer_t *buffer, float x_ratio, float y_ratio);
+} ppe_dl_backend_t;
+/** End of PPE_DL_BACKEND
+  * \}
+  */
+
+/** \defgroup PPE_DL_OP PPE Display List Operation
+  * \{
+  * \ingroup  PPE_DL_Exported_Types
+  */
+typedef struct
+{
+    PPE_DL_OP_TYPE type;        /*!< Operation type. */
+    PPE_BLEND_MODE blend_mode;  /*!< Blend mode of PPE_DL_OP_BLEND. */
+    uint32_t color;             /*!< Color in ABGR8888 format of PPE_DL_OP_CLEAR. */
+    ppe_rect_t rect;            /*!< Area drawn on the target. */
+    ppe_translate_t trans;      /*!< Position of the image on the target. */
+    ppe_buffer_t image;         /*!< Source image of PPE_DL_OP_BLEND and PPE_DL_OP_SCALE. */
+    ppe_buffer_t *buffer;       /*!< Output buffer of PPE_DL_OP_SCALE. */
+    float x_ratio;              /*!< Horizontal ratio of PPE_DL_OP_SCALE. */
+    float y_ratio;              /*!< Vertical ratio of PPE_DL_OP_SCALE. */
+} ppe_dl_op_t;
+/** End of PPE_DL_OP
+  * \}
+  */
+
+/** \defgroup PPE_DL_STATS PPE Display List Statistics
+  * \{
+  * \ingroup  PPE_DL_Exported_Types
+  */
+typedef struct
+{
+    uint32_t tile_num;          /*!< Dirty rectangles drawn. */
+    uint32_t pass_num;          /*!< Passes drawn. */
+    uint32_t layer_num;         /*!< Layers of all passes. */
+    uint32_t pixel_num;         /*!< Pixels written by all passes. */
+    uint32_t submit_num;        /*!< Times the back end was started. */
+} ppe_dl_stats_t;
+/** End of PPE_DL_STATS
+  * \}
+  */
+
+/** \defgroup PPE_DL_LIST PPE Display List
+  * \{
+  * \ingroup  PPE_DL_Exported_Types
+  */
+typedef struct
+{
+    ppe_buffer_t *target;               /*!< Target buffer. */
+    const ppe_dl_backend_t *backend;    /*!< Back end drawing the passes. */
+    ppe_dl_op_t *op;                    /*!< Operation storage. */
+    uint16_t op_max;                    /*!< Size of op. */
+    uint16_t op_num;                    /*!< Recorded operations. */
+    ppe_rect_t *dirty;                  /*!< Dirty rectangle storage. */
+    uint16_t dirty_max;                 /*!< Size of dirty. */
+    uint16_t dirty_num;                 /*!< Dirty rectangles, the whole target if 0. */
+    ppe_dl_pass_t *pass;                /*!< Pass storage. */
+    uint16_t pass_max;                  /*!< Size of pass. */
+    ppe_dl_stats_t stats;               /*!< Statistics of the last flush. */
+} ppe_dl_t;
+/** End of PPE_DL_LIST
+  * \}
+  */
+
+/** End of PPE_DL_Exported_Types
+  * \}
+  */
+
+/*============================================================================*
+ *                         Functions
+ *============================================================================*/
+/** \defgroup PPE_DL_Exported_Functions PPE Display List Exported Functions
+  * \{
+  */
+
+/**
+ * \brief  Initialize a display list.
+ * \param[in] dl: Display list to be initialized.
+ * \param[in] target: Target buffer.
+ * \param[in] backend: Back end drawing the passes, such as @ref ppe_dl_hw_backend.
+ * \param[in] op: Storage of op_max operations.
+ * \param[in] dirty: Storage of dirty_max dirty rectangles.
+ * \param[in] pass: Storage of pass_max passes.
+ *
+ * <b>Example usage</b>
+ * \code{.c}
+    static ppe_dl_op_t op[32];
+    static ppe_rect_t dirty[8];
+    static ppe_dl_pass_t pass[16];
+    static ppe_dl_t dl;
+
+    void demo_code(void){
+        PPE_DL_Init(&dl, &frame_buffer, &ppe_dl_hw_backend, op, 32, dirty, 8, pass, 16);
+        PPE_DL_Clear(&dl, NULL, 0xFF000000);
+        PPE_DL_Blend(&dl, &icon, &trans, NULL, PPE_SRC_OVER_MODE);
+        PPE_DL_Add_Dirty(&dl, &icon_rect);
+        PPE_ERR err = PPE_DL_Flush(&dl);
+    }
+ * \endcode
+ */
+void PPE_DL_Init(ppe_dl_t *dl, ppe_buffer_t *target, const ppe_dl_backend_t *backend,
+                 ppe_dl_op_t *op, uint16_t op_max, ppe_rect_t *dirty, uint16_t dirty_max,
+                 ppe_dl_pass_t *pass, uint16_t pass_max);
+
+/**
+ * \brief  Drop the recorded operations and dirty rectangles.
+ * \param[in] dl: Display list.
+ */
+void PPE_DL_Reset(ppe_dl_t *dl);
+
+/**
+ * \brief  Record filling a rectangle with a color.
+ * \param[in] dl: Display list.
+ * \param[in] rect: Area on the target, NULL for the whole target.
+ * \param[in] color: Color in ABGR8888 format.
+ * \return Operation result.
+ * \retval PPE_SUCCESS  Operation success.
+ * \retval Others       Operation failure, cause refers to @ref PPE_ERR .
+ */
+PPE_ERR PPE_DL_Clear(ppe_dl_t *dl, ppe_rect_t *rect, uint32_t color);
+
+/**
+ * \brief  Record blending an image onto the target.
+ * \param[in] dl: Display list.
+ * \param[in] image: Source image, copied into the list. The pixels must stay valid until flushed.
+ * \param[in] trans: Position of the image on the target.
+ * \param[in] rect: Area on the target the image is limited to, NULL for no limit.
+ * \param[in] blend_mode: Blend mode from @ref PPE_BLEND_MODE.
+ * \return Operation result.
+ * \retval PPE_SUCCESS  Operation success.
+ * \retval Others       Operation failure, cause refers to @ref PPE_ERR .
+ */
+PPE_ERR PPE_DL_Blend(ppe_dl_t *dl, ppe_buffer_t *image, ppe_translate_t *trans,
+                     ppe_rect_t *rect, PPE_BLEND_MODE blend_mode);
+
+/**
+ * \brief  Record scaling an image into a buffer, which later operations can blend.
+ * \param[in] dl: Display list.
+ * \param[in] image: Source image, copied into the list.
+ * \param[in] buffer: Output buffer, its width, height and stride are set here.
+ * \param[in] x_ratio: Scale ratio on horizontal direction.
+ * \param[in] y_ratio: Scale ratio on vertical direction.
+ * \return Operation result.
+ * \retval PPE_SUCCESS  Operation success.
+ * \retval Others       Operation failure, cause refers to @ref PPE_ERR .
+ */
+PPE_ERR PPE_DL_Scale(ppe_dl_t *dl, ppe_buffer_t *image, ppe_buffer_t *buffer, float x_ratio,
+                     float y_ratio);
+
+/**
+ * \brief  Mark an area of the target to be drawn by the next flush.
+ * \param[in] dl: Display list.
+ * \param[in] rect: Area on the target.
+ */
+void PPE_DL_Add_Dirty(ppe_dl_t *dl, ppe_rect_t *rect);
+
+/**
+ * \brief  Draw the recorded operations inside the dirty area, then reset the list.
+ * \param[in] dl: Display list.
+ * \return Operation result.
+ * \retval PPE_SUCCESS  Operation success.
+ * \retval Others       Operation failure, cause refers to @ref PPE_ERR .
+ */
+PPE_ERR PPE_DL_Flush(ppe_dl_t *dl);
+
+/** End of PPE_DL_Exported_Functions
+  * \}
+  */
+
+/** \defgroup PPE_DL_Exported_Variables PPE Display List Exported Variables
+  * \{
+  */
+
+/** \brief Back end drawing by the PPE, passes are chained by the PPE interrupt. */
+extern const ppe_dl_backend_t ppe_dl_hw_backend;
+
+/** \brief Back end drawing by the CPU, with the blending semantics of the PPE. */
+extern const ppe_dl_backend_t ppe_dl_sw_backend;
+
+/** End of PPE_DL_Exported_Variables
+  * \}
+  */
+
+/** End of PPE_DL
+  * \}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTL_PPE_DL_H */
+
+/******************* (C) COPYRIGHT 2023 Realtek Semiconductor Corporation *****END OF FILE****/
@@ -0,0 +1,262 @@
+/**
+*********************************************************************************************************
+*               Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*********************************************************************************************************
+* \file     rtl_ppe_sw.h
+* \brief    This file provides the software PPE functions.
+* \details  The functions draw the same pixels as their PPE counterparts in rtl_ppe.h,
+*           so they can run on parts without PPE or in a simulator, and serve as the
+*           reference the PPE output is checked against.
+* \version  v1.0
+*********************************************************************************************************
+*/
+
+/*============================================================================*
+ *               Define to prevent recursive inclusion
+ *============================================================================*/
+#ifndef RTL_PPE_SW_H
+#define RTL_PPE_SW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================*
+ *                        Header Files
+ *============================================================================*/
+#include "rtl_ppe_format.h"
+
+/** \defgroup PPE_SW       PPE Software Engine
+  * \brief    Draw PPE operations by CPU
+  * \details  Every pixel goes through the same steps as in the PPE:
+  *           - The pixel is read in its format and expanded to ABGR8888. Channels narrower
+  *             than 8 bits are expanded by bit replication, the alpha of formats without
+  *             alpha, and of the X formats, is 0xFF. A8 pixels are black.
+  *           - A pixel equal to the color key, compared in its own format, becomes
+  *             transparent black.
+  *           - The alpha is multiplied by the global alpha: a = a * global_alpha / 255.
+  *           - The pixel is blended onto the pixel below it in ABGR8888:
+  *             C = (Cs * a + Cd * (255 - a)) / 255, A = a + Ad * (255 - a) / 255, rounded.
+  *             Bypass mode blends onto transparent black.
+  *           - The result is truncated to the target format, X bits are written as 1.
+  *             A single layer, as in PPE_Clear() and an opaque PPE_Clear_Rect(), is
+  *             stored without blending.
+  *
+  *           Scaling takes the nearest source pixel, stepping 65536 / ratio in 16.16
+  *           fixed point as the PPE does.
+  *
+  *           Lines are blended in chunks of PPE_SW_CHUNK pixels on the stack. The blend
+  *           kernel uses AVX2 or SSE2 when the compiler targets them, and can be replaced
+  *           by PPE_SW_Set_Blend_Kernel(), e.g. with a Helium or DSP implementation. A
+  *           kernel must give the same result as PPE_SW_Blend_Line_Ref().
+  * \{
+  */
+
+/*============================================================================*
+ *                         Constants
+ *============================================================================*/
+/** \defgroup PPE_SW_Exported_Constants PPE Software Engine Exported Constants
+  * \{
+  */
+
+/** \brief Pixels processed at a time, two ABGR8888 lines of this length live on the stack. */
+#ifndef PPE_SW_CHUNK
+#define PPE_SW_CHUNK                 64
+#endif
+
+/** End of PPE_SW_Exported_Constants
+  * \}
+  */
+
+/*============================================================================*
+ *                         Types
+ *============================================================================*/
+/** \defgroup PPE_SW_Exported_Types PPE Software Engine Exported Types
+  * \{
+  */
+
+/**
+ * \brief  Blend kernel, blends num ABGR8888 pixels of src onto dst in place.
+ */
+typedef void (*ppe_sw_blend_kernel_t)(uint32_t *dst, const uint32_t *src, uint32_t num);
+
+/** End of PPE_SW_Exported_Types
+  * \}
+  */
+
+/*============================================================================*
+ *                         Functions
+ *============================================================================*/
+/** \defgroup PPE_SW_Exported_Functions PPE Software Engine Exported Functions
+  * \{
+  */
+
+/**
+ * \brief  Scale image by software, same as PPE_Scale().
+ * \param[in] image: Pointer to input image buffer.
+ * \param[in,out] buffer: Pointer to output image buffer, its width and height are set here.
+ * \param[in] x_ratio: Scale ration on horizontal direction.
+ * \param[in] y_ratio: Scale ration on vertical direction.
+ * \return Operation result.
+ * \retval PPE_SUCCESS  Operation success.
+ * \retval Others       Operation failure, cause refers to @ref PPE_ERR .
+ */
+PPE_ERR PPE_SW_Scale(ppe_buffer_t *image, ppe_buffer_t *buffer, float x_ratio, float y_ratio);
+
+/**
+ * \brief  Scale a part of image by software, same as PPE_Scale_Rect().
+ * \param[in] image: Pointer to input image buffer.
+ * \param[in,out] buffer: Pointer to output image buffer, its width, height and stride are set here.
+ * \param[in] x_ratio: Scale ration on horizontal direction.
+ * \param[in] y_ratio: Scale ration on vertical direction.
+ * \param[in] rect: Boundary inside the input image.
+ * \return Operation result.
+ * \retval PPE_SUCCESS  Operation success.
+ * \retval Others       Operation failure, cause refers to @ref PPE_ERR .
+ */
+PPE_ERR PPE_SW_Scale_Rect(ppe_buffer_t *image, ppe_buffer_t *buffer, float x_ratio,
+                          float y_ratio, ppe_rect_t *rect);
+
+/**
+ * \brief  Clear the buffer by software, same as PPE_Clear().
+ * \param[in] buffer: Target buffer to be cleared.
+ * \param[in] color: Specified color in ABGR8888 format \ref PPE_ABGR8888
+ * \return Operation result.
+ * \retval PPE_SUCCESS  Operation success.
+ * \retval Others       Operation failure, cause refers to @ref PPE_ERR .
+ */
+PPE_ERR PPE_SW_Clear(ppe_buffer_t *buffer, uint32_t color);
+
+/**
+ * \brief  Clear a part of buffer by software, same as PPE_Clear_Rect().
+ * \param[in] buffer: Target buffer to be cleared.
+ * \param[in] rect: Area of buffer to be cleared.
+ * \param[in] color: Specified color in ABGR8888 format \ref PPE_ABGR8888, blended if not opaque.
+ * \return Operation result.
+ * \retval PPE_SUCCESS  Operation success.
+ * \retval Others       Operation failure, cause refers to @ref PPE_ERR .
+ */
+PPE_ERR PPE_SW_Clear_Rect(ppe_buffer_t *buffer, ppe_rect_t *rect, uint32_t color);
+
+/**
+ * \brief  Blend source image onto target buffer by software, same as PPE_Blend().
+ * \param[in] image: Source image buffer to be blended.
+ * \param[in] buffer: Target image buffer to be blended onto.
+ * \param[in] trans: Position information of source image.
+ * \param[in] blend_mode: Blend mode from @ref PPE_BLEND_MODE to be used.
+ * \return Operation result.
+ * \retval PPE_SUCCESS  Operation success.
+ * \retval Others       Operation failure, cause refers to @ref PPE_ERR .
+ *
+ * <b>Example usage</b>
+ * \code{.c}
+    void test_code(void){
+        ppe_buffer_t image, buffer;
+        ppe_translate_t trans = {20, 20};
+        PPE_ERR err = PPE_SW_Blend(&image, &buffer, &trans, PPE_SRC_OVER_MODE);
+    }
+ * \endcode
+ */
+PPE_ERR PPE_SW_Blend(ppe_buffer_t *image, ppe_buffer_t *buffer, ppe_translate_t *trans,
+                     PPE_BLEND_MODE blend_mode);
+
+/**
+ * \brief  Blend source image to certain area of target buffer by software, same as PPE_Blend_Rect().
+ * \param[in] image: Source image buffer to be blended.
+ * \param[in] buffer: Target image buffer to be blended onto.
+ * \param[in] trans: Position information of source image.
+ * \param[in] rect: Constraint blend area, also clipped to the buffer.
+ * \param[in] blend_mode: Blend mode from @ref PPE_BLEND_MODE to be used.
+ * \return Operation result.
+ * \retval PPE_SUCCESS  Operation success.
+ * \retval Others       Operation failure, cause refers to @ref PPE_ERR .
+ */
+PPE_ERR PPE_SW_Blend_Rect(ppe_buffer_t *image, ppe_buffer_t *buffer, ppe_translate_t *trans,
+                          ppe_rect_t *rect, PPE_BLEND_MODE blend_mode);
+
+/**
+ * \brief  Place mask on target area by software, same as PPE_Mask().
+ * \param[in] src: Source buffer.
+ * \param[in] target: Target buffer, the masked area is stored from its start with a stride of the area width.
+ * \param[in] rect: The boundary of the part to be masked.
+ * \param[in] color: Specified color in ABGR8888 format. \ref PPE_ABGR8888
+ * \return Operation result.
+ * \retval PPE_SUCCESS  Operation success.
+ * \retval Others       Operation failure, cause refers to @ref PPE_ERR .
+ */
+PPE_ERR PPE_SW_Mask(ppe_buffer_t *src, ppe_buffer_t *target, ppe_rect_t *rect, uint32_t color);
+
+/**
+ * \brief  Get pixel size of specified format, same as ppe_get_format_data_len().
+ * \param[in] format: Pixel format of PPE from @ref PPE_PIXEL_FORMAT .
+ * \return Pixel size in bytes, 0 if the format is not supported.
+ */
+uint8_t ppe_sw_get_format_data_len(PPE_PIXEL_FORMAT format);
+
+/**
+ * \brief  Read pixels of an image as ABGR8888, with its color key and global alpha applied.
+ * \param[in] image: Image the pixels belong to, only the format, color key and global alpha are used.
+ * \param[in] pixel: Address of the first pixel.
+ * \param[in] num: Number of pixels.
+ * \param[out] out: ABGR8888 pixels.
+ */
+void PPE_SW_Load_Line(const ppe_buffer_t *image, const void *pixel, uint32_t num, uint32_t *out);
+
+/**
+ * \brief  Write ABGR8888 pixels in a pixel format.
+ * \param[in] format: Pixel format of the destination.
+ * \param[out] pixel: Address of the first destination pixel.
+ * \param[in] in: ABGR8888 pixels.
+ * \param[in] num: Number of pixels.
+ */
+void PPE_SW_Store_Line(PPE_PIXEL_FORMAT format, void *pixel, const uint32_t *in, uint32_t num);
+
+/**
+ * \brief  Blend ABGR8888 pixels onto ABGR8888 pixels with the current blend kernel.
+ * \param[in,out] dst: Lower pixels, replaced by the result.
+ * \param[in] src: Upper pixels.
+ * \param[in] num: Number of pixels.
+ */
+void PPE_SW_Blend_Line(uint32_t *dst, const uint32_t *src, uint32_t num);
+
+/**
+ * \brief  Reference blend kernel in plain C, the result every kernel must match.
+ * \param[in,out] dst: Lower pixels, replaced by the result.
+ * \param[in] src: Upper pixels.
+ * \param[in] num: Number of pixels.
+ */
+void PPE_SW_Blend_Line_Ref(uint32_t *dst, const uint32_t *src, uint32_t num);
+
+/**
+ * \brief  Replace the blend kernel.
+ * \param[in] kernel: New kernel, NULL restores the built-in one.
+ *
+ * <b>Example usage</b>
+ * \code{.c}
+    static void helium_blend(uint32_t *dst, const uint32_t *src, uint32_t num)
+    {
+        //Blend with MVE intrinsics
+    }
+
+    void test_code(void){
+        PPE_SW_Set_Blend_Kernel(helium_blend);
+    }
+ * \endcode
+ */
+void PPE_SW_Set_Blend_Kernel(ppe_sw_blend_kernel_t kernel);
+
+/** End of PPE_SW_Exported_Functions
+  * \}
+  */
+
+/** End of PPE_SW
+  * \}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTL_PPE_SW_H */
+
+/******************* (C) COPYRIGHT 2023 Realtek Semiconductor Corporation *****END OF FILE****/
@@ -0,0 +1,227 @@
+/**
+*********************************************************************************************************
+*               Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*********************************************************************************************************
+* \file     rtl_ppe_dl_hw.c
+* \brief    This file provides the PPE back end of the PPE display list.
+* \details  The passes of a submit are programmed one by one from the PPE_ALL_OVER_INT
+*           interrupt, so the CPU is free while the PPE works through the list.
+* \version  v1.0
+*********************************************************************************************************
+*/
+
+/*============================================================================*
+ *                        Header Files
+ *============================================================================*/
+#include "rtl_ppe.h"
+#include "rtl_ppe_dl.h"
+#include "rtl_ppe_int.h"
+#include "rtl_rcc.h"
+#include "rtl_nvic.h"
+
+/*============================================================================*
+ *                           Private Variables
+ *============================================================================*/
+static const ppe_dl_pass_t *ppe_dl_hw_pass = NULL;
+static uint32_t ppe_dl_hw_pass_num = 0;
+static volatile uint32_t ppe_dl_hw_pass_idx = 0;
+static volatile bool ppe_dl_hw_busy = false;
+
+/*============================================================================*
+ *                           Private Functions
+ *============================================================================*/
+static uint16_t ppe_dl_hw_line_len(const ppe_buffer_t *buffer)
+{
+    return (buffer->stride != 0) ? buffer->stride : buffer->width;
+}
+
+static void ppe_dl_hw_init_layer(uint8_t id, const ppe_dl_pass_t *pass, const ppe_dl_layer_t *layer)
+{
+    PPE_InputLayer_InitTypeDef PPE_Input_Layer;
+    const ppe_buffer_t *image = layer->image;
+
+    PPE_InputLayer_StructInit(&PPE_Input_Layer);
+    PPE_Input_Layer.start_x                        = layer->rect.left - pass->window.left;
+    PPE_Input_Layer.start_y                        = layer->rect.top - pass->window.top;
+    PPE_Input_Layer.width                          = layer->rect.right - layer->rect.left + 1;
+    PPE_Input_Layer.height                         = layer->rect.bottom - layer->rect.top + 1;
+    if (image == NULL)
+    {
+        PPE_Input_Layer.src_addr                   = (uint32_t)NULL;
+        PPE_Input_Layer.const_ABGR8888_value       = layer->color;
+        PPE_Input_Layer.format                     = PPE_ARGB8888;
+        PPE_Input_Layer.src                        = PPE_LAYER_SRC_CONST;
+        PPE_Input_Layer.line_len                   = PPE_Input_Layer.width;
+        PPE_Input_Layer.color_key_en               = DISABLE;
+        PPE_Input_Layer.key_color_value            = 0;
+    }
+    else
+    {
+        PPE_Input_Layer.src_addr                   = (uint32_t)image->memory +
+                                                     (layer->src_x + layer->src_y * ppe_dl_hw_line_len(image)) *
+                                                     ppe_get_format_data_len(image->format);
+        if (image->global_alpha_en)
+        {
+            PPE_Input_Layer.const_ABGR8888_value   = image->global_alpha << 24;
+        }
+        else
+        {
+            PPE_Input_Layer.const_ABGR8888_value   = 0xFFFFFFFF;
+        }
+        PPE_Input_Layer.format                     = image->format;
+        PPE_Input_Layer.src                        = PPE_LAYER_SRC_FROM_DMA;
+        PPE_Input_Layer.line_len                   = ppe_dl_hw_line_len(image);
+        PPE_Input_Layer.color_key_en               = image->color_key_en ? ENABLE : DISABLE;
+        PPE_Input_Layer.key_color_value            = image->color_key_value;
+    }
+    PPE_Input_Layer.AXSIZE                         = 2;// 32bit bandwidth;
+    PPE_Input_Layer.INCR                           = PPE_ARBURST_INCR;
+    PPE_Input_Layer.AXCACHE                        = 1;
+    PPE_Input_Layer.MAX_AXLEN_LOG                  = PPE_MAX_AXLEN_127;
+    PPE_Input_Layer.PRIOR                          = 0;
+    PPE_Input_Layer.byte_swap                      = PPE_NO_SWAP;
+    PPE_Input_Layer.handshake_mode                 = PPE_DMA_SW_HANDSHAKE;
+    PPE_Input_Layer.polarity                       = PPE_POLARITY_HIGH;
+    PPE_Input_Layer.handshake_en                   = DISABLE;
+    PPE_Input_Layer.handshake_msize                = PPE_MSIZE_1024;
+    PPE_Input_Layer.hw_index                       = 0;
+    PPE_InitInputLayer(id, &PPE_Input_Layer);
+}
+
+static void ppe_dl_hw_start(const ppe_dl_pass_t *pass)
+{
+    PPE_ResultLayer_InitTypeDef PPE_Result_Layer;
+    PPE_InitTypeDef PPE_Init_User;
+    const ppe_buffer_t *target = pass->target;
+    uint8_t i;
+
+    for (i = 0; i < pass->layer_num; i++)
+    {
+        ppe_dl_hw_init_layer(i + 1, pass, &pass->layer[i]);
+    }
+
+    PPE_ResultLayer_StructInit(&PPE_Result_Layer);
+    PPE_Result_Layer.width                          = pass->window.right - pass->window.left + 1;
+    PPE_Result_Layer.height                         = pass->window.bottom - pass->window.top + 1;
+    PPE_Result_Layer.src_addr                       = (uint32_t)target->memory +
+                                                      (pass->window.left + pass->window.top * ppe_dl_hw_line_len(target)) *
+                                                      ppe_get_format_data_len(target->format);
+    PPE_Result_Layer.format                         = target->format;
+    PPE_Result_Layer.line_len                       = ppe_dl_hw_line_len(target);
+    PPE_Result_Layer.AXSIZE                         = 2;// 32bit bandwidth
+    PPE_Result_Layer.INCR                           = PPE_ARBURST_INCR;
+    PPE_Result_Layer.AXCACHE                        = 1;
+    PPE_Result_Layer.MAX_AXLEN_LOG                  = PPE_MAX_AXLEN_127;
+    PPE_Result_Layer.PRIOR                          = 0;
+    PPE_Result_Layer.byte_swap                      = PPE_NO_SWAP;
+    PPE_Result_Layer.handshake_mode                 = PPE_DMA_SW_HANDSHAKE;
+    PPE_Result_Layer.polarity                       = PPE_POLARITY_HIGH;
+    PPE_Result_Layer.handshake_en                   = DISABLE;
+    PPE_Result_Layer.handshake_msize                = PPE_MSIZE_1024;
+    PPE_Result_Layer.hw_index                       = 0;
+    PPE_InitResultLayer(&PPE_Result_Layer);
+
+    PPE_structInit(&PPE_Init_User);
+    PPE_Init_User.function                          = PPE_FUNCTION_ALPHA_BLEND;
+    PPE_Init_User.blend_layer_num                   = pass->layer_num;
+    PPE_Init(&PPE_Init_User);
+
+    PPE_Secure(ENABLE);  /*secure for all channel*/
+
+    PPE_Cmd(ENABLE);
+}
+
+static PPE_ERR ppe_dl_hw_submit(const ppe_dl_pass_t *pass, uint32_t pass_num)
+{
+    NVIC_InitTypeDef NVIC_InitStruct;
+    uint32_t i;
+    uint8_t j;
+
+    if (ppe_dl_hw_busy)
+    {
+        return PPE_ERROR_INVALID_PARAM;
+    }
+    for (i = 0; i < pass_num; i++)
+    {
+        if ((pass[i].target == NULL) || (ppe_get_format_data_len(pass[i].target->format) == 0))
+        {
+            return PPE_ERROR_NULL_TARGET;
+        }
+        for (j = 0; j < pass[i].layer_num; j++)
+        {
+            if ((pass[i].layer[j].image != NULL) &&
+                (ppe_get_format_data_len(pass[i].layer[j].image->format) == 0))
+            {
+                return PPE_ERROR_UNKNOWN_FORMAT;
+            }
+        }
+    }
+    if (pass_num == 0)
+    {
+        return PPE_SUCCESS;
+    }
+
+    RCC_PeriphClockCmd(APBPeriph_PPE, APBPeriph_PPE_CLOCK, ENABLE);
+
+    ppe_dl_hw_pass = pass;
+    ppe_dl_hw_pass_num = pass_num;
+    ppe_dl_hw_pass_idx = 0;
+    ppe_dl_hw_busy = true;
+
+    PPE_ClearINTPendingBit(PPE_ALL_OVER_INT);
+    PPE_MaskINTConfig(PPE_ALL_OVER_INT, DISABLE);
+
+    NVIC_InitStruct.NVIC_IRQChannel = PPE_IRQn;
+    NVIC_InitStruct.NVIC_IRQChannelPriority = 3;
+    NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStruct);
+
+    ppe_dl_hw_start(&pass[0]);
+    return PPE_SUCCESS;
+}
+
+static PPE_ERR ppe_dl_hw_wait(void)
+{
+    while (ppe_dl_hw_busy);
+    return PPE_SUCCESS;
+}
+
+static PPE_ERR ppe_dl_hw_scale(ppe_buffer_t *image, ppe_buffer_t *buffer, float x_ratio,
+                               float y_ratio)
+{
+    return PPE_Scale(image, buffer, x_ratio, y_ratio);
+}
+
+/*============================================================================*
+ *                           Public Variables
+ *============================================================================*/
+const ppe_dl_backend_t ppe_dl_hw_backend =
+{
+    .submit = ppe_dl_hw_submit,
+    .wait = ppe_dl_hw_wait,
+    .scale = ppe_dl_hw_scale,
+};
+
+/*============================================================================*
+ *                           Public Functions
+ *============================================================================*/
+void PPE_Handler(void)
+{
+    PPE_ClearINTPendingBit(PPE_ALL_OVER_INT);
+
+    if (!ppe_dl_hw_busy)
+    {
+        return;
+    }
+    ppe_dl_hw_pass_idx++;
+    if (ppe_dl_hw_pass_idx < ppe_dl_hw_pass_num)
+    {
+        ppe_dl_hw_start(&ppe_dl_hw_pass[ppe_dl_hw_pass_idx]);
+        return;
+    }
+
+    PPE_MaskINTConfig(PPE_ALL_OVER_INT, ENABLE);
+    ppe_dl_hw_busy = false;
+}
+
+/******************* (C) COPYRIGHT 2023 Realtek Semiconductor Corporation *****END OF FILE****/
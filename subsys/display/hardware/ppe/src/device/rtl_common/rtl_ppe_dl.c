@@ -0,0 +1,635 @@
+/**
+*********************************************************************************************************
+*               Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*********************************************************************************************************
+* \file     rtl_ppe_dl.c
+* \brief    This file provides the PPE display list functions.
+* \details  Recording, dirty rectangle merging and pass building. Portable C, the passes are
+*           drawn by a back end.
+* \version  v1.0
+*********************************************************************************************************
+*/
+
+/*============================================================================*
+ *                        Header Files
+ *============================================================================*/
+#include <stddef.h>
+#include <string.h>
+#include "rtl_ppe_dl.h"
+
+/*============================================================================*
+ *                          Private Macros
+ *============================================================================*/
+#define MIN(x, y)           (((x)<(y))?(x):(y))
+#define MAX(x, y)           (((x)>(y))?(x):(y))
+
+/*============================================================================*
+ *                           Private Functions
+ *============================================================================*/
+static uint8_t ppe_dl_format_len(PPE_PIXEL_FORMAT format)
+{
+    if (((format >= PPE_ABGR8888) && (format <= PPE_RGBX8888))
+        || ((format >= PPE_ABGR8666) && (format <= PPE_RGBX6668)))
+    {
+        return 4;
+    }
+    if (((format >= PPE_ABGR4444) && (format <= PPE_RGBX4444))
+        || ((format >= PPE_ABGR1555) && (format <= PPE_RGBX5551))
+        || ((format >= PPE_BGR565) && (format <= PPE_RGB565)))
+    {
+        return 2;
+    }
+    if (((format >= PPE_ABGR2222) && (format <= PPE_RGBX2222))
+        || ((format >= PPE_A8) && (format <= PPE_X8)))
+    {
+        return 1;
+    }
+    if (((format >= PPE_ABGR8565) && (format <= PPE_RGBX5658))
+        || ((format >= PPE_BGR888) && (format <= PPE_RGB888)))
+    {
+        return 3;
+    }
+    return 0;
+}
+
+static bool ppe_dl_format_has_alpha(PPE_PIXEL_FORMAT format)
+{
+    uint32_t idx;
+
+    if (format == PPE_A8)
+    {
+        return true;
+    }
+    if (format <= PPE_RGBX5551)
+    {
+        idx = format;
+    }
+    else if ((format >= PPE_ABGR8666) && (format <= PPE_RGBX6668))
+    {
+        idx = format - PPE_ABGR8666;
+    }
+    else
+    {
+        return false;
+    }
+    /* every group of 8 formats is ABGR, ARGB, XBGR, XRGB, BGRA, RGBA, BGRX, RGBX */
+    idx %= 8;
+    return (idx == 0) || (idx == 1) || (idx == 4) || (idx == 5);
+}
+
+static bool ppe_dl_rect_intersect(ppe_rect_t *result, const ppe_rect_t *rect1,
+                                  const ppe_rect_t *rect2)
+{
+    result->left = MAX(rect1->left, rect2->left);
+    result->top = MAX(rect1->top, rect2->top);
+    result->right = MIN(rect1->right, rect2->right);
+    result->bottom = MIN(rect1->bottom, rect2->bottom);
+    return (result->left <= result->right) && (result->top <= result->bottom);
+}
+
+static bool ppe_dl_rect_contain(const ppe_rect_t *outer, const ppe_rect_t *inner)
+{
+    return (outer->left <= inner->left) && (outer->top <= inner->top) &&
+           (outer->right >= inner->right) && (outer->bottom >= inner->bottom);
+}
+
+static void ppe_dl_rect_union(ppe_rect_t *result, const ppe_rect_t *rect1, const ppe_rect_t *rect2)
+{
+    result->left = MIN(rect1->left, rect2->left);
+    result->top = MIN(rect1->top, rect2->top);
+    result->right = MAX(rect1->right, rect2->right);
+    result->bottom = MAX(rect1->bottom, rect2->bottom);
+}
+
+static uint32_t ppe_dl_rect_area(const ppe_rect_t *rect)
+{
+    return (uint32_t)(rect->right - rect->left + 1) * (uint32_t)(rect->bottom - rect->top + 1);
+}
+
+static void ppe_dl_target_rect(ppe_dl_t *dl, ppe_rect_t *rect)
+{
+    rect->left = 0;
+    rect->top = 0;
+    rect->right = dl->target->width - 1;
+    rect->bottom = dl->target->height - 1;
+}
+
+/* Pixels the union of two disjoint rectangles covers beyond them */
+static uint32_t ppe_dl_merge_cost(const ppe_rect_t *rect1, const ppe_rect_t *rect2)
+{
+    ppe_rect_t merged;
+
+    ppe_dl_rect_union(&merged, rect1, rect2);
+    return ppe_dl_rect_area(&merged) - ppe_dl_rect_area(rect1) - ppe_dl_rect_area(rect2);
+}
+
+/* Merge the dirty rectangles until none overlap, so that no pixel is blended twice */
+static void ppe_dl_dirty_merge(ppe_dl_t *dl)
+{
+    ppe_rect_t overlap;
+    bool merged = true;
+    uint16_t i;
+    uint16_t j;
+
+    while (merged)
+    {
+        merged = false;
+        for (i = 0; i < dl->dirty_num; i++)
+        {
+            for (j = i + 1; j < dl->dirty_num; j++)
+            {
+                if (ppe_dl_rect_intersect(&overlap, &dl->dirty[i], &dl->dirty[j]) ||
+                    (ppe_dl_merge_cost(&dl->dirty[i], &dl->dirty[j]) <= PPE_DL_MERGE_SLACK))
+                {
+                    ppe_dl_rect_union(&dl->dirty[i], &dl->dirty[i], &dl->dirty[j]);
+                    dl->dirty[j] = dl->dirty[--dl->dirty_num];
+                    merged = true;
+                    j = i;
+                }
+            }
+        }
+    }
+}
+
+static bool ppe_dl_op_is_opaque(const ppe_dl_op_t *op)
+{
+    if (op->type == PPE_DL_OP_CLEAR)
+    {
+        return (op->color >> 24) == 0xFF;
+    }
+    if ((op->type != PPE_DL_OP_BLEND) || (op->blend_mode != PPE_SRC_OVER_MODE))
+    {
+        return false;
+    }
+    return !ppe_dl_format_has_alpha(op->image.format) && !op->image.color_key_en &&
+           !(op->image.global_alpha_en && (op->image.global_alpha != 0xFF));
+}
+
+static void ppe_dl_op_layer(const ppe_dl_op_t *op, const ppe_rect_t *rect, ppe_dl_layer_t *layer)
+{
+    layer->rect = *rect;
+    if (op->type == PPE_DL_OP_CLEAR)
+    {
+        layer->image = NULL;
+        layer->color = op->color;
+        layer->src_x = 0;
+        layer->src_y = 0;
+    }
+    else
+    {
+        layer->image = &op->image;
+        layer->color = 0;
+        layer->src_x = rect->left - op->trans.x;
+        layer->src_y = rect->top - op->trans.y;
+    }
+}
+
+static PPE_ERR ppe_dl_submit(ppe_dl_t *dl, uint16_t *pass_num)
+{
+    PPE_ERR err;
+
+    if (*pass_num == 0)
+    {
+        return PPE_SUCCESS;
+    }
+    dl->stats.submit_num++;
+    err = dl->backend->submit(dl->pass, *pass_num);
+    if (err == PPE_SUCCESS)
+    {
+        err = dl->backend->wait();
+    }
+    *pass_num = 0;
+    return err;
+}
+
+/* Start a pass on the window, with the target itself as the bottom layer */
+static PPE_ERR ppe_dl_pass_begin(ppe_dl_t *dl, uint16_t *pass_num, const ppe_rect_t *window)
+{
+    ppe_dl_pass_t *pass;
+    PPE_ERR err = PPE_SUCCESS;
+
+    if (*pass_num == dl->pass_max)
+    {
+        err = ppe_dl_submit(dl, pass_num);
+    }
+    pass = &dl->pass[*pass_num];
+    pass->target = dl->target;
+    pass->window = *window;
+    pass->layer_num = 1;
+    pass->layer[0].image = dl->target;
+    pass->layer[0].color = 0;
+    pass->layer[0].rect = *window;
+    pass->layer[0].src_x = window->left;
+    pass->layer[0].src_y = window->top;
+    return err;
+}
+
+static void ppe_dl_pass_end(ppe_dl_t *dl, uint16_t *pass_num)
+{
+    ppe_dl_pass_t *pass = &dl->pass[*pass_num];
+
+    /* the target alone changes nothing */
+    if ((pass->layer_num == 1) && (pass->layer[0].image == dl->target))
+    {
+        return;
+    }
+    dl->stats.pass_num++;
+    dl->stats.layer_num += pass->layer_num;
+    dl->stats.pixel_num += ppe_dl_rect_area(&pass->window);
+    (*pass_num)++;
+}
+
+static PPE_ERR ppe_dl_draw_tile(ppe_dl_t *dl, uint16_t *pass_num, const ppe_rect_t *tile,
+                                uint16_t first, uint16_t last)
+{
+    ppe_dl_pass_t *pass;
+    ppe_dl_op_t *op;
+    ppe_rect_t rect;
+    uint16_t start = first;
+    uint16_t i;
+    PPE_ERR err;
+
+    /* everything below the last opaque operation covering the tile is hidden */
+    for (i = last; i > first; i--)
+    {
+        op = &dl->op[i - 1];
+        if (ppe_dl_rect_contain(&op->rect, tile) &&
+            (ppe_dl_op_is_opaque(op) ||
+             ((op->type == PPE_DL_OP_BLEND) && (op->blend_mode == PPE_BYPASS_MODE))))
+        {
+            start = i - 1;
+            break;
+        }
+    }
+
+    err = ppe_dl_pass_begin(dl, pass_num, tile);
+    if (err != PPE_SUCCESS)
+    {
+        return err;
+    }
+    pass = &dl->pass[*pass_num];
+
+    for (i = start; i < last; i++)
+    {
+        op = &dl->op[i];
+        if (!ppe_dl_rect_intersect(&rect, &op->rect, tile))
+        {
+            continue;
+        }
+
+        if ((op->type == PPE_DL_OP_BLEND) && (op->blend_mode == PPE_BYPASS_MODE))
+        {
+            /* the image is copied as PPE_Blend does, as the bottom layer of a pass on its area */
+            if (!ppe_dl_rect_contain(&rect, tile))
+            {
+                ppe_dl_pass_end(dl, pass_num);
+                err = ppe_dl_pass_begin(dl, pass_num, &rect);
+                if (err != PPE_SUCCESS)
+                {
+                    return err;
+                }
+                pass = &dl->pass[*pass_num];
+            }
+            ppe_dl_op_layer(op, &rect, &pass->layer[0]);
+            pass->layer_num = 1;
+            if (!ppe_dl_rect_contain(&rect, tile))
+            {
+                ppe_dl_pass_end(dl, pass_num);
+                err = ppe_dl_pass_begin(dl, pass_num, tile);
+                if (err != PPE_SUCCESS)
+                {
+                    return err;
+                }
+                pass = &dl->pass[*pass_num];
+            }
+            continue;
+        }
+
+        if ((i == start) && ppe_dl_rect_contain(&rect, tile) && ppe_dl_op_is_opaque(op))
+        {
+            /* the covering operation takes the place of the target */
+            ppe_dl_op_layer(op, &rect, &pass->layer[0]);
+            continue;
+        }
+
+        if (pass->layer_num == PPE_DL_PASS_LAYER_MAX)
+        {
+            ppe_dl_pass_end(dl, pass_num);
+            err = ppe_dl_pass_begin(dl, pass_num, tile);
+            if (err != PPE_SUCCESS)
+            {
+                return err;
+            }
+            pass = &dl->pass[*pass_num];
+        }
+        ppe_dl_op_layer(op, &rect, &pass->layer[pass->layer_num++]);
+    }
+
+    ppe_dl_pass_end(dl, pass_num);
+    return PPE_SUCCESS;
+}
+
+/* Draw the operations in [first, last), none of which is a scale */
+static PPE_ERR ppe_dl_draw_range(ppe_dl_t *dl, uint16_t first, uint16_t last)
+{
+    ppe_rect_t target_rect;
+    uint16_t pass_num = 0;
+    uint16_t i;
+    PPE_ERR err = PPE_SUCCESS;
+
+    if (first == last)
+    {
+        return PPE_SUCCESS;
+    }
+
+    if (dl->dirty_num == 0)
+    {
+        ppe_dl_target_rect(dl, &target_rect);
+        dl->stats.tile_num++;
+        err = ppe_dl_draw_tile(dl, &pass_num, &target_rect, first, last);
+    }
+    for (i = 0; (i < dl->dirty_num) && (err == PPE_SUCCESS); i++)
+    {
+        dl->stats.tile_num++;
+        err = ppe_dl_draw_tile(dl, &pass_num, &dl->dirty[i], first, last);
+    }
+    if (err == PPE_SUCCESS)
+    {
+        err = ppe_dl_submit(dl, &pass_num);
+    }
+    return err;
+}
+
+/* Draw the recorded operations, the dirty rectangles are kept */
+static PPE_ERR ppe_dl_draw(ppe_dl_t *dl)
+{
+    ppe_dl_op_t *op;
+    uint16_t first = 0;
+    uint16_t i;
+    PPE_ERR err = PPE_SUCCESS;
+
+    ppe_dl_dirty_merge(dl);
+    for (i = 0; (i < dl->op_num) && (err == PPE_SUCCESS); i++)
+    {
+        op = &dl->op[i];
+        if (op->type != PPE_DL_OP_SCALE)
+        {
+            continue;
+        }
+        err = ppe_dl_draw_range(dl, first, i);
+        if (err == PPE_SUCCESS)
+        {
+            err = dl->backend->scale(&op->image, op->buffer, op->x_ratio, op->y_ratio);
+            if (err == PPE_SUCCESS_NOT_CHANGE)
+            {
+                err = PPE_SUCCESS;
+            }
+        }
+        first = i + 1;
+    }
+    if (err == PPE_SUCCESS)
+    {
+        err = ppe_dl_draw_range(dl, first, dl->op_num);
+    }
+    dl->op_num = 0;
+    return err;
+}
+
+/* Get a free operation, the recorded ones are drawn if the storage is full */
+static ppe_dl_op_t *ppe_dl_op_alloc(ppe_dl_t *dl, PPE_ERR *err)
+{
+    *err = PPE_SUCCESS;
+    if (dl->op_num == dl->op_max)
+    {
+        *err = ppe_dl_draw(dl);
+        if (*err != PPE_SUCCESS)
+        {
+            return NULL;
+        }
+    }
+    return &dl->op[dl->op_num];
+}
+
+/*============================================================================*
+ *                           Public Functions
+ *============================================================================*/
+void PPE_DL_Init(ppe_dl_t *dl, ppe_buffer_t *target, const ppe_dl_backend_t *backend,
+                 ppe_dl_op_t *op, uint16_t op_max, ppe_rect_t *dirty, uint16_t dirty_max,
+                 ppe_dl_pass_t *pass, uint16_t pass_max)
+{
+    memset(dl, 0, sizeof(ppe_dl_t));
+    dl->target = target;
+    dl->backend = backend;
+    dl->op = op;
+    dl->op_max = op_max;
+    dl->dirty = dirty;
+    dl->dirty_max = (dirty != NULL) ? dirty_max : 0;
+    dl->pass = pass;
+    dl->pass_max = pass_max;
+}
+
+void PPE_DL_Reset(ppe_dl_t *dl)
+{
+    dl->op_num = 0;
+    dl->dirty_num = 0;
+}
+
+PPE_ERR PPE_DL_Clear(ppe_dl_t *dl, ppe_rect_t *rect, uint32_t color)
+{
+    ppe_rect_t target_rect;
+    ppe_rect_t clear_rect;
+    ppe_dl_op_t *op;
+    PPE_ERR err;
+
+    if ((dl == NULL) || (dl->target == NULL))
+    {
+        return PPE_ERROR_NULL_TARGET;
+    }
+    ppe_dl_target_rect(dl, &target_rect);
+    if (rect == NULL)
+    {
+        clear_rect = target_rect;
+    }
+    else if ((rect->top > rect->bottom) || (rect->left > rect->right))
+    {
+        return PPE_ERROR_INVALID_PARAM;
+    }
+    else if (!ppe_dl_rect_intersect(&clear_rect, &target_rect, rect))
+    {
+        return PPE_SUCCESS_NOT_CHANGE;
+    }
+
+    op = ppe_dl_op_alloc(dl, &err);
+    if (op == NULL)
+    {
+        return err;
+    }
+    memset(op, 0, sizeof(ppe_dl_op_t));
+    op->type = PPE_DL_OP_CLEAR;
+    op->color = color;
+    op->rect = clear_rect;
+    dl->op_num++;
+    return PPE_SUCCESS;
+}
+
+PPE_ERR PPE_DL_Blend(ppe_dl_t *dl, ppe_buffer_t *image, ppe_translate_t *trans,
+                     ppe_rect_t *rect, PPE_BLEND_MODE blend_mode)
+{
+    ppe_rect_t image_rect;
+    ppe_rect_t blend_rect;
+    ppe_dl_op_t *op;
+    PPE_ERR err;
+
+    if ((dl == NULL) || (dl->target == NULL))
+    {
+        return PPE_ERROR_NULL_TARGET;
+    }
+    if ((image == NULL) || (image->memory == NULL) || (trans == NULL))
+    {
+        return PPE_ERROR_NULL_SOURCE;
+    }
+    if (ppe_dl_format_len(image->format) == 0)
+    {
+        return PPE_ERROR_UNKNOWN_FORMAT;
+    }
+    if ((rect != NULL) && ((rect->top > rect->bottom) || (rect->left > rect->right)))
+    {
+        return PPE_ERROR_INVALID_PARAM;
+    }
+
+    ppe_dl_target_rect(dl, &blend_rect);
+    image_rect.left = trans->x;
+    image_rect.top = trans->y;
+    image_rect.right = trans->x + image->width - 1;
+    image_rect.bottom = trans->y + image->height - 1;
+    if (!ppe_dl_rect_intersect(&blend_rect, &blend_rect, &image_rect) ||
+        ((rect != NULL) && !ppe_dl_rect_intersect(&blend_rect, &blend_rect, rect)))
+    {
+        return PPE_SUCCESS_NOT_CHANGE;
+    }
+
+    op = ppe_dl_op_alloc(dl, &err);
+    if (op == NULL)
+    {
+        return err;
+    }
+    memset(op, 0, sizeof(ppe_dl_op_t));
+    op->type = PPE_DL_OP_BLEND;
+    op->blend_mode = blend_mode;
+    op->rect = blend_rect;
+    op->trans = *trans;
+    op->image = *image;
+    if (op->image.stride == 0)
+    {
+        op->image.stride = op->image.width;
+    }
+    dl->op_num++;
+    return PPE_SUCCESS;
+}
+
+PPE_ERR PPE_DL_Scale(ppe_dl_t *dl, ppe_buffer_t *image, ppe_buffer_t *buffer, float x_ratio,
+                     float y_ratio)
+{
+    ppe_dl_op_t *op;
+    PPE_ERR err;
+
+    if ((dl == NULL) || (buffer == NULL))
+    {
+        return PPE_ERROR_NULL_TARGET;
+    }
+    if (image == NULL)
+    {
+        return PPE_ERROR_NULL_SOURCE;
+    }
+    if ((x_ratio <= 0) || (y_ratio <= 0))
+    {
+        return PPE_ERROR_INVALID_PARAM;
+    }
+
+    /* known now, so later operations can blend the buffer */
+    buffer->width = (uint32_t)(image->width * x_ratio);
+    buffer->height = (uint32_t)(image->height * y_ratio);
+    buffer->stride = buffer->width;
+    if ((buffer->width == 0) || (buffer->height == 0))
+    {
+        return PPE_SUCCESS_NOT_CHANGE;
+    }
+
+    op = ppe_dl_op_alloc(dl, &err);
+    if (op == NULL)
+    {
+        return err;
+    }
+    memset(op, 0, sizeof(ppe_dl_op_t));
+    op->type = PPE_DL_OP_SCALE;
+    op->image = *image;
+    op->buffer = buffer;
+    op->x_ratio = x_ratio;
+    op->y_ratio = y_ratio;
+    dl->op_num++;
+    return PPE_SUCCESS;
+}
+
+void PPE_DL_Add_Dirty(ppe_dl_t *dl, ppe_rect_t *rect)
+{
+    ppe_rect_t target_rect;
+    ppe_rect_t dirty_rect;
+    uint32_t cost;
+    uint32_t best_cost = UINT32_MAX;
+    uint16_t best = 0;
+    uint16_t i;
+
+    if ((dl->dirty_max == 0) || (rect == NULL))
+    {
+        return;
+    }
+    ppe_dl_target_rect(dl, &target_rect);
+    if (!ppe_dl_rect_intersect(&dirty_rect, &target_rect, rect))
+    {
+        return;
+    }
+
+    for (i = 0; i < dl->dirty_num; i++)
+    {
+        if (ppe_dl_rect_contain(&dl->dirty[i], &dirty_rect))
+        {
+            return;
+        }
+    }
+    if (dl->dirty_num < dl->dirty_max)
+    {
+        dl->dirty[dl->dirty_num++] = dirty_rect;
+        return;
+    }
+
+    /* no room, grow the rectangle that wastes the fewest pixels */
+    for (i = 0; i < dl->dirty_num; i++)
+    {
+        ppe_rect_t merged;
+
+        ppe_dl_rect_union(&merged, &dl->dirty[i], &dirty_rect);
+        cost = ppe_dl_rect_area(&merged) - ppe_dl_rect_area(&dl->dirty[i]);
+        if (cost < best_cost)
+        {
+            best_cost = cost;
+            best = i;
+        }
+    }
+    ppe_dl_rect_union(&dl->dirty[best], &dl->dirty[best], &dirty_rect);
+}
+
+PPE_ERR PPE_DL_Flush(ppe_dl_t *dl)
+{
+    PPE_ERR err;
+
+    if ((dl == NULL) || (dl->target == NULL))
+    {
+        return PPE_ERROR_NULL_TARGET;
+    }
+    memset(&dl->stats, 0, sizeof(ppe_dl_stats_t));
+    err = ppe_dl_draw(dl);
+    PPE_DL_Reset(dl);
+    return err;
+}
+
+/******************* (C) COPYRIGHT 2023 Realtek Semiconductor Corporation *****END OF FILE****/
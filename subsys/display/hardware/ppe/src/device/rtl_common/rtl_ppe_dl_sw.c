@@ -0,0 +1,156 @@
+/**
+*********************************************************************************************************
+*               Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*********************************************************************************************************
+* \file     rtl_ppe_dl_sw.c
+* \brief    This file provides the software back end of the PPE display list.
+* \details  The passes are drawn line by line by the software PPE engine in rtl_ppe_sw.h,
+*           the layers are blended bottom to top as the PPE does.
+* \version  v1.0
+*********************************************************************************************************
+*/
+
+/*============================================================================*
+ *                        Header Files
+ *============================================================================*/
+#include <stddef.h>
+#include "rtl_ppe_dl.h"
+#include "rtl_ppe_sw.h"
+
+/*============================================================================*
+ *                          Private Macros
+ *============================================================================*/
+#define MIN(x, y)           (((x)<(y))?(x):(y))
+#define MAX(x, y)           (((x)>(y))?(x):(y))
+
+/*============================================================================*
+ *                           Private Functions
+ *============================================================================*/
+static uint16_t ppe_dl_sw_line_len(const ppe_buffer_t *buffer)
+{
+    return (buffer->stride != 0) ? buffer->stride : buffer->width;
+}
+
+/* Get num pixels of a layer from (x, y) on, as ABGR8888 */
+static void ppe_dl_sw_layer_line(const ppe_dl_layer_t *layer, int32_t x, int32_t y, uint32_t num,
+                                 uint32_t *out)
+{
+    const ppe_buffer_t *image = layer->image;
+    uint32_t i;
+
+    if (image == NULL)
+    {
+        for (i = 0; i < num; i++)
+        {
+            out[i] = layer->color;
+        }
+        return;
+    }
+    PPE_SW_Load_Line(image, (const uint8_t *)image->memory +
+                     ((uint32_t)(layer->src_y + y - layer->rect.top) * ppe_dl_sw_line_len(image) +
+                      (uint32_t)(layer->src_x + x - layer->rect.left)) * ppe_sw_get_format_data_len(image->format),
+                     num, out);
+}
+
+static PPE_ERR ppe_dl_sw_check(const ppe_dl_pass_t *pass)
+{
+    uint8_t i;
+
+    if ((pass->target == NULL) || (pass->target->memory == NULL))
+    {
+        return PPE_ERROR_NULL_TARGET;
+    }
+    if (ppe_sw_get_format_data_len(pass->target->format) == 0)
+    {
+        return PPE_ERROR_UNKNOWN_FORMAT;
+    }
+    for (i = 0; i < pass->layer_num; i++)
+    {
+        if ((pass->layer[i].image != NULL) &&
+            (ppe_sw_get_format_data_len(pass->layer[i].image->format) == 0))
+        {
+            return PPE_ERROR_UNKNOWN_FORMAT;
+        }
+    }
+    return PPE_SUCCESS;
+}
+
+static void ppe_dl_sw_draw(const ppe_dl_pass_t *pass)
+{
+    uint32_t line[PPE_SW_CHUNK];
+    uint32_t src[PPE_SW_CHUNK];
+    const ppe_buffer_t *target = pass->target;
+    const ppe_dl_layer_t *layer;
+    uint32_t len = ppe_sw_get_format_data_len(target->format);
+    uint32_t line_len = ppe_dl_sw_line_len(target);
+    int32_t x;
+    int32_t y;
+    int32_t x_end;
+    int32_t from;
+    int32_t to;
+    uint8_t l;
+
+    for (y = pass->window.top; y <= pass->window.bottom; y++)
+    {
+        for (x = pass->window.left; x <= pass->window.right; x += PPE_SW_CHUNK)
+        {
+            x_end = MIN(x + PPE_SW_CHUNK - 1, pass->window.right);
+
+            ppe_dl_sw_layer_line(&pass->layer[0], x, y, x_end - x + 1, line);
+            for (l = 1; l < pass->layer_num; l++)
+            {
+                layer = &pass->layer[l];
+                if ((y < layer->rect.top) || (y > layer->rect.bottom))
+                {
+                    continue;
+                }
+                from = MAX(x, layer->rect.left);
+                to = MIN(x_end, layer->rect.right);
+                if (from > to)
+                {
+                    continue;
+                }
+                ppe_dl_sw_layer_line(layer, from, y, to - from + 1, src);
+                PPE_SW_Blend_Line(&line[from - x], src, to - from + 1);
+            }
+
+            PPE_SW_Store_Line(target->format,
+                              (uint8_t *)target->memory + ((uint32_t)y * line_len + (uint32_t)x) * len,
+                              line, x_end - x + 1);
+        }
+    }
+}
+
+static PPE_ERR ppe_dl_sw_submit(const ppe_dl_pass_t *pass, uint32_t pass_num)
+{
+    PPE_ERR err;
+    uint32_t i;
+
+    for (i = 0; i < pass_num; i++)
+    {
+        err = ppe_dl_sw_check(&pass[i]);
+        if (err != PPE_SUCCESS)
+        {
+            return err;
+        }
+        ppe_dl_sw_draw(&pass[i]);
+    }
+    return PPE_SUCCESS;
+}
+
+static PPE_ERR ppe_dl_sw_wait(void)
+{
+    return PPE_SUCCESS;
+}
+
+/*============================================================================*
+ *                           Public Variables
+ *============================================================================*/
+const ppe_dl_backend_t ppe_dl_sw_backend =
+{
+    .submit = ppe_dl_sw_submit,
+    .wait = ppe_dl_sw_wait,
+    .scale = PPE_SW_Scale,
+};
+
+/******************* (C) COPYRIGHT 2023 Realtek Semiconductor Corporation *****END OF FILE****/
@@ -0,0 +1,932 @@
+/**
+*********************************************************************************************************
+*               Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*********************************************************************************************************
+* \file     rtl_ppe_sw.c
+* \brief    This file provides the software PPE functions.
+* \details  Pixels are expanded to ABGR8888 a chunk at a time, blended by the blend kernel
+*           and packed into the target format.
+* \version  v1.0
+*********************************************************************************************************
+*/
+
+/*============================================================================*
+ *                        Header Files
+ *============================================================================*/
+#include <stddef.h>
+#include <string.h>
+#include "rtl_ppe_sw.h"
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/*============================================================================*
+ *                          Private Macros
+ *============================================================================*/
+#define MIN(x, y)           (((x)<(y))?(x):(y))
+#define MAX(x, y)           (((x)>(y))?(x):(y))
+
+/* x / 255 rounded, for x in [0, 255 * 255] */
+#define PPE_SW_DIV255(x)    (((x) + 128 + (((x) + 128) >> 8)) >> 8)
+
+#define PPE_SW_FORMAT_NUM   (PPE_RGBX6668 + 1)
+
+/* Byte length, X flag, then the shift and width of R, G, B and A */
+#define PPE_SW_FMT(len, x, rs, rb, gs, gb, bs, bb, as, ab) \
+    {len, x, {rs, gs, bs, as}, {rb, gb, bb, ab}}
+
+/*============================================================================*
+ *                          Private Types
+ *============================================================================*/
+typedef struct
+{
+    uint8_t len;        /* Bytes of a pixel, 0 for unsupported formats */
+    uint8_t x;          /* The alpha bits are padding, read as opaque and written as 1 */
+    uint8_t shift[4];   /* Lowest bit of R, G, B and A */
+    uint8_t bits[4];    /* Width of R, G, B and A, 0 if absent */
+} ppe_sw_format_t;
+
+/*============================================================================*
+ *                           Private Variables
+ *============================================================================*/
+static const ppe_sw_format_t ppe_sw_format[PPE_SW_FORMAT_NUM] =
+{
+    [PPE_ABGR8888] = PPE_SW_FMT(4, 0, 0, 8, 8, 8, 16, 8, 24, 8),
+    [PPE_ARGB8888] = PPE_SW_FMT(4, 0, 16, 8, 8, 8, 0, 8, 24, 8),
+    [PPE_XBGR8888] = PPE_SW_FMT(4, 1, 0, 8, 8, 8, 16, 8, 24, 8),
+    [PPE_XRGB8888] = PPE_SW_FMT(4, 1, 16, 8, 8, 8, 0, 8, 24, 8),
+    [PPE_BGRA8888] = PPE_SW_FMT(4, 0, 8, 8, 16, 8, 24, 8, 0, 8),
+    [PPE_RGBA8888] = PPE_SW_FMT(4, 0, 24, 8, 16, 8, 8, 8, 0, 8),
+    [PPE_BGRX8888] = PPE_SW_FMT(4, 1, 8, 8, 16, 8, 24, 8, 0, 8),
+    [PPE_RGBX8888] = PPE_SW_FMT(4, 1, 24, 8, 16, 8, 8, 8, 0, 8),
+    [PPE_ABGR4444] = PPE_SW_FMT(2, 0, 0, 4, 4, 4, 8, 4, 12, 4),
+    [PPE_ARGB4444] = PPE_SW_FMT(2, 0, 8, 4, 4, 4, 0, 4, 12, 4),
+    [PPE_XBGR4444] = PPE_SW_FMT(2, 1, 0, 4, 4, 4, 8, 4, 12, 4),
+    [PPE_XRGB4444] = PPE_SW_FMT(2, 1, 8, 4, 4, 4, 0, 4, 12, 4),
+    [PPE_BGRA4444] = PPE_SW_FMT(2, 0, 4, 4, 8, 4, 12, 4, 0, 4),
+    [PPE_RGBA4444] = PPE_SW_FMT(2, 0, 12, 4, 8, 4, 4, 4, 0, 4),
+    [PPE_BGRX4444] = PPE_SW_FMT(2, 1, 4, 4, 8, 4, 12, 4, 0, 4),
+    [PPE_RGBX4444] = PPE_SW_FMT(2, 1, 12, 4, 8, 4, 4, 4, 0, 4),
+    [PPE_ABGR2222] = PPE_SW_FMT(1, 0, 0, 2, 2, 2, 4, 2, 6, 2),
+    [PPE_ARGB2222] = PPE_SW_FMT(1, 0, 4, 2, 2, 2, 0, 2, 6, 2),
+    [PPE_XBGR2222] = PPE_SW_FMT(1, 1, 0, 2, 2, 2, 4, 2, 6, 2),
+    [PPE_XRGB2222] = PPE_SW_FMT(1, 1, 4, 2, 2, 2, 0, 2, 6, 2),
+    [PPE_BGRA2222] = PPE_SW_FMT(1, 0, 2, 2, 4, 2, 6, 2, 0, 2),
+    [PPE_RGBA2222] = PPE_SW_FMT(1, 0, 6, 2, 4, 2, 2, 2, 0, 2),
+    [PPE_BGRX2222] = PPE_SW_FMT(1, 1, 2, 2, 4, 2, 6, 2, 0, 2),
+    [PPE_RGBX2222] = PPE_SW_FMT(1, 1, 6, 2, 4, 2, 2, 2, 0, 2),
+    [PPE_ABGR8565] = PPE_SW_FMT(3, 0, 0, 5, 5, 6, 11, 5, 16, 8),
+    [PPE_ARGB8565] = PPE_SW_FMT(3, 0, 11, 5, 5, 6, 0, 5, 16, 8),
+    [PPE_XBGR8565] = PPE_SW_FMT(3, 1, 0, 5, 5, 6, 11, 5, 16, 8),
+    [PPE_XRGB8565] = PPE_SW_FMT(3, 1, 11, 5, 5, 6, 0, 5, 16, 8),
+    [PPE_BGRA5658] = PPE_SW_FMT(3, 0, 8, 5, 13, 6, 19, 5, 0, 8),
+    [PPE_RGBA5658] = PPE_SW_FMT(3, 0, 19, 5, 13, 6, 8, 5, 0, 8),
+    [PPE_BGRX5658] = PPE_SW_FMT(3, 1, 8, 5, 13, 6, 19, 5, 0, 8),
+    [PPE_RGBX5658] = PPE_SW_FMT(3, 1, 19, 5, 13, 6, 8, 5, 0, 8),
+    [PPE_ABGR1555] = PPE_SW_FMT(2, 0, 0, 5, 5, 5, 10, 5, 15, 1),
+    [PPE_ARGB1555] = PPE_SW_FMT(2, 0, 10, 5, 5, 5, 0, 5, 15, 1),
+    [PPE_XBGR1555] = PPE_SW_FMT(2, 1, 0, 5, 5, 5, 10, 5, 15, 1),
+    [PPE_XRGB1555] = PPE_SW_FMT(2, 1, 10, 5, 5, 5, 0, 5, 15, 1),
+    [PPE_BGRA5551] = PPE_SW_FMT(2, 0, 1, 5, 6, 5, 11, 5, 0, 1),
+    [PPE_RGBA5551] = PPE_SW_FMT(2, 0, 11, 5, 6, 5, 1, 5, 0, 1),
+    [PPE_BGRX5551] = PPE_SW_FMT(2, 1, 1, 5, 6, 5, 11, 5, 0, 1),
+    [PPE_RGBX5551] = PPE_SW_FMT(2, 1, 11, 5, 6, 5, 1, 5, 0, 1),
+    [PPE_BGR888]   = PPE_SW_FMT(3, 0, 0, 8, 8, 8, 16, 8, 0, 0),
+    [PPE_RGB888]   = PPE_SW_FMT(3, 0, 16, 8, 8, 8, 0, 8, 0, 0),
+    [PPE_BGR565]   = PPE_SW_FMT(2, 0, 0, 5, 5, 6, 11, 5, 0, 0),
+    [PPE_RGB565]   = PPE_SW_FMT(2, 0, 11, 5, 5, 6, 0, 5, 0, 0),
+    [PPE_A8]       = PPE_SW_FMT(1, 0, 0, 0, 0, 0, 0, 0, 0, 8),
+    [PPE_X8]       = PPE_SW_FMT(1, 1, 0, 0, 0, 0, 0, 0, 0, 8),
+    [PPE_ABGR8666] = PPE_SW_FMT(4, 0, 2, 6, 10, 6, 18, 6, 24, 8),
+    [PPE_ARGB8666] = PPE_SW_FMT(4, 0, 18, 6, 10, 6, 2, 6, 24, 8),
+    [PPE_XBGR8666] = PPE_SW_FMT(4, 1, 2, 6, 10, 6, 18, 6, 24, 8),
+    [PPE_XRGB8666] = PPE_SW_FMT(4, 1, 18, 6, 10, 6, 2, 6, 24, 8),
+    [PPE_BGRA6668] = PPE_SW_FMT(4, 0, 10, 6, 18, 6, 26, 6, 0, 8),
+    [PPE_RGBA6668] = PPE_SW_FMT(4, 0, 26, 6, 18, 6, 10, 6, 0, 8),
+    [PPE_BGRX6668] = PPE_SW_FMT(4, 1, 10, 6, 18, 6, 26, 6, 0, 8),
+    [PPE_RGBX6668] = PPE_SW_FMT(4, 1, 26, 6, 18, 6, 10, 6, 0, 8),
+};
+
+/*============================================================================*
+ *                           Private Functions
+ *============================================================================*/
+static const ppe_sw_format_t *ppe_sw_get_format(PPE_PIXEL_FORMAT format)
+{
+    if ((format >= PPE_SW_FORMAT_NUM) || (ppe_sw_format[format].len == 0))
+    {
+        return NULL;
+    }
+    return &ppe_sw_format[format];
+}
+
+static bool ppe_sw_rect_intersect(ppe_rect_t *result_rect, const ppe_rect_t *rect1,
+                                  const ppe_rect_t *rect2)
+{
+    result_rect->left = MAX(rect1->left, rect2->left);
+    result_rect->top = MAX(rect1->top, rect2->top);
+    result_rect->right = MIN(rect1->right, rect2->right);
+    result_rect->bottom = MIN(rect1->bottom, rect2->bottom);
+    return (result_rect->left <= result_rect->right) && (result_rect->top <= result_rect->bottom);
+}
+
+static uint16_t ppe_sw_line_len(const ppe_buffer_t *buffer)
+{
+    return (buffer->stride != 0) ? buffer->stride : buffer->width;
+}
+
+static uint32_t ppe_sw_read(const uint8_t *p, uint8_t len)
+{
+    switch (len)
+    {
+    case 1:
+        return p[0];
+    case 2:
+        return p[0] | (p[1] << 8);
+    case 3:
+        return p[0] | (p[1] << 8) | (p[2] << 16);
+    default:
+        return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+}
+
+static void ppe_sw_write(uint8_t *p, uint8_t len, uint32_t v)
+{
+    p[0] = v & 0xFF;
+    if (len > 1)
+    {
+        p[1] = (v >> 8) & 0xFF;
+    }
+    if (len > 2)
+    {
+        p[2] = (v >> 16) & 0xFF;
+    }
+    if (len > 3)
+    {
+        p[3] = v >> 24;
+    }
+}
+
+/* Bit replication, so that the maximum of any width becomes 0xFF */
+static uint32_t ppe_sw_expand(uint32_t c, uint8_t bits)
+{
+    switch (bits)
+    {
+    case 1:
+        return c ? 0xFF : 0;
+    case 2:
+        return c * 0x55;
+    case 4:
+        return c * 0x11;
+    case 5:
+        return (c << 3) | (c >> 2);
+    case 6:
+        return (c << 2) | (c >> 4);
+    default:
+        return c;
+    }
+}
+
+static uint32_t ppe_sw_unpack(const ppe_sw_format_t *f, uint32_t raw)
+{
+    uint32_t abgr = 0;
+    uint32_t c;
+    uint8_t ch;
+
+    for (ch = 0; ch < 3; ch++)
+    {
+        if (f->bits[ch] != 0)
+        {
+            c = (raw >> f->shift[ch]) & ((1u << f->bits[ch]) - 1);
+            abgr |= ppe_sw_expand(c, f->bits[ch]) << (ch * 8);
+        }
+    }
+    if (f->x || (f->bits[3] == 0))
+    {
+        return abgr | 0xFF000000;
+    }
+    c = (raw >> f->shift[3]) & ((1u << f->bits[3]) - 1);
+    return abgr | (ppe_sw_expand(c, f->bits[3]) << 24);
+}
+
+static uint32_t ppe_sw_pack(const ppe_sw_format_t *f, uint32_t abgr)
+{
+    uint32_t raw = 0;
+    uint32_t c;
+    uint8_t ch;
+
+    for (ch = 0; ch < 4; ch++)
+    {
+        if (f->bits[ch] == 0)
+        {
+            continue;
+        }
+        c = (abgr >> (ch * 8)) & 0xFF;
+        if ((ch == 3) && f->x)
+        {
+            c = 0xFF;
+        }
+        raw |= (c >> (8 - f->bits[ch])) << f->shift[ch];
+    }
+    return raw;
+}
+
+static uint32_t ppe_sw_swap_rb(uint32_t v)
+{
+    return (v & 0xFF00FF00) | ((v & 0xFF) << 16) | ((v >> 16) & 0xFF);
+}
+
+/* Read pixels as ABGR8888, without color key and global alpha */
+static void ppe_sw_load(PPE_PIXEL_FORMAT format, const uint8_t *p, uint32_t num, uint32_t *out)
+{
+    const ppe_sw_format_t *f = &ppe_sw_format[format];
+    uint32_t v;
+    uint32_t i;
+
+    switch (format)
+    {
+    case PPE_ABGR8888:
+        memcpy(out, p, num * 4);
+        break;
+    case PPE_XBGR8888:
+        memcpy(out, p, num * 4);
+        for (i = 0; i < num; i++)
+        {
+            out[i] |= 0xFF000000;
+        }
+        break;
+    case PPE_ARGB8888:
+    case PPE_XRGB8888:
+        memcpy(out, p, num * 4);
+        v = (format == PPE_XRGB8888) ? 0xFF000000 : 0;
+        for (i = 0; i < num; i++)
+        {
+            out[i] = ppe_sw_swap_rb(out[i]) | v;
+        }
+        break;
+    case PPE_RGB888:
+        for (i = 0; i < num; i++, p += 3)
+        {
+            out[i] = 0xFF000000 | (p[0] << 16) | (p[1] << 8) | p[2];
+        }
+        break;
+    case PPE_RGB565:
+        for (i = 0; i < num; i++, p += 2)
+        {
+            v = p[0] | (p[1] << 8);
+            out[i] = 0xFF000000 | ppe_sw_expand(v >> 11, 5) |
+                     (ppe_sw_expand((v >> 5) & 0x3F, 6) << 8) | (ppe_sw_expand(v & 0x1F, 5) << 16);
+        }
+        break;
+    default:
+        for (i = 0; i < num; i++, p += f->len)
+        {
+            out[i] = ppe_sw_unpack(f, ppe_sw_read(p, f->len));
+        }
+        break;
+    }
+}
+
+static void ppe_sw_fill(uint32_t *out, uint32_t color, uint32_t num)
+{
+    uint32_t i;
+
+    for (i = 0; i < num; i++)
+    {
+        out[i] = color;
+    }
+}
+
+/* Store a color into w x h pixels, the line length is in pixels */
+static void ppe_sw_fill_rect(PPE_PIXEL_FORMAT format, uint8_t *pixel, uint32_t line, uint32_t w,
+                             uint32_t h, uint32_t color)
+{
+    uint32_t src[PPE_SW_CHUNK];
+    uint8_t chunk[PPE_SW_CHUNK * 4];
+    uint8_t len = ppe_sw_get_format_data_len(format);
+    uint32_t x;
+    uint32_t y;
+    uint32_t n;
+
+    n = MIN(w, PPE_SW_CHUNK);
+    ppe_sw_fill(src, color, n);
+    PPE_SW_Store_Line(format, chunk, src, n);
+    for (y = 0; y < h; y++)
+    {
+        for (x = 0; x < w; x += n)
+        {
+            n = MIN(w - x, PPE_SW_CHUNK);
+            memcpy(pixel + (y * line + x) * len, chunk, n * len);
+        }
+    }
+}
+
+static void ppe_sw_blend_scalar(uint32_t *dst, const uint32_t *src, uint32_t num)
+{
+    uint32_t s;
+    uint32_t d;
+    uint32_t a;
+    uint32_t na;
+    uint32_t i;
+
+    for (i = 0; i < num; i++)
+    {
+        s = src[i];
+        a = s >> 24;
+        if (a == 0xFF)
+        {
+            dst[i] = s;
+            continue;
+        }
+        if (a == 0)
+        {
+            continue;
+        }
+        d = dst[i];
+        na = 255 - a;
+        dst[i] = PPE_SW_DIV255((s & 0xFF) * a + (d & 0xFF) * na) |
+                 (PPE_SW_DIV255(((s >> 8) & 0xFF) * a + ((d >> 8) & 0xFF) * na) << 8) |
+                 (PPE_SW_DIV255(((s >> 16) & 0xFF) * a + ((d >> 16) & 0xFF) * na) << 16) |
+                 (PPE_SW_DIV255(a * 255 + (d >> 24) * na) << 24);
+    }
+}
+
+#if defined(__SSE2__)
+/* Blend 2 pixels unpacked to 16 bits per channel. The alpha lane multiplies by 255
+ * instead of a, which gives a + Ad * (255 - a) / 255 after rounding. */
+static __m128i ppe_sw_blend2_sse2(__m128i s, __m128i d)
+{
+    const __m128i c255 = _mm_set1_epi16(255);
+    const __m128i c128 = _mm_set1_epi16(128);
+    const __m128i alpha_lane = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF);
+    __m128i x;
+
+    x = _mm_add_epi16(_mm_mullo_epi16(s, _mm_or_si128(a, alpha_lane)),
+                      _mm_mullo_epi16(d, _mm_sub_epi16(c255, a)));
+    x = _mm_add_epi16(x, c128);
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+static void ppe_sw_blend_sse2(uint32_t *dst, const uint32_t *src, uint32_t num)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+    __m128i s;
+    __m128i d;
+    int mask;
+    uint32_t i;
+
+    for (i = 0; i + 4 <= num; i += 4)
+    {
+        s = _mm_loadu_si128((const __m128i *)(src + i));
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alpha), alpha));
+        if (mask == 0xFFFF)
+        {
+            _mm_storeu_si128((__m128i *)(dst + i), s);
+            continue;
+        }
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alpha), zero));
+        if (mask == 0xFFFF)
+        {
+            continue;
+        }
+        d = _mm_loadu_si128((const __m128i *)(dst + i));
+        d = _mm_packus_epi16(ppe_sw_blend2_sse2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero)),
+                             ppe_sw_blend2_sse2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero)));
+        _mm_storeu_si128((__m128i *)(dst + i), d);
+    }
+    ppe_sw_blend_scalar(dst + i, src + i, num - i);
+}
+#endif
+
+#if defined(__AVX2__)
+/* Same as ppe_sw_blend2_sse2() on 4 pixels, the unpack and pack work within 128-bit lanes */
+static __m256i ppe_sw_blend4_avx2(__m256i s, __m256i d)
+{
+    const __m256i c255 = _mm256_set1_epi16(255);
+    const __m256i c128 = _mm256_set1_epi16(128);
+    const __m256i alpha_lane = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0,
+                                                255, 0, 0, 0, 255, 0, 0, 0);
+    __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, 0xFF), 0xFF);
+    __m256i x;
+
+    x = _mm256_add_epi16(_mm256_mullo_epi16(s, _mm256_or_si256(a, alpha_lane)),
+                         _mm256_mullo_epi16(d, _mm256_sub_epi16(c255, a)));
+    x = _mm256_add_epi16(x, c128);
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+static void ppe_sw_blend_avx2(uint32_t *dst, const uint32_t *src, uint32_t num)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alpha = _mm256_set1_epi32((int)0xFF000000);
+    __m256i s;
+    __m256i d;
+    uint32_t i;
+
+    for (i = 0; i + 8 <= num; i += 8)
+    {
+        s = _mm256_loadu_si256((const __m256i *)(src + i));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(s, alpha), alpha)) == -1)
+        {
+            _mm256_storeu_si256((__m256i *)(dst + i), s);
+            continue;
+        }
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(s, alpha), zero)) == -1)
+        {
+            continue;
+        }
+        d = _mm256_loadu_si256((const __m256i *)(dst + i));
+        d = _mm256_packus_epi16(ppe_sw_blend4_avx2(_mm256_unpacklo_epi8(s, zero),
+                                                   _mm256_unpacklo_epi8(d, zero)),
+                                ppe_sw_blend4_avx2(_mm256_unpackhi_epi8(s, zero),
+                                                   _mm256_unpackhi_epi8(d, zero)));
+        _mm256_storeu_si256((__m256i *)(dst + i), d);
+    }
+    ppe_sw_blend_sse2(dst + i, src + i, num - i);
+}
+#endif
+
+#if defined(__AVX2__)
+#define PPE_SW_BLEND_KERNEL     ppe_sw_blend_avx2
+#elif defined(__SSE2__)
+#define PPE_SW_BLEND_KERNEL     ppe_sw_blend_sse2
+#else
+#define PPE_SW_BLEND_KERNEL     ppe_sw_blend_scalar
+#endif
+
+static ppe_sw_blend_kernel_t ppe_sw_blend_kernel = PPE_SW_BLEND_KERNEL;
+
+/*
+ * Blend w x h pixels of the upper layer onto the lower layer and store them in the
+ * output. The upper layer is an image, or the color if upper is NULL. The lower
+ * layer is an image, or transparent black if lower is NULL. The line lengths are in pixels.
+ */
+static void ppe_sw_compose(const ppe_buffer_t *upper, const uint8_t *upper_pixel,
+                           uint32_t upper_line, uint32_t color,
+                           const ppe_buffer_t *lower, const uint8_t *lower_pixel, uint32_t lower_line,
+                           PPE_PIXEL_FORMAT format, uint8_t *out_pixel, uint32_t out_line,
+                           uint32_t w, uint32_t h)
+{
+    uint32_t src[PPE_SW_CHUNK];
+    uint32_t dst[PPE_SW_CHUNK];
+    uint8_t upper_len = (upper != NULL) ? ppe_sw_get_format_data_len(upper->format) : 0;
+    uint8_t lower_len = (lower != NULL) ? ppe_sw_get_format_data_len(lower->format) : 0;
+    uint8_t out_len = ppe_sw_get_format_data_len(format);
+    uint32_t x;
+    uint32_t y;
+    uint32_t n;
+
+    if (upper == NULL)
+    {
+        ppe_sw_fill(src, color, MIN(w, PPE_SW_CHUNK));
+    }
+    for (y = 0; y < h; y++)
+    {
+        for (x = 0; x < w; x += n)
+        {
+            n = MIN(w - x, PPE_SW_CHUNK);
+            if (upper != NULL)
+            {
+                PPE_SW_Load_Line(upper, upper_pixel + (y * upper_line + x) * upper_len, n, src);
+            }
+            if (lower != NULL)
+            {
+                PPE_SW_Load_Line(lower, lower_pixel + (y * lower_line + x) * lower_len, n, dst);
+            }
+            else
+            {
+                memset(dst, 0, n * 4);
+            }
+            ppe_sw_blend_kernel(dst, src, n);
+            PPE_SW_Store_Line(format, out_pixel + (y * out_line + x) * out_len, dst, n);
+        }
+    }
+}
+
+/* Nearest pixel scaling of a w x h window, the output is stored contiguously */
+static void ppe_sw_scale(const ppe_buffer_t *image, const uint8_t *pixel, uint32_t w, uint32_t h,
+                         ppe_buffer_t *buffer, float x_ratio, float y_ratio)
+{
+    uint32_t line[PPE_SW_CHUNK];
+    uint32_t step_x = (uint32_t)(65536 / x_ratio);
+    uint32_t step_y = (uint32_t)(65536 / y_ratio);
+    uint8_t in_len = ppe_sw_get_format_data_len(image->format);
+    uint8_t out_len = ppe_sw_get_format_data_len(buffer->format);
+    uint32_t in_line = ppe_sw_line_len(image);
+    const uint8_t *row;
+    uint32_t sx;
+    uint32_t sy;
+    uint32_t x;
+    uint32_t y;
+    uint32_t n;
+    uint32_t i;
+
+    for (y = 0; y < buffer->height; y++)
+    {
+        sy = (uint32_t)MIN(((uint64_t)y * step_y) >> 16, h - 1);
+        row = pixel + sy * in_line * in_len;
+        for (x = 0; x < buffer->width; x += n)
+        {
+            n = MIN(buffer->width - x, PPE_SW_CHUNK);
+            for (i = 0; i < n; i++)
+            {
+                sx = (uint32_t)MIN(((uint64_t)(x + i) * step_x) >> 16, w - 1);
+                ppe_sw_load(image->format, row + sx * in_len, 1, &line[i]);
+            }
+            PPE_SW_Store_Line(buffer->format,
+                              (uint8_t *)buffer->memory + (y * buffer->width + x) * out_len, line, n);
+        }
+    }
+}
+
+static ppe_buffer_t ppe_sw_plain(const ppe_buffer_t *buffer)
+{
+    ppe_buffer_t plain = *buffer;
+
+    plain.color_key_en = false;
+    plain.global_alpha_en = false;
+    return plain;
+}
+
+/* Blend the part of image inside rect, after the parameters are checked */
+static PPE_ERR ppe_sw_blend(ppe_buffer_t *image, ppe_buffer_t *buffer, ppe_translate_t *trans,
+                            ppe_rect_t *rect, PPE_BLEND_MODE blend_mode)
+{
+    ppe_buffer_t lower;
+    ppe_rect_t source_rect;
+    ppe_rect_t buffer_rect;
+    ppe_rect_t blend_area;
+    uint8_t format_len = ppe_sw_get_format_data_len(image->format);
+    uint8_t *pixel;
+
+    source_rect.left = trans->x;
+    source_rect.top = trans->y;
+    source_rect.right = trans->x + image->width - 1;
+    source_rect.bottom = trans->y + image->height - 1;
+    buffer_rect.left = 0;
+    buffer_rect.top = 0;
+    buffer_rect.right = buffer->width - 1;
+    buffer_rect.bottom = buffer->height - 1;
+    if (!ppe_sw_rect_intersect(&blend_area, &source_rect, rect) ||
+        !ppe_sw_rect_intersect(&blend_area, &blend_area, &buffer_rect))
+    {
+        return PPE_SUCCESS;
+    }
+
+    pixel = (uint8_t *)buffer->memory +
+            (blend_area.left + blend_area.top * buffer->width) * ppe_sw_get_format_data_len(buffer->format);
+    lower = ppe_sw_plain(buffer);
+    ppe_sw_compose(image, (const uint8_t *)image->memory +
+                   ((blend_area.left - trans->x) + ppe_sw_line_len(image) * (blend_area.top - trans->y)) * format_len,
+                   ppe_sw_line_len(image), 0,
+                   (blend_mode == PPE_BYPASS_MODE) ? NULL : &lower, pixel, buffer->width,
+                   buffer->format, pixel, buffer->width,
+                   blend_area.right - blend_area.left + 1, blend_area.bottom - blend_area.top + 1);
+    return PPE_SUCCESS;
+}
+
+/*============================================================================*
+ *                           Public Functions
+ *============================================================================*/
+uint8_t ppe_sw_get_format_data_len(PPE_PIXEL_FORMAT format)
+{
+    const ppe_sw_format_t *f = ppe_sw_get_format(format);
+
+    return (f != NULL) ? f->len : 0;
+}
+
+void PPE_SW_Load_Line(const ppe_buffer_t *image, const void *pixel, uint32_t num, uint32_t *out)
+{
+    const uint8_t *p = (const uint8_t *)pixel;
+    uint8_t len = ppe_sw_get_format_data_len(image->format);
+    uint32_t i;
+
+    ppe_sw_load(image->format, p, num, out);
+    if (image->color_key_en)
+    {
+        for (i = 0; i < num; i++)
+        {
+            if (ppe_sw_read(p + i * len, len) == image->color_key_value)
+            {
+                out[i] = 0;
+            }
+        }
+    }
+    if (image->global_alpha_en && (image->global_alpha != 0xFF))
+    {
+        for (i = 0; i < num; i++)
+        {
+            out[i] = (((out[i] >> 24) * image->global_alpha / 255) << 24) | (out[i] & 0xFFFFFF);
+        }
+    }
+}
+
+void PPE_SW_Store_Line(PPE_PIXEL_FORMAT format, void *pixel, const uint32_t *in, uint32_t num)
+{
+    const ppe_sw_format_t *f = &ppe_sw_format[format];
+    uint8_t *p = (uint8_t *)pixel;
+    uint32_t v;
+    uint32_t i;
+
+    switch (format)
+    {
+    case PPE_ABGR8888:
+        memcpy(p, in, num * 4);
+        break;
+    case PPE_XBGR8888:
+    case PPE_ARGB8888:
+    case PPE_XRGB8888:
+        for (i = 0; i < num; i++, p += 4)
+        {
+            v = (format == PPE_XBGR8888) ? in[i] : ppe_sw_swap_rb(in[i]);
+            v |= (format == PPE_ARGB8888) ? 0 : 0xFF000000;
+            memcpy(p, &v, 4);
+        }
+        break;
+    case PPE_RGB888:
+        for (i = 0; i < num; i++, p += 3)
+        {
+            p[0] = (in[i] >> 16) & 0xFF;
+            p[1] = (in[i] >> 8) & 0xFF;
+            p[2] = in[i] & 0xFF;
+        }
+        break;
+    case PPE_RGB565:
+        for (i = 0; i < num; i++, p += 2)
+        {
+            v = ((in[i] & 0xF8) << 8) | ((in[i] >> 5) & 0x7E0) | ((in[i] >> 19) & 0x1F);
+            p[0] = v & 0xFF;
+            p[1] = v >> 8;
+        }
+        break;
+    default:
+        for (i = 0; i < num; i++, p += f->len)
+        {
+            ppe_sw_write(p, f->len, ppe_sw_pack(f, in[i]));
+        }
+        break;
+    }
+}
+
+void PPE_SW_Blend_Line(uint32_t *dst, const uint32_t *src, uint32_t num)
+{
+    ppe_sw_blend_kernel(dst, src, num);
+}
+
+void PPE_SW_Blend_Line_Ref(uint32_t *dst, const uint32_t *src, uint32_t num)
+{
+    ppe_sw_blend_scalar(dst, src, num);
+}
+
+void PPE_SW_Set_Blend_Kernel(ppe_sw_blend_kernel_t kernel)
+{
+    ppe_sw_blend_kernel = (kernel != NULL) ? kernel : PPE_SW_BLEND_KERNEL;
+}
+
+PPE_ERR PPE_SW_Scale(ppe_buffer_t *image, ppe_buffer_t *buffer, float x_ratio, float y_ratio)
+{
+    if (buffer == NULL)
+    {
+        return PPE_ERROR_NULL_TARGET;
+    }
+    if (image == NULL)
+    {
+        return PPE_ERROR_NULL_SOURCE;
+    }
+    if ((image->address % 4) || (buffer->address % 4))
+    {
+        return PPE_ERROR_ADDR_NOT_ALIGNED;
+    }
+    if ((ppe_sw_get_format_data_len(image->format) == 0) || (ppe_sw_get_format_data_len(buffer->format) == 0))
+    {
+        return PPE_ERROR_UNKNOWN_FORMAT;
+    }
+    if ((x_ratio <= 0) || (y_ratio <= 0))
+    {
+        return PPE_ERROR_INVALID_PARAM;
+    }
+
+    buffer->width   = (uint32_t)image->width * x_ratio;
+    buffer->height  = (uint32_t)image->height * y_ratio;
+    if (buffer->width == 0 || buffer->height == 0)
+    {
+        return PPE_SUCCESS_NOT_CHANGE;
+    }
+    ppe_sw_scale(image, (const uint8_t *)image->memory, image->width, image->height, buffer,
+                 x_ratio, y_ratio);
+    return PPE_SUCCESS;
+}
+
+PPE_ERR PPE_SW_Scale_Rect(ppe_buffer_t *image, ppe_buffer_t *buffer, float x_ratio,
+                          float y_ratio, ppe_rect_t *rect)
+{
+    uint8_t format_len;
+
+    if (buffer == NULL)
+    {
+        return PPE_ERROR_NULL_TARGET;
+    }
+    if (image == NULL)
+    {
+        return PPE_ERROR_NULL_SOURCE;
+    }
+    if ((image->address % 4) || (buffer->address % 4))
+    {
+        return PPE_ERROR_ADDR_NOT_ALIGNED;
+    }
+    if ((rect == NULL) || (rect->top > rect->bottom) || (rect->left > rect->right)
+        || (rect->left < 0) || (rect->top < 0)
+        || (rect->right >= image->width) || (rect->bottom >= image->height)
+        || (x_ratio <= 0) || (y_ratio <= 0))
+    {
+        return PPE_ERROR_INVALID_PARAM;
+    }
+    format_len = ppe_sw_get_format_data_len(image->format);
+    if ((format_len == 0) || (ppe_sw_get_format_data_len(buffer->format) == 0))
+    {
+        return PPE_ERROR_UNKNOWN_FORMAT;
+    }
+
+    buffer->width   = (uint32_t)(rect->right - rect->left + 1) * x_ratio;
+    buffer->height  = (uint32_t)(rect->bottom - rect->top + 1) * y_ratio;
+    buffer->stride  = buffer->width;
+    if (buffer->width == 0 || buffer->height == 0)
+    {
+        return PPE_SUCCESS_NOT_CHANGE;
+    }
+    ppe_sw_scale(image, (const uint8_t *)image->memory +
+                 (rect->left + ppe_sw_line_len(image) * rect->top) * format_len,
+                 rect->right - rect->left + 1, rect->bottom - rect->top + 1, buffer, x_ratio, y_ratio);
+    return PPE_SUCCESS;
+}
+
+PPE_ERR PPE_SW_Clear(ppe_buffer_t *buffer, uint32_t color)
+{
+    ppe_rect_t rect;
+
+    if (buffer == NULL)
+    {
+        return PPE_ERROR_NULL_TARGET;
+    }
+    if (ppe_sw_get_format_data_len(buffer->format) == 0)
+    {
+        return PPE_ERROR_UNKNOWN_FORMAT;
+    }
+    if ((buffer->width == 0) || (buffer->height == 0))
+    {
+        return PPE_SUCCESS;
+    }
+
+    rect.left = 0;
+    rect.top = 0;
+    rect.right = buffer->width - 1;
+    rect.bottom = buffer->height - 1;
+    ppe_sw_fill_rect(buffer->format, (uint8_t *)buffer->memory, buffer->width,
+                     rect.right - rect.left + 1, rect.bottom - rect.top + 1, color);
+    return PPE_SUCCESS;
+}
+
+PPE_ERR PPE_SW_Clear_Rect(ppe_buffer_t *buffer, ppe_rect_t *rect, uint32_t color)
+{
+    ppe_buffer_t lower;
+    ppe_rect_t buffer_rect;
+    ppe_rect_t transfer_rect;
+    uint8_t format_len;
+    uint8_t *pixel;
+
+    if (buffer == NULL)
+    {
+        return PPE_ERROR_NULL_TARGET;
+    }
+    if ((rect == NULL) || (rect->top > rect->bottom) || (rect->left > rect->right))
+    {
+        return PPE_ERROR_INVALID_PARAM;
+    }
+    format_len = ppe_sw_get_format_data_len(buffer->format);
+    if (format_len == 0)
+    {
+        return PPE_ERROR_UNKNOWN_FORMAT;
+    }
+
+    buffer_rect.left = 0;
+    buffer_rect.top = 0;
+    buffer_rect.right = buffer->width - 1;
+    buffer_rect.bottom = buffer->height - 1;
+    if (!ppe_sw_rect_intersect(&transfer_rect, &buffer_rect, rect))
+    {
+        return PPE_SUCCESS;
+    }
+    if (buffer->global_alpha_en)
+    {
+        color = (((color >> 24) * buffer->global_alpha / 255) << 24) + (color & 0xFFFFFF);
+    }
+
+    pixel = (uint8_t *)buffer->memory +
+            (transfer_rect.left + transfer_rect.top * buffer->width) * format_len;
+    if ((color >> 24) == 0xFF)
+    {
+        ppe_sw_fill_rect(buffer->format, pixel, buffer->width, transfer_rect.right - transfer_rect.left + 1,
+                         transfer_rect.bottom - transfer_rect.top + 1, color);
+        return PPE_SUCCESS;
+    }
+    lower = ppe_sw_plain(buffer);
+    ppe_sw_compose(NULL, NULL, 0, color, &lower, pixel, buffer->width, buffer->format, pixel,
+                   buffer->width, transfer_rect.right - transfer_rect.left + 1,
+                   transfer_rect.bottom - transfer_rect.top + 1);
+    return PPE_SUCCESS;
+}
+
+PPE_ERR PPE_SW_Blend(ppe_buffer_t *image, ppe_buffer_t *buffer, ppe_translate_t *trans,
+                     PPE_BLEND_MODE blend_mode)
+{
+    ppe_rect_t rect;
+
+    if (buffer == NULL)
+    {
+        return PPE_ERROR_NULL_TARGET;
+    }
+    if (image == NULL)
+    {
+        return PPE_ERROR_NULL_SOURCE;
+    }
+    if ((trans->x < -(image->width - 1)) || (trans->x >= (buffer->width - 1)) \
+        || (trans->y < -(image->height - 1)) || (trans->y >= (buffer->height - 1)))
+    {
+        return PPE_ERROR_OUT_OF_RANGE;
+    }
+    if ((ppe_sw_get_format_data_len(image->format) == 0) ||
+        (ppe_sw_get_format_data_len(buffer->format) == 0))
+    {
+        return PPE_ERROR_UNKNOWN_FORMAT;
+    }
+
+    rect.left = 0;
+    rect.top = 0;
+    rect.right = buffer->width - 1;
+    rect.bottom = buffer->height - 1;
+    return ppe_sw_blend(image, buffer, trans, &rect, blend_mode);
+}
+
+PPE_ERR PPE_SW_Blend_Rect(ppe_buffer_t *image, ppe_buffer_t *buffer, ppe_translate_t *trans,
+                          ppe_rect_t *rect, PPE_BLEND_MODE blend_mode)
+{
+    if (buffer == NULL)
+    {
+        return PPE_ERROR_NULL_TARGET;
+    }
+    if (image == NULL)
+    {
+        return PPE_ERROR_NULL_SOURCE;
+    }
+    if ((image->address % 4) || (buffer->address % 4))
+    {
+        return PPE_ERROR_ADDR_NOT_ALIGNED;
+    }
+    if ((ppe_sw_get_format_data_len(image->format) == 0) ||
+        (ppe_sw_get_format_data_len(buffer->format) == 0))
+    {
+        return PPE_ERROR_UNKNOWN_FORMAT;
+    }
+    if ((trans == NULL) || (rect == NULL))
+    {
+        return PPE_ERROR_INVALID_PARAM;
+    }
+    return ppe_sw_blend(image, buffer, trans, rect, blend_mode);
+}
+
+PPE_ERR PPE_SW_Mask(ppe_buffer_t *src, ppe_buffer_t *target, ppe_rect_t *rect, uint32_t color)
+{
+    ppe_buffer_t lower;
+    uint8_t format_len;
+
+    if (target == NULL)
+    {
+        return PPE_ERROR_NULL_TARGET;
+    }
+    if (src == NULL)
+    {
+        return PPE_ERROR_NULL_SOURCE;
+    }
+    format_len = ppe_sw_get_format_data_len(src->format);
+    if ((format_len == 0) || (ppe_sw_get_format_data_len(target->format) == 0))
+    {
+        return PPE_ERROR_UNKNOWN_FORMAT;
+    }
+    if ((rect == NULL) || (rect->top > rect->bottom) || (rect->left > rect->right)
+        || (rect->left < 0) || (rect->top < 0)
+        || (rect->right >= src->width) || (rect->bottom >= src->height))
+    {
+        return PPE_ERROR_INVALID_PARAM;
+    }
+
+    lower = *src;
+    lower.global_alpha_en = false;
+    ppe_sw_compose(NULL, NULL, 0, color,
+                   &lower, (const uint8_t *)src->memory + (rect->top * src->width + rect->left) * format_len,
+                   src->width, target->format, (uint8_t *)target->memory, rect->right - rect->left + 1,
+                   rect->right - rect->left + 1, rect->bottom - rect->top + 1);
+    return PPE_SUCCESS;
+}
+
+/******************* (C) COPYRIGHT 2023 Realtek Semiconductor Corporation *****END OF FILE****/
@@ -43,6 +43,7 @@
 #include "lwip/stats.h"
 #include "lwip/debug.h"
 #include "lwip/sys.h"
+#include <stdbool.h>
 #include <string.h>
 #include "trace.h"
 
@@ -64,6 +65,37 @@ struct timeoutlist
     struct sys_timeouts timeouts;
     xTaskHandle pid;
 };
+
+#if !NO_SYS
+/* Bounded lock-free ring, each cell has a sequence number telling whether it is free for
+ * the position wr or holds the message of the position rd. Posting and fetching only enter
+ * the kernel to wake a thread which waits for the ring.
+ */
+struct sys_mbox_cell
+{
+    uint32_t seq;
+    void *msg;
+};
+
+struct sys_mbox
+{
+    uint32_t mask;                      /* Number of cells minus 1, a power of 2 */
+    uint32_t wr;
+    uint32_t rd;
+    uint32_t fetch_waiters;
+    uint32_t post_waiters;
+    SemaphoreHandle_t not_empty;
+    SemaphoreHandle_t not_full;
+    struct sys_mbox_cell cell[];
+};
+
+struct sys_mutex
+{
+    uint32_t state;                     /* 0: free, 1: taken, 2: taken with waiters */
+    SemaphoreHandle_t sem;
+};
+#endif
+
 /*============================================================================*
  *                              Local Variables
  *============================================================================*/
@@ -79,6 +111,134 @@ static uint16_t s_nextthread = 0;
 /*============================================================================*
  *                              Local Functions
  *============================================================================*/
+#if !NO_SYS
+static bool sys_mbox_push(struct sys_mbox *mbox, void *msg)
+{
+    uint32_t pos = __atomic_load_n(&mbox->wr, __ATOMIC_RELAXED);
+    struct sys_mbox_cell *cell;
+    int32_t diff;
+
+    for (;;)
+    {
+        cell = &mbox->cell[pos & mbox->mask];
+        diff = (int32_t)(__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) - pos);
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&mbox->wr, &pos, pos + 1, true, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = __atomic_load_n(&mbox->wr, __ATOMIC_RELAXED);
+        }
+    }
+
+    cell->msg = msg;
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static bool sys_mbox_pop(struct sys_mbox *mbox, void **msg)
+{
+    uint32_t pos = __atomic_load_n(&mbox->rd, __ATOMIC_RELAXED);
+    struct sys_mbox_cell *cell;
+    int32_t diff;
+
+    for (;;)
+    {
+        cell = &mbox->cell[pos & mbox->mask];
+        diff = (int32_t)(__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) - (pos + 1));
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&mbox->rd, &pos, pos + 1, true, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = __atomic_load_n(&mbox->rd, __ATOMIC_RELAXED);
+        }
+    }
+
+    *msg = cell->msg;
+    __atomic_store_n(&cell->seq, pos + mbox->mask + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/* the waiter counts are raised before a thread checks the ring again and blocks,
+ * so a wake is never lost
+ */
+static void sys_mbox_wake_fetch(struct sys_mbox *mbox)
+{
+    if (__atomic_load_n(&mbox->fetch_waiters, __ATOMIC_SEQ_CST) != 0)
+    {
+        xSemaphoreGive(mbox->not_empty);
+    }
+}
+
+static void sys_mbox_wake_post(struct sys_mbox *mbox)
+{
+    if (__atomic_load_n(&mbox->post_waiters, __ATOMIC_SEQ_CST) != 0)
+    {
+        xSemaphoreGive(mbox->not_full);
+    }
+}
+
+/* returns false on timeout */
+static bool sys_mbox_wait(struct sys_mbox *m, void **msg, uint32_t timeout)
+{
+    TimeOut_t time_out;
+    TickType_t wait_tick;
+    bool ret;
+
+    if (sys_mbox_pop(m, msg))
+    {
+        return true;
+    }
+
+    if (timeout != 0)
+    {
+        wait_tick = timeout / portTICK_PERIOD_MS;
+        if (wait_tick == 0)
+        {
+            wait_tick = 1;
+        }
+    }
+    else
+    {
+        wait_tick = portMAX_DELAY;
+    }
+    vTaskSetTimeOutState(&time_out);
+
+    __atomic_add_fetch(&m->fetch_waiters, 1, __ATOMIC_SEQ_CST);
+    /* a wake may be for another thread or already used, so check the ring again */
+    while (!(ret = sys_mbox_pop(m, msg)))
+    {
+        if (xTaskCheckForTimeOut(&time_out, &wait_tick) != pdFALSE ||
+            xSemaphoreTake(m->not_empty, wait_tick) != pdTRUE)
+        {
+            /* a post may land after the wait gives up, it is a timeout only if the ring is empty */
+            ret = sys_mbox_pop(m, msg);
+            break;
+        }
+    }
+    __atomic_sub_fetch(&m->fetch_waiters, 1, __ATOMIC_SEQ_CST);
+    return ret;
+}
+#endif
 
 /*============================================================================*
 *                              Global Functions
@@ -129,16 +289,19 @@ struct sys_timeouts *sys_arch_timeouts(void)
     return NULL;
 }
 
+/* lwIP only protects a few pointer updates, masking the interrupts below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY is enough and nests without the critical nesting count.
+ * Interrupts above configMAX_SYSCALL_INTERRUPT_PRIORITY are not masked, so they must not call
+ * into lwIP.
+ */
 sys_prot_t sys_arch_protect(void)
 {
-    vPortEnterCritical();
-    return 1;
+    return (sys_prot_t)portSET_INTERRUPT_MASK_FROM_ISR();
 }
 
 void sys_arch_unprotect(sys_prot_t pval)
 {
-    (void) pval;
-    vPortExitCritical();
+    portCLEAR_INTERRUPT_MASK_FROM_ISR((uint32_t)pval);
 }
 
 #if !NO_SYS
@@ -246,7 +409,23 @@ void sys_sem_signal(sys_sem_t *sem)
 
 err_t sys_mutex_new(sys_mutex_t *mutex)
 {
-    *mutex = xSemaphoreCreateMutex();
+    struct sys_mutex *m = pvPortMalloc(RAM_TYPE_DATA_ON, sizeof(struct sys_mutex));
+
+    if (m != NULL)
+    {
+        m->state = 0;
+#if SYS_ARCH_FAST_MUTEX
+        m->sem = xSemaphoreCreateBinary();
+#else
+        m->sem = xSemaphoreCreateMutex();
+#endif
+        if (m->sem == NULL)
+        {
+            vPortFree(m);
+            m = NULL;
+        }
+    }
+    *mutex = m;
 
     if (*mutex != SYS_MRTEX_NULL)
     {
@@ -261,7 +440,8 @@ err_t sys_mutex_new(sys_mutex_t *mutex)
 
 void sys_mutex_free(sys_mutex_t *mutex)
 {
-    vSemaphoreDelete(*mutex);
+    vSemaphoreDelete((*mutex)->sem);
+    vPortFree(*mutex);
 }
 
 void sys_mutex_set_invalid(sys_mutex_t *mutex)
@@ -271,12 +451,41 @@ void sys_mutex_set_invalid(sys_mutex_t *mutex)
 
 void sys_mutex_lock(sys_mutex_t *mutex)
 {
-    xSemaphoreTake(*mutex, portMAX_DELAY);
+    struct sys_mutex *m = *mutex;
+#if SYS_ARCH_FAST_MUTEX
+    uint32_t state = 0;
+
+    if (__atomic_compare_exchange_n(&m->state, &state, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+    /* mark it contended, so the unlock gives the semaphore */
+    if (state != 2)
+    {
+        state = __atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE);
+    }
+    while (state != 0)
+    {
+        xSemaphoreTake(m->sem, portMAX_DELAY);
+        state = __atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE);
+    }
+#else
+    xSemaphoreTake(m->sem, portMAX_DELAY);
+#endif
 }
 
 void sys_mutex_unlock(sys_mutex_t *mutex)
 {
-    xSemaphoreGive(*mutex);
+    struct sys_mutex *m = *mutex;
+
+#if SYS_ARCH_FAST_MUTEX
+    if (__atomic_exchange_n(&m->state, 0, __ATOMIC_RELEASE) == 2)
+    {
+        xSemaphoreGive(m->sem);
+    }
+#else
+    xSemaphoreGive(m->sem);
+#endif
 }
 
 sys_thread_t sys_thread_new(const char *name, lwip_thread_fn function, void *arg, int stacksize,
@@ -302,7 +511,42 @@ sys_thread_t sys_thread_new(const char *name, lwip_thread_fn function, void *arg
 
 err_t sys_mbox_new(sys_mbox_t *mbox, int size)
 {
-    *mbox = xQueueCreate((UBaseType_t) size, (UBaseType_t) sizeof(void *));
+    struct sys_mbox *m;
+    uint32_t num = 1;
+    uint32_t i;
+
+    while (num < (uint32_t)size)
+    {
+        num <<= 1;
+    }
+
+    m = pvPortMalloc(RAM_TYPE_DATA_ON, sizeof(struct sys_mbox) + num * sizeof(struct sys_mbox_cell));
+    if (m != NULL)
+    {
+        memset(m, 0, sizeof(struct sys_mbox));
+        m->mask = num - 1;
+        for (i = 0; i < num; i++)
+        {
+            m->cell[i].seq = i;
+        }
+        /* counting, so the wakes of several waiting threads are not merged */
+        m->not_empty = xSemaphoreCreateCounting(num, 0);
+        m->not_full = xSemaphoreCreateCounting(num, 0);
+        if (m->not_empty == NULL || m->not_full == NULL)
+        {
+            if (m->not_empty != NULL)
+            {
+                vSemaphoreDelete(m->not_empty);
+            }
+            if (m->not_full != NULL)
+            {
+                vSemaphoreDelete(m->not_full);
+            }
+            vPortFree(m);
+            m = NULL;
+        }
+    }
+    *mbox = m;
 
 #if SYS_STATS
     ++lwip_stats.sys.mbox.used;
@@ -321,7 +565,9 @@ err_t sys_mbox_new(sys_mbox_t *mbox, int size)
 
 void sys_mbox_free(sys_mbox_t *mbox)
 {
-    if (uxQueueMessagesWaiting(*mbox))
+    struct sys_mbox *m = *mbox;
+
+    if (m->wr != m->rd)
     {
         /* Line for breakpoint.  Should never break here! */
         portNOP();
@@ -332,7 +578,9 @@ void sys_mbox_free(sys_mbox_t *mbox)
         // TODO notify the user of failure.
     }
 
-    vQueueDelete(*mbox);
+    vSemaphoreDelete(m->not_empty);
+    vSemaphoreDelete(m->not_full);
+    vPortFree(m);
 
 #if SYS_STATS
     --lwip_stats.sys.mbox.used;
@@ -358,13 +606,28 @@ void sys_mbox_set_invalid(sys_mbox_t *mbox)
 
 void sys_mbox_post(sys_mbox_t *q, void *msg)
 {
-    while (xQueueSend(*q, &msg, portMAX_DELAY) != pdTRUE);
+    struct sys_mbox *m = *q;
+
+    while (!sys_mbox_push(m, msg))
+    {
+        __atomic_add_fetch(&m->post_waiters, 1, __ATOMIC_SEQ_CST);
+        if (!sys_mbox_push(m, msg))
+        {
+            xSemaphoreTake(m->not_full, portMAX_DELAY);
+            __atomic_sub_fetch(&m->post_waiters, 1, __ATOMIC_SEQ_CST);
+            continue;
+        }
+        __atomic_sub_fetch(&m->post_waiters, 1, __ATOMIC_SEQ_CST);
+        break;
+    }
+    sys_mbox_wake_fetch(m);
 }
 
 err_t sys_mbox_trypost(sys_mbox_t *q, void *msg)
 {
-    if (xQueueSend(*q, &msg, 0) == pdPASS)
+    if (sys_mbox_push(*q, msg))
     {
+        sys_mbox_wake_fetch(*q);
         return ERR_OK;
     }
     else
@@ -376,13 +639,24 @@ err_t sys_mbox_trypost(sys_mbox_t *q, void *msg)
 
 err_t sys_mbox_trypost_fromisr(sys_mbox_t *q, void *msg)
 {
-    return sys_mbox_trypost(q, msg);
+    struct sys_mbox *m = *q;
+    BaseType_t woken = pdFALSE;
+
+    if (!sys_mbox_push(m, msg))
+    {
+        return ERR_MEM;
+    }
+    if (__atomic_load_n(&m->fetch_waiters, __ATOMIC_SEQ_CST) != 0)
+    {
+        xSemaphoreGiveFromISR(m->not_empty, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+    return ERR_OK;
 }
 
 uint32_t sys_arch_mbox_fetch(sys_mbox_t *q, void **msg, uint32_t timeout)
 {
     void *dummyptr;
-    uint32_t wait_tick = 0;
     uint32_t start_tick = 0 ;
 
     if (msg == NULL)
@@ -392,27 +666,15 @@ uint32_t sys_arch_mbox_fetch(sys_mbox_t *q, void **msg, uint32_t timeout)
 
     start_tick = sys_now();
 
-    if (timeout != 0)
-    {
-        wait_tick = timeout / portTICK_PERIOD_MS;
-        if (wait_tick == 0)
-        {
-            wait_tick = 1;
-        }
-    }
-    else
-    {
-        wait_tick = portMAX_DELAY;
-    }
-
-    if (xQueueReceive(*q, &(*msg), wait_tick) == pdTRUE)
+    if (sys_mbox_wait(*q, msg, timeout))
     {
+        sys_mbox_wake_post(*q);
         return ((sys_now() - start_tick) * portTICK_PERIOD_MS);
     }
     else
     {
-        *msg = NULL;
 //      APP_PRINT_INFO0("[sys_arch_mbox_fetch] timeout");
+        *msg = NULL;
         return SYS_ARCH_TIMEOUT;
     }
 }
@@ -426,8 +688,9 @@ uint32_t sys_arch_mbox_tryfetch(sys_mbox_t *q, void **msg)
         msg = &dummyptr;
     }
 
-    if (xQueueReceive(*q, &(*msg), 0) == pdTRUE)
+    if (sys_mbox_pop(*q, msg))
     {
+        sys_mbox_wake_post(*q);
         return ERR_OK;
     }
     else
@@ -437,6 +700,26 @@ uint32_t sys_arch_mbox_tryfetch(sys_mbox_t *q, void **msg)
     }
 }
 
+uint32_t sys_arch_mbox_fetch_batch(sys_mbox_t *q, void **msg, uint32_t num, uint32_t timeout)
+{
+    uint32_t count = 0;
+
+    if (num == 0 || !sys_mbox_wait(*q, &msg[0], timeout))
+    {
+        return 0;
+    }
+    sys_mbox_wake_post(*q);
+    for (count = 1; count < num; count++)
+    {
+        if (!sys_mbox_pop(*q, &msg[count]))
+        {
+            break;
+        }
+        sys_mbox_wake_post(*q);
+    }
+    return count;
+}
+
 #if LWIP_NETCONN_SEM_PER_THREAD
 #error LWIP_NETCONN_SEM_PER_THREAD==1 not supported
 #endif /* LWIP_NETCONN_SEM_PER_THREAD */
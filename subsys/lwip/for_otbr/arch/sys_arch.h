@@ -50,17 +50,24 @@ extern "C"
 /*============================================================================*
  *                         Macros
  *============================================================================*/
-#define SYS_MBOX_NULL  (QueueHandle_t)0
+/* Take sys_mutex without a kernel call when it is free. The kernel is only entered on
+ * contention, so there is no priority inheritance. Set it to 0 for FreeRTOS mutexes.
+ */
+#ifndef SYS_ARCH_FAST_MUTEX
+#define SYS_ARCH_FAST_MUTEX 1
+#endif
+
+#define SYS_MBOX_NULL  (sys_mbox_t)0
 #define SYS_SEM_NULL   (SemaphoreHandle_t)0
-#define SYS_MRTEX_NULL SYS_SEM_NULL
+#define SYS_MRTEX_NULL (sys_mutex_t)0
 #define SYS_DEFAULT_THREAD_STACK_DEPTH  configMINIMAL_STACK_SIZE
 
 /*============================================================================*
  *                         Types
  *============================================================================*/
 typedef SemaphoreHandle_t sys_sem_t;
-typedef SemaphoreHandle_t sys_mutex_t;
-typedef QueueHandle_t sys_mbox_t;
+typedef struct sys_mutex *sys_mutex_t;
+typedef struct sys_mbox *sys_mbox_t;
 typedef TaskHandle_t sys_thread_t;
 typedef int sys_prot_t;
 
@@ -73,6 +80,11 @@ typedef int sys_prot_t;
  *============================================================================*/
 void TCPIP_Init(void);
 
+/* Fetch up to num messages, waiting for the first one as sys_arch_mbox_fetch.
+ * Returns the number of messages, 0 on timeout.
+ */
+uint32_t sys_arch_mbox_fetch_batch(sys_mbox_t *q, void **msg, uint32_t num, uint32_t timeout);
+
 #ifdef  __cplusplus
 }
 #endif
@@ -0,0 +1,279 @@
+/**
+*****************************************************************************************
+*     Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*****************************************************************************************
+   * @file      mac_frame.c
+   * @brief     IEEE802.15.4 MAC header parser
+   * @version   v1.0
+   **************************************************************************************
+   * @attention
+   * <h2><center>&copy; COPYRIGHT 2026 Realtek Semiconductor Corporation</center></h2>
+   **************************************************************************************
+  */
+#include <string.h>
+#include "mac_frame.h"
+
+/* Frame control field */
+#define FCF_TYPE_MASK           0x0007
+#define FCF_SECURITY            0x0008
+#define FCF_PENDING             0x0010
+#define FCF_ACK_REQ             0x0020
+#define FCF_PANID_COMP          0x0040
+#define FCF_SEQ_SUPPRESS        0x0100
+#define FCF_IE_PRESENT          0x0200
+#define FCF_DST_MODE_SHIFT      10
+#define FCF_VERSION_SHIFT       12
+#define FCF_SRC_MODE_SHIFT      14
+
+/* Security control field */
+#define SEC_LEVEL_MASK          0x07
+#define SEC_KEY_ID_MODE_SHIFT   3
+#define SEC_FC_SUPPRESS         0x20
+
+/* Header IE descriptor */
+#define IE_LEN_MASK             0x007F
+#define IE_ID_SHIFT             7
+#define IE_TYPE_PAYLOAD         0x8000
+
+static const uint8_t key_id_len[4] = {0, 1, 5, 9};
+
+static uint64_t get_le(const uint8_t *buf, uint8_t len)
+{
+    uint64_t value = 0;
+
+    while (len-- > 0)
+    {
+        value = (value << 8) | buf[len];
+    }
+    return value;
+}
+
+static uint8_t addr_len(uint8_t mode)
+{
+    return (mode == MAC_FRAME_ADDR_EXT) ? 8 : ((mode == MAC_FRAME_ADDR_SHORT) ? 2 : 0);
+}
+
+/* PAN ID presence of 2015 frames, IEEE 802.15.4-2015 table 7-2 */
+static void panid_presence_2015(uint8_t dst_mode, uint8_t src_mode, bool comp, bool *dst_panid,
+                                bool *src_panid)
+{
+    *dst_panid = false;
+    *src_panid = false;
+
+    if (dst_mode == MAC_FRAME_ADDR_NONE && src_mode == MAC_FRAME_ADDR_NONE)
+    {
+        *dst_panid = comp;
+    }
+    else if (src_mode == MAC_FRAME_ADDR_NONE)
+    {
+        *dst_panid = !comp;
+    }
+    else if (dst_mode == MAC_FRAME_ADDR_NONE)
+    {
+        *src_panid = !comp;
+    }
+    else if (dst_mode == MAC_FRAME_ADDR_EXT && src_mode == MAC_FRAME_ADDR_EXT)
+    {
+        *dst_panid = !comp;
+    }
+    else
+    {
+        *dst_panid = true;
+        *src_panid = !comp;
+    }
+}
+
+/* returns the offset after the header IEs, 0 if they run past end */
+static uint8_t parse_header_ies(const uint8_t *frame, uint8_t pos, uint8_t end, mac_frame_desc_t *desc)
+{
+    uint16_t ie;
+    uint8_t id;
+
+    desc->ie_offset = pos;
+    while (pos < end)
+    {
+        if (end - pos < 2)
+        {
+            return 0;
+        }
+        ie = frame[pos] | (frame[pos + 1] << 8);
+        if ((ie & IE_TYPE_PAYLOAD) || end - pos - 2 < (ie & IE_LEN_MASK))
+        {
+            return 0;
+        }
+        pos += 2 + (ie & IE_LEN_MASK);
+
+        id = (ie >> IE_ID_SHIFT) & 0xFF;
+        if (id == MAC_FRAME_IE_HT1)
+        {
+            desc->flags |= MAC_FRAME_FLAG_PAYLOAD_IE;
+            break;
+        }
+        if (id == MAC_FRAME_IE_HT2)
+        {
+            break;
+        }
+    }
+    desc->ie_len = pos - desc->ie_offset;
+    return pos;
+}
+
+mac_frame_status_t mac_frame_parse(const uint8_t *frame, uint8_t len, mac_frame_desc_t *desc)
+{
+    uint8_t pos = 2;
+    uint8_t end = len;
+    uint8_t sec_ctrl;
+    uint8_t alen;
+    bool dst_panid = false;
+    bool src_panid = false;
+    bool comp;
+
+    memset(desc, 0, sizeof(*desc));
+    desc->dst_panid = 0xFFFF;
+    desc->src_panid = 0xFFFF;
+
+    if (len < 2)
+    {
+        return MAC_FRAME_TRUNCATED;
+    }
+    desc->fcf = frame[0] | (frame[1] << 8);
+    desc->type = desc->fcf & FCF_TYPE_MASK;
+    desc->version = (desc->fcf >> FCF_VERSION_SHIFT) & 0x03;
+    desc->dst_addr_mode = (desc->fcf >> FCF_DST_MODE_SHIFT) & 0x03;
+    desc->src_addr_mode = (desc->fcf >> FCF_SRC_MODE_SHIFT) & 0x03;
+    comp = (desc->fcf & FCF_PANID_COMP) != 0;
+
+    if (desc->fcf & FCF_SECURITY)
+    {
+        desc->flags |= MAC_FRAME_FLAG_SECURITY;
+    }
+    if (desc->fcf & FCF_PENDING)
+    {
+        desc->flags |= MAC_FRAME_FLAG_PENDING;
+    }
+    if (desc->fcf & FCF_ACK_REQ)
+    {
+        desc->flags |= MAC_FRAME_FLAG_ACK_REQ;
+    }
+    if (comp)
+    {
+        desc->flags |= MAC_FRAME_FLAG_PANID_COMP;
+    }
+
+    if (desc->type > MAC_FRAME_TYPE_COMMAND)
+    {
+        return (desc->type == 4) ? MAC_FRAME_INVALID : MAC_FRAME_UNSUPPORTED;
+    }
+    if (desc->version > MAC_FRAME_VERSION_2015 || desc->dst_addr_mode == 1 ||
+        desc->src_addr_mode == 1)
+    {
+        return MAC_FRAME_INVALID;
+    }
+    if ((desc->flags & MAC_FRAME_FLAG_SECURITY) && desc->version == MAC_FRAME_VERSION_2003)
+    {
+        return MAC_FRAME_UNSUPPORTED;
+    }
+
+    /* Sequence number */
+    if (desc->version < MAC_FRAME_VERSION_2015 || !(desc->fcf & FCF_SEQ_SUPPRESS))
+    {
+        if (pos >= len)
+        {
+            return MAC_FRAME_TRUNCATED;
+        }
+        desc->seq = frame[pos++];
+        desc->flags |= MAC_FRAME_FLAG_SEQ;
+    }
+
+    /* Addressing fields */
+    if (desc->version == MAC_FRAME_VERSION_2015)
+    {
+        panid_presence_2015(desc->dst_addr_mode, desc->src_addr_mode, comp, &dst_panid, &src_panid);
+    }
+    else
+    {
+        dst_panid = desc->dst_addr_mode != MAC_FRAME_ADDR_NONE;
+        src_panid = desc->src_addr_mode != MAC_FRAME_ADDR_NONE && !comp;
+    }
+
+    alen = addr_len(desc->dst_addr_mode);
+    if (len - pos < (dst_panid ? 2 : 0) + alen)
+    {
+        return MAC_FRAME_TRUNCATED;
+    }
+    if (dst_panid)
+    {
+        desc->dst_panid = frame[pos] | (frame[pos + 1] << 8);
+        desc->flags |= MAC_FRAME_FLAG_DST_PANID;
+        pos += 2;
+    }
+    desc->dst_addr = get_le(&frame[pos], alen);
+    pos += alen;
+
+    alen = addr_len(desc->src_addr_mode);
+    if (len - pos < (src_panid ? 2 : 0) + alen)
+    {
+        return MAC_FRAME_TRUNCATED;
+    }
+    if (src_panid)
+    {
+        desc->src_panid = frame[pos] | (frame[pos + 1] << 8);
+        desc->flags |= MAC_FRAME_FLAG_SRC_PANID;
+        pos += 2;
+    }
+    else if (desc->src_addr_mode != MAC_FRAME_ADDR_NONE)
+    {
+        desc->src_panid = desc->dst_panid;
+    }
+    desc->src_addr = get_le(&frame[pos], alen);
+    pos += alen;
+
+    /* Auxiliary security header */
+    if (desc->flags & MAC_FRAME_FLAG_SECURITY)
+    {
+        if (pos >= len)
+        {
+            return MAC_FRAME_TRUNCATED;
+        }
+        sec_ctrl = frame[pos];
+        desc->sec_offset = pos;
+        desc->sec_level = sec_ctrl & SEC_LEVEL_MASK;
+        desc->key_id_mode = (sec_ctrl >> SEC_KEY_ID_MODE_SHIFT) & 0x03;
+        desc->mic_len = (desc->sec_level & 0x03) ? (2 << (desc->sec_level & 0x03)) : 0;
+        desc->sec_len = 1 + key_id_len[desc->key_id_mode];
+        if (desc->version < MAC_FRAME_VERSION_2015 || !(sec_ctrl & SEC_FC_SUPPRESS))
+        {
+            desc->sec_len += 4;
+        }
+        if (len - pos < desc->sec_len + desc->mic_len)
+        {
+            return MAC_FRAME_TRUNCATED;
+        }
+        pos++;
+        if (desc->sec_len > 1 + key_id_len[desc->key_id_mode])
+        {
+            desc->frame_counter = (uint32_t)get_le(&frame[pos], 4);
+            pos += 4;
+        }
+        pos += key_id_len[desc->key_id_mode];
+        if (desc->key_id_mode != 0)
+        {
+            desc->key_index = frame[pos - 1];
+        }
+        end = len - desc->mic_len;
+    }
+
+    /* Header IEs */
+    if (desc->version == MAC_FRAME_VERSION_2015 && (desc->fcf & FCF_IE_PRESENT))
+    {
+        pos = parse_header_ies(frame, pos, end, desc);
+        if (pos == 0)
+        {
+            return MAC_FRAME_TRUNCATED;
+        }
+    }
+
+    desc->hdr_len = pos;
+    desc->payload_len = end - pos;
+    return MAC_FRAME_OK;
+}
@@ -0,0 +1,101 @@
+/**
+*****************************************************************************************
+*     Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*****************************************************************************************
+   * @file      mac_frame.h
+   * @brief     IEEE802.15.4 MAC header parser
+   * @details   Parses the MHR of 2003, 2006 and 2015 frames into a descriptor of offsets
+   *            and values, so the upper layers need neither the RX header registers nor
+   *            a parser of their own. Plain C without driver dependencies, so it also
+   *            builds on a host.
+   * @version   v1.0
+   **************************************************************************************
+   * @attention
+   * <h2><center>&copy; COPYRIGHT 2026 Realtek Semiconductor Corporation</center></h2>
+   **************************************************************************************
+  */
+#ifndef _MAC_FRAME_H_
+#define _MAC_FRAME_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Frame types */
+#define MAC_FRAME_TYPE_BEACON       0
+#define MAC_FRAME_TYPE_DATA         1
+#define MAC_FRAME_TYPE_ACK          2
+#define MAC_FRAME_TYPE_COMMAND      3
+#define MAC_FRAME_TYPE_MULTIPURPOSE 5
+#define MAC_FRAME_TYPE_FRAGMENT     6
+#define MAC_FRAME_TYPE_EXTENDED     7
+
+/* Frame versions */
+#define MAC_FRAME_VERSION_2003      0
+#define MAC_FRAME_VERSION_2006      1
+#define MAC_FRAME_VERSION_2015      2
+
+/* Addressing modes */
+#define MAC_FRAME_ADDR_NONE         0
+#define MAC_FRAME_ADDR_SHORT        2
+#define MAC_FRAME_ADDR_EXT          3
+
+/* Descriptor flags */
+#define MAC_FRAME_FLAG_SECURITY     0x01 /* Auxiliary security header present */
+#define MAC_FRAME_FLAG_PENDING      0x02 /* Frame pending */
+#define MAC_FRAME_FLAG_ACK_REQ      0x04 /* ACK request */
+#define MAC_FRAME_FLAG_PANID_COMP   0x08 /* PAN ID compression bit */
+#define MAC_FRAME_FLAG_SEQ          0x10 /* Sequence number present */
+#define MAC_FRAME_FLAG_DST_PANID    0x20 /* Destination PAN ID present */
+#define MAC_FRAME_FLAG_SRC_PANID    0x40 /* Source PAN ID present */
+#define MAC_FRAME_FLAG_PAYLOAD_IE   0x80 /* Payload starts with payload IEs */
+
+/* Header IE element IDs which end the header IEs */
+#define MAC_FRAME_IE_HT1            0x7E /* Payload IEs follow */
+#define MAC_FRAME_IE_HT2            0x7F /* Payload follows */
+
+/* Parse results */
+typedef enum
+{
+    MAC_FRAME_OK = 0,
+    MAC_FRAME_TRUNCATED = 1,   /* Frame ends within the MHR or the MIC */
+    MAC_FRAME_INVALID = 2,     /* Reserved frame type, version or addressing mode */
+    MAC_FRAME_UNSUPPORTED = 3  /* Frame type without the general MHR, or 2003 security */
+} mac_frame_status_t;
+
+/* Pre-parsed frame, offsets are from the first byte of the frame control field */
+typedef struct
+{
+    uint16_t fcf;           /* Frame control field */
+    uint8_t type;           /* MAC_FRAME_TYPE_x */
+    uint8_t version;        /* MAC_FRAME_VERSION_x */
+    uint8_t flags;          /* MAC_FRAME_FLAG_x */
+    uint8_t seq;            /* Sequence number, 0 if suppressed */
+    uint8_t dst_addr_mode;  /* MAC_FRAME_ADDR_x */
+    uint8_t src_addr_mode;  /* MAC_FRAME_ADDR_x */
+    uint16_t dst_panid;     /* 0xFFFF if not present */
+    uint16_t src_panid;     /* Destination PAN ID if compressed, 0xFFFF if neither is present */
+    uint64_t dst_addr;      /* Short address in the low 16 bits, or the extended address */
+    uint64_t src_addr;
+    uint8_t sec_offset;     /* Auxiliary security header, 0 if not present */
+    uint8_t sec_len;
+    uint8_t sec_level;
+    uint8_t key_id_mode;
+    uint8_t key_index;      /* Last byte of the key identifier, 0 if key id mode 0 */
+    uint8_t mic_len;        /* MIC length at the end of the frame */
+    uint32_t frame_counter; /* 0 if suppressed */
+    uint8_t ie_offset;      /* Header IEs, 0 if not present */
+    uint8_t ie_len;         /* Length of the header IEs, the termination IE included */
+    uint8_t hdr_len;        /* MHR length, i.e. the offset of the payload */
+    uint8_t payload_len;    /* Payload length, the MIC excluded */
+    int8_t rssi;            /* RSSI in dBm, filled by the RX path */
+    uint8_t lqi;            /* LQI, filled by the RX path */
+    uint32_t timestamp;     /* RX timestamp of mac_rxfifo_tail_t, filled by the RX path */
+} mac_frame_desc_t;
+
+/************************************
+ * API Function Prototypes
+ ************************************/
+/* frame is the PHY payload without the FCS, len its length */
+mac_frame_status_t mac_frame_parse(const uint8_t *frame, uint8_t len, mac_frame_desc_t *desc);
+
+#endif /* _MAC_FRAME_H_ */
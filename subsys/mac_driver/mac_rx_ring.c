@@ -0,0 +1,83 @@
+/**
+*****************************************************************************************
+*     Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*****************************************************************************************
+   * @file      mac_rx_ring.c
+   * @brief     IEEE802.15.4 MAC batched RX FIFO drain
+   * @version   v1.0
+   **************************************************************************************
+   * @attention
+   * <h2><center>&copy; COPYRIGHT 2026 Realtek Semiconductor Corporation</center></h2>
+   **************************************************************************************
+  */
+#include "mac_rx_ring.h"
+#include "mac_stats.h"
+
+static uint8_t ring_next(const mac_rx_ring_t *ring, uint8_t idx)
+{
+    return (idx + 1 == ring->size) ? 0 : idx + 1;
+}
+
+void mac_rx_ring_init(mac_rx_ring_t *ring, mac_rx_entry_t *entry, uint8_t size)
+{
+    ring->entry = entry;
+    ring->size = size;
+    ring->wr = 0;
+    ring->rd = 0;
+}
+
+uint8_t mac_rx_drain(mac_rx_ring_t *ring)
+{
+    uint8_t channel = mac_GetChannel();
+    uint8_t count = 0;
+    uint8_t more = false;
+    uint8_t wr = ring->wr;
+    mac_rx_entry_t *entry;
+    mac_rxfifo_tail_t *tail;
+    uint8_t len;
+
+    while (ring_next(ring, wr) != ring->rd)
+    {
+        entry = &ring->entry[wr];
+        if (mac_RxFIFO(entry->rx_fifo, &more) != MAC_STS_SUCCESS)
+        {
+            break;
+        }
+
+        len = mac_rx_entry_len(entry);
+        if (len > MAC_RX_FIFO_SIZE - 1 - sizeof(mac_rxfifo_tail_t))
+        {
+            /* a corrupt length, the tail is not where it should be */
+            len = MAC_RX_FIFO_SIZE - 1 - sizeof(mac_rxfifo_tail_t);
+        }
+        entry->status = mac_frame_parse(mac_rx_entry_frame(entry), len, &entry->desc);
+
+        tail = (mac_rxfifo_tail_t *)&entry->rx_fifo[1 + len];
+        entry->desc.lqi = tail->lqi;
+        entry->desc.rssi = mac_GetRSSIFromRaw(tail->rssi, channel);
+        entry->desc.timestamp = tail->mac_time;
+        mac_stats_rx_signal_update(channel, entry->desc.rssi, entry->desc.lqi);
+
+        wr = ring_next(ring, wr);
+        ring->wr = wr;
+        count++;
+        if (!more)
+        {
+            break;
+        }
+    }
+    return count;
+}
+
+mac_rx_entry_t *mac_rx_ring_peek(mac_rx_ring_t *ring)
+{
+    return (ring->rd == ring->wr) ? NULL : &ring->entry[ring->rd];
+}
+
+void mac_rx_ring_release(mac_rx_ring_t *ring)
+{
+    if (ring->rd != ring->wr)
+    {
+        ring->rd = ring_next(ring, ring->rd);
+    }
+}
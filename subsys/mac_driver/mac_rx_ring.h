@@ -0,0 +1,66 @@
+/**
+*****************************************************************************************
+*     Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*****************************************************************************************
+   * @file      mac_rx_ring.h
+   * @brief     IEEE802.15.4 MAC batched RX FIFO drain
+   * @details   Moves every pending frame of the RX FIFO into a ring of the caller in one
+   *            pass, each with its pre-parsed header, RSSI, LQI and timestamp.
+   *            The drain is the only producer and the consumer is a single task, so the
+   *            ring needs no lock.
+   * @version   v1.0
+   **************************************************************************************
+   * @attention
+   * <h2><center>&copy; COPYRIGHT 2026 Realtek Semiconductor Corporation</center></h2>
+   **************************************************************************************
+  */
+#ifndef _MAC_RX_RING_H_
+#define _MAC_RX_RING_H_
+
+#include "mac_driver.h"
+#include "mac_frame.h"
+
+/* One received frame, rx_fifo holds the data of mac_RxFIFO: mac_rxfifo_t then mac_rxfifo_tail_t */
+typedef struct
+{
+    uint8_t rx_fifo[MAC_RX_FIFO_SIZE];
+    mac_frame_desc_t desc;
+    mac_frame_status_t status;  /* Result of the header parse, desc is partial if not MAC_FRAME_OK */
+} mac_rx_entry_t;
+
+typedef struct
+{
+    mac_rx_entry_t *entry;
+    uint8_t size;               /* Number of entries, one is kept empty */
+    volatile uint8_t wr;        /* Written by the drain only */
+    volatile uint8_t rd;        /* Written by the consumer only */
+} mac_rx_ring_t;
+
+/************************************
+ * API Function Prototypes
+ ************************************/
+void mac_rx_ring_init(mac_rx_ring_t *ring, mac_rx_entry_t *entry, uint8_t size);
+
+/* Drain the RX FIFO until it is empty or the ring is full, returns the number of frames taken.
+ * Frames left when the ring is full stay in the FIFO for the next drain.
+ */
+uint8_t mac_rx_drain(mac_rx_ring_t *ring);
+
+/* Oldest frame of the ring, NULL if empty */
+mac_rx_entry_t *mac_rx_ring_peek(mac_rx_ring_t *ring);
+
+/* Release the frame returned by mac_rx_ring_peek */
+void mac_rx_ring_release(mac_rx_ring_t *ring);
+
+/* PHY payload of an entry, the FCS excluded */
+static inline uint8_t *mac_rx_entry_frame(mac_rx_entry_t *entry)
+{
+    return ((mac_rxfifo_t *)entry->rx_fifo)->payload;
+}
+
+static inline uint8_t mac_rx_entry_len(const mac_rx_entry_t *entry)
+{
+    return ((const mac_rxfifo_t *)entry->rx_fifo)->frm_len;
+}
+
+#endif /* _MAC_RX_RING_H_ */
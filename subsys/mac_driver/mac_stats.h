@@ -37,13 +37,20 @@
 #ifndef MAC_STATS_PKTSIG_EN
 #define MAC_STATS_PKTSIG_EN 1
 #endif
+/* Histograms and windowed rates, see mac_stats_series.h */
+#ifndef MAC_STATS_SERIES_EN
+#define MAC_STATS_SERIES_EN 0
+#endif
 #else
 #undef MAC_STATS_TX_EN
 #undef MAC_STATS_RX_EN
 #undef MAC_STATS_IRQ_EN
 #undef MAC_STATS_PKTSIG_EN
+#undef MAC_STATS_SERIES_EN
 #endif
 
+#include "mac_stats_series.h"
+
 /* Maximum number of PANs (default: 1) */
 #ifndef MAX_PAN_NUM
 #define MAX_PAN_NUM 1
@@ -350,6 +357,47 @@ static inline mac_stats_pktsig_t *mac_stats_pktsig_get_instance(void)
 #endif
 }
 
+/* Series update functions */
+static inline void mac_stats_series_start(void)
+{
+#if MAC_STATS_SERIES_EN
+    mac_stats_series_init(&g_mac_stats_series, MAX_BT_CLOCK_COUNTER, mac_GetCurrentBTUS());
+#endif
+}
+
+static inline void mac_stats_series_event_inc(mac_stats_rate_event_t event, uint16_t count)
+{
+#if MAC_STATS_SERIES_EN
+    mac_stats_series_event(&g_mac_stats_series, event, count, mac_GetCurrentBTUS());
+#endif
+}
+
+static inline void mac_stats_tx_backoff_update(uint32_t backoff_us)
+{
+#if MAC_STATS_SERIES_EN
+    mac_stats_hist_add(&g_mac_stats_series.backoff, backoff_us);
+#endif
+}
+
+static inline void mac_stats_rx_signal_update(uint8_t channel, int8_t rssi, uint8_t lqi)
+{
+#if MAC_STATS_SERIES_EN
+    mac_stats_series_signal(&g_mac_stats_series, channel, rssi, lqi);
+#endif
+}
+
+/* Encode a snapshot frame of the series, returns its length or 0 */
+static inline uint16_t mac_stats_series_export(mac_stats_stream_t *stream, bool key, uint8_t *buf,
+                                               uint16_t size)
+{
+#if MAC_STATS_SERIES_EN
+    mac_stats_series_advance(&g_mac_stats_series, mac_GetCurrentBTUS());
+    return mac_stats_stream_encode(stream, &g_mac_stats_series, key, buf, size);
+#else
+    return 0;
+#endif
+}
+
 /* TX increment functions */
 static inline void mac_stats_tx_resp_time_update(uint8_t pan_idx, uint32_t resp_time)
 {
@@ -368,6 +416,9 @@ static inline void mac_stats_tx_resp_time_update(uint8_t pan_idx, uint32_t resp_
         stats->resp.avg_time += resp_time;
     }
 #endif
+#if MAC_STATS_SERIES_EN
+    mac_stats_hist_add(&g_mac_stats_series.tx_resp, resp_time);
+#endif
 }
 
 static inline void mac_stats_tx_request_inc(uint8_t pan_idx)
@@ -405,6 +456,7 @@ static inline void mac_stats_tx_succ_total_inc(uint8_t pan_idx)
 #endif
     stats->frm[idx].succ.total++;
     stats->frm[idx].succ.no_ack += mac_GetTxNRetryTimes();
+    mac_stats_series_event_inc(MAC_STATS_RATE_NO_ACK, mac_GetTxNRetryTimes());
     mac_stats_tx_resp_time_update(pan_idx, time_diff(stats->request_time, mac_GetCurrentBTUS()));
 #endif
 }
@@ -423,6 +475,7 @@ static inline void mac_stats_tx_succ_cca_fail_inc(uint8_t pan_idx)
     uint8_t idx = 0;
 #endif
     stats->frm[idx].succ.cca_fail++;
+    mac_stats_series_event_inc(MAC_STATS_RATE_CCA_FAIL, 1);
 #endif
 }
 
@@ -441,6 +494,7 @@ static inline void mac_stats_tx_fail_cca_fail_inc(uint8_t pan_idx)
 #endif
     stats->frm[idx].fail.cca_fail++;
     stats->frm[idx].fail.total++;
+    mac_stats_series_event_inc(MAC_STATS_RATE_CCA_FAIL, 1);
     mac_stats_tx_resp_time_update(pan_idx, time_diff(stats->request_time, mac_GetCurrentBTUS()));
 #endif
 }
@@ -460,6 +514,7 @@ static inline void mac_stats_tx_fail_no_ack_inc(uint8_t pan_idx)
 #endif
     stats->frm[idx].fail.no_ack++;
     stats->frm[idx].fail.total++;
+    mac_stats_series_event_inc(MAC_STATS_RATE_NO_ACK, 1);
     mac_stats_tx_resp_time_update(pan_idx, time_diff(stats->request_time, mac_GetCurrentBTUS()));
 #endif
 }
@@ -573,6 +628,7 @@ static inline void mac_stats_rx_full_inc(uint8_t pan_idx)
     if (stats)
     {
         stats->fifofull++;
+        mac_stats_series_event_inc(MAC_STATS_RATE_FIFO_FULL, 1);
     }
 #endif
 }
@@ -0,0 +1,346 @@
+/**
+*****************************************************************************************
+*     Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*****************************************************************************************
+   * @file      mac_stats_series.c
+   * @brief     IEEE802.15.4 MAC statistics distributions over time
+   * @version   v1.0
+   **************************************************************************************
+   * @attention
+   * <h2><center>&copy; COPYRIGHT 2026 Realtek Semiconductor Corporation</center></h2>
+   **************************************************************************************
+  */
+#include <string.h>
+#include "mac_stats_series.h"
+
+#define US_PER_SECOND 1000000UL
+
+static const uint8_t rate_windows[MAC_STATS_RATE_WINDOW_NUM] = MAC_STATS_RATE_WINDOWS;
+
+mac_stats_series_t g_mac_stats_series;
+
+/************************************
+ * Series
+ ************************************/
+void mac_stats_series_init(mac_stats_series_t *series, uint32_t clock_wrap, uint32_t now_us)
+{
+    memset(series, 0, sizeof(*series));
+    series->clock_wrap = clock_wrap;
+    series->last_us = now_us;
+}
+
+void mac_stats_series_reset(mac_stats_series_t *series)
+{
+    mac_stats_series_init(series, series->clock_wrap, series->last_us);
+}
+
+void mac_stats_hist_add(mac_stats_hist_t *hist, uint32_t value)
+{
+    uint8_t idx = 0;
+
+    /* index of the highest set bit plus one */
+    while (value != 0 && idx < MAC_STATS_HIST_BUCKET_NUM - 1)
+    {
+        value >>= 1;
+        idx++;
+    }
+    hist->bucket[idx]++;
+}
+
+void mac_stats_series_advance(mac_stats_series_t *series, uint32_t now_us)
+{
+    mac_stats_rate_t *rate = &series->rate;
+    uint32_t elapsed;
+    uint8_t event;
+
+    if (series->clock_wrap != 0 && now_us < series->last_us)
+    {
+        elapsed = (series->clock_wrap - series->last_us) + now_us;
+    }
+    else
+    {
+        elapsed = now_us - series->last_us;
+    }
+    series->last_us = now_us;
+
+    if (elapsed >= MAC_STATS_RATE_SLOT_NUM * US_PER_SECOND)
+    {
+        memset(rate->slot, 0, sizeof(rate->slot));
+        rate->sub_us = 0;
+        return;
+    }
+
+    rate->sub_us += elapsed;
+    while (rate->sub_us >= US_PER_SECOND)
+    {
+        rate->sub_us -= US_PER_SECOND;
+        rate->head = (rate->head + 1) % MAC_STATS_RATE_SLOT_NUM;
+        for (event = 0; event < MAC_STATS_RATE_NUM; event++)
+        {
+            rate->slot[event][rate->head] = 0;
+        }
+    }
+}
+
+void mac_stats_series_event(mac_stats_series_t *series, mac_stats_rate_event_t event, uint16_t count,
+                            uint32_t now_us)
+{
+    uint16_t *slot;
+
+    if (event >= MAC_STATS_RATE_NUM || count == 0)
+    {
+        return;
+    }
+    mac_stats_series_advance(series, now_us);
+
+    slot = &series->rate.slot[event][series->rate.head];
+    *slot = (*slot > UINT16_MAX - count) ? UINT16_MAX : *slot + count;
+}
+
+/* events in the last window_s seconds, the current second included */
+uint32_t mac_stats_series_rate_get(const mac_stats_series_t *series, mac_stats_rate_event_t event,
+                                   uint8_t window_s)
+{
+    const mac_stats_rate_t *rate = &series->rate;
+    uint32_t sum = 0;
+    uint8_t idx = rate->head;
+    uint8_t i;
+
+    if (event >= MAC_STATS_RATE_NUM)
+    {
+        return 0;
+    }
+    if (window_s > MAC_STATS_RATE_SLOT_NUM)
+    {
+        window_s = MAC_STATS_RATE_SLOT_NUM;
+    }
+    for (i = 0; i < window_s; i++)
+    {
+        sum += rate->slot[event][idx];
+        idx = (idx == 0) ? MAC_STATS_RATE_SLOT_NUM - 1 : idx - 1;
+    }
+    return sum;
+}
+
+void mac_stats_series_signal(mac_stats_series_t *series, uint8_t channel, int8_t rssi, uint8_t lqi)
+{
+    int16_t rssi_idx;
+
+    if (channel < MAC_STATS_CHANNEL_MIN || channel >= MAC_STATS_CHANNEL_MIN + MAC_STATS_CHANNEL_NUM)
+    {
+        return;
+    }
+    channel -= MAC_STATS_CHANNEL_MIN;
+
+    rssi_idx = (rssi < MAC_STATS_RSSI_MIN) ? 0 : (rssi - MAC_STATS_RSSI_MIN) / 10 + 1;
+    if (rssi_idx >= MAC_STATS_RSSI_BUCKET_NUM)
+    {
+        rssi_idx = MAC_STATS_RSSI_BUCKET_NUM - 1;
+    }
+    series->rssi[channel][rssi_idx]++;
+    series->lqi[channel][lqi / (256 / MAC_STATS_LQI_BUCKET_NUM)]++;
+}
+
+/* value idx of a snapshot, in the order of MAC_STATS_SNAPSHOT_NUM */
+static uint32_t mac_stats_series_value(const mac_stats_series_t *series, uint16_t idx)
+{
+    if (idx < MAC_STATS_HIST_BUCKET_NUM)
+    {
+        return series->tx_resp.bucket[idx];
+    }
+    idx -= MAC_STATS_HIST_BUCKET_NUM;
+    if (idx < MAC_STATS_HIST_BUCKET_NUM)
+    {
+        return series->backoff.bucket[idx];
+    }
+    idx -= MAC_STATS_HIST_BUCKET_NUM;
+    if (idx < MAC_STATS_RATE_NUM * MAC_STATS_RATE_WINDOW_NUM)
+    {
+        return mac_stats_series_rate_get(series, (mac_stats_rate_event_t)(idx / MAC_STATS_RATE_WINDOW_NUM),
+                                         rate_windows[idx % MAC_STATS_RATE_WINDOW_NUM]);
+    }
+    idx -= MAC_STATS_RATE_NUM * MAC_STATS_RATE_WINDOW_NUM;
+    if (idx < MAC_STATS_CHANNEL_NUM * MAC_STATS_RSSI_BUCKET_NUM)
+    {
+        return series->rssi[idx / MAC_STATS_RSSI_BUCKET_NUM][idx % MAC_STATS_RSSI_BUCKET_NUM];
+    }
+    idx -= MAC_STATS_CHANNEL_NUM * MAC_STATS_RSSI_BUCKET_NUM;
+    return series->lqi[idx / MAC_STATS_LQI_BUCKET_NUM][idx % MAC_STATS_LQI_BUCKET_NUM];
+}
+
+void mac_stats_series_snapshot(const mac_stats_series_t *series, uint32_t *values)
+{
+    uint16_t i;
+
+    for (i = 0; i < MAC_STATS_SNAPSHOT_NUM; i++)
+    {
+        values[i] = mac_stats_series_value(series, i);
+    }
+}
+
+/************************************
+ * Snapshot Stream
+ ************************************/
+static uint16_t put_varint(uint8_t *buf, uint16_t pos, uint16_t size, uint32_t value)
+{
+    do
+    {
+        if (pos >= size)
+        {
+            return 0;
+        }
+        buf[pos++] = (value & 0x7F) | ((value > 0x7F) ? 0x80 : 0);
+        value >>= 7;
+    }
+    while (value != 0);
+    return pos;
+}
+
+static uint16_t get_varint(const uint8_t *buf, uint16_t pos, uint16_t len, uint32_t *value)
+{
+    uint8_t shift = 0;
+
+    *value = 0;
+    do
+    {
+        if (pos >= len || shift > 28)
+        {
+            return 0;
+        }
+        *value |= (uint32_t)(buf[pos] & 0x7F) << shift;
+        shift += 7;
+    }
+    while (buf[pos++] & 0x80);
+    return pos;
+}
+
+void mac_stats_stream_init(mac_stats_stream_t *stream)
+{
+    memset(stream, 0, sizeof(*stream));
+}
+
+/* returns the frame length, 0 if buf is too small, then the next frame is a key frame.
+ * Each value is read once and kept as encoded, so updates from interrupts meanwhile
+ * show up in the next frame.
+ */
+uint16_t mac_stats_stream_encode(mac_stats_stream_t *stream, const mac_stats_series_t *series,
+                                 bool key, uint8_t *buf, uint16_t size)
+{
+    uint16_t bitmap_len = (MAC_STATS_SNAPSHOT_NUM + 7) / 8;
+    uint16_t pos = MAC_STATS_SNAPSHOT_HDR_LEN;
+    uint8_t *bitmap = NULL;
+    uint32_t value;
+    int32_t diff;
+    uint16_t i;
+
+    if (!stream->valid)
+    {
+        key = true;
+    }
+    if (size < MAC_STATS_SNAPSHOT_HDR_LEN + (key ? 0 : bitmap_len))
+    {
+        return 0;
+    }
+
+    buf[0] = MAC_STATS_SNAPSHOT_MAGIC0;
+    buf[1] = MAC_STATS_SNAPSHOT_MAGIC1;
+    buf[2] = MAC_STATS_SNAPSHOT_VERSION;
+    buf[3] = key ? MAC_STATS_SNAPSHOT_KEY : MAC_STATS_SNAPSHOT_DELTA;
+    buf[4] = stream->seq & 0xFF;
+    buf[5] = stream->seq >> 8;
+    if (!key)
+    {
+        bitmap = &buf[pos];
+        memset(bitmap, 0, bitmap_len);
+        pos += bitmap_len;
+    }
+
+    for (i = 0; i < MAC_STATS_SNAPSHOT_NUM && pos != 0; i++)
+    {
+        value = mac_stats_series_value(series, i);
+        if (key)
+        {
+            pos = put_varint(buf, pos, size, value);
+        }
+        else
+        {
+            diff = (int32_t)(value - stream->prev[i]);
+            if (diff != 0)
+            {
+                bitmap[i >> 3] |= 1 << (i & 7);
+                pos = put_varint(buf, pos, size, ((uint32_t)diff << 1) ^ (uint32_t)(diff >> 31));
+            }
+        }
+        stream->prev[i] = value;
+    }
+    if (pos == 0)
+    {
+        stream->valid = false;
+        return 0;
+    }
+
+    stream->seq++;
+    stream->valid = true;
+    return pos;
+}
+
+/* returns 0 on success, -1 if the frame is malformed or a delta frame does not follow the last one */
+int mac_stats_stream_decode(mac_stats_stream_t *stream, const uint8_t *buf, uint16_t len,
+                            uint32_t *values)
+{
+    uint16_t bitmap_len = (MAC_STATS_SNAPSHOT_NUM + 7) / 8;
+    uint16_t pos = MAC_STATS_SNAPSHOT_HDR_LEN;
+    uint16_t seq;
+    uint32_t value;
+    uint16_t i;
+
+    if (len < MAC_STATS_SNAPSHOT_HDR_LEN || buf[0] != MAC_STATS_SNAPSHOT_MAGIC0 ||
+        buf[1] != MAC_STATS_SNAPSHOT_MAGIC1 || buf[2] != MAC_STATS_SNAPSHOT_VERSION)
+    {
+        return -1;
+    }
+    seq = buf[4] | (buf[5] << 8);
+
+    if (buf[3] == MAC_STATS_SNAPSHOT_KEY)
+    {
+        for (i = 0; i < MAC_STATS_SNAPSHOT_NUM; i++)
+        {
+            pos = get_varint(buf, pos, len, &values[i]);
+            if (pos == 0)
+            {
+                return -1;
+            }
+        }
+    }
+    else if (buf[3] == MAC_STATS_SNAPSHOT_DELTA)
+    {
+        const uint8_t *bitmap = &buf[pos];
+        if (!stream->valid || seq != stream->seq || len < pos + bitmap_len)
+        {
+            return -1;
+        }
+        pos += bitmap_len;
+        for (i = 0; i < MAC_STATS_SNAPSHOT_NUM; i++)
+        {
+            values[i] = stream->prev[i];
+            if (bitmap[i >> 3] & (1 << (i & 7)))
+            {
+                pos = get_varint(buf, pos, len, &value);
+                if (pos == 0)
+                {
+                    return -1;
+                }
+                values[i] += (value >> 1) ^ (0 - (value & 1));
+            }
+        }
+    }
+    else
+    {
+        return -1;
+    }
+
+    memcpy(stream->prev, values, sizeof(stream->prev));
+    stream->seq = seq + 1;
+    stream->valid = true;
+    return 0;
+}
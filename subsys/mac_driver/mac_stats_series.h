@@ -0,0 +1,138 @@
+/**
+*****************************************************************************************
+*     Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*****************************************************************************************
+   * @file      mac_stats_series.h
+   * @brief     IEEE802.15.4 MAC statistics distributions over time
+   * @details   Log2 latency histograms, windowed event rates and per-channel RSSI/LQI
+   *            histograms, with a compact snapshot stream for export over UART/BLE.
+   *            Plain C without driver dependencies, so it also builds on a host.
+   * @version   v1.0
+   **************************************************************************************
+   * @attention
+   * <h2><center>&copy; COPYRIGHT 2026 Realtek Semiconductor Corporation</center></h2>
+   **************************************************************************************
+  */
+#ifndef _MAC_STATS_SERIES_H_
+#define _MAC_STATS_SERIES_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Log2 buckets: [0] = 0, [i] = [2^(i-1), 2^i), the last one takes everything above */
+#ifndef MAC_STATS_HIST_BUCKET_NUM
+#define MAC_STATS_HIST_BUCKET_NUM 16
+#endif
+
+/* Channels 11..26 of the 2.4 GHz band */
+#define MAC_STATS_CHANNEL_MIN 11
+#define MAC_STATS_CHANNEL_NUM 16
+
+/* RSSI buckets of 10 dB from MAC_STATS_RSSI_MIN, the first and last ones are open */
+#define MAC_STATS_RSSI_MIN -100
+#define MAC_STATS_RSSI_BUCKET_NUM 8
+
+/* LQI buckets of 32 */
+#define MAC_STATS_LQI_BUCKET_NUM 8
+
+/* Rates are kept per second for the longest window */
+#define MAC_STATS_RATE_SLOT_NUM 60
+
+/* Windows of the rates in seconds */
+#define MAC_STATS_RATE_WINDOW_NUM 3
+#define MAC_STATS_RATE_WINDOWS {1, 10, 60}
+
+/* Rate events */
+typedef enum
+{
+    MAC_STATS_RATE_CCA_FAIL = 0,
+    MAC_STATS_RATE_NO_ACK = 1,
+    MAC_STATS_RATE_FIFO_FULL = 2,
+    MAC_STATS_RATE_NUM
+} mac_stats_rate_event_t;
+
+typedef struct
+{
+    uint32_t bucket[MAC_STATS_HIST_BUCKET_NUM];
+} mac_stats_hist_t;
+
+typedef struct
+{
+    uint16_t slot[MAC_STATS_RATE_NUM][MAC_STATS_RATE_SLOT_NUM]; /* Events in each second */
+    uint8_t head;        /* Slot of the current second */
+    uint32_t sub_us;     /* Time passed in the current second */
+} mac_stats_rate_t;
+
+typedef struct
+{
+    mac_stats_hist_t tx_resp;   /* TX response time in us */
+    mac_stats_hist_t backoff;   /* CSMA backoff in us */
+    mac_stats_rate_t rate;
+    uint32_t rssi[MAC_STATS_CHANNEL_NUM][MAC_STATS_RSSI_BUCKET_NUM];
+    uint32_t lqi[MAC_STATS_CHANNEL_NUM][MAC_STATS_LQI_BUCKET_NUM];
+    uint32_t last_us;    /* Time of the last update */
+    uint32_t clock_wrap; /* Wrap value of the clock, 0 if it wraps at 2^32 */
+} mac_stats_series_t;
+
+/************************************
+ * Snapshot Stream
+ ************************************/
+/* Values of a snapshot, in this order:
+ * tx_resp buckets, backoff buckets, rates of each event in each window,
+ * RSSI buckets of each channel, LQI buckets of each channel.
+ */
+#define MAC_STATS_SNAPSHOT_NUM (2 * MAC_STATS_HIST_BUCKET_NUM + \
+                                MAC_STATS_RATE_NUM * MAC_STATS_RATE_WINDOW_NUM + \
+                                MAC_STATS_CHANNEL_NUM * (MAC_STATS_RSSI_BUCKET_NUM + MAC_STATS_LQI_BUCKET_NUM))
+
+/* Frame: magic (2 bytes), version, type, sequence (2 bytes, LE), then
+ * key frame:   every value as a varint;
+ * delta frame: bitmap of the changed values, then their zigzag varint differences.
+ */
+#define MAC_STATS_SNAPSHOT_MAGIC0 'M'
+#define MAC_STATS_SNAPSHOT_MAGIC1 'S'
+#define MAC_STATS_SNAPSHOT_VERSION 1
+#define MAC_STATS_SNAPSHOT_KEY 0
+#define MAC_STATS_SNAPSHOT_DELTA 1
+#define MAC_STATS_SNAPSHOT_HDR_LEN 6
+
+/* Worst case frame length */
+#define MAC_STATS_SNAPSHOT_MAX_LEN (MAC_STATS_SNAPSHOT_HDR_LEN + (MAC_STATS_SNAPSHOT_NUM + 7) / 8 + \
+                                    MAC_STATS_SNAPSHOT_NUM * 5)
+
+/* State of one end of the stream, the encoder and the decoder keep one each */
+typedef struct
+{
+    uint32_t prev[MAC_STATS_SNAPSHOT_NUM];
+    uint16_t seq;
+    bool valid;
+} mac_stats_stream_t;
+
+/************************************
+ * External Global Variables
+ ************************************/
+extern mac_stats_series_t g_mac_stats_series;
+
+/************************************
+ * API Function Prototypes
+ ************************************/
+void mac_stats_series_init(mac_stats_series_t *series, uint32_t clock_wrap, uint32_t now_us);
+void mac_stats_series_reset(mac_stats_series_t *series);
+
+void mac_stats_hist_add(mac_stats_hist_t *hist, uint32_t value);
+void mac_stats_series_advance(mac_stats_series_t *series, uint32_t now_us);
+void mac_stats_series_event(mac_stats_series_t *series, mac_stats_rate_event_t event, uint16_t count,
+                            uint32_t now_us);
+uint32_t mac_stats_series_rate_get(const mac_stats_series_t *series, mac_stats_rate_event_t event,
+                                   uint8_t window_s);
+void mac_stats_series_signal(mac_stats_series_t *series, uint8_t channel, int8_t rssi, uint8_t lqi);
+
+void mac_stats_series_snapshot(const mac_stats_series_t *series, uint32_t *values);
+
+void mac_stats_stream_init(mac_stats_stream_t *stream);
+uint16_t mac_stats_stream_encode(mac_stats_stream_t *stream, const mac_stats_series_t *series,
+                                 bool key, uint8_t *buf, uint16_t size);
+int mac_stats_stream_decode(mac_stats_stream_t *stream, const uint8_t *buf, uint16_t len,
+                            uint32_t *values);
+
+#endif /* _MAC_STATS_SERIES_H_ */
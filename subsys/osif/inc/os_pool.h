@@ -47,6 +47,22 @@ extern "C" {
  */
 #define OS_POOL_INVALID_HANDLE  0xFF
 
+/**
+ *
+ * \brief The usage statistics of one pool slot, i.e. the buffers of one size.
+ *
+ */
+typedef struct
+{
+    uint16_t buf_size;          /**< The buffer size of the slot in bytes. */
+    uint16_t buf_count;         /**< The number of buffers in the slot. */
+    uint16_t used_count;        /**< The number of buffers currently allocated. */
+    uint16_t peak_used;         /**< The high-water mark of allocated buffers. */
+    uint32_t fail_count;        /**< The number of failed requests that best fit this slot. */
+    uint32_t fallback_count;    /**< The number of requests that best fit this slot but were
+                                     served by a larger slot. */
+} T_OS_POOL_SLOT_STATS;
+
 /** End of group OS_POOL_Exported_Types
   * @}
   */
@@ -354,6 +370,63 @@ extern bool (*os_buffer_put_intern)(void *p_buf, const char *p_func, uint32_t fi
  */
 extern void (*os_pool_dump)(uint8_t handle);
 
+/**
+ *
+ * \brief   Get the number of slots in the specified memory pool. Each os_pool_create()
+ *          or os_pool_extend() call adds one slot.
+ *
+ * \param[in]   handle  The handle of the created memory pool.
+ *
+ * \return      The number of slots. 0 is returned if the pool is not created.
+ *
+ */
+uint8_t os_pool_slot_num_get(uint8_t handle);
+
+/**
+ *
+ * \brief   Get the usage statistics of one slot in the specified memory pool.
+ *
+ * \param[in]   handle    The handle of the created memory pool.
+ *
+ * \param[in]   slot_idx  The slot index in ascending buffer size order, less than
+ *                        os_pool_slot_num_get().
+ *
+ * \param[out]  p_stats   Used to pass back the slot statistics, refer to @ref T_OS_POOL_SLOT_STATS.
+ *
+ * \return           The status of getting the statistics.
+ * \retval true      Statistics were got successfully.
+ * \retval false     Getting statistics failed. It happens when parameters are not valid or pool is not created.
+ *
+ * <b>Example usage</b>
+ * \code{.c}
+ * void test(uint8_t handle)
+ * {
+ *     T_OS_POOL_SLOT_STATS stats;
+ *     uint8_t i;
+ *
+ *     for (i = 0; i < os_pool_slot_num_get(handle); i++)
+ *     {
+ *         if (os_pool_slot_stats_get(handle, i, &stats) == true)
+ *         {
+ *             // Inspect stats.peak_used, stats.fail_count and stats.fallback_count.
+ *         }
+ *     }
+ * }
+ * \endcode
+ *
+ */
+bool os_pool_slot_stats_get(uint8_t handle, uint8_t slot_idx, T_OS_POOL_SLOT_STATS *p_stats);
+
+/**
+ *
+ * \brief   Reset the failure and fallback counters of the specified memory pool. The
+ *          high-water mark of each slot restarts from the current usage.
+ *
+ * \param[in]   handle  The handle of the created memory pool.
+ *
+ */
+void os_pool_stats_reset(uint8_t handle);
+
 /** End of group OS_POOL_Exported_Functions
   * @}
   */
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026, Realtek Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _OS_RING_H_
+#define _OS_RING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup OS_RING    Message Ring
+ *
+ * \brief   Lock-free single-producer/single-consumer message ring.
+ * \details Message Ring passes fixed-size messages from exactly one producer to exactly one
+ *          consumer, typically from an ISR to a task. Unlike the Message Queue, no critical
+ *          section is taken and messages can be built and consumed in place: the producer
+ *          reserves a slot, fills it and commits it, while the consumer peeks the oldest
+ *          message and releases it after use. The consumer can also drain several messages
+ *          per wakeup with the batch interfaces.
+ *
+ *          If a consumer task is bound to the ring, the producer wakes it by task notification
+ *          when a message is committed to an empty ring, so one wakeup covers a whole burst.
+ *
+ *          Reserve/commit must only be called by the producer and peek/release only by the
+ *          consumer. Several producers or consumers need external locking.
+ *
+ */
+
+/*============================================================================*
+ *                              Functions
+*============================================================================*/
+/** @defgroup OS_RING_Exported_Functions OS Ring Exported Functions
+  * \ingroup  OS_RING
+  * @{
+  */
+
+/**
+ *
+ * \brief   Create a message ring.
+ *
+ * \param[out]  pp_handle     Used to pass back a handle by which the message ring can be referenced.
+ *
+ * \param[in]   msg_num       The maximum number of messages in the ring. It is rounded up to a power of 2.
+ *
+ * \param[in]   msg_size      The size of each message in bytes.
+ *
+ * \param[in]   p_task        The handle of the consumer task woken by task notification, or NULL
+ *                            if the consumer polls the ring.
+ *
+ * \return           The status of the message ring creation.
+ * \retval true      Message ring was created successfully.
+ * \retval false     Message ring creation failed. It happens when parameters are not valid or there is not enough heap to malloc.
+ *
+ * <b>Example usage</b>
+ * \code{.c}
+ * struct rx_msg
+ * {
+ *     uint16_t len;
+ *     uint8_t  data[64];
+ * };
+ *
+ * void *p_ring;
+ *
+ * void rx_task(void *p_param)
+ * {
+ *     void *p_task;
+ *     struct rx_msg *p_msg;
+ *
+ *     os_task_handle_get(&p_task);
+ *     os_ring_create(&p_ring, 16, sizeof(struct rx_msg), p_task);
+ *
+ *     while (true)
+ *     {
+ *         os_ring_wait(p_ring, 0xFFFFFFFF);
+ *         while ((p_msg = os_ring_peek(p_ring)) != NULL)
+ *         {
+ *             // Handle p_msg in place.
+ *             os_ring_release(p_ring);
+ *         }
+ *     }
+ * }
+ *
+ * void RX_Handler(void)
+ * {
+ *     struct rx_msg *p_msg = os_ring_reserve(p_ring);
+ *
+ *     if (p_msg != NULL)
+ *     {
+ *         // Fill p_msg in place.
+ *         os_ring_commit(p_ring);
+ *     }
+ * }
+ * \endcode
+ *
+ */
+bool os_ring_create(void **pp_handle, uint32_t msg_num, uint32_t msg_size, void *p_task);
+
+/**
+ *
+ * \brief   Delete a message ring. Messages left in the ring are discarded.
+ *
+ * \param[in]   p_handle  The handle of the message ring.
+ *
+ * \return           The status of the message ring deletion.
+ * \retval true      Message ring was deleted successfully.
+ * \retval false     Message ring deletion failed. It happens when the handle is NULL.
+ *
+ */
+bool os_ring_delete(void *p_handle);
+
+/**
+ *
+ * \brief   Reserve the next free message slot. Producer only.
+ *
+ * \param[in]   p_handle  The handle of the message ring.
+ *
+ * \return      The address of the reserved slot to be filled in place, or NULL if the ring is full.
+ *              Reserving again before os_ring_commit() returns the same slot.
+ *
+ */
+void *os_ring_reserve(void *p_handle);
+
+/**
+ *
+ * \brief   Publish the slot reserved by os_ring_reserve() to the consumer. Producer only.
+ *          The bound consumer task is notified if the ring was empty.
+ *
+ * \param[in]   p_handle  The handle of the message ring.
+ *
+ * \return           The status of the commit.
+ * \retval true      Message was committed successfully.
+ * \retval false     Commit failed. It happens when the handle is NULL or the ring is full.
+ *
+ */
+bool os_ring_commit(void *p_handle);
+
+/**
+ *
+ * \brief   Copy one message into the ring. Producer only.
+ *
+ * \param[in]   p_handle  The handle of the message ring.
+ *
+ * \param[in]   p_msg     The message to be copied, of the size given to os_ring_create().
+ *
+ * \return           The status of sending.
+ * \retval true      Message was sent successfully.
+ * \retval false     Sending failed. It happens when parameters are not valid or the ring is full.
+ *
+ */
+bool os_ring_send(void *p_handle, const void *p_msg);
+
+/**
+ *
+ * \brief   Get the oldest message in place without removing it. Consumer only.
+ *
+ * \param[in]   p_handle  The handle of the message ring.
+ *
+ * \return      The address of the oldest message, or NULL if the ring is empty.
+ *
+ */
+void *os_ring_peek(void *p_handle);
+
+/**
+ *
+ * \brief   Return the oldest message slot to the producer. Consumer only.
+ *
+ * \param[in]   p_handle  The handle of the message ring.
+ *
+ * \return           The status of the release.
+ * \retval true      Message was released successfully.
+ * \retval false     Release failed. It happens when the handle is NULL or the ring is empty.
+ *
+ */
+bool os_ring_release(void *p_handle);
+
+/**
+ *
+ * \brief   Get the oldest messages in place as one contiguous array. Consumer only.
+ *          Messages that wrap around the end of the ring are returned by the next call
+ *          after os_ring_release_batch().
+ *
+ * \param[in]   p_handle  The handle of the message ring.
+ *
+ * \param[out]  pp_msg    Used to pass back the address of the oldest message.
+ *
+ * \return      The number of contiguous messages at *pp_msg, 0 if the ring is empty.
+ *
+ */
+uint32_t os_ring_peek_batch(void *p_handle, void **pp_msg);
+
+/**
+ *
+ * \brief   Return the oldest msg_num message slots to the producer. Consumer only.
+ *
+ * \param[in]   p_handle  The handle of the message ring.
+ *
+ * \param[in]   msg_num   The number of messages to release, not more than the ring holds.
+ *
+ * \return           The status of the release.
+ * \retval true      Messages were released successfully.
+ * \retval false     Release failed. It happens when parameters are not valid.
+ *
+ */
+bool os_ring_release_batch(void *p_handle, uint32_t msg_num);
+
+/**
+ *
+ * \brief   Copy up to max_num of the oldest messages out of the ring. Consumer only.
+ *
+ * \param[in]   p_handle  The handle of the message ring.
+ *
+ * \param[out]  p_msgs    The buffer to hold max_num messages.
+ *
+ * \param[in]   max_num   The maximum number of messages to receive.
+ *
+ * \param[in]   wait_ms   The time to wait for the first message if the ring is empty.
+ *                        Only valid when a consumer task is bound to the ring.
+ *                        \arg \c 0           No blocking and return immediately.
+ *                        \arg \c 0xFFFFFFFF  Block infinitely until a message is committed.
+ *                        \arg \c others      The timeout value in milliseconds.
+ *
+ * \return      The number of messages received.
+ *
+ */
+uint32_t os_ring_recv_batch(void *p_handle, void *p_msgs, uint32_t max_num, uint32_t wait_ms);
+
+/**
+ *
+ * \brief   Wait until the ring is not empty. Consumer task only.
+ *
+ * \param[in]   p_handle  The handle of the message ring.
+ *
+ * \param[in]   wait_ms   The timeout value in milliseconds, 0xFFFFFFFF to block infinitely.
+ *
+ * \return           The ring state.
+ * \retval true      The ring has messages.
+ * \retval false     The ring is still empty after the timeout, or no consumer task is bound.
+ *
+ */
+bool os_ring_wait(void *p_handle, uint32_t wait_ms);
+
+/**
+ *
+ * \brief   Get the number of messages in the ring.
+ *
+ * \param[in]   p_handle  The handle of the message ring.
+ *
+ * \return      The number of committed and unreleased messages.
+ *
+ */
+uint32_t os_ring_count(void *p_handle);
+
+/** End of group OS_RING_Exported_Functions
+  * @}
+  */
+
+/** End of OS_RING
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _OS_RING_H_ */
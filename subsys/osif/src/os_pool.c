@@ -18,11 +18,15 @@ typedef struct t_os_slot
 {
     struct t_os_slot *p_next;
     uint8_t           pool_id;
+    uint8_t           slot_idx;
     uint16_t          buf_size;
     uint16_t          buf_count;
     void             *header_addr;
     void             *payload_addr;
     T_OS_QUEUE        buf_q;
+    uint16_t          peak_used;
+    uint32_t          fail_count;
+    uint32_t          fallback_count;
 } T_OS_SLOT;
 
 /* OS Pool Buffer Bit Mask */
@@ -53,14 +57,33 @@ typedef struct t_os_buffer
 #define OS_POOL_MEM_ALIGN_SET(flag, align)  ( (flag) |= (((uint8_t)(align)) << 24)       )
 #define OS_POOL_MEM_ALIGN_GET(flag, align)  ( (align) = (uint8_t)(((flag) >> 24) & 0xFF) )
 
+/* maximum number of slots, i.e. distinct buffer sizes, in one pool */
+#define OS_POOL_SLOT_MAX        16
+
+/**
+ * Size class of a request is the bit width of (size - 1), so class n covers
+ * sizes (2^(n-1), 2^n]. Class 0 is size 1 and class 16 covers up to 0xFFFF.
+ */
+#define OS_POOL_SIZE_CLASS_NUM  17
+
+#define OS_POOL_SIZE_CLASS(size)    ((size) <= 1 ? 0 : (uint8_t)(32 - __builtin_clz((uint32_t)(size) - 1)))
+
 typedef struct t_os_pool
 {
     uint32_t    flags;
-    T_OS_QUEUE  slot_q;
+    uint8_t     slot_num;
+    /* index of the first slot whose size class is not less than the class */
+    uint8_t     class_tbl[OS_POOL_SIZE_CLASS_NUM];
+    /* bit n is set when slot n has free buffers */
+    uint32_t    avail_bitmap;
+    /* slots sorted in ascending buffer size order */
+    T_OS_SLOT  *slot_tbl[OS_POOL_SLOT_MAX];
 } T_OS_POOL;
 
 /* maximum number of pools created by os_pool_create */
+#ifndef OS_POOL_TABLE_SIZE
 #define OS_POOL_TABLE_SIZE      4
+#endif
 
 #define POOL_BUFFER_ADDR_MASK   (sizeof(void *) - 1)
 
@@ -69,16 +92,42 @@ typedef struct t_os_pool
 
 T_OS_POOL os_pool_table[OS_POOL_TABLE_SIZE];
 
+static void os_pool_index_build(T_OS_POOL *p_pool)
+{
+    uint8_t slot_idx = 0;
+    uint8_t size_class;
+
+    p_pool->avail_bitmap = 0;
+
+    for (size_class = 0; size_class < OS_POOL_SIZE_CLASS_NUM; size_class++)
+    {
+        while (slot_idx < p_pool->slot_num &&
+               OS_POOL_SIZE_CLASS(p_pool->slot_tbl[slot_idx]->buf_size) < size_class)
+        {
+            slot_idx++;
+        }
+        p_pool->class_tbl[size_class] = slot_idx;
+    }
+
+    for (slot_idx = 0; slot_idx < p_pool->slot_num; slot_idx++)
+    {
+        p_pool->slot_tbl[slot_idx]->slot_idx = slot_idx;
+        if (p_pool->slot_tbl[slot_idx]->buf_q.count > 0)
+        {
+            p_pool->avail_bitmap |= (1UL << slot_idx);
+        }
+    }
+}
+
 bool os_slot_create(uint8_t pool_id, RAM_TYPE ram_type, uint16_t buf_size, uint16_t buf_count)
 {
     T_OS_POOL   *p_pool;
     T_OS_SLOT   *p_slot;
-    T_OS_SLOT   *p_prev_slot;
-    T_OS_SLOT   *p_curr_slot;
     T_OS_BUFFER *p_buf;
     void        *p_hdr, *p_data;
     size_t       data_len;
     uint16_t     i;
+    uint32_t     s;
 
     p_slot = (T_OS_SLOT *)os_mem_zalloc(RAM_TYPE_DATA_ON, sizeof(T_OS_SLOT));
     if (p_slot == NULL)
@@ -115,28 +164,41 @@ bool os_slot_create(uint8_t pool_id, RAM_TYPE ram_type, uint16_t buf_size, uint1
         os_queue_in(&p_slot->buf_q, p_buf);
     }
 
-    p_pool      = &os_pool_table[pool_id];
-    p_prev_slot = NULL;
-    p_curr_slot = (T_OS_SLOT *)p_pool->slot_q.p_first;
+    p_slot->buf_size  = buf_size;
+    p_slot->buf_count = buf_count;
+    p_slot->pool_id   = pool_id;
+
+    p_slot->header_addr  = p_hdr;
+    p_slot->payload_addr = p_data;
+
+    p_pool = &os_pool_table[pool_id];
+
+    s = os_lock();
+
+    if (p_pool->slot_num >= OS_POOL_SLOT_MAX)
+    {
+        os_unlock(s);
+        os_mem_free(p_data);
+        os_mem_free(p_hdr);
+        os_mem_free(p_slot);
+        return false;
+    }
+
     /* sort slots in ascending buffer size order */
-    while (p_curr_slot != NULL)
+    for (i = p_pool->slot_num; i > 0; i--)
     {
-        if (p_curr_slot->buf_size >= buf_size)
+        if (p_pool->slot_tbl[i - 1]->buf_size < buf_size)
         {
             break;
         }
-        p_prev_slot = p_curr_slot;
-        p_curr_slot = (T_OS_SLOT *)p_curr_slot->p_next;
+        p_pool->slot_tbl[i] = p_pool->slot_tbl[i - 1];
     }
+    p_pool->slot_tbl[i] = p_slot;
+    p_pool->slot_num++;
 
-    p_slot->buf_size  = buf_size;
-    p_slot->buf_count = buf_count;
-    p_slot->pool_id   = pool_id;
+    os_pool_index_build(p_pool);
 
-    p_slot->header_addr  = p_hdr;
-    p_slot->payload_addr = p_data;
-
-    os_queue_insert(&p_pool->slot_q, p_prev_slot, p_slot);
+    os_unlock(s);
 
     return true;
 }
@@ -159,7 +221,7 @@ bool os_pool_create_intern_imp(uint8_t *p_handle, RAM_TYPE ram_type, uint16_t bu
         if (!(os_pool_table[id].flags & OS_POOL_CREATED))
         {
             p_pool = &os_pool_table[id];
-            p_pool->flags = 0;
+            memset(p_pool, 0, sizeof(T_OS_POOL));
             break;
         }
     }
@@ -231,6 +293,7 @@ bool os_pool_delete_intern_imp(uint8_t handle, const char *p_func, uint32_t file
 {
     T_OS_POOL  *p_pool;
     T_OS_SLOT  *p_slot;
+    uint8_t     i;
     uint32_t    s;
 
     if (handle >= OS_POOL_TABLE_SIZE)
@@ -250,9 +313,9 @@ bool os_pool_delete_intern_imp(uint8_t handle, const char *p_func, uint32_t file
 
     s = os_lock();
 
-    p_slot = (T_OS_SLOT *)p_pool->slot_q.p_first;
-    while (p_slot != NULL)
+    for (i = 0; i < p_pool->slot_num; i++)
     {
+        p_slot = p_pool->slot_tbl[i];
         if (p_slot->buf_count != p_slot->buf_q.count)
         {
             OSIF_PRINT_ERROR3("os_pool_delete_intern: %s<%u> pool %u is busy",
@@ -260,16 +323,18 @@ bool os_pool_delete_intern_imp(uint8_t handle, const char *p_func, uint32_t file
             os_unlock(s);
             return false;
         }
-
-        p_slot = (T_OS_SLOT *)p_slot->p_next;
     }
 
-    while ((p_slot = os_queue_out(&p_pool->slot_q)) != NULL)
+    for (i = 0; i < p_pool->slot_num; i++)
     {
+        p_slot = p_pool->slot_tbl[i];
         os_mem_free(p_slot->header_addr);
         os_mem_free(p_slot->payload_addr);
         os_mem_free(p_slot);
+        p_pool->slot_tbl[i] = NULL;
     }
+    p_pool->slot_num     = 0;
+    p_pool->avail_bitmap = 0;
 
     os_unlock(s);
 
@@ -285,6 +350,9 @@ void *os_buffer_get_intern_imp(uint8_t handle, uint16_t buf_size,
     T_OS_BUFFER *p_buf_hdr;
     T_OS_SLOT   *p_slot;
     T_OS_POOL   *p_pool;
+    uint32_t     avail;
+    uint16_t     used;
+    uint8_t      fit_idx;
     uint32_t     s;
 
     if (buf_size == 0)
@@ -309,30 +377,51 @@ void *os_buffer_get_intern_imp(uint8_t handle, uint16_t buf_size,
         return NULL;
     }
 
-    p_slot = (T_OS_SLOT *)p_pool->slot_q.p_first;
     s = os_lock();
-    while (p_slot != NULL)
+
+    /* locate the best-fit slot by size class, then pick the first non-empty slot from it */
+    fit_idx = p_pool->class_tbl[OS_POOL_SIZE_CLASS(buf_size)];
+    while (fit_idx < p_pool->slot_num && p_pool->slot_tbl[fit_idx]->buf_size < buf_size)
     {
-        if (p_slot->buf_size >= buf_size)
-        {
-            if (p_slot->buf_q.count > 0)
-            {
-                break; /* find the buffer */
-            }
-        }
+        /* only slots in the same size class as the request can be skipped here */
+        fit_idx++;
+    }
 
-        p_slot = (T_OS_SLOT *)p_slot->p_next;
+    if (fit_idx >= p_pool->slot_num)
+    {
+        os_unlock(s);
+        OSIF_PRINT_ERROR3("os_buffer_get_intern: %s<%u> no buf in size %u",
+                          TRACE_STRING(p_func), file_line, buf_size);
+        return NULL;
     }
 
-    if (p_slot == NULL)
+    avail = p_pool->avail_bitmap & ~((1UL << fit_idx) - 1);
+    if (avail == 0)
     {
+        p_pool->slot_tbl[fit_idx]->fail_count++;
         os_unlock(s);
         OSIF_PRINT_ERROR3("os_buffer_get_intern: %s<%u> no buf in size %u",
                           TRACE_STRING(p_func), file_line, buf_size);
         return NULL;
     }
 
+    p_slot = p_pool->slot_tbl[__builtin_ctz(avail)];
+    if (p_slot->slot_idx != fit_idx)
+    {
+        p_pool->slot_tbl[fit_idx]->fallback_count++;
+    }
+
     p_buf_hdr = (T_OS_BUFFER *)os_queue_out(&p_slot->buf_q);
+    if (p_slot->buf_q.count == 0)
+    {
+        p_pool->avail_bitmap &= ~(1UL << p_slot->slot_idx);
+    }
+
+    used = p_slot->buf_count - p_slot->buf_q.count;
+    if (used > p_slot->peak_used)
+    {
+        p_slot->peak_used = used;
+    }
 
     os_unlock(s);
 
@@ -373,6 +462,7 @@ bool os_buffer_put_intern_imp(void *p_buf, const char *p_func, uint32_t file_lin
 
     s = os_lock();
     os_queue_in(&p_slot->buf_q, p_buf_hdr);
+    os_pool_table[p_slot->pool_id].avail_bitmap |= (1UL << p_slot->slot_idx);
     os_unlock(s);
 
     return true;
@@ -382,6 +472,7 @@ void os_pool_dump_imp(uint8_t handle)
 {
     uint8_t    pool_id;
     uint8_t    pool_max;
+    uint8_t    i;
     T_OS_SLOT *p_slot;
 
     if (handle >= OS_POOL_TABLE_SIZE)
@@ -401,21 +492,94 @@ void os_pool_dump_imp(uint8_t handle)
         if (os_pool_table[pool_id].flags & OS_POOL_CREATED)
         {
             OSIF_PRINT_ERROR3("pool id %d, flags 0x%x, slot num %d",
-                              pool_id, os_pool_table[pool_id].flags, os_pool_table[pool_id].slot_q.count);
+                              pool_id, os_pool_table[pool_id].flags, os_pool_table[pool_id].slot_num);
 
-            p_slot = (T_OS_SLOT *)os_pool_table[pool_id].slot_q.p_first;
-            while (p_slot)
+            for (i = 0; i < os_pool_table[pool_id].slot_num; i++)
             {
+                p_slot = os_pool_table[pool_id].slot_tbl[i];
                 OSIF_PRINT_ERROR5("slot(%p), pool id %d, buf size %d, total num %d, free num %d",
                                   p_slot, p_slot->pool_id, p_slot->buf_size,
                                   p_slot->buf_count, p_slot->buf_q.count);
-
-                p_slot = (T_OS_SLOT *)p_slot->p_next;
+                OSIF_PRINT_ERROR3("slot peak used %d, fail count %u, fallback count %u",
+                                  p_slot->peak_used, p_slot->fail_count, p_slot->fallback_count);
             }
         }
     }
 }
 
+bool os_pool_slot_stats_get(uint8_t handle, uint8_t slot_idx, T_OS_POOL_SLOT_STATS *p_stats)
+{
+    T_OS_POOL *p_pool;
+    T_OS_SLOT *p_slot;
+    uint32_t   s;
+
+    if (handle >= OS_POOL_TABLE_SIZE || p_stats == NULL)
+    {
+        return false;
+    }
+
+    p_pool = &os_pool_table[handle];
+    if (!(p_pool->flags & OS_POOL_CREATED))
+    {
+        return false;
+    }
+
+    s = os_lock();
+
+    if (slot_idx >= p_pool->slot_num)
+    {
+        os_unlock(s);
+        return false;
+    }
+
+    p_slot = p_pool->slot_tbl[slot_idx];
+    p_stats->buf_size       = p_slot->buf_size;
+    p_stats->buf_count      = p_slot->buf_count;
+    p_stats->used_count     = p_slot->buf_count - p_slot->buf_q.count;
+    p_stats->peak_used      = p_slot->peak_used;
+    p_stats->fail_count     = p_slot->fail_count;
+    p_stats->fallback_count = p_slot->fallback_count;
+
+    os_unlock(s);
+
+    return true;
+}
+
+uint8_t os_pool_slot_num_get(uint8_t handle)
+{
+    if (handle >= OS_POOL_TABLE_SIZE || !(os_pool_table[handle].flags & OS_POOL_CREATED))
+    {
+        return 0;
+    }
+
+    return os_pool_table[handle].slot_num;
+}
+
+void os_pool_stats_reset(uint8_t handle)
+{
+    T_OS_POOL *p_pool;
+    T_OS_SLOT *p_slot;
+    uint8_t    i;
+    uint32_t   s;
+
+    if (handle >= OS_POOL_TABLE_SIZE)
+    {
+        return;
+    }
+
+    p_pool = &os_pool_table[handle];
+
+    s = os_lock();
+    for (i = 0; i < p_pool->slot_num; i++)
+    {
+        p_slot = p_pool->slot_tbl[i];
+        p_slot->peak_used      = p_slot->buf_count - p_slot->buf_q.count;
+        p_slot->fail_count     = 0;
+        p_slot->fallback_count = 0;
+    }
+    os_unlock(s);
+}
+
 void os_pool_func_init(void) APP_FLASH_TEXT_SECTION;
 void os_pool_func_init(void)
 {
@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2026, Realtek Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: LicenseRef-Realtek-5-Clause
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "os_mem.h"
+#include "os_ring.h"
+#include "os_task.h"
+#include "osif.h"
+#include "trace.h"
+
+/**
+ * head and tail are free-running message counters. Only the producer writes
+ * head and only the consumer writes tail, so (head - tail) is the number of
+ * messages in the ring and no lock is needed.
+ */
+typedef struct t_os_ring
+{
+    volatile uint32_t   head;
+    volatile uint32_t   tail;
+    uint32_t            mask;
+    uint32_t            msg_size;
+    void               *p_task;
+    uint8_t            *p_buf;
+} T_OS_RING;
+
+#define OS_RING_SLOT(p_ring, idx)   ((p_ring)->p_buf + ((idx) & (p_ring)->mask) * (p_ring)->msg_size)
+
+bool os_ring_create(void **pp_handle, uint32_t msg_num, uint32_t msg_size, void *p_task)
+{
+    T_OS_RING *p_ring;
+    uint32_t   num = 1;
+
+    if (pp_handle == NULL || msg_num == 0 || msg_num > 0x80000000UL || msg_size == 0)
+    {
+        OSIF_PRINT_ERROR2("os_ring_create: invalid msg_num %u, msg_size %u", msg_num, msg_size);
+        return false;
+    }
+
+    while (num < msg_num)
+    {
+        num <<= 1;
+    }
+
+    /* keep every slot word aligned */
+    msg_size = (msg_size + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1);
+
+    p_ring = (T_OS_RING *)os_mem_zalloc(RAM_TYPE_DATA_ON, sizeof(T_OS_RING));
+    if (p_ring == NULL)
+    {
+        return false;
+    }
+
+    p_ring->p_buf = (uint8_t *)os_mem_alloc(RAM_TYPE_DATA_ON, num * msg_size);
+    if (p_ring->p_buf == NULL)
+    {
+        os_mem_free(p_ring);
+        return false;
+    }
+
+    p_ring->mask     = num - 1;
+    p_ring->msg_size = msg_size;
+    p_ring->p_task   = p_task;
+
+    *pp_handle = p_ring;
+
+    return true;
+}
+
+bool os_ring_delete(void *p_handle)
+{
+    T_OS_RING *p_ring = (T_OS_RING *)p_handle;
+
+    if (p_ring == NULL)
+    {
+        return false;
+    }
+
+    os_mem_free(p_ring->p_buf);
+    os_mem_free(p_ring);
+
+    return true;
+}
+
+void *os_ring_reserve(void *p_handle)
+{
+    T_OS_RING *p_ring = (T_OS_RING *)p_handle;
+    uint32_t   head;
+
+    if (p_ring == NULL)
+    {
+        return NULL;
+    }
+
+    head = p_ring->head;
+    if (head - p_ring->tail > p_ring->mask)
+    {
+        return NULL;
+    }
+
+    return OS_RING_SLOT(p_ring, head);
+}
+
+bool os_ring_commit(void *p_handle)
+{
+    T_OS_RING *p_ring = (T_OS_RING *)p_handle;
+    uint32_t   head;
+
+    if (p_ring == NULL)
+    {
+        return false;
+    }
+
+    head = p_ring->head;
+    if (head - p_ring->tail > p_ring->mask)
+    {
+        return false;
+    }
+
+    /* the message must be visible before the consumer can see the new head */
+    __DMB();
+    p_ring->head = head + 1;
+    __DMB();
+
+    /* one wakeup per burst: the consumer drains the ring before it waits again */
+    if (p_ring->p_task != NULL && head == p_ring->tail)
+    {
+        os_task_notify_give(p_ring->p_task);
+    }
+
+    return true;
+}
+
+bool os_ring_send(void *p_handle, const void *p_msg)
+{
+    void *p_slot;
+
+    if (p_msg == NULL)
+    {
+        return false;
+    }
+
+    p_slot = os_ring_reserve(p_handle);
+    if (p_slot == NULL)
+    {
+        return false;
+    }
+
+    memcpy(p_slot, p_msg, ((T_OS_RING *)p_handle)->msg_size);
+
+    return os_ring_commit(p_handle);
+}
+
+void *os_ring_peek(void *p_handle)
+{
+    T_OS_RING *p_ring = (T_OS_RING *)p_handle;
+    uint32_t   tail;
+
+    if (p_ring == NULL)
+    {
+        return NULL;
+    }
+
+    tail = p_ring->tail;
+    if (p_ring->head == tail)
+    {
+        return NULL;
+    }
+
+    __DMB();
+
+    return OS_RING_SLOT(p_ring, tail);
+}
+
+bool os_ring_release(void *p_handle)
+{
+    return os_ring_release_batch(p_handle, 1);
+}
+
+uint32_t os_ring_peek_batch(void *p_handle, void **pp_msg)
+{
+    T_OS_RING *p_ring = (T_OS_RING *)p_handle;
+    uint32_t   tail;
+    uint32_t   count;
+    uint32_t   contiguous;
+
+    if (p_ring == NULL || pp_msg == NULL)
+    {
+        return 0;
+    }
+
+    tail  = p_ring->tail;
+    count = p_ring->head - tail;
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    __DMB();
+
+    contiguous = p_ring->mask + 1 - (tail & p_ring->mask);
+    if (count > contiguous)
+    {
+        count = contiguous;
+    }
+
+    *pp_msg = OS_RING_SLOT(p_ring, tail);
+
+    return count;
+}
+
+bool os_ring_release_batch(void *p_handle, uint32_t msg_num)
+{
+    T_OS_RING *p_ring = (T_OS_RING *)p_handle;
+    uint32_t   tail;
+
+    if (p_ring == NULL)
+    {
+        return false;
+    }
+
+    tail = p_ring->tail;
+    if (msg_num == 0 || msg_num > p_ring->head - tail)
+    {
+        return false;
+    }
+
+    /* finish reading the messages before the producer may overwrite them */
+    __DMB();
+    p_ring->tail = tail + msg_num;
+    __DMB();
+
+    return true;
+}
+
+uint32_t os_ring_recv_batch(void *p_handle, void *p_msgs, uint32_t max_num, uint32_t wait_ms)
+{
+    T_OS_RING *p_ring = (T_OS_RING *)p_handle;
+    uint8_t   *p_dst = (uint8_t *)p_msgs;
+    void      *p_src;
+    uint32_t   total = 0;
+    uint32_t   num;
+
+    if (p_ring == NULL || p_msgs == NULL || max_num == 0)
+    {
+        return 0;
+    }
+
+    if (wait_ms != 0 && p_ring->head == p_ring->tail)
+    {
+        os_ring_wait(p_handle, wait_ms);
+    }
+
+    /* at most two rounds when the messages wrap around the ring end */
+    while (total < max_num && (num = os_ring_peek_batch(p_handle, &p_src)) != 0)
+    {
+        if (num > max_num - total)
+        {
+            num = max_num - total;
+        }
+
+        memcpy(p_dst, p_src, num * p_ring->msg_size);
+        os_ring_release_batch(p_handle, num);
+
+        p_dst += num * p_ring->msg_size;
+        total += num;
+    }
+
+    return total;
+}
+
+bool os_ring_wait(void *p_handle, uint32_t wait_ms)
+{
+    T_OS_RING *p_ring = (T_OS_RING *)p_handle;
+    uint32_t   wait_ticks;
+    uint32_t   notify;
+
+    if (p_ring == NULL)
+    {
+        return false;
+    }
+
+    if (p_ring->head != p_ring->tail)
+    {
+        return true;
+    }
+
+    if (p_ring->p_task == NULL || wait_ms == 0)
+    {
+        return false;
+    }
+
+    if (wait_ms == 0xFFFFFFFFUL)
+    {
+        wait_ticks = 0xFFFFFFFFUL;
+    }
+    else
+    {
+        wait_ticks = (uint32_t)(((uint64_t)wait_ms * osif_sys_tick_rate_get() + 999) / 1000);
+    }
+
+    /* a stale notification left by a drained burst only causes another round */
+    do
+    {
+        notify = 0;
+        os_task_notify_take(1, wait_ticks, &notify);
+        if (p_ring->head != p_ring->tail)
+        {
+            return true;
+        }
+    }
+    while (notify != 0 || wait_ticks == 0xFFFFFFFFUL);
+
+    return false;
+}
+
+uint32_t os_ring_count(void *p_handle)
+{
+    T_OS_RING *p_ring = (T_OS_RING *)p_handle;
+
+    if (p_ring == NULL)
+    {
+        return 0;
+    }
+
+    return p_ring->head - p_ring->tail;
+}
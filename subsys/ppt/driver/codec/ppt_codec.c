@@ -0,0 +1,341 @@
+/**
+*****************************************************************************************
+*     Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*****************************************************************************************
+  * @file     ppt_codec.c
+  * @brief    Source file for software model of the 2.4G packet pipeline.
+  * @details  CRC and whitening run a byte at a time from tables built at initialization,
+  *           the bits which do not fill a byte run one at a time.
+  * @version  v0.1
+  * *************************************************************************************
+  */
+
+#include <string.h>
+#include "ppt_codec.h"
+
+#define PPT_CODEC_MASK(bits)        ((bits) >= 32 ? 0xFFFFFFFF : ((1UL << (bits)) - 1))
+
+static uint8_t ppt_codec_swap_bits8(uint8_t data)
+{
+    uint8_t retval = data;
+    retval = (retval >> 4) | (retval << 4);
+    retval = ((retval & 0xCC) >> 2) | ((retval & 0x33) << 2);
+    retval = ((retval & 0xAA) >> 1) | ((retval & 0x55) << 1);
+    return retval;
+}
+
+static uint32_t ppt_codec_swap_bits(uint32_t data, uint8_t bits)
+{
+    uint32_t retval = 0;
+    for (uint8_t loop = 0; loop < bits; loop++)
+    {
+        retval = (retval << 1) | ((data >> loop) & 1);
+    }
+    return retval;
+}
+
+static uint8_t ppt_codec_crc_bits(const ppt_codec_t *codec)
+{
+    return codec->cfg.crc.len << 3;
+}
+
+static uint32_t ppt_codec_header_bits(const ppt_codec_t *codec)
+{
+    const ppt_pkt_format_t *format = &codec->cfg.format;
+    return format->hp_len + format->length_len + format->hs_len;
+}
+
+static void ppt_codec_put_bits(uint8_t *buf, uint32_t *pos, uint32_t value, uint8_t bits,
+                               ppt_field_bit_order_t order)
+{
+    for (uint8_t loop = 0; loop < bits; loop++)
+    {
+        uint8_t shift = (order == PPT_FIELD_BIT_ORDER_LSB) ? loop : bits - 1 - loop;
+        uint8_t mask = 1 << (*pos & 7);
+        if ((value >> shift) & 1)
+        {
+            buf[*pos >> 3] |= mask;
+        }
+        else
+        {
+            buf[*pos >> 3] &= ~mask;
+        }
+        (*pos)++;
+    }
+}
+
+static uint32_t ppt_codec_get_bits(const uint8_t *buf, uint32_t *pos, uint8_t bits,
+                                   ppt_field_bit_order_t order)
+{
+    uint32_t value = 0;
+    for (uint8_t loop = 0; loop < bits; loop++)
+    {
+        uint8_t shift = (order == PPT_FIELD_BIT_ORDER_LSB) ? loop : bits - 1 - loop;
+        value |= (uint32_t)((buf[*pos >> 3] >> (*pos & 7)) & 1) << shift;
+        (*pos)++;
+    }
+    return value;
+}
+
+static void ppt_codec_put_payload(uint8_t *buf, uint32_t *pos, const uint8_t *payload,
+                                  uint16_t payload_len, ppt_field_bit_order_t order)
+{
+    if ((*pos & 7) == 0)
+    {
+        uint8_t *dst = buf + (*pos >> 3);
+        if (order == PPT_FIELD_BIT_ORDER_LSB)
+        {
+            memcpy(dst, payload, payload_len);
+        }
+        else
+        {
+            for (uint16_t loop = 0; loop < payload_len; loop++)
+            {
+                dst[loop] = ppt_codec_swap_bits8(payload[loop]);
+            }
+        }
+        *pos += (uint32_t)payload_len << 3;
+        return;
+    }
+
+    for (uint16_t loop = 0; loop < payload_len; loop++)
+    {
+        ppt_codec_put_bits(buf, pos, payload[loop], 8, order);
+    }
+}
+
+static void ppt_codec_get_payload(const uint8_t *buf, uint32_t *pos, uint8_t *payload,
+                                  uint16_t payload_len, ppt_field_bit_order_t order)
+{
+    if ((*pos & 7) == 0)
+    {
+        const uint8_t *src = buf + (*pos >> 3);
+        if (order == PPT_FIELD_BIT_ORDER_LSB)
+        {
+            memcpy(payload, src, payload_len);
+        }
+        else
+        {
+            for (uint16_t loop = 0; loop < payload_len; loop++)
+            {
+                payload[loop] = ppt_codec_swap_bits8(src[loop]);
+            }
+        }
+        *pos += (uint32_t)payload_len << 3;
+        return;
+    }
+
+    for (uint16_t loop = 0; loop < payload_len; loop++)
+    {
+        payload[loop] = ppt_codec_get_bits(buf, pos, 8, order);
+    }
+}
+
+/* one step of the whitening lfsr, returns the output bit */
+static uint8_t ppt_codec_white_step(uint32_t *state, uint32_t poly, uint8_t bits)
+{
+    uint8_t out = (*state >> (bits - 1)) & 1;
+    *state = (*state << 1) & PPT_CODEC_MASK(bits);
+    if (out)
+    {
+        *state ^= poly;
+    }
+    return out;
+}
+
+bool ppt_codec_init(ppt_codec_t *codec, const ppt_codec_cfg_t *cfg)
+{
+    uint8_t crc_bits;
+    uint8_t white_bits = cfg->white_entry.len;
+    uint32_t poly;
+
+    if (cfg->format.addr_len > PPT_ADDR_LEN_MAX || cfg->crc.len > 4 ||
+        cfg->format.hp_len > 8 || cfg->format.length_len > 16 || cfg->format.hs_len > 32)
+    {
+        return false;
+    }
+    if (cfg->white.enable && (white_bits == 0 || white_bits > 32))
+    {
+        return false;
+    }
+
+    memset(codec, 0, sizeof(ppt_codec_t));
+    codec->cfg = *cfg;
+
+    /* reflected table, so the bits are shifted in from bit 0 of each byte */
+    crc_bits = ppt_codec_crc_bits(codec);
+    if (crc_bits)
+    {
+        poly = ppt_codec_swap_bits(cfg->crc_entry.value.poly, crc_bits);
+        for (uint16_t index = 0; index < 256; index++)
+        {
+            uint32_t crc = index;
+            for (uint8_t loop = 0; loop < 8; loop++)
+            {
+                crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+            }
+            codec->crc_table[index] = crc;
+        }
+        codec->crc_init = ppt_codec_swap_bits(cfg->crc_entry.value.init, crc_bits);
+    }
+
+    if (cfg->white.enable && white_bits <= 8)
+    {
+        poly = cfg->white_entry.value.poly & PPT_CODEC_MASK(white_bits);
+        for (uint16_t index = 0; index < (1 << white_bits); index++)
+        {
+            uint32_t state = index;
+            uint8_t white = 0;
+            for (uint8_t loop = 0; loop < 8; loop++)
+            {
+                white |= ppt_codec_white_step(&state, poly, white_bits) << loop;
+            }
+            codec->white_table[index] = white | (state << 8);
+        }
+    }
+    return true;
+}
+
+void ppt_codec_set_white_init(ppt_codec_t *codec, uint32_t init)
+{
+    codec->cfg.white_entry.value.init = init;
+}
+
+uint16_t ppt_codec_get_frame_len(const ppt_codec_t *codec, uint16_t payload_len)
+{
+    uint32_t bits = ppt_codec_header_bits(codec) + ((uint32_t)payload_len << 3) +
+                    ppt_codec_crc_bits(codec);
+    return codec->cfg.preamble_len + codec->cfg.format.addr_len + ((bits + 7) >> 3);
+}
+
+uint32_t ppt_codec_crc(const ppt_codec_t *codec, const uint8_t *data, uint32_t bit_len)
+{
+    uint8_t crc_bits = ppt_codec_crc_bits(codec);
+    uint32_t poly;
+    uint32_t crc = codec->crc_init;
+    uint32_t loop;
+
+    if (crc_bits == 0)
+    {
+        return 0;
+    }
+
+    for (loop = 0; loop < (bit_len >> 3); loop++)
+    {
+        crc = (crc >> 8) ^ codec->crc_table[(crc ^ data[loop]) & 0xFF];
+    }
+    poly = codec->crc_table[0x80];
+    for (loop <<= 3; loop < bit_len; loop++)
+    {
+        uint8_t bit = (data[loop >> 3] >> (loop & 7)) & 1;
+        crc = ((crc ^ bit) & 1) ? (crc >> 1) ^ poly : crc >> 1;
+    }
+    return ppt_codec_swap_bits(crc, crc_bits);
+}
+
+void ppt_codec_whiten(const ppt_codec_t *codec, uint8_t *data, uint32_t bit_len)
+{
+    uint8_t white_bits = codec->cfg.white_entry.len;
+    uint32_t poly = codec->cfg.white_entry.value.poly & PPT_CODEC_MASK(white_bits);
+    uint32_t state = codec->cfg.white_entry.value.init & PPT_CODEC_MASK(white_bits);
+    uint32_t loop = 0;
+
+    if (!codec->cfg.white.enable)
+    {
+        return;
+    }
+
+    if (white_bits <= 8)
+    {
+        for (; loop < (bit_len >> 3); loop++)
+        {
+            uint16_t white = codec->white_table[state];
+            data[loop] ^= white & 0xFF;
+            state = white >> 8;
+        }
+        loop <<= 3;
+    }
+    for (; loop < bit_len; loop++)
+    {
+        data[loop >> 3] ^= ppt_codec_white_step(&state, poly, white_bits) << (loop & 7);
+    }
+}
+
+uint16_t ppt_codec_encode(const ppt_codec_t *codec, const ppt_header_t *header,
+                          const uint8_t *payload, uint16_t payload_len, uint8_t *frame)
+{
+    const ppt_codec_cfg_t *cfg = &codec->cfg;
+    uint16_t frame_len = ppt_codec_get_frame_len(codec, payload_len);
+    uint8_t preamble = (cfg->format.addr_len && (cfg->addr[0] & 1)) ? 0x55 : 0xAA;
+    uint8_t *pdu = frame + cfg->preamble_len + cfg->format.addr_len;
+    uint32_t pos = 0;
+
+    memset(frame, preamble, cfg->preamble_len);
+    memcpy(frame + cfg->preamble_len, cfg->addr, cfg->format.addr_len);
+
+    ppt_codec_put_bits(pdu, &pos, header->hp, cfg->format.hp_len, cfg->format.header_order);
+    ppt_codec_put_bits(pdu, &pos, payload_len, cfg->format.length_len, cfg->format.header_order);
+    ppt_codec_put_bits(pdu, &pos, header->hs, cfg->format.hs_len, cfg->format.header_order);
+    ppt_codec_put_payload(pdu, &pos, payload, payload_len, cfg->format.payload_order);
+    ppt_codec_put_bits(pdu, &pos, ppt_codec_crc(codec, pdu, pos), ppt_codec_crc_bits(codec),
+                       PPT_FIELD_BIT_ORDER_MSB);
+    /* pad the last byte */
+    ppt_codec_put_bits(pdu, &pos, 0, (8 - (pos & 7)) & 7, PPT_FIELD_BIT_ORDER_LSB);
+
+    ppt_codec_whiten(codec, pdu, pos);
+    return frame_len;
+}
+
+ppt_codec_result_t ppt_codec_decode(const ppt_codec_t *codec, uint8_t *frame, uint16_t frame_len,
+                                    ppt_header_t *header, uint8_t *payload, uint16_t *payload_len)
+{
+    const ppt_codec_cfg_t *cfg = &codec->cfg;
+    uint16_t pdu_len;
+    uint8_t *pdu = frame + cfg->preamble_len + cfg->format.addr_len;
+    uint8_t crc_bits = ppt_codec_crc_bits(codec);
+    uint32_t pdu_bits;
+    uint32_t pos = 0;
+    uint32_t length;
+
+    if (frame_len < ppt_codec_get_frame_len(codec, 0))
+    {
+        return PPT_CODEC_LENGTH_ERROR;
+    }
+    if (memcmp(frame + cfg->preamble_len, cfg->addr, cfg->format.addr_len) != 0)
+    {
+        return PPT_CODEC_ADDR_MISMATCH;
+    }
+
+    pdu_len = frame_len - cfg->preamble_len - cfg->format.addr_len;
+    ppt_codec_whiten(codec, pdu, (uint32_t)pdu_len << 3);
+
+    header->hp = ppt_codec_get_bits(pdu, &pos, cfg->format.hp_len, cfg->format.header_order);
+    length = ppt_codec_get_bits(pdu, &pos, cfg->format.length_len, cfg->format.header_order);
+    header->hs = ppt_codec_get_bits(pdu, &pos, cfg->format.hs_len, cfg->format.header_order);
+    if (cfg->format.length_len == 0)
+    {
+        length = (((uint32_t)pdu_len << 3) - pos - crc_bits) >> 3;
+    }
+    header->length = length;
+
+    pdu_bits = pos + (length << 3);
+    if (pdu_bits + crc_bits > ((uint32_t)pdu_len << 3) || length > *payload_len)
+    {
+        return PPT_CODEC_LENGTH_ERROR;
+    }
+
+    if (crc_bits)
+    {
+        uint32_t crc = ppt_codec_crc(codec, pdu, pdu_bits);
+        pos = pdu_bits;
+        if (ppt_codec_get_bits(pdu, &pos, crc_bits, PPT_FIELD_BIT_ORDER_MSB) != crc)
+        {
+            return PPT_CODEC_CRC_ERROR;
+        }
+    }
+
+    pos = ppt_codec_header_bits(codec);
+    ppt_codec_get_payload(pdu, &pos, payload, length, cfg->format.payload_order);
+    *payload_len = length;
+    return PPT_CODEC_OK;
+}
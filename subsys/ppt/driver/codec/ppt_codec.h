@@ -0,0 +1,176 @@
+/**
+*****************************************************************************************
+*     Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*****************************************************************************************
+  * @file     ppt_codec.h
+  * @brief    Head file for software model of the 2.4G packet pipeline.
+  * @details  Build and parse the air frames which the hardware sends and receives,
+  *           using the same parameters which configure the hardware.
+  * @version  v0.1
+  * *************************************************************************************
+  */
+
+/* Define to prevent recursive inclusion */
+#ifndef _PPT_CODEC_H_
+#define _PPT_CODEC_H_
+
+/* Add Includes here */
+#include <stdbool.h>
+#include <stdint.h>
+#include "ppt_types.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif      /* __cplusplus */
+
+/** @addtogroup PPT_Codec
+  * @brief Software model of the packet pipeline.
+  *
+  * An air frame is kept as bytes in the order they are sent, each byte sent from bit 0 to bit 7:
+  * - Preamble, alternating bits ending with the inverse of the first address bit.
+  * - Access address, in the byte order of @ref ppt_tx_addr_t.
+  * - Header prefix, payload length and header suffix fields in @ref ppt_pkt_format_t::header_order.
+  * - Payload bytes in @ref ppt_pkt_format_t::payload_order.
+  * - CRC over the header and the payload, sent from its most significant bit.
+  *
+  * The header, payload and CRC are whitened if enabled. The CRC and whitening polynomials
+  * include the highest term, e.g. 0x0100065b for the 24 bits BLE CRC and 0x91 for the 7 bits
+  * BLE whitening. Bit i of the initial values is position i of the shift register.
+  * @{
+  */
+
+/** @defgroup PPT_Codec_Exported_Types Exported Types
+  * @brief
+  * @{
+  */
+
+/** @brief Frame parameters, the same as configured by the driver. */
+typedef struct
+{
+    uint8_t preamble_len; //!< Length of preamble in bytes, refer to @ref ppt_phy_entry_param_t.
+    uint8_t addr[PPT_ADDR_LEN_MAX]; //!< Access address, refer to @ref ppt_tx_addr_t.
+    ppt_pkt_format_t format; //!< Packet format, refer to @ref ppt_set_pkt_format.
+    ppt_crc_param_t crc; //!< CRC length, refer to @ref ppt_set_crc_param.
+    ppt_crc_entry_param_t crc_entry; //!< CRC formula, refer to @ref ppt_set_crc_entry_param.
+    ppt_white_param_t white; //!< Whitening switch, refer to @ref ppt_set_white_param.
+    ppt_white_entry_param_t white_entry; //!< Whitening formula, refer to @ref ppt_set_white_entry_param.
+} ppt_codec_cfg_t;
+
+/** @brief Codec context, initialized by @ref ppt_codec_init. */
+typedef struct
+{
+    ppt_codec_cfg_t cfg; //!< Frame parameters.
+    uint32_t crc_init; //!< CRC initial value with bits reversed.
+    uint32_t crc_table[256]; //!< CRC of each byte with bits reversed.
+    uint16_t white_table[256]; //!< Whitening byte and next state of each state, used when the whitening is no longer than 8 bits.
+} ppt_codec_t;
+
+/** @brief Decode result. */
+typedef enum
+{
+    PPT_CODEC_OK, //!< Frame is valid.
+    PPT_CODEC_ADDR_MISMATCH, //!< Access address differs.
+    PPT_CODEC_LENGTH_ERROR, //!< Frame is shorter than its length field, or the payload exceeds the buffer.
+    PPT_CODEC_CRC_ERROR //!< CRC check fails.
+} ppt_codec_result_t;
+
+/** @} End of PPT_Codec_Exported_Types */
+
+/** @defgroup PPT_Codec_Exported_Functions Exported Functions
+  * @brief
+  * @{
+  */
+
+/**
+  * @brief Initialize the codec.
+  *
+  * @param[out] codec: Codec context.
+  * @param[in] cfg: Frame parameters.
+  *
+  * @return Result.
+  * @retval True: Success.
+  * @retval False: The parameters are not supported by the hardware.
+  */
+bool ppt_codec_init(ppt_codec_t *codec, const ppt_codec_cfg_t *cfg);
+
+/**
+  * @brief Change the whitening initial value, e.g. when the RF channel changes.
+  *
+  * @param[in] codec: Codec context.
+  * @param[in] init: Whitening initial value, refer to @ref ppt_get_ble_white_init.
+  */
+void ppt_codec_set_white_init(ppt_codec_t *codec, uint32_t init);
+
+/**
+  * @brief Get the length of an air frame.
+  *
+  * @param[in] codec: Codec context.
+  * @param[in] payload_len: Length of the payload.
+  *
+  * @return Length of the frame in bytes.
+  */
+uint16_t ppt_codec_get_frame_len(const ppt_codec_t *codec, uint16_t payload_len);
+
+/**
+  * @brief Build an air frame.
+  *
+  * The length field is set to the payload length as the DMA does.
+  *
+  * @param[in] codec: Codec context.
+  * @param[in] header: Header prefix and suffix values.
+  * @param[in] payload: Pointer of the payload.
+  * @param[in] payload_len: Length of the payload.
+  * @param[out] frame: Frame buffer of at least @ref ppt_codec_get_frame_len bytes.
+  *
+  * @return Length of the frame in bytes.
+  */
+uint16_t ppt_codec_encode(const ppt_codec_t *codec, const ppt_header_t *header,
+                          const uint8_t *payload, uint16_t payload_len, uint8_t *frame);
+
+/**
+  * @brief Parse an air frame.
+  *
+  * The frame is dewhitened in place.
+  * Without a length field, the payload takes the rest of the frame before the CRC.
+  *
+  * @param[in] codec: Codec context.
+  * @param[in,out] frame: Pointer of the frame.
+  * @param[in] frame_len: Length of the frame.
+  * @param[out] header: Header fields.
+  * @param[out] payload: Payload buffer.
+  * @param[in,out] payload_len: Size of the payload buffer, set to the length of the payload.
+  *
+  * @return Decode result.
+  */
+ppt_codec_result_t ppt_codec_decode(const ppt_codec_t *codec, uint8_t *frame, uint16_t frame_len,
+                                    ppt_header_t *header, uint8_t *payload, uint16_t *payload_len);
+
+/**
+  * @brief Calculate the CRC of air bits.
+  *
+  * @param[in] codec: Codec context.
+  * @param[in] data: Pointer of the bits, sent from bit 0 of each byte.
+  * @param[in] bit_len: Number of bits.
+  *
+  * @return CRC shift register, bit i is position i.
+  */
+uint32_t ppt_codec_crc(const ppt_codec_t *codec, const uint8_t *data, uint32_t bit_len);
+
+/**
+  * @brief Whiten or dewhiten air bits in place.
+  *
+  * @param[in] codec: Codec context.
+  * @param[in,out] data: Pointer of the bits, sent from bit 0 of each byte.
+  * @param[in] bit_len: Number of bits.
+  */
+void ppt_codec_whiten(const ppt_codec_t *codec, uint8_t *data, uint32_t bit_len);
+
+/** @} End of PPT_Codec_Exported_Functions */
+
+/** @} End of PPT_Codec */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif
@@ -22,6 +22,7 @@
 #include "ppt_hw_reg.h"
 #include "ll_common.h"
 #include "ppt_pf.h"
+#include "ppt_types.h"
 
 #ifdef  __cplusplus
 extern "C" {
@@ -60,7 +61,6 @@ extern "C" {
   * @brief Hardware miscellaneous definition.
   * @{
   */
-#define PPT_ADDR_LEN_MAX            5 //!< Maximum length of the access address supported by the hardware.
 #define PPT_TX_FIFO_SIZE            8 //!< Tx FIFO depth supported by the hardware.
 
 #define PRO_ONE_ENTRY_DW_SIZE       0x20 //!< Macro used for the convenience of accessing registers.
@@ -292,113 +292,12 @@ typedef enum
     PPT_FSM_PSD //!< PSD state.
 } ppt_fsm_t;
 
-/** @brief The bit endianess of packet field. */
-typedef enum
-{
-    PPT_FIELD_BIT_ORDER_LSB, //!< Least significant bit first.
-    PPT_FIELD_BIT_ORDER_MSB //!< Most significant bit first.
-} ppt_field_bit_order_t;
-
-/** @brief The packet format control parameters. */
-typedef struct
-{
-    uint8_t addr_len; //!< Length of access address in bytes.
-    uint8_t hp_len; //!< Length of header prefix in bits.
-    uint8_t length_len; //!< Length of payload length in bits.
-    uint8_t hs_len; //!< Length of header suffix in bits.
-    ppt_field_bit_order_t header_order;  //!< Bit endianess of header.
-    ppt_field_bit_order_t payload_order; //!< Bit endianess of payload.
-} ppt_pkt_format_t;
-
 /** @brief The addon field length parameters. */
 typedef struct
 {
     uint8_t len; //!< Length of addon field in bytes.
 } ppt_addon_length_t;
 
-/** @brief The CRC formula parameters. */
-typedef struct
-{
-    uint32_t poly; //!< CRC polynomial.
-    uint32_t init; //!< CRC initial value.
-} ppt_crc_value_t;
-
-/** @brief The CRC length parameters for all channels. */
-typedef struct
-{
-    uint8_t len; //!< Length of CRC in bytes.
-    bool include_addr; //!< Calculation includes access address. Not supported feature!
-} ppt_crc_param_t;
-
-/** @brief CRC parameters of each channel. */
-typedef struct
-{
-    ppt_crc_value_t value; //!< Crc formula parameters.
-} ppt_crc_entry_param_t;
-
-/** @brief The whitening formula parameters. */
-typedef struct
-{
-    uint32_t poly; //!< Whitening polynomial.
-    uint32_t init; //!< Whitening initial value.
-} ppt_white_value_t;
-
-/** @brief The whitening switch for all channels. */
-typedef struct
-{
-    bool enable;
-} ppt_white_param_t;
-
-/** @brief The whitening parameters of each channel. */
-typedef struct
-{
-    uint8_t len; //!< Length of whitening coding in bits.
-    ppt_white_value_t value; //!< Whitening formula parameters
-} ppt_white_entry_param_t;
-
-/** @brief Supported PHY types. */
-typedef enum
-{
-    PPT_PHY_TYPE_BLE_1M, //!< BLE 1 Mbps phy type.
-    PPT_PHY_TYPE_BLE_2M //!< BLE 2 Mbps phy type.
-} ppt_phy_type_t;
-
-/** @brief The PHY common parameters for all channels. */
-typedef struct
-{
-    uint8_t bank; //!< RF frequency bank.
-    uint8_t channel;  //!< RF frequency channel.
-    ppt_phy_type_t rx_phy; //!< PHY types of RX.
-} ppt_phy_param_t;
-
-/** @brief The PHY special parameters of each channel. */
-typedef struct
-{
-    uint8_t preamble_len; //!< Length of preamble field.
-    ppt_phy_type_t tx_phy; //!< PHY types of TX.
-} ppt_phy_entry_param_t;
-
-/** @brief The tx access address of each channel. */
-typedef struct
-{
-    uint8_t tx_addr[PPT_ADDR_LEN_MAX]; //!< TX access address.
-} ppt_tx_addr_t;
-
-/** @brief The rx access address of each channel. */
-typedef struct
-{
-    bool enable; //!< Enable or disable RX for this channel.
-    uint8_t rx_addr[PPT_ADDR_LEN_MAX]; //!< RX access address.
-} ppt_rx_addr_t;
-
-/** @brief The header fields of frame of each channel. */
-typedef struct
-{
-    uint8_t hp; //!< Header prefix field value.
-    uint16_t length; //!< Payload length field value. This value is set by the DMA automatically.
-    uint32_t hs; //!< Header suffix field value.
-} ppt_header_t;
-
 /** @brief The PTX mode parameters for all channels. */
 typedef struct
 {
@@ -0,0 +1,153 @@
+/**
+*****************************************************************************************
+*     Copyright(c) 2026, Realtek Semiconductor Corporation. All rights reserved.
+*****************************************************************************************
+  * @file     ppt_types.h
+  * @brief    Head file for the 2.4G frame parameters.
+  * @details  Parameter structs shared by the driver and the software codec. They depend on
+  *           the standard headers only, so the codec can be built on a host.
+  * *************************************************************************************
+  */
+
+/* Define to prevent recursive inclusion */
+#ifndef _PPT_TYPES_H_
+#define _PPT_TYPES_H_
+
+/* Add Includes here */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif      /* __cplusplus */
+
+/** @addtogroup PPT_Driver
+  * @{
+  */
+
+/** @addtogroup PPT_Driver_Exported_Macros
+  * @{
+  */
+
+/** @addtogroup PPT_HW_MISC
+  * @{
+  */
+#define PPT_ADDR_LEN_MAX            5 //!< Maximum length of the access address supported by the hardware.
+/** @} */
+
+/** @} End of PPT_Driver_Exported_Macros */
+
+/** @addtogroup PPT_Driver_Exported_Types
+  * @{
+  */
+
+/** @brief The bit endianess of packet field. */
+typedef enum
+{
+    PPT_FIELD_BIT_ORDER_LSB, //!< Least significant bit first.
+    PPT_FIELD_BIT_ORDER_MSB //!< Most significant bit first.
+} ppt_field_bit_order_t;
+
+/** @brief The packet format control parameters. */
+typedef struct
+{
+    uint8_t addr_len; //!< Length of access address in bytes.
+    uint8_t hp_len; //!< Length of header prefix in bits.
+    uint8_t length_len; //!< Length of payload length in bits.
+    uint8_t hs_len; //!< Length of header suffix in bits.
+    ppt_field_bit_order_t header_order;  //!< Bit endianess of header.
+    ppt_field_bit_order_t payload_order; //!< Bit endianess of payload.
+} ppt_pkt_format_t;
+
+/** @brief The CRC formula parameters. */
+typedef struct
+{
+    uint32_t poly; //!< CRC polynomial.
+    uint32_t init; //!< CRC initial value.
+} ppt_crc_value_t;
+
+/** @brief The CRC length parameters for all channels. */
+typedef struct
+{
+    uint8_t len; //!< Length of CRC in bytes.
+    bool include_addr; //!< Calculation includes access address. Not supported feature!
+} ppt_crc_param_t;
+
+/** @brief CRC parameters of each channel. */
+typedef struct
+{
+    ppt_crc_value_t value; //!< Crc formula parameters.
+} ppt_crc_entry_param_t;
+
+/** @brief The whitening formula parameters. */
+typedef struct
+{
+    uint32_t poly; //!< Whitening polynomial.
+    uint32_t init; //!< Whitening initial value.
+} ppt_white_value_t;
+
+/** @brief The whitening switch for all channels. */
+typedef struct
+{
+    bool enable;
+} ppt_white_param_t;
+
+/** @brief The whitening parameters of each channel. */
+typedef struct
+{
+    uint8_t len; //!< Length of whitening coding in bits.
+    ppt_white_value_t value; //!< Whitening formula parameters
+} ppt_white_entry_param_t;
+
+/** @brief Supported PHY types. */
+typedef enum
+{
+    PPT_PHY_TYPE_BLE_1M, //!< BLE 1 Mbps phy type.
+    PPT_PHY_TYPE_BLE_2M //!< BLE 2 Mbps phy type.
+} ppt_phy_type_t;
+
+/** @brief The PHY common parameters for all channels. */
+typedef struct
+{
+    uint8_t bank; //!< RF frequency bank.
+    uint8_t channel;  //!< RF frequency channel.
+    ppt_phy_type_t rx_phy; //!< PHY types of RX.
+} ppt_phy_param_t;
+
+/** @brief The PHY special parameters of each channel. */
+typedef struct
+{
+    uint8_t preamble_len; //!< Length of preamble field.
+    ppt_phy_type_t tx_phy; //!< PHY types of TX.
+} ppt_phy_entry_param_t;
+
+/** @brief The tx access address of each channel. */
+typedef struct
+{
+    uint8_t tx_addr[PPT_ADDR_LEN_MAX]; //!< TX access address.
+} ppt_tx_addr_t;
+
+/** @brief The rx access address of each channel. */
+typedef struct
+{
+    bool enable; //!< Enable or disable RX for this channel.
+    uint8_t rx_addr[PPT_ADDR_LEN_MAX]; //!< RX access address.
+} ppt_rx_addr_t;
+
+/** @brief The header fields of frame of each channel. */
+typedef struct
+{
+    uint8_t hp; //!< Header prefix field value.
+    uint16_t length; //!< Payload length field value. This value is set by the DMA automatically.
+    uint32_t hs; //!< Header suffix field value.
+} ppt_header_t;
+
+/** @} End of PPT_Driver_Exported_Types */
+
+/** @} End of PPT_Driver */
+
+#ifdef  __cplusplus
+}
+#endif      /* __cplusplus */
+
+#endif /* _PPT_TYPES_H_ */
@@ -21,9 +21,28 @@ extern int8_t (*get_phy_rssi0_dbm)(uint8_t);
 extern uint8_t(*modem_psd_get_rf_mode)(void);
 uint8_t modem_psd_get_scan_mode(void);
 
+#if PPT_TX_RING_SLOT_NUM > PPT_TX_FIFO_SIZE
+#error "PPT_TX_RING_SLOT_NUM shall not exceed PPT_TX_FIFO_SIZE"
+#endif
+
 ppt_ctx_t ppt_ctx_imp;
 ppt_ctx_t *ppt_ctx = &ppt_ctx_imp;
 
+PPT_API_SECTION static int8_t ppt_read_rx_rssi(void)
+{
+    return ppt_get_rssi(RD_PPT_REG(PRO_RSSI));
+}
+
+static const ppt_fifo_ops_t ppt_fifo_ops_hw =
+{
+    .push_tx = ppt_push_tx_fifo,
+    .get_tx_pend_num = ppt_get_tx_fifo_pend_pkt_num,
+    .pop_rx = ppt_pop_rx_fifo,
+    .read_time = ppt_native_time_read,
+    .read_rssi = ppt_read_rx_rssi,
+};
+static const ppt_fifo_ops_t *ppt_fifo_ops = &ppt_fifo_ops_hw;
+
 void ppt_set_ptx_mode_ext(ppt_ptx_mode_ext_t *param)
 {
     ppt_ptx_mode_t *base = &param->base;
@@ -70,32 +89,54 @@ bool ppt_set_psd_mode_ext(ppt_psd_mode_ext_t *param)
     return true;
 }
 
-PPT_API_SECTION uint8_t *ppt_get_tx_buffer(uint16_t payload_len)
+void ppt_set_fifo_ops(const ppt_fifo_ops_t *ops)
 {
-    if (payload_len > PPT_TX_BUFFER_SIZE)
-    {
-        APP_PRINT_ERROR1("ppt_get_tx_buffer: fail, payload size %d exceed limit", payload_len);
-        return NULL;
-    }
+    ppt_fifo_ops = (ops != NULL) ? ops : &ppt_fifo_ops_hw;
+}
 
-    return ppt_ctx->tx_buffer[0];
+PPT_API_SECTION static uint8_t *ppt_get_tx_slot(uint8_t entry, uint8_t slot)
+{
+    return ppt_ctx->tx_buffer[entry] + slot * PPT_TX_SLOT_SIZE;
 }
 
-uint8_t *ppt_get_tx_buffer_by_entry(uint8_t entry, uint16_t payload_len)
+/* the next slot to reserve, or NULL if the slots are either reserved or still in the hw tx fifo */
+PPT_API_SECTION static uint8_t *ppt_peek_tx_slot(uint8_t entry, uint16_t payload_len,
+                                                 uint8_t *slot)
 {
+    ppt_tx_ring_t *ring;
+
     if (payload_len > PPT_TX_BUFFER_SIZE)
     {
-        APP_PRINT_ERROR1("ppt_get_tx_buffer_entry: fail, payload size %d exceed limit", payload_len);
+        APP_PRINT_ERROR1("ppt_peek_tx_slot: fail, payload size %d exceed limit", payload_len);
         return NULL;
     }
 
     if (entry >= PPT_TX_BUFFER_NUM)
     {
-        APP_PRINT_ERROR1("ppt_get_tx_buffer_entry: fail, entry %d exceed limit", entry);
+        APP_PRINT_ERROR1("ppt_peek_tx_slot: fail, entry %d exceed limit", entry);
         return NULL;
     }
 
-    return ppt_ctx->tx_buffer[entry];
+    /* the hw tx fifo sends in order, so the pending packets are the latest committed slots */
+    ring = &ppt_ctx->tx_ring[entry];
+    if (ppt_fifo_ops->get_tx_pend_num(entry) + ring->reserved >= PPT_TX_RING_SLOT_NUM)
+    {
+        return NULL;
+    }
+
+    *slot = (ring->head + ring->reserved) % PPT_TX_RING_SLOT_NUM;
+    return ppt_get_tx_slot(entry, *slot);
+}
+
+PPT_API_SECTION uint8_t *ppt_get_tx_buffer(uint16_t payload_len)
+{
+    return ppt_get_tx_buffer_by_entry(0, payload_len);
+}
+
+PPT_API_SECTION uint8_t *ppt_get_tx_buffer_by_entry(uint8_t entry, uint16_t payload_len)
+{
+    uint8_t slot;
+    return ppt_peek_tx_slot(entry, payload_len, &slot);
 }
 
 PPT_API_SECTION uint8_t *ppt_get_rx_buffer(uint16_t pdu_len)
@@ -109,41 +150,185 @@ PPT_API_SECTION uint8_t *ppt_get_rx_buffer(uint16_t pdu_len)
     return ppt_ctx->rx_buffer;
 }
 
-PPT_API_SECTION void ppt_push_tx_data(uint16_t len, uint8_t *data)
+PPT_API_SECTION uint8_t *ppt_reserve_tx_slot(uint8_t entry, uint16_t payload_len)
 {
-    uint8_t *tx_buffer = ppt_get_tx_buffer(len);
-    memcpy(tx_buffer, data, len);
-    ppt_push_tx_fifo(0, tx_buffer, len);
+    uint8_t slot;
+    uint8_t *tx_buffer = ppt_peek_tx_slot(entry, payload_len, &slot);
+
+    if (tx_buffer)
+    {
+        ppt_ctx->tx_ring[entry].len[slot] = payload_len;
+        ppt_ctx->tx_ring[entry].reserved++;
+    }
+    return tx_buffer;
+}
+
+PPT_API_SECTION bool ppt_commit_tx_slot(uint8_t entry, uint16_t payload_len)
+{
+    ppt_tx_ring_t *ring;
+
+    if (entry >= PPT_TX_BUFFER_NUM || ppt_ctx->tx_ring[entry].reserved == 0)
+    {
+        APP_PRINT_ERROR1("ppt_commit_tx_slot: fail, entry %d has no reserved slot", entry);
+        return false;
+    }
+
+    ring = &ppt_ctx->tx_ring[entry];
+    if (payload_len > ring->len[ring->head])
+    {
+        APP_PRINT_ERROR2("ppt_commit_tx_slot: fail, payload size %d exceed reserved %d", payload_len,
+                         ring->len[ring->head]);
+        return false;
+    }
+
+    ppt_fifo_ops->push_tx(entry, ppt_get_tx_slot(entry, ring->head), payload_len);
+    ring->head = (ring->head + 1) % PPT_TX_RING_SLOT_NUM;
+    ring->reserved--;
+    return true;
+}
+
+PPT_API_SECTION uint8_t ppt_commit_tx_burst(uint8_t entry, uint8_t num)
+{
+    ppt_tx_ring_t *ring;
+    uint8_t loop;
+
+    if (entry >= PPT_TX_BUFFER_NUM)
+    {
+        return 0;
+    }
+
+    ring = &ppt_ctx->tx_ring[entry];
+    for (loop = 0; loop < num && ring->reserved != 0; loop++)
+    {
+        ppt_commit_tx_slot(entry, ring->len[ring->head]);
+    }
+    return loop;
+}
+
+PPT_API_SECTION uint8_t ppt_push_tx_burst(uint8_t entry, uint8_t *const *data, const uint16_t *len,
+                                          uint8_t num)
+{
+    uint8_t loop;
+
+    for (loop = 0; loop < num; loop++)
+    {
+        uint8_t *tx_buffer = ppt_reserve_tx_slot(entry, len[loop]);
+        if (tx_buffer == NULL)
+        {
+            break;
+        }
+        memcpy(tx_buffer, data[loop], len[loop]);
+        ppt_commit_tx_slot(entry, len[loop]);
+    }
+    return loop;
+}
+
+PPT_API_SECTION bool ppt_push_tx_data(uint16_t len, uint8_t *data)
+{
+    return ppt_push_tx_data_by_entry(0, len, data);
 }
 
 void ppt_update_tx_data(uint16_t len, uint8_t *data)
 {
-    uint8_t *tx_buffer = ppt_get_tx_buffer(len);
+    /* rewrite the slot of the last pushed packet */
+    uint8_t slot = (ppt_ctx->tx_ring[0].head + PPT_TX_RING_SLOT_NUM - 1) % PPT_TX_RING_SLOT_NUM;
+    uint8_t *tx_buffer;
+
+    if (len > PPT_TX_BUFFER_SIZE)
+    {
+        APP_PRINT_ERROR1("ppt_update_tx_data: fail, payload size %d exceed limit", len);
+        return;
+    }
+
+    tx_buffer = ppt_get_tx_slot(0, slot);
     memcpy(tx_buffer, data, len);
     ppt_update_tx_fifo(0, tx_buffer, len);
 }
 
-PPT_API_SECTION void ppt_push_tx_data_by_entry(uint8_t entry, uint16_t len, uint8_t *data)
+PPT_API_SECTION bool ppt_push_tx_data_by_entry(uint8_t entry, uint16_t len, uint8_t *data)
 {
-    uint8_t *tx_buffer = ppt_get_tx_buffer_by_entry(entry, len);
+    uint8_t *tx_buffer = ppt_reserve_tx_slot(entry, len);
+    if (tx_buffer == NULL)
+    {
+        APP_PRINT_ERROR1("ppt_push_tx_data_by_entry: fail, entry %d has no free slot", entry);
+        return false;
+    }
     memcpy(tx_buffer, data, len);
-    ppt_push_tx_fifo(entry, tx_buffer, len);
+    ppt_commit_tx_slot(entry, len);
+    return true;
 }
 
 PPT_API_SECTION uint8_t *ppt_pop_rx_data(uint16_t len)
 {
     uint8_t *rx_buffer = ppt_get_rx_buffer(len);
-    ppt_pop_rx_fifo(0, rx_buffer, len);
+    ppt_fifo_ops->pop_rx(0, rx_buffer, len);
     return rx_buffer;
 }
 
 PPT_API_SECTION uint8_t *ppt_pop_rx_data_by_entry(uint8_t entry, uint16_t len)
 {
     uint8_t *rx_buffer = ppt_get_rx_buffer(len);
-    ppt_pop_rx_fifo(entry, rx_buffer, len);
+    ppt_fifo_ops->pop_rx(entry, rx_buffer, len);
     return rx_buffer;
 }
 
+/* take the next packet of the rx ring and pop into it */
+PPT_API_SECTION static ppt_rx_pkt_t *ppt_pop_rx_pkt_imp(uint8_t entry, uint16_t len)
+{
+    ppt_rx_pkt_t *pkt = &ppt_ctx->rx_pkt[ppt_ctx->rx_wr];
+
+    if (len > PPT_RX_BUFFER_SIZE)
+    {
+        APP_PRINT_ERROR1("ppt_pop_rx_pkt: fail, pdu size %d exceed limit", len);
+        return NULL;
+    }
+
+    if (pkt->busy)
+    {
+        return NULL;
+    }
+
+    ppt_fifo_ops->pop_rx(entry, pkt->pdu, len);
+    pkt->len = len;
+    pkt->entry = entry;
+    pkt->busy = true;
+    ppt_ctx->rx_wr = (ppt_ctx->rx_wr + 1) % PPT_RX_RING_SLOT_NUM;
+    return pkt;
+}
+
+PPT_API_SECTION ppt_rx_pkt_t *ppt_pop_rx_pkt(uint8_t entry, uint16_t len)
+{
+    ppt_rx_pkt_t *pkt = ppt_pop_rx_pkt_imp(entry, len);
+
+    if (pkt)
+    {
+        pkt->timestamp = ppt_fifo_ops->read_time();
+        pkt->rssi = ppt_fifo_ops->read_rssi();
+    }
+    return pkt;
+}
+
+PPT_API_SECTION uint8_t ppt_pop_rx_burst(uint8_t entry, const uint16_t *len, ppt_rx_pkt_t **pkt,
+                                         uint8_t num)
+{
+    uint8_t loop;
+
+    for (loop = 0; loop < num; loop++)
+    {
+        pkt[loop] = ppt_pop_rx_pkt(entry, len[loop]);
+        if (pkt[loop] == NULL)
+        {
+            break;
+        }
+    }
+    return loop;
+}
+
+PPT_API_SECTION void ppt_release_rx_pkt(ppt_rx_pkt_t *pkt)
+{
+    pkt->busy = false;
+}
+
 void ppt_async_cb_template(void)
 {
     /* make the async way easy to use */
@@ -398,7 +583,8 @@ static void ppt_init_sw(void)
     {
         if (ppt_ctx->tx_buffer[loop] == NULL)
         {
-            ppt_ctx->tx_buffer[loop] = os_mem_alloc(RAM_TYPE_BUFFER_ON, PPT_TX_BUFFER_SIZE);
+            ppt_ctx->tx_buffer[loop] = os_mem_alloc(RAM_TYPE_BUFFER_ON,
+                                                    PPT_TX_RING_SLOT_NUM * PPT_TX_SLOT_SIZE);
         }
     }
 
@@ -406,6 +592,15 @@ static void ppt_init_sw(void)
     {
         ppt_ctx->rx_buffer = os_mem_alloc(RAM_TYPE_BUFFER_ON, PPT_RX_BUFFER_SIZE);
     }
+
+    if (ppt_ctx->rx_pkt[0].pdu == NULL)
+    {
+        uint8_t *rx_ring = os_mem_alloc(RAM_TYPE_BUFFER_ON, PPT_RX_RING_SLOT_NUM * PPT_RX_SLOT_SIZE);
+        for (uint8_t loop = 0; loop < PPT_RX_RING_SLOT_NUM; loop++)
+        {
+            ppt_ctx->rx_pkt[loop].pdu = rx_ring + loop * PPT_RX_SLOT_SIZE;
+        }
+    }
 }
 
 static void ppt_deinit_sw(void)
@@ -422,6 +617,11 @@ static void ppt_deinit_sw(void)
     {
         os_mem_free(ppt_ctx->rx_buffer);
     }
+
+    if (ppt_ctx->rx_pkt[0].pdu)
+    {
+        os_mem_free(ppt_ctx->rx_pkt[0].pdu);
+    }
     memset(ppt_ctx, 0, sizeof(ppt_ctx_t));
 }
 
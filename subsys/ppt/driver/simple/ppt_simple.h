@@ -35,8 +35,9 @@ extern "C" {
 
 #ifndef PPT_TX_BUFFER_NUM
 /**
- * @brief Number of software buffers for tx packets which are the buffer RAM type.
+ * @brief Number of channels with software buffers for tx packets which are the buffer RAM type.
  * All the data pushed to the TX FIFO shall be of the buffer RAM type.
+ * Each channel owns @ref PPT_TX_RING_SLOT_NUM buffers.
  * When need more buffers, user can redefine this number using the compile parameter.
  */
 #define PPT_TX_BUFFER_NUM           2
@@ -44,6 +45,24 @@ extern "C" {
 #define PPT_TX_BUFFER_SIZE          255 //!< Maximum length of the tx packet's payload.
 #define PPT_RX_BUFFER_SIZE          (PPT_TX_BUFFER_SIZE + 8) //!< Maximum length of the rx packet including the header and the payload.
 
+#ifndef PPT_TX_RING_SLOT_NUM
+/**
+ * @brief Number of tx slots of each channel, i.e. packets that can be queued before the oldest is sent.
+ * Each channel below @ref PPT_TX_BUFFER_NUM owns a ring of this many slots of the buffer RAM type.
+ * It shall not exceed @ref PPT_TX_FIFO_SIZE, and can be redefined using the compile parameter.
+ */
+#define PPT_TX_RING_SLOT_NUM        4
+#endif
+#ifndef PPT_RX_RING_SLOT_NUM
+/**
+ * @brief Number of rx packet buffers of the buffer RAM type, refer to @ref ppt_pop_rx_pkt.
+ * When need more buffers, user can redefine this number using the compile parameter.
+ */
+#define PPT_RX_RING_SLOT_NUM        4
+#endif
+#define PPT_TX_SLOT_SIZE            ((PPT_TX_BUFFER_SIZE + 3) & ~3) //!< Size of a tx slot, word aligned for the DMA.
+#define PPT_RX_SLOT_SIZE            ((PPT_RX_BUFFER_SIZE + 3) & ~3) //!< Size of a rx packet buffer, word aligned for the DMA.
+
 /** @} End of PPT_Simple_Exported_Macros */
 
 /** @defgroup PPT_Simple_Exported_Types Exported Types
@@ -70,6 +89,39 @@ typedef struct
     ppt_psd_mode_t base; //!< The PSD mode parameters.
 } ppt_psd_mode_ext_t;
 
+/** @brief Received packet held in the rx ring, refer to @ref ppt_pop_rx_pkt. */
+typedef struct
+{
+    uint8_t *pdu; //!< Header and payload of the packet.
+    uint16_t len; //!< Length of the header and the payload.
+    uint8_t entry; //!< Channel index.
+    int8_t rssi; //!< RSSI of the packet in dBm.
+    uint64_t timestamp; //!< Native time when the packet is popped, refer to @ref ppt_native_time_read.
+    volatile bool busy; //!< The packet is held by the application until @ref ppt_release_rx_pkt.
+} ppt_rx_pkt_t;
+
+/** @brief Tx slot ring of a channel. */
+typedef struct
+{
+    uint8_t head; //!< Oldest reserved slot, which is the next to commit.
+    uint8_t reserved; //!< Number of reserved slots not committed yet.
+    uint16_t len[PPT_TX_RING_SLOT_NUM]; //!< Length reserved in each slot.
+} ppt_tx_ring_t;
+
+/**
+ * @brief Fifo operations used by the tx and rx rings.
+ *
+ * By default they access the hardware fifo, refer to @ref ppt_set_fifo_ops.
+ */
+typedef struct
+{
+    bool (*push_tx)(uint8_t entry, uint8_t *payload, uint16_t payload_len); //!< Push a payload, refer to @ref ppt_push_tx_fifo.
+    uint8_t (*get_tx_pend_num)(uint8_t entry); //!< Get the number of pushed packets not sent yet, refer to @ref ppt_get_tx_fifo_pend_pkt_num.
+    bool (*pop_rx)(uint8_t entry, uint8_t *pdu, uint16_t pdu_len); //!< Pop a pdu, refer to @ref ppt_pop_rx_fifo.
+    uint64_t (*read_time)(void); //!< Read the timestamp of a popped packet, refer to @ref ppt_native_time_read.
+    int8_t (*read_rssi)(void); //!< Read the RSSI of a popped packet in dBm.
+} ppt_fifo_ops_t;
+
 typedef struct
 {
     volatile ppt_fsm_t fsm; //!< Record current state.
@@ -77,8 +129,11 @@ typedef struct
     bool oneshot; //!< Oneshot mode.
     uint16_t retransmit_times; //!< Only used by the ptx, refer to @ref ppt_ptx_mode_ext_t.
     volatile uint16_t retransmit_counter; //!< Record current tx count.
-    uint8_t *tx_buffer[PPT_TX_BUFFER_NUM]; //!< Tx packet buffers.
+    uint8_t *tx_buffer[PPT_TX_BUFFER_NUM]; //!< Tx slots of each channel, slot i starts at i * @ref PPT_TX_SLOT_SIZE.
+    ppt_tx_ring_t tx_ring[PPT_TX_BUFFER_NUM]; //!< Tx slot ring of each channel.
     uint8_t *rx_buffer; //!< Rx packet buffer.
+    ppt_rx_pkt_t rx_pkt[PPT_RX_RING_SLOT_NUM]; //!< Rx packet ring.
+    uint8_t rx_wr; //!< Next rx packet of the ring to pop into.
     volatile bool sync_flag; //!< Flag indicates synchronous or asynchronous calling.
     void (*async_cb)(void); //!< Asynchronous callback when using asynchronous calling.
     struct
@@ -176,8 +231,10 @@ uint8_t *ppt_get_rx_buffer(uint16_t pdu_len);
   *
   * @param[in] len: Length of the payload.
   * @param[in] data: Pointer of the payload.
+  *
+  * @return true if the data is pushed, false if no tx slot is free or the parameters are invalid.
   */
-void ppt_push_tx_data(uint16_t len, uint8_t *data);
+bool ppt_push_tx_data(uint16_t len, uint8_t *data);
 
 /**
   * @brief Update and copy the data to the hw tx fifo of the channel 0.
@@ -198,8 +255,10 @@ void ppt_update_tx_data(uint16_t len, uint8_t *data);
   * @param[in] entry: Channel index.
   * @param[in] len: Length of the payload.
   * @param[in] data: Pointer of the payload.
+  *
+  * @return true if the data is pushed, false if no tx slot is free or the parameters are invalid.
   */
-void ppt_push_tx_data_by_entry(uint8_t entry, uint16_t len, uint8_t *data);
+bool ppt_push_tx_data_by_entry(uint8_t entry, uint16_t len, uint8_t *data);
 
 /**
   * @brief Pop and copy the data from the hw rx fifo of the channel 0.
@@ -224,6 +283,113 @@ uint8_t *ppt_pop_rx_data(uint16_t len);
   */
 uint8_t *ppt_pop_rx_data_by_entry(uint8_t entry, uint16_t len);
 
+/**
+  * @brief Reserve a tx slot of the specific channel to build a packet in place.
+  *
+  * The slots are of the buffer RAM type, so they can be pushed to the hw tx fifo without copying.
+  * Several slots can be reserved before committing, they are committed in the order of reservation.
+  * A slot is reusable once its packet has been sent, i.e. has left the hw tx fifo.
+  *
+  * @param[in] entry: Channel index, shall be less than @ref PPT_TX_BUFFER_NUM.
+  * @param[in] payload_len: Length of the payload.
+  *
+  * @return Pointer of the slot, or NULL if all slots are in use.
+  *
+  * <b>Example usage</b>
+  * \code{.c}
+    uint8_t *slot = ppt_reserve_tx_slot(0, 32);
+    if (slot)
+    {
+        build_report(slot, 32);
+        ppt_commit_tx_slot(0, 32);
+    }
+  * \endcode
+  */
+uint8_t *ppt_reserve_tx_slot(uint8_t entry, uint16_t payload_len);
+
+/**
+  * @brief Commit the oldest reserved tx slot of the specific channel to the hw tx fifo.
+  *
+  * @param[in] entry: Channel index, shall be less than @ref PPT_TX_BUFFER_NUM.
+  * @param[in] payload_len: Length of the payload, no more than the reserved length.
+  *
+  * @return Result.
+  * @retval True: Success.
+  * @retval False: No reserved slot or the length exceeds the reserved length.
+  */
+bool ppt_commit_tx_slot(uint8_t entry, uint16_t payload_len);
+
+/**
+  * @brief Commit several reserved tx slots of the specific channel with their reserved lengths.
+  *
+  * @param[in] entry: Channel index, shall be less than @ref PPT_TX_BUFFER_NUM.
+  * @param[in] num: Number of slots to commit.
+  *
+  * @return Number of committed slots.
+  */
+uint8_t ppt_commit_tx_burst(uint8_t entry, uint8_t num);
+
+/**
+  * @brief Push and copy several packets to the hw tx fifo of the specific channel.
+  *
+  * The packets are pushed in order until the tx slots run out.
+  *
+  * @param[in] entry: Channel index, shall be less than @ref PPT_TX_BUFFER_NUM.
+  * @param[in] data: Pointers of the payloads.
+  * @param[in] len: Lengths of the payloads.
+  * @param[in] num: Number of packets.
+  *
+  * @return Number of pushed packets.
+  */
+uint8_t ppt_push_tx_burst(uint8_t entry, uint8_t *const *data, const uint16_t *len, uint8_t num);
+
+/**
+  * @brief Pop a packet from the hw rx fifo into the rx ring.
+  *
+  * The packet stays valid until it is released by @ref ppt_release_rx_pkt, so it can be
+  * handed over to a task without copying. The timestamp and RSSI are read when popping,
+  * so this shall be called for each packet at its rx interrupt.
+  *
+  * @param[in] entry: Channel index.
+  * @param[in] len: Length of the header and the payload.
+  *
+  * @return Pointer of the packet, or NULL if all packets of the ring are held.
+  */
+ppt_rx_pkt_t *ppt_pop_rx_pkt(uint8_t entry, uint16_t len);
+
+/**
+  * @brief Pop several packets from the hw rx fifo of the specific channel into the rx ring.
+  *
+  * The timestamp and RSSI of every packet are read when it is popped, as @ref ppt_pop_rx_pkt does.
+  *
+  * @param[in] entry: Channel index.
+  * @param[in] len: Lengths of the header and the payload of each packet.
+  * @param[out] pkt: Pointers of the popped packets.
+  * @param[in] num: Number of packets.
+  *
+  * @return Number of popped packets.
+  */
+uint8_t ppt_pop_rx_burst(uint8_t entry, const uint16_t *len, ppt_rx_pkt_t **pkt, uint8_t num);
+
+/**
+  * @brief Release a packet popped by @ref ppt_pop_rx_pkt or @ref ppt_pop_rx_burst.
+  *
+  * Packets are reused in the order they are popped, so one that is held blocks the ring
+  * even if later ones are released.
+  *
+  * @param[in] pkt: Pointer of the packet.
+  */
+void ppt_release_rx_pkt(ppt_rx_pkt_t *pkt);
+
+/**
+  * @brief Replace the fifo operations used by the tx and rx rings.
+  *
+  * A loopback model of the fifo can be set here to run the rings without the radio.
+  *
+  * @param[in] ops: Fifo operations, NULL restores the hardware fifo.
+  */
+void ppt_set_fifo_ops(const ppt_fifo_ops_t *ops);
+
 /**
   * @brief Asynchronous callback template.
   *
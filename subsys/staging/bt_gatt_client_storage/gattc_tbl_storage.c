@@ -12,15 +12,34 @@
 #include "gap_bond_le.h"
 #endif
 
-#define GATTC_FTL_MGR_VERSION 0x02
+#define GATTC_FTL_MGR_VERSION 0x03
 #define GATTC_FTL_SYNC_WORD 0x55335533
 
 #define GATTC_FTL_MAX_BLOCK_LEN BT_EXT_FTL_BLOCK_LEN
 #define GATTC_FTL_BLOCK_MAX_NUM  ((BT_EXT_FTL_SIZE+GATTC_FTL_MAX_BLOCK_LEN-1)/GATTC_FTL_MAX_BLOCK_LEN)
 #define GATTC_FTL_BITMAP_MAX_NUM  ((GATTC_FTL_BLOCK_MAX_NUM + 7)/8)
 
+/* The blocks of one device are kept in a few contiguous extents */
+#define GATTC_FTL_EXTENT_MAX_NUM  4
+
 #define GATTC_STORAGE_DEBUG 0
 
+/** @brief The number of recently used devices whose service table is cached in RAM, 0 to disable. */
+#ifndef GATTC_TBL_HOT_DEV_NUM
+#define GATTC_TBL_HOT_DEV_NUM   2
+#endif
+
+/** @brief The longest service table kept in the RAM cache. */
+#ifndef GATTC_TBL_HOT_DATA_LEN
+#define GATTC_TBL_HOT_DATA_LEN  512
+#endif
+
+typedef struct
+{
+    uint8_t  start;
+    uint8_t  num;
+} T_GATTC_FTL_EXTENT;
+
 typedef struct
 {
     uint8_t  used: 1;
@@ -31,23 +50,27 @@ typedef struct
     uint8_t  cccd_block_num;
     uint8_t  svc_block_idx;
     uint8_t  block_used_num;
+    uint8_t  extent_num;
     uint16_t cccd_data_len;
     uint16_t cccd_crc16;
     uint16_t svc_total_len;
     uint16_t svc_crc16;
-    uint8_t  block_used_bitmap[GATTC_FTL_BITMAP_MAX_NUM];
+    T_GATTC_FTL_EXTENT extent[GATTC_FTL_EXTENT_MAX_NUM];
 } T_GATTC_FTL_DEV;
 
 typedef struct
 {
     uint8_t version;
     uint8_t block_unused_num;
+    uint8_t alloc_cursor;
     uint8_t block_unused_bitmap[GATTC_FTL_BITMAP_MAX_NUM];
     T_GATTC_FTL_DEV dev_tbl[GATTC_FTL_MAX_DEV_NUM];
     uint32_t sync_word;
 } T_GATTC_FTL_CB;
 
 #define GATTC_FTL_CB_LEN  ((sizeof(T_GATTC_FTL_CB)+GATTC_FTL_MAX_BLOCK_LEN-1)/GATTC_FTL_MAX_BLOCK_LEN)*GATTC_FTL_MAX_BLOCK_LEN
+#define GATTC_FTL_CB_BLOCK_NUM  (GATTC_FTL_CB_LEN / GATTC_FTL_MAX_BLOCK_LEN)
+#define GATTC_FTL_DATA_BLOCK_NUM  ((BT_EXT_FTL_SIZE - GATTC_FTL_CB_LEN) / GATTC_FTL_MAX_BLOCK_LEN)
 
 typedef union
 {
@@ -55,6 +78,30 @@ typedef union
     T_GATTC_FTL_CB ftl_cb;
 } T_GATTC_FTL_HEADER;
 
+#if GATTC_TBL_HOT_DEV_NUM
+typedef struct
+{
+    uint8_t  used;
+    uint8_t  identity_addr_type;
+    uint8_t  identity_addr[6];
+    uint16_t svc_total_len;
+    uint16_t svc_crc16;
+    uint32_t last_use;
+    uint8_t  svc_data[GATTC_TBL_HOT_DATA_LEN];
+} T_GATTC_TBL_HOT_DEV;
+
+static T_GATTC_TBL_HOT_DEV gattc_tbl_hot_dev[GATTC_TBL_HOT_DEV_NUM];
+static uint32_t gattc_tbl_hot_clock = 0;
+#endif
+
+/* The header is kept in RAM, only the header blocks marked dirty are written back */
+static T_GATTC_FTL_HEADER gattc_ftl_header;
+static bool gattc_ftl_header_loaded = false;
+static uint32_t gattc_ftl_header_dirty = 0;
+
+/* Bounce buffer for the partial block at the end of the data */
+static uint8_t gattc_ftl_block_buf[GATTC_FTL_MAX_BLOCK_LEN];
+
 bool gattc_tbl_storage_add_dev(T_GATT_STORAGE_SVC_TBL_SET_IND *p_set_ind);
 
 bool gattc_tbl_get_identity_addr(uint8_t *bd_addr, uint8_t bd_type,
@@ -144,79 +191,149 @@ failed:
 #if GATTC_STORAGE_DEBUG
 void gattc_tbl_storage_print(void)
 {
-    T_GATTC_FTL_HEADER *p_ftl_header = NULL;
-    p_ftl_header = calloc(1, sizeof(T_GATTC_FTL_HEADER));
+    T_GATTC_FTL_CB *p_ftl_cb = &gattc_ftl_header.ftl_cb;
 
-    if (p_ftl_header)
+    if (gattc_ftl_header_loaded && p_ftl_cb->sync_word == GATTC_FTL_SYNC_WORD)
     {
-        if (ftl_load_from_module(BT_EXT_FTL_PARTITION_NAME, p_ftl_header, 0,
-                                 sizeof(T_GATTC_FTL_HEADER)) != 0)
-        {
-            APP_PRINT_INFO0("gattc_tbl_storage_print: load header failed");
-        }
-        else
+        APP_PRINT_INFO4("gattc_tbl_storage_print: version 0x%x, block_unused_num %d, alloc_cursor %d, block_unused_bitmap %b",
+                        p_ftl_cb->version, p_ftl_cb->block_unused_num, p_ftl_cb->alloc_cursor,
+                        TRACE_BINARY(GATTC_FTL_BITMAP_MAX_NUM, p_ftl_cb->block_unused_bitmap));
+        for (uint8_t i = 0; i < GATTC_FTL_MAX_DEV_NUM; i++)
         {
-            if (p_ftl_header->ftl_cb.sync_word == GATTC_FTL_SYNC_WORD)
+            if (p_ftl_cb->dev_tbl[i].used)
             {
-                APP_PRINT_INFO3("gattc_tbl_storage_print: version 0x%x, block_unused_num %d, block_unused_bitmap %b",
-                                p_ftl_header->ftl_cb.version, p_ftl_header->ftl_cb.block_unused_num,
-                                TRACE_BINARY(GATTC_FTL_BITMAP_MAX_NUM, p_ftl_header->ftl_cb.block_unused_bitmap));
-                for (uint8_t i = 0; i < GATTC_FTL_MAX_DEV_NUM; i++)
-                {
-                    if (p_ftl_header->ftl_cb.dev_tbl[i].used)
-                    {
-                        APP_PRINT_INFO5("dev_tbl[%d]: remote_bd_type %d, remote_bd %s, block_used_num %d, block_used_bitmap %b",
-                                        i,
-                                        p_ftl_header->ftl_cb.dev_tbl[i].remote_bd_type,
-                                        TRACE_BDADDR(p_ftl_header->ftl_cb.dev_tbl[i].remote_bd),
-                                        p_ftl_header->ftl_cb.dev_tbl[i].block_used_num,
-                                        TRACE_BINARY(GATTC_FTL_BITMAP_MAX_NUM, p_ftl_header->ftl_cb.dev_tbl[i].block_used_bitmap));
-                        APP_PRINT_INFO6("\t cccd_block_num %d, cccd_data_len %d, cccd_crc16 0x%x, svc_block_idx %d, svc_total_len %d, svc_crc16 0x%x",
-                                        p_ftl_header->ftl_cb.dev_tbl[i].cccd_block_num,
-                                        p_ftl_header->ftl_cb.dev_tbl[i].cccd_data_len,
-                                        p_ftl_header->ftl_cb.dev_tbl[i].cccd_crc16,
-                                        p_ftl_header->ftl_cb.dev_tbl[i].svc_block_idx,
-                                        p_ftl_header->ftl_cb.dev_tbl[i].svc_total_len,
-                                        p_ftl_header->ftl_cb.dev_tbl[i].svc_crc16);
-                    }
-                    else
-                    {
-                        APP_PRINT_INFO1("dev_tbl[%d]: not used", i);
-                    }
-                }
+                APP_PRINT_INFO6("dev_tbl[%d]: remote_bd_type %d, remote_bd %s, block_used_num %d, extent_num %d, extent %b",
+                                i,
+                                p_ftl_cb->dev_tbl[i].remote_bd_type,
+                                TRACE_BDADDR(p_ftl_cb->dev_tbl[i].remote_bd),
+                                p_ftl_cb->dev_tbl[i].block_used_num,
+                                p_ftl_cb->dev_tbl[i].extent_num,
+                                TRACE_BINARY(sizeof(p_ftl_cb->dev_tbl[i].extent), p_ftl_cb->dev_tbl[i].extent));
+                APP_PRINT_INFO6("\t cccd_block_num %d, cccd_data_len %d, cccd_crc16 0x%x, svc_block_idx %d, svc_total_len %d, svc_crc16 0x%x",
+                                p_ftl_cb->dev_tbl[i].cccd_block_num,
+                                p_ftl_cb->dev_tbl[i].cccd_data_len,
+                                p_ftl_cb->dev_tbl[i].cccd_crc16,
+                                p_ftl_cb->dev_tbl[i].svc_block_idx,
+                                p_ftl_cb->dev_tbl[i].svc_total_len,
+                                p_ftl_cb->dev_tbl[i].svc_crc16);
             }
             else
             {
-                APP_PRINT_INFO0("gattc_tbl_storage_print: no info");
+                APP_PRINT_INFO1("dev_tbl[%d]: not used", i);
             }
         }
     }
-    if (p_ftl_header)
+    else
     {
-        free(p_ftl_header);
+        APP_PRINT_INFO0("gattc_tbl_storage_print: no info");
     }
 }
 #endif
 
-void gattc_tbl_bitmap_init(T_GATTC_FTL_CB *p_ftl_cb)
+#if GATTC_TBL_HOT_DEV_NUM
+T_GATTC_TBL_HOT_DEV *gattc_tbl_hot_find(uint8_t *identity_addr, uint8_t identity_addr_type)
+{
+    for (uint8_t i = 0; i < GATTC_TBL_HOT_DEV_NUM; i++)
+    {
+        if (gattc_tbl_hot_dev[i].used &&
+            gattc_tbl_hot_dev[i].identity_addr_type == identity_addr_type &&
+            memcmp(gattc_tbl_hot_dev[i].identity_addr, identity_addr, 6) == 0)
+        {
+            return &gattc_tbl_hot_dev[i];
+        }
+    }
+    return NULL;
+}
+
+void gattc_tbl_hot_remove(uint8_t *identity_addr, uint8_t identity_addr_type)
+{
+    T_GATTC_TBL_HOT_DEV *p_hot_dev;
+
+    if (identity_addr == NULL)
+    {
+        for (uint8_t i = 0; i < GATTC_TBL_HOT_DEV_NUM; i++)
+        {
+            gattc_tbl_hot_dev[i].used = false;
+        }
+        return;
+    }
+
+    p_hot_dev = gattc_tbl_hot_find(identity_addr, identity_addr_type);
+    if (p_hot_dev)
+    {
+        p_hot_dev->used = false;
+    }
+}
+
+void gattc_tbl_hot_save(uint8_t *identity_addr, uint8_t identity_addr_type,
+                        uint8_t *p_data, uint16_t data_len, uint16_t crc16)
+{
+    T_GATTC_TBL_HOT_DEV *p_hot_dev = gattc_tbl_hot_find(identity_addr, identity_addr_type);
+
+    if (data_len > GATTC_TBL_HOT_DATA_LEN)
+    {
+        if (p_hot_dev)
+        {
+            p_hot_dev->used = false;
+        }
+        return;
+    }
+
+    /* replace the least recently used device */
+    if (p_hot_dev == NULL)
+    {
+        p_hot_dev = &gattc_tbl_hot_dev[0];
+        for (uint8_t i = 0; i < GATTC_TBL_HOT_DEV_NUM; i++)
+        {
+            if (gattc_tbl_hot_dev[i].used == false)
+            {
+                p_hot_dev = &gattc_tbl_hot_dev[i];
+                break;
+            }
+            if (gattc_tbl_hot_dev[i].last_use < p_hot_dev->last_use)
+            {
+                p_hot_dev = &gattc_tbl_hot_dev[i];
+            }
+        }
+    }
+
+    p_hot_dev->used = true;
+    p_hot_dev->identity_addr_type = identity_addr_type;
+    memcpy(p_hot_dev->identity_addr, identity_addr, 6);
+    p_hot_dev->svc_total_len = data_len;
+    p_hot_dev->svc_crc16 = crc16;
+    p_hot_dev->last_use = ++gattc_tbl_hot_clock;
+    memcpy(p_hot_dev->svc_data, p_data, data_len);
+}
+#endif
+
+bool gattc_tbl_block_is_unused(T_GATTC_FTL_CB *p_ftl_cb, uint8_t block_idx)
+{
+    return (p_ftl_cb->block_unused_bitmap[block_idx / 8] & (1 << (block_idx % 8))) != 0;
+}
+
+void gattc_tbl_block_set_unused(T_GATTC_FTL_CB *p_ftl_cb, uint8_t block_idx, uint8_t block_num,
+                                bool unused)
 {
-    uint16_t block_unused_num;
-    p_ftl_cb->block_unused_num = ((BT_EXT_FTL_SIZE - sizeof(T_GATTC_FTL_HEADER) +
-                                   GATTC_FTL_MAX_BLOCK_LEN - 1) / GATTC_FTL_MAX_BLOCK_LEN);
-    block_unused_num = p_ftl_cb->block_unused_num;
-    for (uint8_t i = 0; i < GATTC_FTL_BITMAP_MAX_NUM; i++)
+    for (uint8_t i = block_idx; i < block_idx + block_num; i++)
     {
-        if (block_unused_num >= 8)
+        if (unused)
         {
-            p_ftl_cb->block_unused_bitmap[i] = 0xFF;
-            block_unused_num -= 8;
+            p_ftl_cb->block_unused_bitmap[i / 8] |= (1 << (i % 8));
         }
         else
         {
-            p_ftl_cb->block_unused_bitmap[i] = (1 << block_unused_num) - 1;
-            break;
+            p_ftl_cb->block_unused_bitmap[i / 8] &= ~(1 << (i % 8));
         }
     }
+}
+
+void gattc_tbl_bitmap_init(T_GATTC_FTL_CB *p_ftl_cb)
+{
+    p_ftl_cb->block_unused_num = GATTC_FTL_DATA_BLOCK_NUM;
+    p_ftl_cb->alloc_cursor = 0;
+    memset(p_ftl_cb->block_unused_bitmap, 0, GATTC_FTL_BITMAP_MAX_NUM);
+    gattc_tbl_block_set_unused(p_ftl_cb, 0, GATTC_FTL_DATA_BLOCK_NUM, true);
 #if GATTC_STORAGE_DEBUG
     APP_PRINT_INFO2("gattc_tbl_bitmap_init: p_ftl_cb->block_unused_num %d, block_unused_bitmap %b",
                     p_ftl_cb->block_unused_num,
@@ -226,236 +343,226 @@ void gattc_tbl_bitmap_init(T_GATTC_FTL_CB *p_ftl_cb)
 
 bool gattc_tbl_bitmap_free(T_GATTC_FTL_CB *p_ftl_cb, T_GATTC_FTL_DEV *p_ftl_dev)
 {
-    for (uint8_t i = 0; i < GATTC_FTL_BITMAP_MAX_NUM; i++)
+    T_GATTC_FTL_EXTENT *p_extent;
+
+    for (uint8_t i = 0; i < p_ftl_dev->extent_num; i++)
     {
-        if ((p_ftl_cb->block_unused_bitmap[i] & p_ftl_dev->block_used_bitmap[i]) == 0)
+        p_extent = &p_ftl_dev->extent[i];
+        for (uint8_t j = 0; j < p_extent->num; j++)
         {
-            p_ftl_cb->block_unused_bitmap[i] |= p_ftl_dev->block_used_bitmap[i];
-        }
-        else
-        {
-            APP_PRINT_ERROR0("gattc_tbl_bitmap_free: no matching");
-            return false;
+            if (gattc_tbl_block_is_unused(p_ftl_cb, p_extent->start + j))
+            {
+                APP_PRINT_ERROR0("gattc_tbl_bitmap_free: no matching");
+                return false;
+            }
         }
     }
+    for (uint8_t i = 0; i < p_ftl_dev->extent_num; i++)
+    {
+        gattc_tbl_block_set_unused(p_ftl_cb, p_ftl_dev->extent[i].start, p_ftl_dev->extent[i].num, true);
+    }
     p_ftl_cb->block_unused_num += p_ftl_dev->block_used_num;
     return true;
 }
 
+/* Get the number of unused blocks from block_idx, without wrapping around */
+uint8_t gattc_tbl_bitmap_unused_run(T_GATTC_FTL_CB *p_ftl_cb, uint8_t block_idx)
+{
+    uint8_t run = 0;
+
+    while ((block_idx + run) < GATTC_FTL_DATA_BLOCK_NUM &&
+           gattc_tbl_block_is_unused(p_ftl_cb, block_idx + run))
+    {
+        run++;
+    }
+    return run;
+}
+
+/*
+ * Assign the blocks from the allocation cursor on, so rewritten tables move around the store
+ * instead of always wearing the first blocks. One extent is preferred, otherwise the unused
+ * runs are taken in order up to GATTC_FTL_EXTENT_MAX_NUM extents.
+ */
 bool gattc_tbl_bitmap_assign(T_GATTC_FTL_CB *p_ftl_cb, T_GATTC_FTL_DEV *p_ftl_dev,
                              uint8_t block_num)
 {
-    uint8_t block_idx = 0;
-    uint8_t block_assign_num = 0;
-    uint8_t block_unused_bitmap;
+    uint8_t block_idx;
+    uint8_t run;
+    uint8_t left = block_num;
+    uint16_t scan;
+
     if (p_ftl_cb->block_unused_num < block_num)
     {
         return false;
     }
-    memset(p_ftl_dev->block_used_bitmap, 0, sizeof(uint8_t)*GATTC_FTL_BITMAP_MAX_NUM);
-    for (uint8_t i = 0; i < GATTC_FTL_BITMAP_MAX_NUM; i++)
+    p_ftl_dev->extent_num = 0;
+    p_ftl_dev->block_used_num = 0;
+    if (block_num == 0)
+    {
+        return true;
+    }
+
+    for (uint8_t pass = 0; pass < 2 && left != 0; pass++)
     {
-        block_idx = 0;
-        block_unused_bitmap = p_ftl_cb->block_unused_bitmap[i];
-        while (block_unused_bitmap)
+        for (scan = 0; scan < GATTC_FTL_DATA_BLOCK_NUM && left != 0;)
         {
-            if (block_unused_bitmap & 0x01)
+            block_idx = (p_ftl_cb->alloc_cursor + scan) % GATTC_FTL_DATA_BLOCK_NUM;
+            run = gattc_tbl_bitmap_unused_run(p_ftl_cb, block_idx);
+            if (run == 0)
             {
-                p_ftl_dev->block_used_bitmap[i] |= (1 << block_idx);
-                p_ftl_cb->block_unused_bitmap[i] &= ~(1 << block_idx);
-                block_assign_num++;
-                if (block_assign_num == block_num)
-                {
-                    break;
-                }
+                scan++;
+                continue;
+            }
+            scan += run;
+
+            if (pass == 0 && run < block_num)
+            {
+                continue;
+            }
+            if (run > left)
+            {
+                run = left;
+            }
+            p_ftl_dev->extent[p_ftl_dev->extent_num].start = block_idx;
+            p_ftl_dev->extent[p_ftl_dev->extent_num].num = run;
+            p_ftl_dev->extent_num++;
+            gattc_tbl_block_set_unused(p_ftl_cb, block_idx, run, false);
+            left -= run;
+            p_ftl_cb->alloc_cursor = (block_idx + run) % GATTC_FTL_DATA_BLOCK_NUM;
+
+            if (p_ftl_dev->extent_num == GATTC_FTL_EXTENT_MAX_NUM)
+            {
+                break;
             }
-            block_unused_bitmap >>= 1;
-            block_idx++;
         }
-        if (block_assign_num == block_num)
+    }
+
+    if (left != 0)
+    {
+        for (uint8_t i = 0; i < p_ftl_dev->extent_num; i++)
         {
-            break;
+            gattc_tbl_block_set_unused(p_ftl_cb, p_ftl_dev->extent[i].start, p_ftl_dev->extent[i].num,
+                                       true);
         }
+        p_ftl_dev->extent_num = 0;
+        p_ftl_dev->block_used_num = 0;
+        return false;
     }
-    if (block_assign_num == block_num)
-    {
-        p_ftl_dev->block_used_num = block_num;
-        p_ftl_cb->block_unused_num -= p_ftl_dev->block_used_num;
+
+    p_ftl_dev->block_used_num = block_num;
+    p_ftl_cb->block_unused_num -= block_num;
 #if GATTC_STORAGE_DEBUG
-        APP_PRINT_INFO4("gattc_tbl_bitmap_assign: block_unused_bitmap %b, block_unused_num %d, block_used_bitmap %b, block_used_num %d",
-                        TRACE_BINARY(GATTC_FTL_BITMAP_MAX_NUM, p_ftl_cb->block_unused_bitmap),
-                        p_ftl_cb->block_unused_num,
-                        TRACE_BINARY(GATTC_FTL_BITMAP_MAX_NUM, p_ftl_dev->block_used_bitmap),
-                        p_ftl_dev->block_used_num);
+    APP_PRINT_INFO4("gattc_tbl_bitmap_assign: block_unused_bitmap %b, block_unused_num %d, extent_num %d, block_used_num %d",
+                    TRACE_BINARY(GATTC_FTL_BITMAP_MAX_NUM, p_ftl_cb->block_unused_bitmap),
+                    p_ftl_cb->block_unused_num, p_ftl_dev->extent_num, p_ftl_dev->block_used_num);
 #endif
-        return true;
-    }
-    else
+    return true;
+}
+
+/* Get the store block of the block_idx-th block of the device, and the contiguous blocks from it */
+uint8_t gattc_tbl_extent_map(T_GATTC_FTL_DEV *p_ftl_dev, uint8_t block_idx, uint8_t *p_run)
+{
+    for (uint8_t i = 0; i < p_ftl_dev->extent_num; i++)
     {
-        return false;
+        if (block_idx < p_ftl_dev->extent[i].num)
+        {
+            *p_run = p_ftl_dev->extent[i].num - block_idx;
+            return p_ftl_dev->extent[i].start + block_idx;
+        }
+        block_idx -= p_ftl_dev->extent[i].num;
     }
+    *p_run = 0;
+    return 0;
 }
 
-bool gattc_tbl_write_data(T_GATTC_FTL_DEV *p_ftl_dev, uint8_t block_start_idx,
-                          uint8_t  *p_data, uint16_t write_len)
+/* Whole blocks go straight between the buffer and the FTL, one call per extent */
+bool gattc_tbl_access_data(T_GATTC_FTL_DEV *p_ftl_dev, uint8_t block_start_idx,
+                           uint8_t *p_data, uint16_t data_len, bool is_write)
 {
-    uint16_t write_idx = 0;
-    uint8_t error_idx = 1;
-    uint8_t block_idx = 0;
-    uint8_t used_block_idx = 0;
-    uint8_t block_used_bitmap;
-    uint8_t  *p_write_data;
-    uint8_t  *p_temp_data = NULL;
+    uint16_t data_idx = 0;
+    uint16_t offset;
+    uint16_t size;
+    uint8_t block_idx = block_start_idx;
+    uint8_t block;
+    uint8_t run;
+    int32_t ret;
 
-    for (uint8_t i = 0; i < GATTC_FTL_BITMAP_MAX_NUM; i++)
+    while (data_idx < data_len)
     {
-        block_used_bitmap = p_ftl_dev->block_used_bitmap[i];
-        while (block_used_bitmap)
+        block = gattc_tbl_extent_map(p_ftl_dev, block_idx, &run);
+        if (run == 0)
         {
-            if (block_used_bitmap & 0x01)
-            {
-                if (used_block_idx < block_start_idx)
-                {
-                    block_used_bitmap >>= 1;
-                    block_idx++;
-                    used_block_idx++;
-                    continue;
-                }
-
-                p_write_data = p_data + write_idx;
-
-                if ((write_len - write_idx) < GATTC_FTL_MAX_BLOCK_LEN)
-                {
-                    p_temp_data = calloc(1, GATTC_FTL_MAX_BLOCK_LEN);
-                    if (p_temp_data == NULL)
-                    {
-                        error_idx = 3;
-                        goto failed;
-                    }
-
-                    memcpy(p_temp_data, p_write_data, write_len - write_idx);
-                    p_write_data = p_temp_data;
-                }
+            return false;
+        }
+        offset = GATTC_FTL_CB_LEN + GATTC_FTL_MAX_BLOCK_LEN * block;
 
-                if (ftl_save_to_module(BT_EXT_FTL_PARTITION_NAME, p_write_data,
-                                       GATTC_FTL_CB_LEN + GATTC_FTL_MAX_BLOCK_LEN * block_idx,
-                                       GATTC_FTL_MAX_BLOCK_LEN) != 0)
-                {
-                    error_idx = 2;
-                    goto failed;
-                }
-                else
-                {
-                    write_idx += GATTC_FTL_MAX_BLOCK_LEN;
-                    if (write_idx >= write_len)
-                    {
-                        goto success;
-                    }
-                }
+        size = (data_len - data_idx) / GATTC_FTL_MAX_BLOCK_LEN;
+        if (size != 0)
+        {
+            if (size > run)
+            {
+                size = run;
+            }
+            block_idx += size;
+            size *= GATTC_FTL_MAX_BLOCK_LEN;
+            if (is_write)
+            {
+                ret = ftl_save_to_module(BT_EXT_FTL_PARTITION_NAME, p_data + data_idx, offset, size);
+            }
+            else
+            {
+                ret = ftl_load_from_module(BT_EXT_FTL_PARTITION_NAME, p_data + data_idx, offset, size);
             }
-            block_used_bitmap >>= 1;
+        }
+        else
+        {
             block_idx++;
+            size = data_len - data_idx;
+            if (is_write)
+            {
+                memcpy(gattc_ftl_block_buf, p_data + data_idx, size);
+                memset(gattc_ftl_block_buf + size, 0, GATTC_FTL_MAX_BLOCK_LEN - size);
+                ret = ftl_save_to_module(BT_EXT_FTL_PARTITION_NAME, gattc_ftl_block_buf, offset,
+                                         GATTC_FTL_MAX_BLOCK_LEN);
+            }
+            else
+            {
+                ret = ftl_load_from_module(BT_EXT_FTL_PARTITION_NAME, gattc_ftl_block_buf, offset,
+                                           GATTC_FTL_MAX_BLOCK_LEN);
+                memcpy(p_data + data_idx, gattc_ftl_block_buf, size);
+            }
         }
-        if (write_idx >= write_len)
+        if (ret != 0)
         {
-            goto success;
+            return false;
         }
-    }
-failed:
-    if (p_temp_data)
-    {
-        free(p_temp_data);
-    }
-    APP_PRINT_ERROR1("gattc_tbl_write_data: failed, error_idx %d", error_idx);
-    return false;
-success:
-    if (p_temp_data)
-    {
-        free(p_temp_data);
+        data_idx += size;
     }
     return true;
 }
 
-uint8_t *gattc_tbl_read_data(T_GATTC_FTL_DEV *p_ftl_dev, uint8_t block_start_idx,
-                             uint16_t svc_total_len)
+bool gattc_tbl_write_data(T_GATTC_FTL_DEV *p_ftl_dev, uint8_t block_start_idx,
+                          uint8_t  *p_data, uint16_t write_len)
 {
-    uint8_t *p_temp_buf = NULL;
-    uint16_t read_len = svc_total_len;
-    uint16_t read_idx = 0;
-    uint8_t error_idx = 1;
-    uint8_t block_idx = 0;
-    uint8_t used_block_idx = 0;
-    uint8_t block_used_bitmap;
-
-    if ((read_len % GATTC_FTL_MAX_BLOCK_LEN) != 0)
-    {
-        read_len = (read_len / GATTC_FTL_MAX_BLOCK_LEN + 1) * GATTC_FTL_MAX_BLOCK_LEN;
-    }
-    p_temp_buf = calloc(1, read_len);
-    if (p_temp_buf == NULL)
+    if (gattc_tbl_access_data(p_ftl_dev, block_start_idx, p_data, write_len, true) == false)
     {
-        error_idx = 1;
-        goto failed;
+        APP_PRINT_ERROR2("gattc_tbl_write_data: failed, block_start_idx %d, write_len %d",
+                         block_start_idx, write_len);
+        return false;
     }
-    for (uint8_t i = 0; i < GATTC_FTL_BITMAP_MAX_NUM; i++)
-    {
-        block_used_bitmap = p_ftl_dev->block_used_bitmap[i];
-        while (block_used_bitmap)
-        {
-            if (block_used_bitmap & 0x01)
-            {
-                if (used_block_idx < block_start_idx)
-                {
-                    block_used_bitmap >>= 1;
-                    block_idx++;
-                    used_block_idx++;
-                    continue;
-                }
-
-                if ((read_idx + GATTC_FTL_MAX_BLOCK_LEN) > read_len)
-                {
-                    error_idx = 3;
-                    goto failed;
-                }
+    return true;
+}
 
-                if (ftl_load_from_module(BT_EXT_FTL_PARTITION_NAME, p_temp_buf + read_idx,
-                                         GATTC_FTL_CB_LEN + GATTC_FTL_MAX_BLOCK_LEN * block_idx,
-                                         GATTC_FTL_MAX_BLOCK_LEN) != 0)
-                {
-                    error_idx = 2;
-                    goto failed;
-                }
-                else
-                {
-                    read_idx += GATTC_FTL_MAX_BLOCK_LEN;
-                    if (read_idx == read_len)
-                    {
-                        goto success;
-                    }
-                }
-            }
-            block_used_bitmap >>= 1;
-            block_idx++;
-        }
-        if (read_idx > read_len)
-        {
-            error_idx = 4;
-            goto failed;
-        }
-        else if (read_idx == read_len)
-        {
-            goto success;
-        }
-    }
-failed:
-    APP_PRINT_ERROR1("gattc_tbl_read_data: failed, error_idx %d", error_idx);
-    if (p_temp_buf)
+bool gattc_tbl_read_data(T_GATTC_FTL_DEV *p_ftl_dev, uint8_t block_start_idx,
+                         uint8_t *p_buf, uint16_t read_len)
+{
+    if (gattc_tbl_access_data(p_ftl_dev, block_start_idx, p_buf, read_len, false) == false)
     {
-        free(p_temp_buf);
+        APP_PRINT_ERROR2("gattc_tbl_read_data: failed, block_start_idx %d, read_len %d",
+                         block_start_idx, read_len);
+        return false;
     }
-    return NULL;
-success:
-    return p_temp_buf;
+    return true;
 }
 
 T_GATTC_FTL_DEV *gattc_tbl_storage_find_dev(T_GATTC_FTL_CB *p_ftl_cb,
@@ -492,118 +599,160 @@ T_GATTC_FTL_DEV *gattc_tbl_storage_find_unused_dev(T_GATTC_FTL_CB *p_ftl_cb)
     return NULL;
 }
 
-bool gattc_tbl_storage_save_header(T_GATTC_FTL_HEADER *p_ftl_header)
+/* Mark the header blocks covering the field to be written back by gattc_tbl_storage_save_header */
+void gattc_tbl_storage_mark_header(const void *p_field, uint16_t len)
 {
-    if (ftl_save_to_module(BT_EXT_FTL_PARTITION_NAME, p_ftl_header, 0, sizeof(T_GATTC_FTL_HEADER)) == 0)
+    uint16_t offset = (const uint8_t *)p_field - gattc_ftl_header.data;
+
+    for (uint16_t i = offset / GATTC_FTL_MAX_BLOCK_LEN; i <= (offset + len - 1) / GATTC_FTL_MAX_BLOCK_LEN;
+         i++)
     {
-        return true;
+        gattc_ftl_header_dirty |= (1UL << i);
     }
-    return false;
+}
+
+bool gattc_tbl_storage_save_header(void)
+{
+    uint8_t block_idx = 0;
+    uint8_t block_num;
+
+    while (gattc_ftl_header_dirty != 0 && block_idx < GATTC_FTL_CB_BLOCK_NUM)
+    {
+        if ((gattc_ftl_header_dirty & (1UL << block_idx)) == 0)
+        {
+            block_idx++;
+            continue;
+        }
+        for (block_num = 1; block_idx + block_num < GATTC_FTL_CB_BLOCK_NUM; block_num++)
+        {
+            if ((gattc_ftl_header_dirty & (1UL << (block_idx + block_num))) == 0)
+            {
+                break;
+            }
+        }
+        if (ftl_save_to_module(BT_EXT_FTL_PARTITION_NAME,
+                               gattc_ftl_header.data + block_idx * GATTC_FTL_MAX_BLOCK_LEN,
+                               block_idx * GATTC_FTL_MAX_BLOCK_LEN,
+                               block_num * GATTC_FTL_MAX_BLOCK_LEN) != 0)
+        {
+            /* the RAM header is ahead of the flash, load it again on next access */
+            gattc_ftl_header_loaded = false;
+            gattc_ftl_header_dirty = 0;
+            return false;
+        }
+        gattc_ftl_header_dirty &= ~(((1UL << block_num) - 1) << block_idx);
+        block_idx += block_num;
+    }
+    return true;
 }
 
 bool gattc_tbl_storage_clear(void)
 {
-    T_GATTC_FTL_HEADER ftl_header;
-    memset(&ftl_header, 0, sizeof(ftl_header));
+    memset(&gattc_ftl_header, 0, sizeof(gattc_ftl_header));
+    gattc_ftl_header_loaded = true;
+    gattc_tbl_storage_mark_header(gattc_ftl_header.data, sizeof(gattc_ftl_header));
+#if GATTC_TBL_HOT_DEV_NUM
+    gattc_tbl_hot_remove(NULL, 0);
+#endif
 
     APP_PRINT_INFO0("gattc_tbl_storage_clear");
-    return gattc_tbl_storage_save_header(&ftl_header);
+    return gattc_tbl_storage_save_header();
+}
+
+/* Mark the device and the block allocation state after the device blocks were changed */
+void gattc_tbl_storage_mark_dev(T_GATTC_FTL_DEV *p_ftl_dev)
+{
+    T_GATTC_FTL_CB *p_ftl_cb = &gattc_ftl_header.ftl_cb;
+
+    gattc_tbl_storage_mark_header(p_ftl_cb, (uint8_t *)p_ftl_cb->dev_tbl - (uint8_t *)p_ftl_cb);
+    gattc_tbl_storage_mark_header(p_ftl_dev, sizeof(T_GATTC_FTL_DEV));
 }
 
 bool gattc_tbl_storage_remove_dev(T_GATTC_FTL_HEADER *p_ftl_header, T_GATTC_FTL_DEV *p_ftl_dev)
 {
+#if GATTC_TBL_HOT_DEV_NUM
+    gattc_tbl_hot_remove(p_ftl_dev->remote_bd, p_ftl_dev->remote_bd_type);
+#endif
     if (gattc_tbl_bitmap_free(&p_ftl_header->ftl_cb, p_ftl_dev))
     {
         memset(p_ftl_dev, 0, sizeof(T_GATTC_FTL_DEV));
-        return gattc_tbl_storage_save_header(p_ftl_header);
+        gattc_tbl_storage_mark_dev(p_ftl_dev);
+        return gattc_tbl_storage_save_header();
     }
     return false;
 }
 
-bool gattc_tbl_storage_remove(uint8_t *identity_addr, uint8_t identity_addr_type)
+T_GATTC_FTL_HEADER *gattc_tbl_storage_get_header(bool is_new)
 {
-    T_GATTC_FTL_HEADER ftl_header;
-    T_GATTC_FTL_DEV *p_ftl_dev = NULL;
-    if (ftl_load_from_module(BT_EXT_FTL_PARTITION_NAME, &ftl_header, 0, sizeof(ftl_header)) != 0)
-    {
-        goto failed;
-    }
-    p_ftl_dev = gattc_tbl_storage_find_dev(&ftl_header.ftl_cb, identity_addr, identity_addr_type);
-    if (p_ftl_dev)
+    uint8_t error_idx = 0;
+    int32_t ret;
+    T_GATTC_FTL_HEADER *p_ftl_header = &gattc_ftl_header;
+
+    if (gattc_ftl_header_loaded == false)
     {
-        if (gattc_tbl_storage_remove_dev(&ftl_header, p_ftl_dev) == false)
+        gattc_ftl_header_dirty = 0;
+        ret = ftl_load_from_module(BT_EXT_FTL_PARTITION_NAME, p_ftl_header, 0,
+                                   sizeof(T_GATTC_FTL_HEADER));
+        if (ret == 0)
         {
-            goto failed;
+            if (p_ftl_header->ftl_cb.sync_word != GATTC_FTL_SYNC_WORD ||
+                p_ftl_header->ftl_cb.version != GATTC_FTL_MGR_VERSION)
+            {
+                if (p_ftl_header->ftl_cb.sync_word != 0 &&
+                    p_ftl_header->ftl_cb.version != 0)
+                {
+                    gattc_tbl_storage_clear();
+                }
+                memset(p_ftl_header, 0, sizeof(T_GATTC_FTL_HEADER));
+            }
         }
+        else
+        {
+            memset(p_ftl_header, 0, sizeof(T_GATTC_FTL_HEADER));
+        }
+        gattc_ftl_header_loaded = true;
     }
-    else
+
+    if (p_ftl_header->ftl_cb.sync_word != GATTC_FTL_SYNC_WORD && is_new == false)
     {
+        error_idx = 2;
         goto failed;
     }
-    APP_PRINT_INFO2("gattc_tbl_storage_remove: identity_addr_type %d, identity_addr %s",
-                    identity_addr_type,
-                    TRACE_BDADDR(identity_addr));
-    return true;
+    return p_ftl_header;
 failed:
-    return false;
+    APP_PRINT_ERROR2("gattc_tbl_storage_get_header:failed, is_new %d, error_idx %d", is_new,
+                     error_idx);
+    return NULL;
 }
 
-T_GATTC_FTL_HEADER *gattc_tbl_storage_get_header(bool is_new)
+bool gattc_tbl_storage_remove(uint8_t *identity_addr, uint8_t identity_addr_type)
 {
-    uint8_t error_idx = 0;
-    int32_t ret;
-    T_GATTC_FTL_HEADER *p_ftl_header = calloc(1, sizeof(T_GATTC_FTL_HEADER));
+    T_GATTC_FTL_HEADER *p_ftl_header = NULL;
+    T_GATTC_FTL_DEV *p_ftl_dev = NULL;
 
+    p_ftl_header = gattc_tbl_storage_get_header(false);
     if (p_ftl_header == NULL)
     {
-        error_idx = 1;
         goto failed;
     }
-
-    ret = ftl_load_from_module(BT_EXT_FTL_PARTITION_NAME, p_ftl_header, 0,
-                               sizeof(T_GATTC_FTL_HEADER));
-    if (ret == 0)
+    p_ftl_dev = gattc_tbl_storage_find_dev(&p_ftl_header->ftl_cb, identity_addr, identity_addr_type);
+    if (p_ftl_dev)
     {
-        if (p_ftl_header->ftl_cb.sync_word != GATTC_FTL_SYNC_WORD ||
-            p_ftl_header->ftl_cb.version != GATTC_FTL_MGR_VERSION)
+        if (gattc_tbl_storage_remove_dev(p_ftl_header, p_ftl_dev) == false)
         {
-            if (p_ftl_header->ftl_cb.sync_word != 0 &&
-                p_ftl_header->ftl_cb.version != 0)
-            {
-                gattc_tbl_storage_clear();
-            }
-            if (is_new)
-            {
-                p_ftl_header->ftl_cb.sync_word = 0;
-            }
-            else
-            {
-                error_idx = 2;
-                goto failed;
-            }
+            goto failed;
         }
     }
     else
     {
-        if (is_new)
-        {
-            p_ftl_header->ftl_cb.sync_word = 0;
-        }
-        else
-        {
-            error_idx = 3;
-            goto failed;
-        }
+        goto failed;
     }
-    return p_ftl_header;
+    APP_PRINT_INFO2("gattc_tbl_storage_remove: identity_addr_type %d, identity_addr %s",
+                    identity_addr_type,
+                    TRACE_BDADDR(identity_addr));
+    return true;
 failed:
-    if (p_ftl_header)
-    {
-        free(p_ftl_header);
-    }
-    APP_PRINT_ERROR2("gattc_tbl_storage_get_header:failed, is_new %d, error_idx %d", is_new,
-                     error_idx);
-    return NULL;
+    return false;
 }
 
 bool gattc_tbl_storage_get_dev(T_GATT_STORAGE_SVC_TBL_GET_IND *p_get_ind)
@@ -615,6 +764,9 @@ bool gattc_tbl_storage_get_dev(T_GATT_STORAGE_SVC_TBL_GET_IND *p_get_ind)
     uint16_t crc16 = 0;
     uint8_t  identity_addr[6];
     uint8_t  identity_addr_type;
+#if GATTC_TBL_HOT_DEV_NUM
+    T_GATTC_TBL_HOT_DEV *p_hot_dev = NULL;
+#endif
     if (gattc_tbl_get_identity_addr(p_get_ind->addr, p_get_ind->remote_bd_type,
                                     identity_addr, &identity_addr_type) == false)
     {
@@ -635,13 +787,31 @@ bool gattc_tbl_storage_get_dev(T_GATT_STORAGE_SVC_TBL_GET_IND *p_get_ind)
         goto failed;
     }
 
-    p_temp_buf = gattc_tbl_read_data(p_ftl_dev, p_ftl_dev->svc_block_idx, p_ftl_dev->svc_total_len);
-
+    /* the GATT client takes over the buffer */
+    p_temp_buf = calloc(1, p_ftl_dev->svc_total_len);
     if (p_temp_buf == NULL)
     {
         error_idx = 5;
         goto failed;
     }
+
+#if GATTC_TBL_HOT_DEV_NUM
+    p_hot_dev = gattc_tbl_hot_find(identity_addr, identity_addr_type);
+    if (p_hot_dev && p_hot_dev->svc_crc16 == p_ftl_dev->svc_crc16 &&
+        p_hot_dev->svc_total_len == p_ftl_dev->svc_total_len)
+    {
+        memcpy(p_temp_buf, p_hot_dev->svc_data, p_ftl_dev->svc_total_len);
+        p_hot_dev->last_use = ++gattc_tbl_hot_clock;
+        goto success;
+    }
+#endif
+
+    if (gattc_tbl_read_data(p_ftl_dev, p_ftl_dev->svc_block_idx, p_temp_buf,
+                            p_ftl_dev->svc_total_len) == false)
+    {
+        error_idx = 6;
+        goto failed;
+    }
     crc16 = btxfcs(crc16, p_temp_buf, p_ftl_dev->svc_total_len);
 
     if (p_ftl_dev->svc_crc16 != crc16)
@@ -650,12 +820,13 @@ bool gattc_tbl_storage_get_dev(T_GATT_STORAGE_SVC_TBL_GET_IND *p_get_ind)
         error_idx = 9;
         goto failed;
     }
+#if GATTC_TBL_HOT_DEV_NUM
+    gattc_tbl_hot_save(identity_addr, identity_addr_type, p_temp_buf, p_ftl_dev->svc_total_len,
+                       crc16);
+success:
+#endif
     p_get_ind->data_len = p_ftl_dev->svc_total_len;
     p_get_ind->p_data = p_temp_buf;
-    if (p_ftl_header != NULL)
-    {
-        free(p_ftl_header);
-    }
     return true;
 failed:
     APP_PRINT_ERROR1("gattc_tbl_storage_get_dev:failed, error_idx %d", error_idx);
@@ -663,10 +834,6 @@ failed:
     {
         free(p_temp_buf);
     }
-    if (p_ftl_header != NULL)
-    {
-        free(p_ftl_header);
-    }
     return false;
 }
 
@@ -701,6 +868,7 @@ bool gattc_tbl_storage_add_dev(T_GATT_STORAGE_SVC_TBL_SET_IND *p_set_ind)
         p_ftl_header->ftl_cb.sync_word = GATTC_FTL_SYNC_WORD;
         p_ftl_header->ftl_cb.version = GATTC_FTL_MGR_VERSION;
         gattc_tbl_bitmap_init(&p_ftl_header->ftl_cb);
+        gattc_tbl_storage_mark_header(p_ftl_header->data, sizeof(T_GATTC_FTL_HEADER));
     }
     else
     {
@@ -710,7 +878,6 @@ bool gattc_tbl_storage_add_dev(T_GATT_STORAGE_SVC_TBL_SET_IND *p_set_ind)
             if (p_ftl_dev->svc_crc16 == crc16 && p_ftl_dev->svc_total_len == p_set_ind->data_len)
             {
                 APP_PRINT_INFO0("gattc_tbl_storage_add_dev:already exist");
-                free(p_ftl_header);
                 return true;
             }
             else
@@ -719,6 +886,7 @@ bool gattc_tbl_storage_add_dev(T_GATT_STORAGE_SVC_TBL_SET_IND *p_set_ind)
                 if (gattc_tbl_bitmap_free(&p_ftl_header->ftl_cb, p_ftl_dev))
                 {
                     memset(p_ftl_dev, 0, sizeof(T_GATTC_FTL_DEV));
+                    gattc_tbl_storage_mark_dev(p_ftl_dev);
                 }
                 else
                 {
@@ -759,30 +927,37 @@ bool gattc_tbl_storage_add_dev(T_GATT_STORAGE_SVC_TBL_SET_IND *p_set_ind)
 
     if (gattc_tbl_bitmap_assign(&p_ftl_header->ftl_cb, p_ftl_dev, block_num) == false)
     {
+        memset(p_ftl_dev, 0, sizeof(T_GATTC_FTL_DEV));
         error_idx = 4;
         goto failed;
     }
+    gattc_tbl_storage_mark_dev(p_ftl_dev);
     if (gattc_tbl_write_data(p_ftl_dev, p_ftl_dev->svc_block_idx, p_set_ind->p_data,
                              p_set_ind->data_len) == false)
     {
         error_idx = 7;
         goto failed;
     }
-    if (gattc_tbl_storage_save_header(p_ftl_header) == false)
+    if (gattc_tbl_storage_save_header() == false)
     {
         error_idx = 8;
         goto failed;
     }
-    if (p_ftl_header != NULL)
-    {
-        free(p_ftl_header);
-    }
+#if GATTC_TBL_HOT_DEV_NUM
+    gattc_tbl_hot_save(identity_addr, identity_addr_type, p_set_ind->p_data, p_set_ind->data_len,
+                       crc16);
+#endif
     return true;
 failed:
     APP_PRINT_ERROR1("gattc_tbl_storage_add_dev:failed, error_idx %d", error_idx);
-    if (p_ftl_header != NULL)
+#if GATTC_TBL_HOT_DEV_NUM
+    gattc_tbl_hot_remove(identity_addr, identity_addr_type);
+#endif
+    /* drop the changes not saved yet */
+    if (gattc_ftl_header_dirty != 0)
     {
-        free(p_ftl_header);
+        gattc_ftl_header_loaded = false;
+        gattc_ftl_header_dirty = 0;
     }
     return false;
 }
@@ -819,7 +994,13 @@ bool gattc_tbl_storage_get_cccd(T_GATT_STORAGE_SVC_CCCD_GET_IND *p_get_ind)
     }
     if (p_ftl_dev->cccd_data_len && p_ftl_dev->cccd_crc16 != 0)
     {
-        p_cccd = gattc_tbl_read_data(p_ftl_dev, 0, p_ftl_dev->cccd_data_len);
+        /* the GATT client takes over the buffer */
+        p_cccd = calloc(1, p_ftl_dev->cccd_data_len);
+        if (p_cccd && gattc_tbl_read_data(p_ftl_dev, 0, p_cccd, p_ftl_dev->cccd_data_len) == false)
+        {
+            free(p_cccd);
+            p_cccd = NULL;
+        }
     }
     if (p_cccd)
     {
@@ -837,11 +1018,6 @@ bool gattc_tbl_storage_get_cccd(T_GATT_STORAGE_SVC_CCCD_GET_IND *p_get_ind)
         p_get_ind->data_len = 0;
         p_get_ind->p_data = NULL;
     }
-
-    if (p_ftl_header != NULL)
-    {
-        free(p_ftl_header);
-    }
     return true;
 failed:
     APP_PRINT_ERROR1("gattc_tbl_storage_get_cccd:failed, error_idx %d", error_idx);
@@ -849,10 +1025,6 @@ failed:
     {
         free(p_cccd);
     }
-    if (p_ftl_header != NULL)
-    {
-        free(p_ftl_header);
-    }
     return false;
 }
 
@@ -892,6 +1064,10 @@ bool gattc_tbl_storage_set_cccd(T_GATT_STORAGE_SVC_CCCD_SET_IND *p_set_ind)
         goto failed;
     }
     crc16 = btxfcs(crc16, p_set_ind->p_data, p_set_ind->data_len);
+    if (p_ftl_dev->cccd_data_len == p_set_ind->data_len && p_ftl_dev->cccd_crc16 == crc16)
+    {
+        return true;
+    }
     if (gattc_tbl_write_data(p_ftl_dev, 0, p_set_ind->p_data, p_set_ind->data_len) == false)
     {
         error_idx = 5;
@@ -899,22 +1075,15 @@ bool gattc_tbl_storage_set_cccd(T_GATT_STORAGE_SVC_CCCD_SET_IND *p_set_ind)
     }
     p_ftl_dev->cccd_data_len = p_set_ind->data_len;
     p_ftl_dev->cccd_crc16 = crc16;
-    if (gattc_tbl_storage_save_header(p_ftl_header) == false)
+    gattc_tbl_storage_mark_header(&p_ftl_dev->cccd_data_len, 2 * sizeof(uint16_t));
+    if (gattc_tbl_storage_save_header() == false)
     {
         error_idx = 8;
         goto failed;
     }
-    if (p_ftl_header != NULL)
-    {
-        free(p_ftl_header);
-    }
     return true;
 failed:
     APP_PRINT_ERROR1("gattc_tbl_storage_set_cccd:failed, error_idx %d", error_idx);
-    if (p_ftl_header != NULL)
-    {
-        free(p_ftl_header);
-    }
     return false;
 }
 
@@ -948,18 +1117,9 @@ bool gattc_tbl_storage_get_gatt_data(T_GATT_STORAGE_SVC_GATT_GET_IND *p_get_ind)
         goto failed;
     }
     memcpy(p_get_ind->p_gatt_data, &p_ftl_dev->gatt_data, sizeof(T_GATT_SERVICE_DATA));
-
-    if (p_ftl_header != NULL)
-    {
-        free(p_ftl_header);
-    }
     return true;
 failed:
     APP_PRINT_ERROR1("gattc_tbl_storage_get_gatt_data:failed, error_idx %d", error_idx);
-    if (p_ftl_header != NULL)
-    {
-        free(p_ftl_header);
-    }
     return false;
 }
 
@@ -995,30 +1155,16 @@ bool gattc_tbl_storage_set_gatt_data(T_GATT_STORAGE_SVC_GATT_SET_IND *p_set_ind)
     if (memcmp(p_set_ind->p_gatt_data, &p_ftl_dev->gatt_data, sizeof(T_GATT_SERVICE_DATA)) != 0)
     {
         memcpy(&p_ftl_dev->gatt_data, p_set_ind->p_gatt_data, sizeof(T_GATT_SERVICE_DATA));
-        if (gattc_tbl_storage_save_header(p_ftl_header) == false)
+        gattc_tbl_storage_mark_header(&p_ftl_dev->gatt_data, sizeof(T_GATT_SERVICE_DATA));
+        if (gattc_tbl_storage_save_header() == false)
         {
             error_idx = 8;
             goto failed;
         }
     }
-
-    if (gattc_tbl_storage_save_header(p_ftl_header) == false)
-    {
-        error_idx = 8;
-        goto failed;
-    }
-
-    if (p_ftl_header != NULL)
-    {
-        free(p_ftl_header);
-    }
     return true;
 failed:
     APP_PRINT_ERROR1("gattc_tbl_storage_set_gatt_data:failed, error_idx %d", error_idx);
-    if (p_ftl_header != NULL)
-    {
-        free(p_ftl_header);
-    }
     return false;
 }
 
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 #include <data_uart.h>
 #include <os_msg.h>
 #include <trace.h>
@@ -11,10 +12,35 @@
 #include <rtl_uart.h>
 #include <rtl_rcc.h>
 #include <rtl_pinmux.h>
+#include <rtl_gdma.h>
+
+/* RX ring fed by GDMA, in two blocks so the ring raises an interrupt per half */
+#ifndef DATA_UART_RX_BUF_SIZE
+#define DATA_UART_RX_BUF_SIZE               256
+#endif
+#ifndef DATA_UART_RX_GDMA_CHANNEL_NUM
+#define DATA_UART_RX_GDMA_CHANNEL_NUM       GDMA_CH_NUM9
+#define DATA_UART_RX_GDMA_CHANNEL           GDMA_Channel9
+#define DATA_UART_RX_GDMA_CHANNEL_IRQN      GDMA0_Channel9_IRQn
+#define DATA_UART_RX_GDMA_HANDLER           GDMA0_Channel9_Handler
+#endif
+
+#if (DATA_UART_RX_BUF_SIZE & (DATA_UART_RX_BUF_SIZE - 1)) != 0
+#error DATA_UART_RX_BUF_SIZE must be a power of 2
+#endif
+
+#define DATA_UART_RX_BLOCK_SIZE             (DATA_UART_RX_BUF_SIZE / 2)
 
 static void *h_event_q;
 static void *h_io_q;
 
+static uint8_t rx_buf[DATA_UART_RX_BUF_SIZE];
+static GDMA_LLIDef rx_lli[2];
+static volatile uint32_t rx_head;       /* Bytes received, updated by the interrupts only */
+static uint32_t rx_tail;                /* Bytes read, updated by data_uart_read only */
+static uint32_t rx_dropped;
+static volatile bool rx_notified;       /* A message is queued which data_uart_read has not drained */
+
 int data_uart_send_char(int ch)
 {
     UART_SendData(UART4, (uint8_t *)&ch, 1);
@@ -24,6 +50,14 @@ int data_uart_send_char(int ch)
     return ch;
 }
 
+void data_uart_send(const uint8_t *p_data, uint16_t len)
+{
+    while (len--)
+    {
+        data_uart_send_char(*p_data++);
+    }
+}
+
 int data_uart_vsprintf(char *buf, const char *fmt, const int *dp)
 {
     char *p;
@@ -161,66 +195,212 @@ void data_uart_print(char *fmt, ...)
 }
 
 /****************************************************************************/
-/* UART4 interrupt                                                           */
+/* RX ring                                                                  */
 /****************************************************************************/
-void UART4_Handler(void)
+/* Called from the UART and GDMA interrupts, which share a priority. They run at least
+ * once per block, so the DMA position never moves a whole ring between two calls.
+ */
+static void data_uart_rx_update(void)
+{
+    uint32_t pos = (GDMA_GetDstTransferAddress(DATA_UART_RX_GDMA_CHANNEL) - (uint32_t)rx_buf) &
+                   (DATA_UART_RX_BUF_SIZE - 1);
+
+    rx_head += (pos - rx_head) & (DATA_UART_RX_BUF_SIZE - 1);
+}
+
+/* One message per burst, the next one once data_uart_read has drained the ring */
+static void data_uart_rx_notify(void)
 {
-    //DBG_DIRECT("UART4_Handler");
-    uint8_t rx_char;
     T_IO_MSG io_driver_msg_send;
-    uint8_t event  = EVENT_IO_TO_APP;
+    uint8_t event = EVENT_IO_TO_APP;
+
+    if (rx_notified || rx_head == rx_tail)
+    {
+        return;
+    }
+
     io_driver_msg_send.type = IO_MSG_TYPE_UART;
+    io_driver_msg_send.subtype = IO_MSG_UART_RX;
+    io_driver_msg_send.u.param = 0;
+
+    if (os_msg_send(h_io_q, &io_driver_msg_send, 0) == false)
+    {
+    }
+    else if (os_msg_send(h_event_q, &event, 0) == false)
+    {
+    }
+    else
+    {
+        rx_notified = true;
+    }
+}
+
+/**
+ * @brief  Read the bytes received by the Data UART.
+ *
+ * Call it on IO_MSG_TYPE_UART until it returns 0, the next message is sent only after that.
+ * @param[out] p_buf   Buffer for the received bytes.
+ * @param[in]  len     Size of p_buf.
+ * @return Number of bytes copied to p_buf.
+ */
+uint16_t data_uart_read(uint8_t *p_buf, uint16_t len)
+{
+    uint32_t head = rx_head;
+    uint32_t avail;
+    uint32_t offset;
+    uint32_t chunk;
+
+    if (head == rx_tail)
+    {
+        rx_notified = false;
+        head = rx_head;
+        if (head == rx_tail)
+        {
+            return 0;
+        }
+        rx_notified = true;
+    }
+
+    avail = head - rx_tail;
+    if (avail > DATA_UART_RX_BUF_SIZE)
+    {
+        /* the DMA has lapped the reader, the oldest bytes are gone */
+        rx_dropped += avail - DATA_UART_RX_BUF_SIZE;
+        rx_tail = head - DATA_UART_RX_BUF_SIZE;
+        avail = DATA_UART_RX_BUF_SIZE;
+    }
+    if (len > avail)
+    {
+        len = avail;
+    }
+
+    offset = rx_tail & (DATA_UART_RX_BUF_SIZE - 1);
+    chunk = DATA_UART_RX_BUF_SIZE - offset;
+    if (chunk > len)
+    {
+        chunk = len;
+    }
+    memcpy(p_buf, &rx_buf[offset], chunk);
+    memcpy(p_buf + chunk, rx_buf, len - chunk);
+    rx_tail += len;
+
+    return len;
+}
 
+/**
+ * @brief  Number of received bytes overwritten before data_uart_read took them.
+ * @return Dropped bytes since data_uart_init.
+ */
+uint32_t data_uart_rx_dropped(void)
+{
+    return rx_dropped;
+}
+
+/****************************************************************************/
+/* UART4 interrupt                                                           */
+/****************************************************************************/
+void UART4_Handler(void)
+{
+    //DBG_DIRECT("UART4_Handler");
     uint32_t interrupt_id = 0;
     /* read interrupt id */
     interrupt_id = UART_GetIID(UART4);
 
-    /* disable interrupt */
-    UART_INTConfig(UART4, UART_INT_RD_AVA | UART_INT_LINE_STS, DISABLE);
+    /* the line went idle, the burst is complete */
+    if (UART_GetFlagState(UART4, UART_FLAG_RX_IDLE) == SET)
+    {
+        UART_INTConfig(UART4, UART_INT_RX_IDLE, DISABLE);
+        data_uart_rx_update();
+        data_uart_rx_notify();
+        UART_INTConfig(UART4, UART_INT_RX_IDLE, ENABLE);
+    }
 
-    switch (interrupt_id)
+    /* receive line status interrupt */
+    if ((interrupt_id & 0x0E) == UART_INT_ID_LINE_STATUS)
     {
-    /* tx fifo empty, not enable */
-    case UART_INT_ID_TX_EMPTY:
-        break;
+        /* reading the line status register clears the interrupt */
+        DBG_DIRECT("Line status error! 0x%x", UART4->UART_LSR);
+    }
+
+    return;
+}
 
-    /* rx data valiable */
-    case UART_INT_ID_RX_LEVEL_REACH:
-        UART_ReceiveData(UART4, &rx_char, 1);
-        io_driver_msg_send.subtype = rx_char;
+/****************************************************************************/
+/* RX GDMA interrupt                                                        */
+/****************************************************************************/
+void DATA_UART_RX_GDMA_HANDLER(void)
+{
+    /* one half of the ring is full */
+    GDMA_ClearINTPendingBit(DATA_UART_RX_GDMA_CHANNEL_NUM, GDMA_INT_Block);
+    data_uart_rx_update();
+    data_uart_rx_notify();
+}
 
-        if (os_msg_send(h_io_q, &io_driver_msg_send, 0) == false)
-        {
-        }
-        else if (os_msg_send(h_event_q, &event, 0) == false)
-        {
-        }
-        break;
+static void data_uart_rx_dma_init(void)
+{
+    GDMA_InitTypeDef GDMA_InitStruct;
+    NVIC_InitTypeDef nvic_init_struct;
+    uint8_t i;
 
-    case UART_INT_ID_RX_TMEOUT:
-        break;
+    rx_head = 0;
+    rx_tail = 0;
+    rx_dropped = 0;
+    rx_notified = false;
 
-    /* receive line status interrupt */
-    case UART_INT_ID_LINE_STATUS:
-        {
-            DBG_DIRECT("Line status error!!!!\n");
-        }
-        break;
+    RCC_PeriphClockCmd(APBPeriph_GDMA, APBPeriph_GDMA_CLOCK, ENABLE);
+
+    GDMA_StructInit(&GDMA_InitStruct);
+    GDMA_InitStruct.GDMA_ChannelNum          = DATA_UART_RX_GDMA_CHANNEL_NUM;
+    GDMA_InitStruct.GDMA_DIR                 = GDMA_DIR_PeripheralToMemory;
+    GDMA_InitStruct.GDMA_BufferSize          = DATA_UART_RX_BLOCK_SIZE;
+    GDMA_InitStruct.GDMA_SourceInc           = DMA_SourceInc_Fix;
+    GDMA_InitStruct.GDMA_DestinationInc      = DMA_DestinationInc_Inc;
+    GDMA_InitStruct.GDMA_SourceDataSize      = GDMA_DataSize_Byte;
+    GDMA_InitStruct.GDMA_DestinationDataSize = GDMA_DataSize_Byte;
+    GDMA_InitStruct.GDMA_SourceMsize         = GDMA_Msize_1;
+    GDMA_InitStruct.GDMA_DestinationMsize    = GDMA_Msize_1;
+    GDMA_InitStruct.GDMA_SourceAddr          = (uint32_t)(&(UART4->UART_RBR_THR));
+    GDMA_InitStruct.GDMA_DestinationAddr     = (uint32_t)rx_buf;
+    GDMA_InitStruct.GDMA_SourceHandshake     = GDMA_Handshake_UART4_RX;
 
-    default:
-        break;
+    /* the two blocks link to each other, so the transfer never ends */
+    GDMA_InitStruct.GDMA_Multi_Block_En      = ENABLE;
+    GDMA_InitStruct.GDMA_Multi_Block_Mode    = LLI_TRANSFER;
+    GDMA_InitStruct.GDMA_Multi_Block_Struct  = (uint32_t)rx_lli;
+    for (i = 0; i < 2; i++)
+    {
+        rx_lli[i].SAR = GDMA_InitStruct.GDMA_SourceAddr;
+        rx_lli[i].DAR = (uint32_t)&rx_buf[i * DATA_UART_RX_BLOCK_SIZE];
+        rx_lli[i].LLP = (uint32_t)&rx_lli[(i + 1) % 2];
+        rx_lli[i].CTL_LOW = BIT(0)
+                            | (GDMA_InitStruct.GDMA_DestinationDataSize << 1)
+                            | (GDMA_InitStruct.GDMA_SourceDataSize << 4)
+                            | (GDMA_InitStruct.GDMA_DestinationInc << 7)
+                            | (GDMA_InitStruct.GDMA_SourceInc << 9)
+                            | (GDMA_InitStruct.GDMA_DestinationMsize << 11)
+                            | (GDMA_InitStruct.GDMA_SourceMsize << 14)
+                            | (GDMA_InitStruct.GDMA_DIR << 20)
+                            | (GDMA_InitStruct.GDMA_Multi_Block_Mode & LLP_SELECTED_BIT);
+        rx_lli[i].CTL_HIGH = DATA_UART_RX_BLOCK_SIZE;
     }
+    GDMA_Init(DATA_UART_RX_GDMA_CHANNEL, &GDMA_InitStruct);
+    GDMA_INTConfig(DATA_UART_RX_GDMA_CHANNEL_NUM, GDMA_INT_Block, ENABLE);
 
-    /* enable interrupt again */
-    UART_INTConfig(UART4, UART_INT_RD_AVA, ENABLE);
+    /* same priority as UART4, so the two never preempt each other in data_uart_rx_update */
+    nvic_init_struct.NVIC_IRQChannel         = DATA_UART_RX_GDMA_CHANNEL_IRQN;
+    nvic_init_struct.NVIC_IRQChannelCmd      = ENABLE;
+    nvic_init_struct.NVIC_IRQChannelPriority = 5;
+    NVIC_Init(&nvic_init_struct);
 
-    return;
+    GDMA_Cmd(DATA_UART_RX_GDMA_CHANNEL_NUM, ENABLE);
 }
 
 /**
  * @brief  Initializes the Data UART4.
  *
- * When data uart receives data, data uart will send an event IO_MSG_TYPE_UART to evt_queue_handle and send the data to io_queue_handle.
+ * RX goes through a GDMA ring. When a burst of data ends or half of the ring is full, data uart sends
+ * one IO_MSG_TYPE_UART to io_queue_handle and an event to evt_queue_handle, the APP then reads the ring
+ * with data_uart_read until it returns 0.
  * @param[in] event_queue_handle   Event queue handle which is created by APP.
  * @param[in] io_queue_handle      IO message queue handle which is created by APP.
  * @return void
@@ -242,14 +422,17 @@ void UART4_Handler(void)
     void app_handle_io_msg(T_IO_MSG io_msg)
     {
         uint16_t msg_type = io_msg.type;
-        uint8_t rx_char;
+        uint8_t rx_buf[32];
+        uint16_t rx_len;
 
         switch (msg_type)
         {
         case IO_MSG_TYPE_UART:
-            // We handle user command informations from Data UART4 in this branch.
-            rx_char = (uint8_t)io_msg.subtype;
-            user_cmd_collect(&user_cmd_if, &rx_char, sizeof(rx_char), user_cmd_table);
+            // We handle user command informations from Data UART in this branch.
+            while ((rx_len = data_uart_read(rx_buf, sizeof(rx_buf))) != 0)
+            {
+                user_cmd_collect(&user_cmd_if, rx_buf, rx_len, user_cmd_table);
+            }
             break;
         default:
             break;
@@ -276,12 +459,17 @@ void data_uart_init(void *event_queue_handle, void *io_queue_handle)
     Pad_Config(DATA_UART_RX_PIN, PAD_PINMUX_MODE, PAD_IS_PWRON, PAD_PULL_UP, PAD_OUT_DISABLE,
                PAD_OUT_LOW);
 
-    /* uart init */
+    /* uart init, RX through GDMA */
     UART_InitTypeDef uartInitStruct;
     UART_StructInit(&uartInitStruct);
-    uartInitStruct.rxTriggerLevel = 1;
+    uartInitStruct.UART_IdleTime = UART_RX_IDLE_2BYTE;
+    uartInitStruct.UART_DmaEn = UART_DMA_ENABLE;
+    uartInitStruct.UART_RxDmaEn = ENABLE;
+    uartInitStruct.UART_RxWaterLevel = 1;
     UART_Init(UART4, &uartInitStruct);
-    UART_INTConfig(UART4, UART_INT_RD_AVA, ENABLE);
+
+    data_uart_rx_dma_init();
+    UART_INTConfig(UART4, UART_INT_RX_IDLE | UART_INT_LINE_STS, ENABLE);
 
     /*  Enable UART4 IRQ  */
     NVIC_InitTypeDef nvic_init_struct;
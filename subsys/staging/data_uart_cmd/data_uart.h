@@ -17,6 +17,8 @@
 extern "C" {
 #endif      /* __cplusplus */
 
+#include <stdint.h>
+
 /** @defgroup DATA_UART_CMD Data Uart Command Module
   * @brief Application uses this module to receive user command and send infomation through data uart.
   * @{
@@ -33,7 +35,9 @@ extern "C" {
 /**
  * @brief  Initializes the Data UART.
  *
- * When data uart receives data, data uart will send an event IO_MSG_TYPE_UART to evt_queue_handle and send the data to io_queue_handle.
+ * RX goes through a GDMA ring. When a burst of data ends or half of the ring is full, data uart sends
+ * one IO_MSG_TYPE_UART to io_queue_handle and an event to evt_queue_handle, the APP then reads the ring
+ * with data_uart_read until it returns 0.
  * @param[in] event_queue_handle   Event queue handle which is created by APP.
  * @param[in] io_queue_handle      IO message queue handle which is created by APP.
  * @return void
@@ -55,14 +59,17 @@ extern "C" {
     void app_handle_io_msg(T_IO_MSG io_msg)
     {
         uint16_t msg_type = io_msg.type;
-        uint8_t rx_char;
+        uint8_t rx_buf[32];
+        uint16_t rx_len;
 
         switch (msg_type)
         {
         case IO_MSG_TYPE_UART:
             // We handle user command informations from Data UART in this branch.
-            rx_char = (uint8_t)io_msg.subtype;
-            user_cmd_collect(&user_cmd_if, &rx_char, sizeof(rx_char), user_cmd_table);
+            while ((rx_len = data_uart_read(rx_buf, sizeof(rx_buf))) != 0)
+            {
+                user_cmd_collect(&user_cmd_if, rx_buf, rx_len, user_cmd_table);
+            }
             break;
         default:
             break;
@@ -72,6 +79,30 @@ extern "C" {
  */
 void data_uart_init(void *event_queue_handle, void *io_queue_handle);
 
+/**
+ * @brief  Read the bytes received by the Data UART.
+ *
+ * Call it on IO_MSG_TYPE_UART until it returns 0, the next IO_MSG_TYPE_UART is sent only after that.
+ * @param[out] p_buf   Buffer for the received bytes.
+ * @param[in]  len     Size of p_buf.
+ * @return Number of bytes copied to p_buf.
+ */
+uint16_t data_uart_read(uint8_t *p_buf, uint16_t len);
+
+/**
+ * @brief  Number of received bytes overwritten before data_uart_read took them.
+ * @return Dropped bytes since data_uart_init.
+ */
+uint32_t data_uart_rx_dropped(void);
+
+/**
+ * @brief  Send raw bytes through data uart, e.g. a binary frame.
+ * @param[in] p_data   Bytes to send.
+ * @param[in] len      Number of bytes.
+ * @return void
+ */
+void data_uart_send(const uint8_t *p_data, uint16_t len);
+
 /**
  * @brief  Print the trace information through data uart.
  * @param[in] fmt   Print parameters.
@@ -13,10 +13,16 @@
 #include <string.h>
 #include <data_uart.h>
 #include <user_cmd_parse.h>
+#include <crc16btx.h>
+#include <os_sched.h>
 #if F_BT_DLPS_EN
 #include <data_uart_dlps.h>
 #endif
 
+/* FNV-1a */
+#define USER_CMD_HASH_INIT      0x811C9DC5
+#define USER_CMD_HASH_PRIME     0x01000193
+
 /**
  * @brief   Check if a character is a white space.
  *
@@ -64,6 +70,101 @@ static char *user_cmd_find_end_of_word(char *buffer)
     return p;
 }
 
+/**
+ * @brief  Hash of a command name.
+ *
+ * @param p_cmd    Command name.
+ * @return hash value.
+ */
+static uint32_t user_cmd_hash(const char *p_cmd)
+{
+    uint32_t hash = USER_CMD_HASH_INIT;
+
+    while (*p_cmd != '\0')
+    {
+        hash = (hash ^ (uint8_t)*p_cmd++) * USER_CMD_HASH_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief  Build the hash index of a command table.
+ *
+ * Linear probing keeps the commands of a probe chain in table order, so a duplicated
+ * command resolves to its first entry as with a linear search.
+ * @param p_user_cmd_if     Command interface.
+ * @param p_cmd_table       Command table.
+ * @return none.
+ */
+static void user_cmd_index_build(T_USER_CMD_IF *p_user_cmd_if,
+                                 const T_USER_CMD_TABLE_ENTRY *p_cmd_table)
+{
+    uint16_t count = 0;
+
+    while (p_cmd_table[count].p_cmd != NULL)
+    {
+        count++;
+    }
+
+    p_user_cmd_if->p_index_table = p_cmd_table;
+    p_user_cmd_if->cmd_count = count;
+    memset(p_user_cmd_if->cmd_index, 0, sizeof(p_user_cmd_if->cmd_index));
+    if (count > USER_CMD_HASH_MAX_COMMANDS)
+    {
+        return;
+    }
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint32_t slot = user_cmd_hash(p_cmd_table[i].p_cmd) & (USER_CMD_HASH_SIZE - 1);
+
+        while (p_user_cmd_if->cmd_index[slot] != 0)
+        {
+            slot = (slot + 1) & (USER_CMD_HASH_SIZE - 1);
+        }
+        p_user_cmd_if->cmd_index[slot] = i + 1;
+    }
+}
+
+/**
+ * @brief  Find a command in the table.
+ *
+ * @param p_user_cmd_if     Command interface, its index is built for p_cmd_table.
+ * @param p_cmd_table       Command table.
+ * @param p_cmd             Command name.
+ * @param hash              Hash of the command name.
+ * @return  Command entry, NULL if not found.
+ */
+static const T_USER_CMD_TABLE_ENTRY *user_cmd_find(T_USER_CMD_IF *p_user_cmd_if,
+                                                   const T_USER_CMD_TABLE_ENTRY *p_cmd_table,
+                                                   const char *p_cmd, uint32_t hash)
+{
+    uint32_t slot = hash & (USER_CMD_HASH_SIZE - 1);
+    uint8_t idx;
+
+    if (p_user_cmd_if->cmd_count > USER_CMD_HASH_MAX_COMMANDS)
+    {
+        for (uint16_t i = 0; i < p_user_cmd_if->cmd_count; i++)
+        {
+            if (strcmp(p_cmd_table[i].p_cmd, p_cmd) == 0)
+            {
+                return &p_cmd_table[i];
+            }
+        }
+        return NULL;
+    }
+
+    while ((idx = p_user_cmd_if->cmd_index[slot]) != 0)
+    {
+        if (strcmp(p_cmd_table[idx - 1].p_cmd, p_cmd) == 0)
+        {
+            return &p_cmd_table[idx - 1];
+        }
+        slot = (slot + 1) & (USER_CMD_HASH_SIZE - 1);
+    }
+    return NULL;
+}
+
 /**
  * @brief  Read ASCII string and convert to uint32_t.
  *
@@ -223,123 +324,219 @@ static T_USER_CMD_PARSE_RESULT user_cmd_list(const T_USER_CMD_TABLE_ENTRY *p_cmd
 /**
  * @brief  Execute command.
  *
+ * @param p_user_cmd_if     Command interface.
  * @param p_parse_value     Command parse value.
+ * @param hash              Hash of the command name.
  * @param p_cmd_table       Command table, include user self-definition command function.
  * @return  Command execute result.
 */
-static T_USER_CMD_PARSE_RESULT user_cmd_execute(T_USER_CMD_PARSED_VALUE *p_parse_value,
+static T_USER_CMD_PARSE_RESULT user_cmd_execute(T_USER_CMD_IF *p_user_cmd_if,
+                                                T_USER_CMD_PARSED_VALUE *p_parse_value, uint32_t hash,
                                                 const T_USER_CMD_TABLE_ENTRY *p_cmd_table)
 {
-    int32_t i = 0;
-    T_USER_CMD_PARSE_RESULT result = RESULT_CMD_NOT_FOUND;
+    const T_USER_CMD_TABLE_ENTRY *p_entry;
 
-    if (strcmp((const char *)p_parse_value->p_cmd, (const char *)"?") == 0)
+    if ((p_parse_value->p_cmd[0] == '?') && (p_parse_value->p_cmd[1] == '\0'))
     {
         user_cmd_list(p_cmd_table);
         return RESULT_SUCESS;
     }
 
-    /* find command in table */
-    while ((p_cmd_table + i)->p_cmd != NULL)
+    p_entry = user_cmd_find(p_user_cmd_if, p_cmd_table, p_parse_value->p_cmd, hash);
+    if (p_entry == NULL)
     {
-        if (strcmp((const char *)(p_cmd_table + i)->p_cmd, (const char *)p_parse_value->p_cmd) == 0)
-        {
-            /* check if user wants help */
-            if (p_parse_value->param_count && *p_parse_value->p_param[0] == '?')
-            {
-                data_uart_print("%s", (p_cmd_table + i)->p_option);
-                data_uart_print("%s", "  *");
-                data_uart_print("%s", (p_cmd_table + i)->p_help);
-                result = RESULT_SUCESS;
-            }
-            else
-            {
-                /* execute command function */
-                result = (p_cmd_table + i)->func(p_parse_value);
-            }
-            /* exit while */
-            break;
-        }
-        i++;
-    };
+        return RESULT_CMD_NOT_FOUND;
+    }
 
-    return result;
+    /* check if user wants help */
+    if (p_parse_value->param_count && *p_parse_value->p_param[0] == '?')
+    {
+        data_uart_print("%s", p_entry->p_option);
+        data_uart_print("%s", "  *");
+        data_uart_print("%s", p_entry->p_help);
+        return RESULT_SUCESS;
+    }
+
+    /* execute command function */
+    return p_entry->func(p_parse_value);
 }
 
 /**
  * @brief  Parse a command line and return the found command and parameters in "p_parse_value"
  *
+ * The line is tokenized in place in one pass, the command name is hashed while it is scanned.
  * @param p_user_cmd_if     Command parsed.
  * @param p_parse_value     Command parse value.
+ * @param p_hash            Hash of the command name.
  * @return  Command parse result.
 */
 static T_USER_CMD_PARSE_RESULT user_cmd_parse(T_USER_CMD_IF *p_user_cmd_if,
-                                              T_USER_CMD_PARSED_VALUE *p_parse_value)
+                                              T_USER_CMD_PARSED_VALUE *p_parse_value,
+                                              uint32_t *p_hash)
 {
-    int32_t i;
-    char *p, *q;
+    uint32_t hash = USER_CMD_HASH_INIT;
+    int32_t j = 0;
+    char *p;
 
     /* clear all results */
     p_parse_value->p_cmd       = NULL;
     p_parse_value->param_count = 0;
-    for (i = 0 ; i < USER_CMD_MAX_PARAMETERS; i++)
-    {
-        p_parse_value->p_param[i]  = NULL;
-        p_parse_value->dw_param[i] = 0;
-    }
-
-    /* Parse line */
-    p = p_user_cmd_if->cmdline_buf;
+    memset(p_parse_value->p_param, 0, sizeof(p_parse_value->p_param));
+    memset(p_parse_value->dw_param, 0, sizeof(p_parse_value->dw_param));
 
-    /*ignore leading spaces */
-    p = user_cmd_skip_spaces(p);
+    /* ignore leading spaces */
+    p = user_cmd_skip_spaces(p_user_cmd_if->cmdline_buf);
     if (*p == '\0')                     /* empty command line ? */
     {
         return RESULT_CMD_EMPTY_LINE;
     }
 
-    /* find end of word */
-    q = user_cmd_find_end_of_word(p);
-    if (p == q)                         /* empty command line ? */
+    /* find end of command */
+    p_parse_value->p_cmd = p;
+    while (!user_cmd_is_white_space(*p) && (*p != '\0'))
     {
-        return RESULT_CMD_EMPTY_LINE;
+        hash = (hash ^ (uint8_t)*p++) * USER_CMD_HASH_PRIME;
+    }
+    *p_hash = hash;
+    if (*p != '\0')
+    {
+        *p++ = '\0';                    /* mark end of command */
     }
-
-    p_parse_value->p_cmd = p;
-    *q = '\0';                        /* mark end of command */
-    p = q + 1;
 
     /* parse parameters */
-    if (*p != '\0')                   /* end of line ? */
+    while (j < USER_CMD_MAX_PARAMETERS)
     {
-        int32_t j;
+        p = user_cmd_skip_spaces(p);
+        if (*p == '\0')                 /* end of line ? */
+        {
+            break;
+        }
 
-        j = 0;
-        do
+        p_parse_value->p_param[j]  = p;
+        p_parse_value->dw_param[j] = user_cmd_str_to_uint32(p);
+        j++;
+
+        /* find next parameter */
+        p = user_cmd_find_end_of_word(p);
+        if (*p != '\0')
         {
-            uint32_t d;
-            /* ignore leading spaces */
-            p = user_cmd_skip_spaces(p);
-            d = user_cmd_str_to_uint32(p);
+            *p++ = '\0';                /* mark end of parameter */
+        }
+    }
+    p_parse_value->param_count = j;
 
-            p_parse_value->p_param[j]    = p;
-            p_parse_value->dw_param[j++] = d;
+    return RESULT_SUCESS;
+}
 
-            if (j >= USER_CMD_MAX_PARAMETERS)
-            {
-                break;
-            }
+/**
+ * @brief  Send the answer of a binary command frame.
+ *
+ * @param opcode    Index of the command.
+ * @param result    Command execute result.
+ * @return none.
+*/
+static void user_cmd_frame_reply(uint8_t opcode, T_USER_CMD_PARSE_RESULT result)
+{
+    uint8_t frame[6];
+    uint16_t crc;
+
+    frame[0] = USER_CMD_FRAME_SYNC;
+    frame[1] = 2;
+    frame[2] = opcode;
+    frame[3] = (uint8_t)result;
+    crc = btxfcs(BTXFCS_INIT, &frame[1], 3);
+    frame[4] = (uint8_t)crc;
+    frame[5] = (uint8_t)(crc >> 8);
+    data_uart_send(frame, sizeof(frame));
+}
 
-            /* find next parameter */
-            p  = user_cmd_find_end_of_word(p);
-            *p++ = '\0';                        /* mark end of parameter */
-        }
-        while (*p != '\0');
+/**
+ * @brief  Execute a complete binary command frame.
+ *
+ * @param p_user_cmd_if     Command interface, frame_buf holds the frame.
+ * @param p_cmd_table       Command table.
+ * @return none.
+*/
+static void user_cmd_frame_execute(T_USER_CMD_IF *p_user_cmd_if,
+                                   const T_USER_CMD_TABLE_ENTRY *p_cmd_table)
+{
+    static char empty_param[] = "";
+    T_USER_CMD_PARSED_VALUE parse_value;
+    T_USER_CMD_PARSE_RESULT result;
+    uint8_t *p_buf = p_user_cmd_if->frame_buf;
+    uint8_t payload_len = p_buf[1];
+    uint8_t opcode = p_buf[2];
+    uint16_t crc = p_buf[2 + payload_len] | (p_buf[3 + payload_len] << 8);
+
+    if (btxfcs(BTXFCS_INIT, &p_buf[1], 1 + payload_len) != crc)
+    {
+        user_cmd_frame_reply(opcode, RESULT_ERR);
+        return;
+    }
+    if (opcode >= p_user_cmd_if->cmd_count)
+    {
+        user_cmd_frame_reply(opcode, RESULT_CMD_NOT_FOUND);
+        return;
+    }
 
-        p_parse_value->param_count = j;
+    parse_value.p_cmd = p_cmd_table[opcode].p_cmd;
+    parse_value.param_count = (payload_len - 1) / 4;
+    memset(parse_value.dw_param, 0, sizeof(parse_value.dw_param));
+    for (int32_t i = 0; i < USER_CMD_MAX_PARAMETERS; i++)
+    {
+        parse_value.p_param[i] = empty_param;
     }
+    for (int32_t i = 0; i < parse_value.param_count; i++)
+    {
+        uint8_t *p = &p_buf[3 + 4 * i];
 
-    return RESULT_SUCESS;
+        parse_value.dw_param[i] = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    result = p_cmd_table[opcode].func(&parse_value);
+    user_cmd_frame_reply(opcode, result);
+}
+
+/**
+ * @brief  Collect a byte of a binary command frame.
+ *
+ * @param p_user_cmd_if     Command interface.
+ * @param c                 Received byte, the sync byte for the first call of a frame.
+ * @param p_cmd_table       Command table.
+ * @return none.
+*/
+static void user_cmd_frame_collect(T_USER_CMD_IF *p_user_cmd_if, uint8_t c,
+                                   const T_USER_CMD_TABLE_ENTRY *p_cmd_table)
+{
+    uint8_t payload_len;
+
+    p_user_cmd_if->frame_buf[p_user_cmd_if->frame_pos++] = c;
+    if (p_user_cmd_if->frame_pos < 2)
+    {
+        return;
+    }
+
+    payload_len = p_user_cmd_if->frame_buf[1];
+    if ((payload_len == 0) || (payload_len > USER_CMD_FRAME_MAX_PAYLOAD) ||
+        ((payload_len - 1) % 4 != 0))
+    {
+        /* not a frame, drop it, the length may be the sync byte of the next frame */
+        p_user_cmd_if->frame_pos = 0;
+        if (c == USER_CMD_FRAME_SYNC)
+        {
+            p_user_cmd_if->frame_buf[p_user_cmd_if->frame_pos++] = c;
+        }
+        return;
+    }
+
+    if (p_user_cmd_if->frame_pos == 2 + payload_len + 2)
+    {
+        p_user_cmd_if->frame_pos = 0;
+        user_cmd_frame_execute(p_user_cmd_if, p_cmd_table);
+#if F_BT_DLPS_EN
+        data_uart_can_enter_dlps(true);
+#endif
+    }
 }
 
 /**
@@ -404,14 +601,17 @@ static void cmd_clear_screen(T_USER_CMD_IF *p_user_cmd_if)
     void app_handle_io_msg(T_IO_MSG io_msg)
     {
         uint16_t msg_type = io_msg.type;
-        uint8_t rx_char;
+        uint8_t rx_buf[32];
+        uint16_t rx_len;
 
         switch (msg_type)
         {
         case IO_MSG_TYPE_UART:
             // We handle user command informations from Data UART in this branch.
-            rx_char = (uint8_t)io_msg.subtype;
-            user_cmd_collect(&user_cmd_if, &rx_char, sizeof(rx_char), user_cmd_table);
+            while ((rx_len = data_uart_read(rx_buf, sizeof(rx_buf))) != 0)
+            {
+                user_cmd_collect(&user_cmd_if, rx_buf, rx_len, user_cmd_table);
+            }
             break;
         default:
             break;
@@ -423,11 +623,35 @@ bool user_cmd_collect(T_USER_CMD_IF *p_user_cmd_if, uint8_t *p_data, int32_t len
                       const T_USER_CMD_TABLE_ENTRY *p_cmd_table)
 {
     T_USER_CMD_PARSED_VALUE parse_result;
+    uint32_t hash;
+    uint32_t now;
+
+    if (p_user_cmd_if->p_index_table != p_cmd_table)
+    {
+        user_cmd_index_build(p_user_cmd_if, p_cmd_table);
+    }
+
+    now = (uint32_t)os_sys_time_get();
+    if ((p_user_cmd_if->frame_pos != 0) &&
+        (now - p_user_cmd_if->frame_time > USER_CMD_FRAME_TIMEOUT_MS))
+    {
+        /* the rest of the frame is lost, go back to command lines */
+        p_user_cmd_if->frame_pos = 0;
+    }
+    p_user_cmd_if->frame_time = now;
 
     while (len--)
     {
         char c = *p_data++;
 
+        if ((p_user_cmd_if->frame_pos != 0) ||
+            (p_user_cmd_if->frame_en && ((uint8_t)c == USER_CMD_FRAME_SYNC) &&
+             (p_user_cmd_if->accum_cmd_len == 0)))
+        {
+            user_cmd_frame_collect(p_user_cmd_if, (uint8_t)c, p_cmd_table);
+            continue;
+        }
+
         if (c != 0x0)                   /* not ESC character received */
         {
             switch (c)                  /* Normal handling */
@@ -462,10 +686,10 @@ bool user_cmd_collect(T_USER_CMD_IF *p_user_cmd_if, uint8_t *p_data, int32_t len
                            p_user_cmd_if->accum_cmd_len);
 
                     p_user_cmd_if->cmdline_buf[p_user_cmd_if->accum_cmd_len] = '\0';
-                    result = user_cmd_parse(p_user_cmd_if, &parse_result);
+                    result = user_cmd_parse(p_user_cmd_if, &parse_result, &hash);
                     if (result == RESULT_SUCESS)
                     {
-                        result = user_cmd_execute(&parse_result, p_cmd_table);
+                        result = user_cmd_execute(p_user_cmd_if, &parse_result, hash, p_cmd_table);
                     }
 
                     if (result != RESULT_SUCESS)
@@ -640,3 +864,14 @@ void user_cmd_init(T_USER_CMD_IF *p_user_cmd_if, char *project_name)
     data_uart_print(">> Command Parse Init (%s) <<\r\n", project_name);
 }
 
+/**
+ * @brief  Accept binary command frames besides the command lines.
+ * @param[in] p_user_cmd_if   Command interface.
+ * @param[in] enable          Accept binary frames or not.
+ * @return void
+ */
+void user_cmd_frame_enable(T_USER_CMD_IF *p_user_cmd_if, bool enable)
+{
+    p_user_cmd_if->frame_en = enable;
+    p_user_cmd_if->frame_pos = 0;
+}
@@ -37,6 +37,13 @@ extern "C" {
 #define USER_CMD_MAX_COMMAND_LINE       80  /**< max. length of command line in bytes */
 #define USER_CMD_MAX_HISTORY_LINE       3   /**< max. num of history command line */
 #define USER_CMD_MAX_PARAMETERS         20  /**< max. number of parameters that the parser will scan */
+#define USER_CMD_HASH_SIZE              256 /**< slots of the command hash index, a power of 2 */
+#define USER_CMD_HASH_MAX_COMMANDS      (USER_CMD_HASH_SIZE / 2) /**< larger tables are searched linearly */
+
+#define USER_CMD_FRAME_SYNC             0xA5 /**< first byte of a binary command frame */
+#define USER_CMD_FRAME_MAX_PAYLOAD      (1 + 4 * USER_CMD_MAX_PARAMETERS) /**< opcode and parameters */
+#define USER_CMD_FRAME_MAX_LEN          (2 + USER_CMD_FRAME_MAX_PAYLOAD + 2) /**< sync, length, payload, CRC */
+#define USER_CMD_FRAME_TIMEOUT_MS       20   /**< a frame is dropped if the next byte comes later */
 /** End of USER_CMD_PARSE_Exported_Micros
   * @}
   */
@@ -103,6 +110,13 @@ typedef struct
     uint8_t   history_tail;
     uint8_t   history_cur;
     int32_t   accum_cmd_len;            /**< accumulated length of command */
+    const void *p_index_table;          /**< command table the hash index is built for */
+    uint16_t  cmd_count;                /**< number of commands of that table */
+    uint8_t   cmd_index[USER_CMD_HASH_SIZE];    /**< table index + 1 in each slot, 0 if empty */
+    bool      frame_en;                 /**< binary command frames accepted */
+    uint8_t   frame_pos;                /**< bytes of the binary frame received, 0 if none */
+    uint8_t   frame_buf[USER_CMD_FRAME_MAX_LEN];
+    uint32_t  frame_time;               /**< time of the last received data in ms */
 } T_USER_CMD_IF;
 
 /** @brief Prototype of functions that can be called from command table. */
@@ -171,14 +185,17 @@ void user_cmd_init(T_USER_CMD_IF *p_user_cmd_if, char *project_name);
     void app_handle_io_msg(T_IO_MSG io_msg)
     {
         uint16_t msg_type = io_msg.type;
-        uint8_t rx_char;
+        uint8_t rx_buf[32];
+        uint16_t rx_len;
 
         switch (msg_type)
         {
         case IO_MSG_TYPE_UART:
             // We handle user command informations from Data UART in this branch.
-            rx_char = (uint8_t)io_msg.subtype;
-            user_cmd_collect(&user_cmd_if, &rx_char, sizeof(rx_char), user_cmd_table);
+            while ((rx_len = data_uart_read(rx_buf, sizeof(rx_buf))) != 0)
+            {
+                user_cmd_collect(&user_cmd_if, rx_buf, rx_len, user_cmd_table);
+            }
             break;
         default:
             break;
@@ -188,6 +205,25 @@ void user_cmd_init(T_USER_CMD_IF *p_user_cmd_if, char *project_name);
  */
 bool user_cmd_collect(T_USER_CMD_IF *p_user_cmd_if, uint8_t *p_data, int32_t len,
                       const T_USER_CMD_TABLE_ENTRY *p_cmd_table);
+
+/**
+ * @brief  Accept binary command frames besides the command lines.
+ *
+ * A frame starts at the beginning of a line and skips the echo, history and ASCII parsing.
+ * All fields are little endian:
+ * - 0xA5, length of the payload, payload, CRC of the length and the payload (btxfcs, BTXFCS_INIT).
+ * - The payload is the index of the command in the table followed by its uint32_t parameters.
+ * - p_param of the parsed value points to empty strings, only dw_param is set.
+ *
+ * Each frame is answered by a frame with the payload: index of the command, T_USER_CMD_PARSE_RESULT.
+ * A frame with a bad CRC is answered with RESULT_ERR. A frame with a bad length, or not complete
+ * within USER_CMD_FRAME_TIMEOUT_MS of its last byte, is dropped and the following data is parsed
+ * as command lines.
+ * @param[in] p_user_cmd_if   Command interface.
+ * @param[in] enable          Accept binary frames or not.
+ * @return void
+ */
+void user_cmd_frame_enable(T_USER_CMD_IF *p_user_cmd_if, bool enable);
 /** End of USER_CMD_PARSE_Exported_Functions
   * @}
   */
@@ -131,6 +131,20 @@ typedef struct _usb_pipe_attr
  */
 typedef uint32_t (*USB_PIPE_CB)(void *handle, void *buf, uint32_t len, int status);
 
+/**
+ * usb_pipe.h
+ *
+ * \brief   One segment of the data sent by \ref usb_pipe_sendv.
+ *
+ * \param buf: The data of the segment.
+ * \param len: The length of the segment.
+ */
+typedef struct _usb_pipe_iov
+{
+    void *buf;
+    uint32_t len;
+} T_USB_PIPE_IOV;
+
 /** End of group USB_PIPE_Exported_Types
   * @}
   */
@@ -182,6 +196,42 @@ int usb_pipe_close(void *handle);
  */
 int usb_pipe_send(void *handle, void *buf, uint32_t len);
 
+/**
+ * usb_pipe.h
+ *
+ * \brief   Send data pipe from several segments.
+ *
+ * \details The segments are gathered into one transfer, so a header and a payload can be sent
+ *          without being joined by the caller first. The total length must not exceed the mtu.
+ *
+ * \param  handle The return value of \ref usb_pipe_open.
+ * \param  iov The segments of \ref T_USB_PIPE_IOV to be sent.
+ * \param  iov_num The number of segments.
+ *
+ * \return Refer to `rtl_errno.h`.
+ */
+int usb_pipe_sendv(void *handle, const T_USB_PIPE_IOV *iov, uint8_t iov_num);
+
+/**
+ * usb_pipe.h
+ *
+ * \brief   Send data pipe without copying the data.
+ *
+ * \details The buffer is handed to the controller directly and must stay valid until \p done is called.
+ *          The pipe must be an in pipe opened with pending requests, and the buffer must be 4-byte aligned.
+ *
+ * \param  handle The return value of \ref usb_pipe_open.
+ * \param  buf The data to be sent.
+ * \param  len The length of data, which must not exceed the mtu.
+ * \param  done Called exactly once to return the buffer, with the actual length and the status of the
+ *              transmission. A status of -ENOBUFS means the data was dropped by congestion control and
+ *              -ESHUTDOWN means the pipe was closed or the endpoint was disabled.
+ *
+ * \return Refer to `rtl_errno.h`. If the result is not ESUCCESS, \p done is not called and the buffer
+ *         is still owned by the caller.
+ */
+int usb_pipe_send_zero_copy(void *handle, void *buf, uint32_t len, USB_PIPE_CB done);
+
 /**
  * usb_pipe.h
  *
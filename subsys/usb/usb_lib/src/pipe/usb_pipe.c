@@ -13,17 +13,25 @@ static int fail_line = 0;
 
 typedef struct _t_usb_pipe_req
 {
-    struct _t_usb_pipe_req *p_next;
     void *buf;
     uint32_t len;
+    USB_PIPE_CB done;               /* returns the buffer of a zero-copy request, NULL for a copied one */
 } T_USB_PIPE_REQ;
 
+/*
+ * Requests are queued in a fixed ring, reqs[head] is the oldest one and is in flight if busy is set.
+ * Copied requests take a buffer of mtu bytes from free_bufs, zero-copy requests use the caller's buffer.
+ */
 typedef struct _t_usb_pipe_tx
 {
     void *buf;
-    T_USB_PIPE_REQ *cur_req;
-    T_USB_UTILS_LIST pending_reqs;
-    T_USB_UTILS_LIST idle_reqs;
+    T_USB_PIPE_REQ *reqs;
+    void **free_bufs;
+    uint8_t req_num;
+    uint8_t head;
+    uint8_t count;
+    uint8_t free_buf_num;
+    bool busy;
 } T_USB_PIPE_TX;
 
 typedef struct _t_usb_pipe_db
@@ -32,6 +40,7 @@ typedef struct _t_usb_pipe_db
     void *ep_handle;
     T_USB_PIPE_ATTR attr;
     T_HAL_USB_REQUEST_BLOCK *urb;
+    uint8_t *urb_buf;
     T_USB_ENDPOINT_DESC **ep_desc;
     USB_PIPE_CB cb;
     union
@@ -69,7 +78,8 @@ void *usb_pipe_open(T_USB_ENDPOINT_DESC **desc, uint8_t ep_addr, T_USB_PIPE_ATTR
     T_USB_PIPE_DB *pipe = NULL;
     T_HAL_USB_REQUEST_BLOCK *urb = NULL;
     void *ep_handle = NULL;
-    T_USB_PIPE_REQ *req = NULL;
+    T_USB_PIPE_TX *tx = NULL;
+    uint32_t buf_size = 0;
 
     ep_handle = hal_usb_ep_handle_get(ep_addr);
     pipe = usb_pipe_match(ep_handle);
@@ -78,7 +88,7 @@ void *usb_pipe_open(T_USB_ENDPOINT_DESC **desc, uint8_t ep_addr, T_USB_PIPE_ATTR
         goto end;
     }
 
-    pipe = (T_USB_PIPE_DB *)malloc(sizeof(T_USB_PIPE_DB) + sizeof(T_USB_PIPE_REQ) * pending_req_num);
+    pipe = (T_USB_PIPE_DB *)malloc(sizeof(T_USB_PIPE_DB));
     if (!pipe)
     {
         fail_line = __LINE__;
@@ -99,41 +109,39 @@ void *usb_pipe_open(T_USB_ENDPOINT_DESC **desc, uint8_t ep_addr, T_USB_PIPE_ATTR
     urb->complete_in_isr = attr.high_throughput;
     urb->priv = pipe;
     pipe->urb = urb;
+    pipe->urb_buf = urb->buf;
     pipe->ep_desc = desc;
     pipe->cb = cb;
 
     if ((ep_addr & USB_DIR_MASK) && pending_req_num != 0)
     {
-        pipe->priv.tx = malloc(sizeof(T_USB_PIPE_TX));
-        if (!pipe->priv.tx)
+        tx = malloc(sizeof(T_USB_PIPE_TX) + pending_req_num * (sizeof(T_USB_PIPE_REQ) + sizeof(void *)));
+        if (!tx)
         {
             fail_line = __LINE__;
             goto end;
         }
-        memset(pipe->priv.tx, 0, sizeof(T_USB_PIPE_TX));
-        pipe->priv.tx->buf = (uint8_t *)malloc(pending_req_num * pipe->attr.mtu);
-        if (!pipe->priv.tx->buf)
+        memset(tx, 0, sizeof(T_USB_PIPE_TX));
+        pipe->priv.tx = tx;
+
+        /* the request buffers are handed to the URB directly, so keep each one word aligned */
+        buf_size = (attr.mtu + 3) & ~3;
+        tx->buf = (uint8_t *)malloc(pending_req_num * buf_size);
+        if (!tx->buf)
         {
             fail_line = __LINE__;
             goto end;
         }
-        memset(pipe->priv.tx->buf, 0, pending_req_num * pipe->attr.mtu);
-
-        USB_UTILS_LIST_INIT(&(pipe->priv.tx->pending_reqs));
-        USB_UTILS_LIST_INIT(&(pipe->priv.tx->idle_reqs));
+        memset(tx->buf, 0, pending_req_num * buf_size);
 
+        tx->reqs = (T_USB_PIPE_REQ *)(tx + 1);
+        tx->free_bufs = (void **)(tx->reqs + pending_req_num);
+        tx->req_num = pending_req_num;
         for (uint8_t i = 0; i < pending_req_num; i++)
         {
-            req = malloc(sizeof(T_USB_PIPE_REQ));
-            if (!req)
-            {
-                fail_line = __LINE__;
-                goto end;
-            }
-            memset(req, 0, sizeof(T_USB_PIPE_REQ));
-            req->buf = (uint8_t *)pipe->priv.tx->buf + i * attr.mtu;
-            USB_UTILS_LIST_INSERT_TAIL(&(pipe->priv.tx->idle_reqs), req);
+            tx->free_bufs[i] = (uint8_t *)tx->buf + i * buf_size;
         }
+        tx->free_buf_num = pending_req_num;
     }
 
 end:
@@ -143,20 +151,210 @@ end:
     return pipe;
 }
 
+USB_USER_SPEC_SECTION
+static uint8_t usb_pipe_req_index(T_USB_PIPE_TX *tx, uint8_t offset)
+{
+    uint32_t index = tx->head + offset;
+
+    return (index >= tx->req_num) ? (index - tx->req_num) : index;
+}
+
+/* Remove the oldest request with the lock held, and return its copy buffer */
+USB_USER_SPEC_SECTION
+static void usb_pipe_req_pop(T_USB_PIPE_TX *tx, T_USB_PIPE_REQ *req)
+{
+    *req = tx->reqs[tx->head];
+    tx->head = usb_pipe_req_index(tx, 1);
+    tx->count--;
+    if (req->done == NULL)
+    {
+        tx->free_bufs[tx->free_buf_num++] = req->buf;
+    }
+}
+
+/* Remove the oldest request that is not in flight with the lock held, the copy buffer is kept in req */
+USB_USER_SPEC_SECTION
+static bool usb_pipe_req_drop_first(T_USB_PIPE_TX *tx, T_USB_PIPE_REQ *req)
+{
+    uint8_t first = tx->busy ? 1 : 0;
+
+    if (tx->count <= first)
+    {
+        return false;
+    }
+
+    *req = tx->reqs[usb_pipe_req_index(tx, first)];
+    if (tx->busy)
+    {
+        tx->reqs[usb_pipe_req_index(tx, 1)] = tx->reqs[tx->head];
+    }
+    tx->head = usb_pipe_req_index(tx, 1);
+    tx->count--;
+    return true;
+}
+
+/* Get a copy buffer, dropping the oldest pending request if the congestion control allows */
+USB_USER_SPEC_SECTION
+static void *usb_pipe_buf_get(T_USB_PIPE_DB *pipe)
+{
+    T_USB_PIPE_TX *tx = pipe->priv.tx;
+    T_USB_PIPE_REQ dropped;
+    void *buf = NULL;
+    bool retry = true;
+    uint32_t s;
+
+    while (buf == NULL && retry)
+    {
+        dropped.done = NULL;
+        s = os_lock();
+        if (tx->free_buf_num > 0)
+        {
+            buf = tx->free_bufs[--tx->free_buf_num];
+        }
+        else if (pipe->attr.congestion_ctrl == USB_PIPE_CONGESTION_CTRL_DROP_FIRST &&
+                 usb_pipe_req_drop_first(tx, &dropped))
+        {
+            if (dropped.done == NULL)
+            {
+                buf = dropped.buf;
+            }
+        }
+        else
+        {
+            retry = false;
+        }
+        os_unlock(s);
+
+        if (dropped.done)
+        {
+            dropped.done(pipe, dropped.buf, 0, -ENOBUFS);
+        }
+    }
+
+    return buf;
+}
+
+USB_USER_SPEC_SECTION
+static int usb_pipe_req_submit(T_USB_PIPE_DB *pipe, T_USB_PIPE_REQ *req)
+{
+    T_USB_PIPE_TX *tx = pipe->priv.tx;
+    T_USB_PIPE_REQ dropped;
+    bool queued = true;
+    uint32_t s;
+
+    dropped.done = NULL;
+    s = os_lock();
+#if LOG_PRINT
+    USB_PRINT_INFO2("usb_pipe_req_submit:0x%x-0x%x", tx->count, tx->busy);
+#endif
+    if (tx->count == tx->req_num)
+    {
+        if (pipe->attr.congestion_ctrl == USB_PIPE_CONGESTION_CTRL_DROP_FIRST &&
+            usb_pipe_req_drop_first(tx, &dropped))
+        {
+            if (dropped.done == NULL)
+            {
+                tx->free_bufs[tx->free_buf_num++] = dropped.buf;
+            }
+        }
+        else
+        {
+            queued = false;
+            if (req->done == NULL)
+            {
+                tx->free_bufs[tx->free_buf_num++] = req->buf;
+            }
+        }
+    }
+    if (queued)
+    {
+        tx->reqs[usb_pipe_req_index(tx, tx->count)] = *req;
+        tx->count++;
+    }
+    os_unlock(s);
+
+    if (dropped.done)
+    {
+        dropped.done(pipe, dropped.buf, 0, -ENOBUFS);
+    }
+
+    return queued ? ESUCCESS : -ENOBUFS;
+}
+
+/* Finish the request in flight */
+USB_USER_SPEC_SECTION
+static void usb_pipe_req_finish(T_USB_PIPE_DB *pipe, uint32_t actual, int status)
+{
+    T_USB_PIPE_TX *tx = pipe->priv.tx;
+    T_USB_PIPE_REQ req;
+    uint32_t s;
+
+    s = os_lock();
+    usb_pipe_req_pop(tx, &req);
+    tx->busy = false;
+    os_unlock(s);
+
+    if (req.done)
+    {
+        req.done(pipe, req.buf, actual, status);
+    }
+}
+
+/* Discard the queued requests, including the one in flight if all is set */
+static void usb_pipe_req_flush(T_USB_PIPE_DB *pipe, bool all)
+{
+    T_USB_PIPE_TX *tx = pipe->priv.tx;
+    T_USB_PIPE_REQ req;
+    bool more = true;
+    uint32_t s;
+
+    while (more)
+    {
+        req.done = NULL;
+        s = os_lock();
+        more = (tx->count > 0 && (all || !tx->busy));
+        if (more)
+        {
+            usb_pipe_req_pop(tx, &req);
+            if (tx->count == 0)
+            {
+                tx->busy = false;
+            }
+        }
+        os_unlock(s);
+
+        if (req.done)
+        {
+            req.done(pipe, req.buf, 0, -ESHUTDOWN);
+        }
+    }
+}
+
 int usb_pipe_close(void *handle)
 {
-    T_USB_PIPE_REQ *req = NULL;
     T_USB_PIPE_DB *pipe = (T_USB_PIPE_DB *)handle;
     T_USB_ENDPOINT_DESC *ep_desc = NULL;
     T_USB_PIPE_DB *pipe_tmp = NULL;
     bool found = false;
-    int s = os_lock();
+    int s;
+
+    if (pipe && pipe->priv.tx)
+    {
+        /* the URB in flight still owns the request buffer, stop the endpoint before it is returned */
+        if (pipe->priv.tx->busy)
+        {
+            hal_usb_ep_disable(pipe->ep_handle);
+        }
+        usb_pipe_req_flush(pipe, true);
+    }
 
+    s = os_lock();
     if (pipe)
     {
         pipe->ep_handle = NULL;
         if (pipe->urb)
         {
+            pipe->urb->buf = pipe->urb_buf;
             hal_usb_urb_free(pipe->urb);
             pipe->urb = NULL;
         }
@@ -172,16 +370,6 @@ int usb_pipe_close(void *handle)
                     free(pipe->priv.tx->buf);
                     pipe->priv.tx->buf = NULL;
                 }
-                USB_UTILS_LIST_FOREACH(&pipe->priv.tx->idle_reqs, T_USB_PIPE_REQ *, req)
-                {
-                    USB_UTILS_LIST_REMOVE(&pipe->priv.tx->idle_reqs, req);
-                    free(req);
-                }
-                USB_UTILS_LIST_FOREACH(&pipe->priv.tx->pending_reqs, T_USB_PIPE_REQ *, req)
-                {
-                    USB_UTILS_LIST_REMOVE(&pipe->priv.tx->pending_reqs, req);
-                    free(req);
-                }
 
                 free(pipe->priv.tx);
                 pipe->priv.tx = NULL;
@@ -210,33 +398,50 @@ int usb_pipe_close(void *handle)
     os_unlock(s);
     return ESUCCESS;
 }
+
+/* Start the oldest request if none is in flight, return the result of the last start */
 USB_USER_SPEC_SECTION
-static void usb_pipe_pending_req_handle(T_USB_PIPE_DB *pipe)
+static int usb_pipe_pending_req_handle(T_USB_PIPE_DB *pipe)
 {
-    bool send_now = false;
-    T_USB_PIPE_REQ  *req = NULL;
+    T_USB_PIPE_TX *tx = pipe->priv.tx;
+    T_USB_PIPE_REQ req;
+    bool send_now = true;
+    int ret = ESUCCESS;
     uint32_t s;
 
-    s = os_lock();
-    if (pipe->priv.tx->cur_req == NULL && pipe->priv.tx->pending_reqs.count > 0)
+    while (send_now)
     {
-        USB_UTILS_LIST_REMOVE_HEAD(&(pipe->priv.tx->pending_reqs), req);
-        pipe->priv.tx->cur_req = req;
-        send_now = true;
-    }
-    os_unlock(s);
+        s = os_lock();
+        send_now = (!tx->busy && tx->count > 0);
+        if (send_now)
+        {
+            tx->busy = true;
+            req = tx->reqs[tx->head];
+        }
+        os_unlock(s);
 
-    if (send_now)
-    {
-        usb_pipe_ep_data_send(pipe, pipe->priv.tx->cur_req->buf, pipe->priv.tx->cur_req->len);
+        if (send_now)
+        {
+            ret = usb_pipe_ep_data_send(pipe, req.buf, req.len);
+            if (ret == ESUCCESS)
+            {
+                break;
+            }
+            if (pipe->cb)
+            {
+                pipe->cb(pipe, req.buf, 0, ret);
+            }
+            usb_pipe_req_finish(pipe, 0, ret);
+        }
     }
+
+    return ret;
 }
 
 USB_USER_SPEC_SECTION
 static int usb_pipe_in_xfer_done(T_HAL_USB_REQUEST_BLOCK *urb)
 {
     int ret = ESUCCESS;
-    uint32_t s;
     T_USB_PIPE_DB *pipe = urb->priv;
     if (!pipe)
     {
@@ -252,24 +457,14 @@ static int usb_pipe_in_xfer_done(T_HAL_USB_REQUEST_BLOCK *urb)
 
     if (pipe->priv.tx)
     {
-        s = os_lock();
-        USB_UTILS_LIST_INSERT_TAIL(&(pipe->priv.tx->idle_reqs), pipe->priv.tx->cur_req);
-        pipe->priv.tx->cur_req = NULL;
+        usb_pipe_req_finish(pipe, urb->actual, urb->status);
         if (urb->status == -ESHUTDOWN)
         {
-            T_USB_PIPE_REQ  *req = NULL;
-            USB_UTILS_LIST_FOREACH(&pipe->priv.tx->pending_reqs, T_USB_PIPE_REQ *, req)
-            {
-                USB_UTILS_LIST_INSERT_TAIL(&(pipe->priv.tx->idle_reqs), req);
-            }
-            USB_UTILS_LIST_INIT(&(pipe->priv.tx->pending_reqs));
-            os_unlock(s);
+            usb_pipe_req_flush(pipe, false);
             goto end;
         }
-        os_unlock(s);
 
         usb_pipe_pending_req_handle(pipe);
-
     }
 
 end:
@@ -304,7 +499,7 @@ static int usb_pipe_ep_data_send(void *handle, uint8_t *buf, uint32_t len)
     }
     urb->length = len;
     urb->ep_handle = pipe->ep_handle;
-    memcpy(urb->buf, buf, len);
+    urb->buf = buf;
     urb->complete = usb_pipe_in_xfer_done;
 
     if (pipe->attr.zlp)
@@ -335,94 +530,122 @@ end:
 }
 
 USB_USER_SPEC_SECTION
-int usb_pipe_send(void *handle, void *buf, uint32_t len)
+int usb_pipe_sendv(void *handle, const T_USB_PIPE_IOV *iov, uint8_t iov_num)
 {
     int ret = ESUCCESS;
-    bool send_now = true;
-    T_USB_PIPE_REQ  *req = NULL;
+    T_USB_PIPE_REQ req;
     T_USB_PIPE_DB *pipe = (T_USB_PIPE_DB *)handle;
-    uint32_t s;
-    uint8_t *buf_to_send = buf;
-    uint32_t len_to_send = len;
+    uint32_t len = 0;
+    uint8_t *dst;
 
-    if (!pipe)
+    if (!pipe || !iov)
     {
         fail_line = __LINE__;
         ret = -EFAULT;
         goto end;
     }
+    for (uint8_t i = 0; i < iov_num; i++)
+    {
+        len += iov[i].len;
+    }
     if (len > pipe->attr.mtu)
     {
         fail_line = __LINE__;
         ret = -EFAULT;
         goto end;
     }
+
+    /* gather straight into the buffer handed to the URB */
     if (pipe->priv.tx)
     {
-        s = os_lock();
-        USB_UTILS_LIST_REMOVE_HEAD(&(pipe->priv.tx->idle_reqs), req);
-        os_unlock(s);
-        if (!req)
+        dst = usb_pipe_buf_get(pipe);
+        if (!dst)
         {
-            if (pipe->attr.congestion_ctrl == USB_PIPE_CONGESTION_CTRL_DROP_FIRST)
-            {
-                s = os_lock();
-                USB_UTILS_LIST_REMOVE_HEAD(&(pipe->priv.tx->pending_reqs), req);
-                os_unlock(s);
-            }
-            else
-            {
-                fail_line = __LINE__;
-                ret = -EFAULT;
-                goto end;
-            }
+            fail_line = __LINE__;
+            ret = -EFAULT;
+            goto end;
         }
-        memcpy(req->buf, buf, len);
-        req->len = len;
-        s = os_lock();
-#if LOG_PRINT
-        USB_PRINT_INFO2("usb_pipe_send:0x%x-0x%x", pipe->priv.tx->pending_reqs.count,
-                        pipe->priv.tx->cur_req);
-#endif
-        if (pipe->priv.tx->pending_reqs.count > 0 || pipe->priv.tx->cur_req != NULL)
+    }
+    else
+    {
+        dst = pipe->urb_buf;
+    }
+    req.buf = dst;
+    req.len = len;
+    req.done = NULL;
+    for (uint8_t i = 0; i < iov_num; i++)
+    {
+        memcpy(dst, iov[i].buf, iov[i].len);
+        dst += iov[i].len;
+    }
+
+    if (pipe->priv.tx)
+    {
+        ret = usb_pipe_req_submit(pipe, &req);
+        if (ret == ESUCCESS)
         {
-            USB_UTILS_LIST_INSERT_TAIL(&(pipe->priv.tx->pending_reqs), req);
-            send_now = false;
+            ret = usb_pipe_pending_req_handle(pipe);
         }
-        else
+    }
+    else
+    {
+        ret = usb_pipe_ep_data_send(pipe, req.buf, req.len);
+        if (ret != ESUCCESS && pipe->cb)
         {
-            pipe->priv.tx->cur_req = req;
-            send_now = true;
+            pipe->cb(pipe, pipe->urb->buf, 0, ret);
         }
-        os_unlock(s);
-        buf_to_send = pipe->priv.tx->cur_req->buf;
-        len_to_send =  pipe->priv.tx->cur_req->len;
     }
 
-    if (send_now)
+end:
+    if (ret != ESUCCESS)
     {
-        ret = usb_pipe_ep_data_send(pipe, buf_to_send, len_to_send);
-        if (ret != ESUCCESS)
-        {
-            if (pipe->cb)
-            {
-                pipe->cb(pipe, pipe->urb->buf, 0, ret);
-            }
-            if (pipe->priv.tx)
-            {
-                s = os_lock();
-                USB_UTILS_LIST_INSERT_TAIL(&(pipe->priv.tx->idle_reqs), pipe->priv.tx->cur_req);
-                pipe->priv.tx->cur_req = NULL;
-                os_unlock(s);
-                usb_pipe_pending_req_handle(pipe);
-            }
-        }
+        USB_PRINT_INFO2("usb_pipe_sendv, result:%d, fail line:%d", ret, fail_line);
+    }
+    return ret;
+}
+
+USB_USER_SPEC_SECTION
+int usb_pipe_send(void *handle, void *buf, uint32_t len)
+{
+    T_USB_PIPE_IOV iov = {.buf = buf, .len = len};
+
+    return usb_pipe_sendv(handle, &iov, 1);
+}
+
+USB_USER_SPEC_SECTION
+int usb_pipe_send_zero_copy(void *handle, void *buf, uint32_t len, USB_PIPE_CB done)
+{
+    int ret = ESUCCESS;
+    T_USB_PIPE_REQ req;
+    T_USB_PIPE_DB *pipe = (T_USB_PIPE_DB *)handle;
+
+    if (!pipe || !buf || !done)
+    {
+        fail_line = __LINE__;
+        ret = -EFAULT;
+        goto end;
+    }
+    if (!pipe->priv.tx || ((uint32_t)buf & 3) != 0 || len > pipe->attr.mtu)
+    {
+        fail_line = __LINE__;
+        ret = -EINVAL;
+        goto end;
+    }
+
+    req.buf = buf;
+    req.len = len;
+    req.done = done;
+    ret = usb_pipe_req_submit(pipe, &req);
+    if (ret == ESUCCESS)
+    {
+        /* once queued, the result is reported by done */
+        usb_pipe_pending_req_handle(pipe);
     }
 
 end:
     if (ret != ESUCCESS)
     {
-        USB_PRINT_INFO2("usb_pipe_send, result:%d, fail line:%d", ret, fail_line);
+        USB_PRINT_INFO2("usb_pipe_send_zero_copy, result:%d, fail line:%d", ret, fail_line);
     }
     return ret;
 }